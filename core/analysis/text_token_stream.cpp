@@ -22,6 +22,7 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include <cctype>
+#include <cstring>
 #include <fstream>
 #include <mutex>
 #include <unordered_map>
@@ -71,14 +72,27 @@ NS_BEGIN(analysis)
 // -----------------------------------------------------------------------------
 
 struct text_token_stream::state_t {
+  struct term_entry {
+    irs::bstring value; // resulting term value
+    bool ignored; // term is in the ignored words list
+  };
+
+  // maximum number of entries in the 'terms' memo
+  static const size_t MAX_TERMS = 4096;
+
+  string_ref ascii_data; // input data if it consists of ASCII characters only
+  size_t ascii_offset; // offset of the next word in 'ascii_data'
+  bool ascii; // input data is tokenized without ICU
+  bool ascii_enabled; // locale case-conversion is equivalent to ASCII one
   std::shared_ptr<BreakIterator> break_iterator;
   UnicodeString data;
   Locale locale;
   std::shared_ptr<const Normalizer2> normalizer;
   std::shared_ptr<sb_stemmer> stemmer;
+  std::unordered_map<std::string, term_entry> terms; // memo of recent words
   std::string tmp_buf; // used by processTerm(...)
   std::shared_ptr<Transliterator> transliterator;
-  state_t(): locale("C") {
+  state_t(): ascii_offset(0), ascii(false), ascii_enabled(false), locale("C") {
     // NOTE: use of the default constructor for Locale() or
     //       use of Locale::createFromName(nullptr)
     //       causes a memory leak with Boost 1.58, as detected by valgrind
@@ -325,6 +339,192 @@ irs::analysis::analyzer::ptr construct(
   return construct(cache_key, locale, std::move(ignored_words));
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief filters and stems the normalized word stored in 'state.tmp_buf',
+///        results are memoized since the vocabulary of a text is mostly small
+/// @return the word isn't ignored
+////////////////////////////////////////////////////////////////////////////////
+bool stem_term(
+  irs::analysis::text_token_stream::bytes_term& term,
+  const std::unordered_set<std::string>& ignored_words,
+  irs::analysis::text_token_stream::state_t& state
+) {
+  typedef irs::analysis::text_token_stream::state_t state_t;
+  const std::string& word_utf8 = state.tmp_buf;
+  auto itr = state.terms.find(word_utf8);
+
+  if (itr == state.terms.end()) {
+    if (state.terms.size() >= state_t::MAX_TERMS) {
+      state.terms.clear(); // start over, cheaper than tracking recency
+    }
+
+    itr = state.terms.emplace(word_utf8, state_t::term_entry()).first;
+
+    auto& entry = itr->second;
+
+    // .........................................................................
+    // skip ignored tokens
+    // .........................................................................
+    entry.ignored = ignored_words.find(word_utf8) != ignored_words.end();
+
+    if (!entry.ignored) {
+      // .......................................................................
+      // find the token stem
+      // .......................................................................
+      const sb_symbol* value = nullptr;
+
+      if (state.stemmer) {
+        static_assert(sizeof(sb_symbol) == sizeof(char), "sizeof(sb_symbol) != sizeof(char)");
+        value = sb_stemmer_stem(
+          state.stemmer.get(),
+          reinterpret_cast<sb_symbol const*>(word_utf8.c_str()),
+          (int)word_utf8.size()
+        );
+      }
+
+      static_assert(sizeof(irs::byte_type) == sizeof(sb_symbol), "sizeof(irs::byte_type) != sizeof(sb_symbol)");
+      static_assert(sizeof(irs::byte_type) == sizeof(char), "sizeof(irs::byte_type) != sizeof(char)");
+      entry.value = value
+        ? irs::bstring(reinterpret_cast<const irs::byte_type*>(value), sb_stemmer_length(state.stemmer.get()))
+        : irs::bstring(irs::ref_cast<irs::byte_type>(word_utf8).c_str(), word_utf8.size()) // use the value of the unstemmed token
+        ;
+    }
+  }
+
+  if (itr->second.ignored) {
+    return false;
+  }
+
+  term.value(itr->second.value); // valid until the next call
+
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @return the specified data consists of ASCII characters only
+////////////////////////////////////////////////////////////////////////////////
+bool is_ascii(const irs::string_ref& data) NOEXCEPT {
+  const char* begin = data.c_str();
+  const char* end = begin + data.size();
+
+  // check a word at a time
+  for (const char* word_end = end - (data.size() % sizeof(uint64_t)); begin != word_end; begin += sizeof(uint64_t)) {
+    uint64_t word;
+
+    std::memcpy(&word, begin, sizeof(uint64_t));
+
+    if (word & UINT64_C(0x8080808080808080)) {
+      return false;
+    }
+  }
+
+  for (; begin != end; ++begin) {
+    if (*begin & 0x80) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// word break property of an ASCII character, see UAX #29
+enum ascii_word_break {
+  AWB_OTHER = 0,
+  AWB_LETTER, // ALetter
+  AWB_NUMERIC, // Numeric
+  AWB_EXTEND_NUM_LET, // ExtendNumLet, i.e. '_'
+  AWB_MID_NUM_LET, // MidNumLet and Single_Quote, i.e. '.' and '\''
+  AWB_MID_NUM // MidNum, i.e. ',' and ';'
+};
+
+ascii_word_break word_break(char c) NOEXCEPT {
+  if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '@') {
+    return AWB_LETTER; // ICU treats '@' as a letter to keep e-mails together
+  }
+
+  if (c >= '0' && c <= '9') {
+    return AWB_NUMERIC;
+  }
+
+  switch (c) {
+   case '_':
+    return AWB_EXTEND_NUM_LET;
+   case '.':
+   case '\'':
+    return AWB_MID_NUM_LET;
+   case ',':
+   case ';':
+    return AWB_MID_NUM;
+  }
+
+  return AWB_OTHER;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief finds the next word in the ASCII data starting at 'offset', follows
+///        the ICU word boundary rules (UAX #29) restricted to ASCII characters
+/// @return the word is found, [start, end) are its boundaries
+////////////////////////////////////////////////////////////////////////////////
+bool next_ascii_word(
+    const irs::string_ref& data,
+    size_t offset,
+    size_t& start,
+    size_t& end) NOEXCEPT {
+  const char* value = data.c_str();
+  const size_t size = data.size();
+
+  for (auto i = offset; i < size;) {
+    if (word_break(value[i]) < AWB_LETTER || word_break(value[i]) > AWB_EXTEND_NUM_LET) {
+      ++i; // not a part of a word
+      continue;
+    }
+
+    start = i;
+
+    bool alnum = false;
+
+    for (;;) {
+      ascii_word_break prev;
+
+      while (i < size
+             && (prev = word_break(value[i])) >= AWB_LETTER
+             && prev <= AWB_EXTEND_NUM_LET) {
+        alnum |= AWB_EXTEND_NUM_LET != prev;
+        ++i;
+      }
+
+      if (i + 1 >= size) {
+        break;
+      }
+
+      // a letter/number is followed by the same kind of character across a
+      // single middle punctuation, e.g. "don't", "e.g", "3.14", "1,000"
+      prev = word_break(value[i - 1]);
+
+      const auto mid = word_break(value[i]);
+      const auto next = word_break(value[i + 1]);
+
+      if ((AWB_LETTER == prev || AWB_NUMERIC == prev)
+          && prev == next
+          && (AWB_MID_NUM_LET == mid || (AWB_MID_NUM == mid && AWB_NUMERIC == prev))) {
+        ++i;
+        continue;
+      }
+
+      break;
+    }
+
+    // a single '_' isn't a word
+    if (alnum || i - start > 1) {
+      end = i;
+
+      return true;
+    }
+  }
+
+  return false;
+}
+
 bool process_term(
   irs::analysis::text_token_stream::bytes_term& term,
   const std::unordered_set<std::string>& ignored_words,
@@ -358,37 +558,26 @@ bool process_term(
   word_utf8.clear();
   word.toUTF8String(word_utf8);
 
-  // ...........................................................................
-  // skip ignored tokens
-  // ...........................................................................
-  if (ignored_words.find(word_utf8) != ignored_words.end()) {
-    return false;
-  }
-
-  // ...........................................................................
-  // find the token stem
-  // ...........................................................................
-  if (state.stemmer) {
-    static_assert(sizeof(sb_symbol) == sizeof(char), "sizeof(sb_symbol) != sizeof(char)");
-    const sb_symbol* value = reinterpret_cast<sb_symbol const*>(word_utf8.c_str());
+  return stem_term(term, ignored_words, state);
+}
 
-    value = sb_stemmer_stem(state.stemmer.get(), value, (int)word_utf8.size());
+bool process_ascii_term(
+  irs::analysis::text_token_stream::bytes_term& term,
+  const std::unordered_set<std::string>& ignored_words,
+  irs::analysis::text_token_stream::state_t& state,
+  const irs::string_ref& data
+) {
+  // NFC normalization and accent removal are no-op for ASCII characters
+  std::string& word_utf8 = state.tmp_buf;
 
-    if (value) {
-      static_assert(sizeof(irs::byte_type) == sizeof(sb_symbol), "sizeof(irs::byte_type) != sizeof(sb_symbol)");
-      term.value(irs::bytes_ref(reinterpret_cast<const irs::byte_type*>(value), sb_stemmer_length(state.stemmer.get())));
+  word_utf8.resize(data.size());
 
-      return true;
-    }
+  for (size_t i = 0, size = data.size(); i < size; ++i) {
+    const auto c = data[i];
+    word_utf8[i] = c >= 'A' && c <= 'Z' ? char(c + ('a' - 'A')) : c;
   }
 
-  // ...........................................................................
-  // use the value of the unstemmed token
-  // ...........................................................................
-  static_assert(sizeof(irs::byte_type) == sizeof(char), "sizeof(irs::byte_type) != sizeof(char)");
-  term.value(irs::bstring(irs::ref_cast<irs::byte_type>(word_utf8).c_str(), word_utf8.size()));
-
-  return true;
+  return stem_term(term, ignored_words, state);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -506,6 +695,9 @@ bool text_token_stream::reset(const string_ref& data) {
     if (state_->locale.isBogus()) {
       return false;
     }
+
+    // Turkic languages lowercase 'I' to a dotless 'i'
+    state_->ascii_enabled = locale_.language != "tr" && locale_.language != "az";
   }
 
   UErrorCode err = U_ZERO_ERROR; // a value that passes the U_SUCCESS() test
@@ -557,6 +749,21 @@ bool text_token_stream::reset(const string_ref& data) {
     );
   }
 
+  // ...........................................................................
+  // tokenize plain ASCII data without ICU
+  // ...........................................................................
+  state_->ascii = state_->ascii_enabled
+    && locale_.utf8
+    && data.size() <= INT32_MAX // same limit as for ICU
+    && is_ascii(data);
+
+  if (state_->ascii) {
+    state_->ascii_data = data;
+    state_->ascii_offset = 0;
+
+    return true;
+  }
+
   // ...........................................................................
   // convert encoding to UTF8 for use with ICU
   // ...........................................................................
@@ -590,6 +797,24 @@ bool text_token_stream::reset(const string_ref& data) {
 }
 
 bool text_token_stream::next() {
+  if (state_->ascii) {
+    for (size_t start, end;
+         next_ascii_word(state_->ascii_data, state_->ascii_offset, start, end);) {
+      state_->ascii_offset = end;
+
+      if (!process_ascii_term(term_, ignored_words_, *state_, string_ref(state_->ascii_data.c_str() + start, end - start))) {
+        continue; // skip ignored terms
+      }
+
+      // for ASCII data UTF-16 offsets are equal to byte offsets
+      offs_.start = uint32_t(start);
+      offs_.end = uint32_t(end);
+      return true;
+    }
+
+    return false;
+  }
+
   // ...........................................................................
   // find boundaries of the next word
   // ...........................................................................
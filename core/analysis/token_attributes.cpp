@@ -24,6 +24,43 @@
 #include "shared.hpp"
 #include "token_attributes.hpp"
 #include "store/store_utils.hpp"
+#include "utils/integer.hpp"
+#include "utils/math_utils.hpp"
+
+#include <cmath>
+
+NS_LOCAL
+
+// field lengths below 'EXACT_LENGTHS' are quantized as is
+CONSTEXPR const uint32_t EXACT_LENGTHS = 24;
+
+// quantized norm of the documents without a stored norm, i.e. of length 1
+CONSTEXPR const irs::byte_type DEFAULT_QUANTIZED = 1;
+
+uint64_t quantized_length(irs::byte_type value) NOEXCEPT {
+  if (value < EXACT_LENGTHS) {
+    return value;
+  }
+
+  // 3 lower bits of mantissa (the 4th is implicit), the rest is a shift
+  const uint32_t encoded = value - EXACT_LENGTHS;
+  const uint32_t mantissa = encoded & 0x07;
+  const uint32_t shift = encoded >> 3;
+
+  return EXACT_LENGTHS + (shift ? uint64_t(mantissa | 0x08) << (shift - 1) : mantissa);
+}
+
+std::array<float_t, irs::norm::QUANTIZED_VALUES()> quantized_norms() {
+  std::array<float_t, irs::norm::QUANTIZED_VALUES()> norms;
+
+  for (size_t i = 0; i < norms.size(); ++i) {
+    norms[i] = float_t(1. / std::sqrt(double_t(quantized_length(irs::byte_type(i)))));
+  }
+
+  return norms;
+}
+
+NS_END
 
 NS_ROOT
 
@@ -84,6 +121,12 @@ document::document() NOEXCEPT:
 REGISTER_ATTRIBUTE(iresearch::frequency);
 DEFINE_ATTRIBUTE_TYPE(frequency);
 
+// -----------------------------------------------------------------------------
+// --SECTION--                                                   frequency_bound
+// -----------------------------------------------------------------------------
+
+DEFINE_ATTRIBUTE_TYPE(frequency_bound);
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                granularity_prefix
 // -----------------------------------------------------------------------------
@@ -91,6 +134,13 @@ DEFINE_ATTRIBUTE_TYPE(frequency);
 REGISTER_ATTRIBUTE(iresearch::granularity_prefix);
 DEFINE_ATTRIBUTE_TYPE(iresearch::granularity_prefix);
 
+// -----------------------------------------------------------------------------
+// --SECTION--                                                       point_index
+// -----------------------------------------------------------------------------
+
+REGISTER_ATTRIBUTE(iresearch::point_index);
+DEFINE_ATTRIBUTE_TYPE(iresearch::point_index);
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                              norm
 // -----------------------------------------------------------------------------
@@ -101,13 +151,43 @@ DEFINE_FACTORY_DEFAULT(norm);
 
 const document INVALID_DOCUMENT;
 
+/*static*/ const std::array<float_t, norm::QUANTIZED_VALUES()> norm::QUANTIZED_NORMS = quantized_norms();
+
+/*static*/ byte_type norm::quantize(uint32_t length) NOEXCEPT {
+  if (length < EXACT_LENGTHS) {
+    return byte_type(length);
+  }
+
+  // keep 4 significant bits of the remainder
+  const uint32_t value = length - EXACT_LENGTHS;
+  uint32_t encoded = value;
+
+  if (value >= 0x08) {
+    const uint32_t shift = 28 - math::clz32(value);
+    encoded = ((value >> shift) & 0x07) | ((shift + 1) << 3);
+  }
+
+  return byte_type(std::min(EXACT_LENGTHS + encoded, uint32_t(QUANTIZED_VALUES() - 1)));
+}
+
+/*static*/ byte_type norm::quantize_norm(float_t norm) NOEXCEPT {
+  // norm == 1/sqrt(length)
+  const double_t length = std::round(1. / (double_t(norm)*norm));
+
+  return quantize(length < double_t(integer_traits<uint32_t>::const_max)
+    ? uint32_t(length)
+    : integer_traits<uint32_t>::const_max
+  );
+}
+
 norm::norm() NOEXCEPT {
   reset();
 }
 
 void norm::reset() {
-  column_ = [](doc_id_t, bytes_ref&){ return false; };
+  column_.reset();
   doc_ = &INVALID_DOCUMENT;
+  quantized_ = true;
 }
 
 bool norm::empty() const {
@@ -121,20 +201,27 @@ bool norm::reset(const sub_reader& reader, field_id column, const document& doc)
     return false;
   }
 
-  column_ = column_reader->values();
+  column_ = column_reader->cursor();
   doc_ = &doc;
+  quantized_ = column_reader->quantized_norms();
   return true;
 }
 
-float_t norm::read() const {
+byte_type norm::read_quantized() const {
   bytes_ref value;
-  if (!column_(doc_->value, value)) {
-    return DEFAULT();
+
+  if (!column_ || !column_->read(doc_->value, value) || value.empty()) {
+    return DEFAULT_QUANTIZED;
+  }
+
+  if (quantized_) {
+    return value[0];
   }
 
-  // TODO: create set of helpers to decode float from buffer directly
+  // norms written by the previous format versions
   bytes_ref_input in(value);
-  return read_zvfloat(in);
+
+  return quantize_norm(read_zvfloat(in));
 }
 
 // -----------------------------------------------------------------------------
@@ -35,6 +35,8 @@
 #include "utils/type_limits.hpp"
 #include "utils/iterator.hpp"
 
+#include <array>
+
 NS_ROOT
 
 //////////////////////////////////////////////////////////////////////////////
@@ -125,6 +127,37 @@ struct IRESEARCH_API frequency : basic_attribute<uint64_t> {
   frequency() = default;
 }; // frequency
 
+//////////////////////////////////////////////////////////////////////////////
+/// @class frequency_bound
+/// @brief upper bounds of the term frequency in the documents of a postings
+///        list, allow to estimate the best possible score of a block of
+///        documents without decoding it
+//////////////////////////////////////////////////////////////////////////////
+class IRESEARCH_API frequency_bound : public attribute {
+ public:
+  DECLARE_REF(frequency_bound);
+  DECLARE_TYPE_ID(attribute::type_id);
+
+  virtual ~frequency_bound() = default;
+
+  ////////////////////////////////////////////////////////////////////////////
+  /// @returns upper bound of the frequency over the whole postings list
+  ////////////////////////////////////////////////////////////////////////////
+  virtual uint64_t max() const = 0;
+
+  ////////////////////////////////////////////////////////////////////////////
+  /// @brief moves to the block of documents which may contain the specified
+  ///        target, doesn't affect the position of the postings iterator
+  /// @returns the last document of the block, 'eof' for the last block
+  ////////////////////////////////////////////////////////////////////////////
+  virtual doc_id_t shallow_seek(doc_id_t target) = 0;
+
+  ////////////////////////////////////////////////////////////////////////////
+  /// @returns upper bound of the frequency in the current block
+  ////////////////////////////////////////////////////////////////////////////
+  virtual uint64_t block_max() const = 0;
+}; // frequency_bound
+
 //////////////////////////////////////////////////////////////////////////////
 /// @class granularity_prefix
 /// @brief indexed tokens are prefixed with one byte indicating granularity
@@ -137,6 +170,19 @@ struct IRESEARCH_API granularity_prefix : attribute {
   granularity_prefix() = default;
 }; // granularity_prefix
 
+//////////////////////////////////////////////////////////////////////////////
+/// @class point_index
+/// @brief exact values of the field terms are additionally indexed as points
+///        in a block KD-tree, e.g. for efficient evaluation of 'by_point_range'
+///        this is marker attribute only used in field::features
+///        for fields with 'granularity_prefix' only the most precise terms
+///        are indexed as points
+//////////////////////////////////////////////////////////////////////////////
+struct IRESEARCH_API point_index : attribute {
+  DECLARE_ATTRIBUTE_TYPE();
+  point_index() = default;
+}; // point_index
+
 //////////////////////////////////////////////////////////////////////////////
 /// @class norm
 /// @brief this is marker attribute only used in field::features in order to
@@ -150,10 +196,37 @@ struct IRESEARCH_API norm : stored_attribute {
     return 1.f;
   }
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief number of distinct quantized norm values
+  //////////////////////////////////////////////////////////////////////////////
+  FORCE_INLINE static CONSTEXPR size_t QUANTIZED_VALUES() {
+    return 256;
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @returns the field length quantized into a single byte, lengths
+  ///          below 24 are exact, larger ones keep 4 significant bits
+  //////////////////////////////////////////////////////////////////////////////
+  static byte_type quantize(uint32_t length) NOEXCEPT;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @returns quantized field length of the specified normalization factor,
+  ///          i.e. of the norm stored as 'zvfloat' by the previous versions
+  //////////////////////////////////////////////////////////////////////////////
+  static byte_type quantize_norm(float_t norm) NOEXCEPT;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @returns the normalization factor of the specified quantized length
+  //////////////////////////////////////////////////////////////////////////////
+  static float_t dequantize(byte_type value) NOEXCEPT {
+    return QUANTIZED_NORMS[value];
+  }
+
   norm() NOEXCEPT;
 
   bool reset(const sub_reader& segment, field_id column, const document& doc);
-  float_t read() const;
+  float_t read() const { return dequantize(read_quantized()); }
+  byte_type read_quantized() const;
   bool empty() const;
 
   void clear() {
@@ -161,10 +234,15 @@ struct IRESEARCH_API norm : stored_attribute {
   }
 
  private:
+  static const std::array<float_t, 256> QUANTIZED_NORMS; // per quantized value
+
   void reset();
 
-  columnstore_reader::values_reader_f column_;
+  IRESEARCH_API_PRIVATE_VARIABLES_BEGIN
+  columnstore_reader::values_cursor::ptr column_;
+  IRESEARCH_API_PRIVATE_VARIABLES_END
   const document* doc_;
+  bool quantized_; // norms are stored as quantized lengths, 'zvfloat' otherwise
 }; // norm
 
 //////////////////////////////////////////////////////////////////////////////
@@ -28,6 +28,12 @@
 
 #include "formats/formats.hpp"
 
+MSVC_ONLY(__pragma(warning(push)))
+MSVC_ONLY(__pragma(warning(disable:4244)))
+MSVC_ONLY(__pragma(warning(disable:4245)))
+#include <boost/crc.hpp>
+MSVC_ONLY(__pragma(warning(pop)))
+
 NS_ROOT
 
 void validate_footer(iresearch::index_input& in) {
@@ -44,7 +50,8 @@ void validate_footer(iresearch::index_input& in) {
   }
 
   const int32_t alg_id = in.read_int();
-  if (alg_id != 0) {
+  if (alg_id != format_utils::CHECKSUM_CRC32
+      && alg_id != format_utils::CHECKSUM_CRC32C) {
     // invalid algorithm
     throw iresearch::index_error();
   }
@@ -60,7 +67,7 @@ void write_header(index_output& out, const string_ref& format, int32_t ver) {
 
 void write_footer(index_output& out) {
   out.write_int(FOOTER_MAGIC);
-  out.write_int(0);
+  out.write_int(CHECKSUM_CRC32C);
   out.write_long(out.checksum());
 }
 
@@ -89,5 +96,53 @@ int32_t check_header(
   return ver;
 }
 
+int64_t checksum(const index_input& in) {
+  const auto length = in.length();
+
+  if (length < FOOTER_LEN) {
+    // invalid file length
+    throw index_error();
+  }
+
+  auto stream = in.dup();
+
+  if (!stream) {
+    throw detailed_io_error("Failed to duplicate input");
+  }
+
+  stream->seek(length - FOOTER_LEN + sizeof(int32_t)); // skip magic
+  const int32_t alg_id = stream->read_int();
+  const size_t size = length - sizeof(uint64_t);
+
+  stream->seek(0);
+
+  switch (alg_id) {
+    case CHECKSUM_CRC32C:
+      return stream->checksum(size);
+    case CHECKSUM_CRC32: {
+      // files written before CRC32C was introduced
+      boost::crc_32_type crc;
+      byte_type buf[1024];
+
+      for (auto left = size; left; ) {
+        const auto to_read = (std::min)(left, sizeof buf);
+        const auto read = stream->read_bytes(buf, to_read);
+
+        if (read != to_read) {
+          throw eof_error(); // read past eof
+        }
+
+        crc.process_bytes(buf, read);
+        left -= read;
+      }
+
+      return crc.checksum();
+    }
+  }
+
+  // invalid algorithm
+  throw index_error();
+}
+
 NS_END
 NS_END
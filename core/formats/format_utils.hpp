@@ -63,6 +63,10 @@ const int32_t FOOTER_MAGIC = -FORMAT_MAGIC;
 
 const uint32_t FOOTER_LEN = 2 * sizeof( int32_t ) + sizeof( int64_t );
 
+// checksum algorithms stored in the footer
+const int32_t CHECKSUM_CRC32 = 0; // legacy, boost::crc_32_type
+const int32_t CHECKSUM_CRC32C = 1;
+
 void IRESEARCH_API write_header(index_output& out, const string_ref& format, int32_t ver);
 
 void IRESEARCH_API write_footer(index_output& out);
@@ -88,19 +92,11 @@ inline int64_t check_footer(index_input& in, int64_t checksum) {
   return checksum;
 }
 
-inline int64_t checksum(const index_input& in) {
-  auto* stream = &in;
-
-  index_input::ptr dup;
-  if (0 != in.file_pointer()) {
-    dup = in.dup();
-    dup->seek(0);
-    stream = dup.get();
-  }
-
-  assert(0 == stream->file_pointer());
-  return stream->checksum(stream->length() - sizeof(uint64_t));
-}
+//////////////////////////////////////////////////////////////////////////////
+/// @returns checksum of the whole file except the stored checksum itself,
+///          computed with the algorithm specified in the file footer
+//////////////////////////////////////////////////////////////////////////////
+int64_t IRESEARCH_API checksum(const index_input& in);
 
 NS_END
 NS_END
@@ -61,17 +61,38 @@ class format_register :
 iresearch::columnstore_reader::values_reader_f INVALID_COLUMN =
   [] (irs::doc_id_t, irs::bytes_ref&) { return false; };
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief cursor reading values via 'column_reader::values()'
+////////////////////////////////////////////////////////////////////////////////
+class values_reader_cursor final : public irs::columnstore_reader::values_cursor {
+ public:
+  explicit values_reader_cursor(
+      irs::columnstore_reader::values_reader_f&& reader) NOEXCEPT
+    : reader_(std::move(reader)) {
+  }
+
+ protected:
+  virtual bool read_block(irs::doc_id_t doc, irs::bytes_ref& value) override {
+    return reader_(doc, value);
+  }
+
+ private:
+  irs::columnstore_reader::values_reader_f reader_;
+}; // values_reader_cursor
+
 NS_END
 
 NS_ROOT
 
 DEFINE_ATTRIBUTE_TYPE(iresearch::term_meta);
+DEFINE_ATTRIBUTE_TYPE(iresearch::raw_postings);
 
 postings_writer::~postings_writer() {}
 field_writer::~field_writer() {}
 
 postings_reader::~postings_reader() {}
 basic_term_reader::~basic_term_reader() {}
+point_reader::~point_reader() {}
 term_reader::~term_reader() {}
 field_reader::~field_reader() {}
 
@@ -86,6 +107,11 @@ column_meta_reader::~column_meta_reader() {}
 
 columnstore_writer::~columnstore_writer() {}
 columnstore_reader::~columnstore_reader() {}
+columnstore_reader::values_cursor::~values_cursor() {}
+
+columnstore_reader::values_cursor::ptr columnstore_reader::column_reader::cursor() const {
+  return memory::make_unique<values_reader_cursor>(values());
+}
 
 /* static */ const columnstore_reader::values_reader_f& columnstore_reader::empty_reader() {
   return INVALID_COLUMN;
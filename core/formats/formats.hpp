@@ -28,9 +28,11 @@
 #include "store/data_output.hpp"
 #include "store/directory.hpp"
 
+#include "index/document_mask.hpp"
 #include "index/index_meta.hpp"
 #include "index/iterators.hpp"
 
+#include "utils/block_cache.hpp"
 #include "utils/block_pool.hpp"
 #include "utils/io_utils.hpp"
 #include "utils/string.hpp"
@@ -48,7 +50,7 @@ struct reader_state;
 struct index_output;
 struct data_input;
 struct index_input;
-typedef std::unordered_set<doc_id_t> document_mask;
+class bitset;
 
 /* -------------------------------------------------------------------
  * postings_writer
@@ -75,6 +77,18 @@ struct IRESEARCH_API term_meta : attribute {
   uint64_t freq = 0; // FIXME check whether we can move freq to another place
 }; // term_meta
 
+//////////////////////////////////////////////////////////////////////////////
+/// @class raw_postings
+/// @brief exposes the encoded postings a doc iterator reads from, a postings
+///        writer of the same format may copy them instead of re-encoding
+//////////////////////////////////////////////////////////////////////////////
+struct IRESEARCH_API raw_postings : attribute {
+  DECLARE_ATTRIBUTE_TYPE();
+
+  raw_postings() = default;
+  virtual ~raw_postings() = default;
+}; // raw_postings
+
 struct IRESEARCH_API postings_writer : util::const_attribute_view_provider {
   DECLARE_PTR(postings_writer);
   DECLARE_FACTORY(postings_writer);
@@ -188,6 +202,39 @@ struct IRESEARCH_API basic_term_reader: public util::const_attribute_view_provid
   virtual const bytes_ref& (max)() const = 0;
 }; // basic_term_reader
 
+/* -------------------------------------------------------------------
+ * point_reader
+ * ------------------------------------------------------------------*/
+
+//////////////////////////////////////////////////////////////////////////////
+/// @struct point_reader
+/// @brief block KD-tree over the exact values of a field indexed with the
+///        'point_index' feature, values are compared lexicographically
+//////////////////////////////////////////////////////////////////////////////
+struct IRESEARCH_API point_reader {
+  virtual ~point_reader();
+
+  // total number of indexed points
+  virtual uint64_t size() const = 0;
+
+  // least significant point value
+  virtual const bytes_ref& (min)() const = 0;
+
+  // most significant point value
+  virtual const bytes_ref& (max)() const = 0;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief marks documents having at least one point within the specified
+  ///        range in 'docs', 'bytes_ref::NIL' denotes an unbounded side
+  /// @returns number of matched points
+  //////////////////////////////////////////////////////////////////////////////
+  virtual uint64_t visit(
+    const bytes_ref& min, bool min_inclusive,
+    const bytes_ref& max, bool max_inclusive,
+    bitset& docs
+  ) const = 0;
+}; // point_reader
+
 struct IRESEARCH_API term_reader: public util::const_attribute_view_provider {
   DECLARE_PTR( term_reader);
   DECLARE_FACTORY(term_reader);
@@ -210,6 +257,9 @@ struct IRESEARCH_API term_reader: public util::const_attribute_view_provider {
 
   // most significant term
   virtual const bytes_ref& (max)() const = 0;
+
+  // returns points of the field, nullptr if the field isn't indexed as points
+  virtual const point_reader* points() const { return nullptr; }
 };
 
 /* -------------------------------------------------------------------
@@ -253,6 +303,9 @@ struct IRESEARCH_API columnstore_writer {
   virtual bool prepare(directory& dir, const segment_meta& meta) = 0;
   virtual column_t push_column() = 0;
   virtual bool flush() = 0; // @return was anything actually flushed
+
+  // @return estimated number of bytes buffered in memory by the writer
+  virtual size_t memory() const NOEXCEPT = 0;
 }; // columnstore_writer
 
 NS_END
@@ -298,7 +351,53 @@ struct IRESEARCH_API columnstore_reader {
   DECLARE_PTR(columnstore_reader);
 
   typedef std::function<bool(doc_id_t, bytes_ref&)> values_reader_f;
-  typedef std::function<bool(doc_id_t, const bytes_ref&)> values_visitor_f;  
+  typedef std::function<bool(doc_id_t, const bytes_ref&)> values_visitor_f;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @class values_cursor
+  /// @brief reads values of a column keeping the block of the last accessed
+  ///        document, best suited for documents requested in ascending order
+  /// @note values of a run of fixed-length entries exposed by the
+  ///       implementation are read inline, without a virtual call
+  //////////////////////////////////////////////////////////////////////////////
+  class IRESEARCH_API values_cursor {
+   public:
+    DECLARE_PTR(values_cursor);
+
+    virtual ~values_cursor();
+
+    // @returns false if there is no value for the specified document
+    // @note returned value is valid until the next call
+    bool read(doc_id_t doc, bytes_ref& value) {
+      if (doc >= begin_ && doc < end_) {
+        value = bytes_ref(data_ + (doc - begin_)*length_, length_);
+        return true;
+      }
+
+      return read_block(doc, value);
+    }
+
+   protected:
+    // reads the value of a document outside of the current run
+    virtual bool read_block(doc_id_t doc, bytes_ref& value) = 0;
+
+    // values of the documents [begin;end) are stored sequentially
+    // at 'data', each of 'length' bytes
+    void run(
+        doc_id_t begin, doc_id_t end,
+        const byte_type* data, size_t length) NOEXCEPT {
+      begin_ = begin;
+      end_ = end;
+      data_ = data;
+      length_ = length;
+    }
+
+   private:
+    const byte_type* data_{};
+    size_t length_{};
+    doc_id_t begin_{};
+    doc_id_t end_{}; // empty run
+  }; // values_cursor
 
   struct column_reader {
     virtual ~column_reader() = default;
@@ -306,6 +405,10 @@ struct IRESEARCH_API columnstore_reader {
     // returns corresponding column reader
     virtual columnstore_reader::values_reader_f values() const = 0;
 
+    // returns a cursor over the column values, the default implementation
+    // reads values via 'values()'
+    virtual columnstore_reader::values_cursor::ptr cursor() const;
+
     // returns the corresponding column iterator
     // if the column implementation supports document payloads then the latter
     // may be accessed via the 'payload_iterator' attribute
@@ -314,6 +417,11 @@ struct IRESEARCH_API columnstore_reader {
     virtual bool visit(const columnstore_reader::values_visitor_f& reader) const = 0;
 
     virtual size_t size() const = 0;
+
+    // returns false if field norms stored in the column are encoded as
+    // 'zvfloat' normalization factors by the previous format versions,
+    // true if they are stored as quantized field lengths (norm::quantize)
+    virtual bool quantized_norms() const NOEXCEPT { return true; }
   };
 
   static const values_reader_f& empty_reader();
@@ -323,11 +431,14 @@ struct IRESEARCH_API columnstore_reader {
   // @param seen if found and seen != nullptr -> set seen = true
   //             if not found and seen != nullptr -> set seen = false, return true
   //             if not found and seen == nullptr -> log warning, return false
+  // @param cache if not nullptr, loaded blocks are kept in the specified
+  //              shared cache instead of being cached for the reader lifetime
   // @return success
   virtual bool prepare(
     const directory& dir,
     const segment_meta& meta,
-    bool* seen = nullptr
+    bool* seen = nullptr,
+    const block_cache::ptr& cache = nullptr
   ) = 0;
 
   virtual const column_reader* column(field_id field) const = 0;
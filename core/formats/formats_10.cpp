@@ -98,7 +98,7 @@ inline void prepare_output(
   format_utils::write_header(*out, format, version);
 }
 
-inline void prepare_input(
+inline int32_t prepare_input(
     std::string& str,
     index_input::ptr& in,
     IOAdvice advice,
@@ -119,7 +119,21 @@ inline void prepare_input(
     throw detailed_io_error(ss.str());
   }
 
-  format_utils::check_header(*in, format, min_ver, max_ver);
+  return format_utils::check_header(*in, format, min_ver, max_ver);
+}
+
+// reads block previously written by the postings writer of the specified version
+template<typename T>
+FORCE_INLINE void read_block(
+    data_input& in,
+    int32_t version,
+    T* RESTRICT encoded,
+    T* RESTRICT decoded) {
+  if (version >= postings_writer::FORMAT_SIMD) {
+    encode::bitpack::read_block_simd(in, postings_writer::BLOCK_SIZE, encoded, decoded);
+  } else {
+    encode::bitpack::read_block(in, postings_writer::BLOCK_SIZE, encoded, decoded);
+  }
 }
 
 FORCE_INLINE void skip_positions(index_input& in) {
@@ -139,6 +153,62 @@ FORCE_INLINE void skip_offsets(index_input& in) {
   encode::bitpack::skip_block32(in, postings_writer::BLOCK_SIZE);
 }
 
+// skips 'count' variable length encoded positions written by the postings writer
+void skip_positions_tail(index_input& in, const features& features, uint64_t count) {
+  uint32_t pay_size = 0;
+  uint32_t value;
+
+  for (; count; --count) {
+    if (features.payload()) {
+      if (shift_unpack_32(in.read_vint(), value)) {
+        pay_size = in.read_vint();
+      }
+
+      if (pay_size) {
+        in.seek(in.file_pointer() + pay_size);
+      }
+    } else {
+      in.read_vint();
+    }
+
+    if (features.offset() && shift_unpack_32(in.read_vint(), value)) {
+      in.read_vint();
+    }
+  }
+}
+
+// copies 'size' bytes starting at 'offset' from 'in' to 'out'
+void copy_bytes(index_input& in, uint64_t offset, uint64_t size, data_output& out) {
+  byte_type buf[1024];
+
+  in.seek(offset);
+
+  while (size) {
+    const auto to_read = (std::min)(size, uint64_t(sizeof buf));
+    const auto read = in.read_bytes(buf, to_read);
+
+    if (read != to_read) {
+      throw eof_error(); // read past eof
+    }
+
+    out.write_bytes(buf, read);
+    size -= read;
+  }
+}
+
+// writes variable length encoded document delta and frequency
+FORCE_INLINE void write_doc(
+    data_output& out, uint32_t delta, const uint64_t* freq) {
+  if (!freq) {
+    out.write_vint(delta);
+  } else if (1 == *freq) {
+    out.write_vint(shift_pack_32(delta, true));
+  } else {
+    out.write_vint(shift_pack_32(delta, false));
+    out.write_vlong(*freq);
+  }
+}
+
 NS_END // NS_LOCAL
 
 struct skip_state {
@@ -146,6 +216,7 @@ struct skip_state {
   uint64_t pos_ptr{}; // pointer to the positions of the first document in a document block
   uint64_t pay_ptr{}; // pointer to the payloads of the first document in a document block
   size_t pend_pos{}; // positions to skip before new document block
+  uint64_t max_freq{}; // max term frequency in a previous block(s) (FORMAT_BLOCK_MAX only)
   doc_id_t doc{ type_limits<type_t::doc_id_t>::invalid() }; // last document in a previous block 
   uint32_t pay_pos{}; // payload size to skip before in new document block 
 }; // skip_state
@@ -154,6 +225,32 @@ struct skip_context : skip_state {
   size_t level{}; // skip level
 }; // skip_context 
 
+// reads skip entry previously written by the postings writer of the
+// specified version
+inline doc_id_t read_skip(
+    skip_state& state,
+    index_input& in,
+    const version10::features& features,
+    int32_t version) {
+  state.doc = in.read_vint();
+  state.doc_ptr += in.read_vlong();
+  if (features.position()) {
+    state.pend_pos = in.read_vint();
+    state.pos_ptr += in.read_vlong();
+    const bool has_pay = features.payload();
+    if (has_pay || features.offset()) {
+      if (has_pay) {
+        state.pay_pos = in.read_vint();
+      }
+      state.pay_ptr += in.read_vlong();
+    }
+  }
+  if (features.freq() && version >= postings_writer::FORMAT_BLOCK_MAX) {
+    state.max_freq = in.read_vlong();
+  }
+  return state.doc;
+}
+
 struct doc_state {
   const index_input* pos_in;
   const index_input* pay_in;
@@ -163,8 +260,110 @@ struct doc_state {
   uint64_t tail_start;
   size_t tail_length;
   version10::features features;
+  int32_t version; // postings format version
 }; // doc_state
 
+///////////////////////////////////////////////////////////////////////////////
+/// @class block_max_reader
+/// @brief provides max term frequencies of the document blocks, uses its own
+///        skip reader in order to not interfere with the document iterator
+///////////////////////////////////////////////////////////////////////////////
+class block_max_reader final : public frequency_bound {
+ public:
+  block_max_reader() NOEXCEPT
+    : skip_(postings_writer::BLOCK_SIZE, postings_writer::SKIP_N) {
+  }
+
+  void prepare(
+      const index_input* doc_in,
+      const version10::term_meta& state,
+      const version10::features& features,
+      uint64_t term_freq,
+      int32_t version) {
+    doc_in_ = doc_in;
+    skip_start_ = state.doc_start + state.e_skip_start;
+    features_ = features;
+    version_ = version;
+    max_ = value_ = term_freq; // total term frequency is a valid upper bound
+
+    // short postings lists have no skip list, segments written by the
+    // older versions have no max frequencies in the skip list
+    end_ = state.docs_count > postings_writer::BLOCK_SIZE
+        && features.freq()
+        && version >= postings_writer::FORMAT_BLOCK_MAX
+      ? type_limits<type_t::doc_id_t>::invalid()
+      : type_limits<type_t::doc_id_t>::eof();
+  }
+
+  virtual uint64_t max() const override {
+    return max_;
+  }
+
+  virtual uint64_t block_max() const override {
+    return value_;
+  }
+
+  virtual doc_id_t shallow_seek(doc_id_t target) override {
+    if (target <= end_) {
+      return end_;
+    }
+
+    // init skip reader in lazy fashion
+    if (!skip_) {
+      prepare_skip();
+    }
+
+    skip_.seek(target);
+
+    // level 0 entry describes the block containing target,
+    // the last block isn't indexed by skip list
+    const auto& entry = levels_.front();
+    end_ = entry.doc;
+    value_ = type_limits<type_t::doc_id_t>::eof(end_) ? max_ : entry.max_freq;
+
+    return end_;
+  }
+
+ private:
+  void prepare_skip() {
+    assert(doc_in_);
+    index_input::ptr skip_in = doc_in_->dup();
+
+    if (!skip_in) {
+      IR_FRMT_FATAL("Failed to duplicate document input in: %s", __FUNCTION__);
+
+      throw detailed_io_error("Failed to duplicate document input");
+    }
+
+    skip_in->seek(skip_start_);
+
+    skip_.prepare(
+      std::move(skip_in),
+      [this](size_t level, index_input& in) {
+        auto& entry = levels_[level];
+
+        if (in.eof()) {
+          // stream exhausted
+          return (entry.doc = type_limits<type_t::doc_id_t>::eof());
+        }
+
+        return read_skip(entry, in, features_, version_);
+    });
+
+    levels_.resize(std::max(size_t(1), skip_.num_levels()));
+  }
+
+  std::vector<skip_state> levels_; // last read entry for each level
+  skip_reader skip_;
+  const index_input* doc_in_{};
+  uint64_t skip_start_{};
+  uint64_t max_{}; // upper bound for the whole postings list
+  uint64_t value_{}; // upper bound for the current block
+  doc_id_t end_{ type_limits<type_t::doc_id_t>::eof() }; // last document in the current block
+  features features_; // field features
+  int32_t version_{}; // postings format version
+}; // block_max_reader
+
 ///////////////////////////////////////////////////////////////////////////////
 /// @class doc_iterator
 ///////////////////////////////////////////////////////////////////////////////
@@ -174,6 +373,9 @@ class doc_iterator : public iresearch::doc_iterator {
 
   DECLARE_FACTORY(doc_iterator);
 
+  static const size_t PREFETCH_SIZE = 64 * 1024; // postings bytes to read ahead
+  static const size_t PREFETCH_MARGIN = 4096; // prefetch again when that close to the end
+
   doc_iterator() NOEXCEPT
     : skip_levels_(1),
       skip_(postings_writer::BLOCK_SIZE, postings_writer::SKIP_N) {
@@ -186,9 +388,11 @@ class doc_iterator : public iresearch::doc_iterator {
       const irs::attribute_view& attrs,
       const index_input* doc_in,
       const index_input* pos_in,
-      const index_input* pay_in) {
+      const index_input* pay_in,
+      int32_t version) {
     features_ = field; // set field features
     enabled_ = enabled; // set enabled features
+    version_ = version;
 
     // add mandatory attributes
     attrs_.emplace(doc_);
@@ -212,9 +416,20 @@ class doc_iterator : public iresearch::doc_iterator {
 
       doc_in_->seek(term_state_.doc_start);
       assert(!doc_in_->eof());
+      prefetched_ = 0;
     }
 
     prepare_attributes(enabled, attrs, pos_in, pay_in);
+
+    // expose encoded postings for copying
+    raw_.meta = &term_state_;
+    raw_.doc = &doc_;
+    raw_.doc_in = doc_in;
+    raw_.pos_in = pos_in;
+    raw_.pay_in = pay_in;
+    raw_.field = field;
+    raw_.version = version;
+    attrs_.emplace(raw_);
   }
 
   virtual doc_id_t seek(doc_id_t target) override {
@@ -261,6 +476,39 @@ class doc_iterator : public iresearch::doc_iterator {
     return true;
   }
 
+  virtual size_t next_batch(doc_id_t* docs, size_t size) override {
+    size_t count = 0;
+
+    while (count < size) {
+      if (begin_ == end_) {
+        cur_pos_ += relative_pos();
+
+        if (cur_pos_ == term_state_.docs_count) {
+          doc_.value = type_limits<type_t::doc_id_t>::eof();
+          begin_ = end_ = docs_; // seal the iterator
+          return count;
+        }
+
+        refill();
+      }
+
+      // copy decoded documents straight from the block
+      const size_t n = std::min(size - count, size_t(end_ - begin_));
+      std::memcpy(docs + count, begin_, n*sizeof(doc_id_t));
+      next_batch_notify(doc_freq_, n);
+      begin_ += n;
+      doc_freq_ += n;
+      count += n;
+      doc_.value = begin_[-1]; // base for the next block
+    }
+
+    if (count) {
+      freq_.value = doc_freq_[-1];
+    }
+
+    return count;
+  }
+
 #if defined(_MSC_VER)
   #pragma warning( default : 4706 )
 #elif defined (__GNUC__)
@@ -281,12 +529,22 @@ class doc_iterator : public iresearch::doc_iterator {
       assert(attrs.contains<frequency>());
       attrs_.emplace(freq_);
       term_freq_ = attrs.get<frequency>()->value;
+      prepare_max_freq();
     }
   }
 
+  void prepare_max_freq() {
+    max_freq_.prepare(doc_in_.get(), term_state_, features_, term_freq_, version_);
+    attrs_.emplace<frequency_bound>(max_freq_);
+  }
+
   virtual void seek_notify(const skip_context& /*ctx*/) {
   }
 
+  // called for every chunk of documents skipped by 'next_batch(...)'
+  virtual void next_batch_notify(const uint64_t* /*freqs*/, size_t /*count*/) {
+  }
+
   void seek_to_block(doc_id_t target);
 
   // returns current position in the document block 'docs_'
@@ -296,20 +554,7 @@ class doc_iterator : public iresearch::doc_iterator {
   }
 
   doc_id_t read_skip(skip_state& state, index_input& in) {
-    state.doc = in.read_vint();
-    state.doc_ptr += in.read_vlong();
-    if (features_.position()) {
-      state.pend_pos = in.read_vint();
-      state.pos_ptr += in.read_vlong();
-      const bool has_pay = features_.payload();
-      if (has_pay || features_.offset()) {
-        if (has_pay) {
-          state.pay_pos = in.read_vint();
-        }
-        state.pay_ptr += in.read_vlong();
-      }
-    }
-    return state.doc;
+    return detail::read_skip(state, in, features_, version_);
   }
 
   void read_end_block(uint64_t size) {
@@ -328,23 +573,49 @@ class doc_iterator : public iresearch::doc_iterator {
     }
   }
 
+  // hints the input to read the document blocks ahead of time, blocks of
+  // the long postings lists are followed by the skip list
+  void prefetch_blocks() {
+    const uint64_t pos = doc_in_->file_pointer();
+    const uint64_t end = term_state_.doc_start + term_state_.e_skip_start;
+
+    if (pos >= end || prefetched_ >= end || pos + PREFETCH_MARGIN <= prefetched_) {
+      return; // already requested
+    }
+
+    prefetched_ = std::min(end, pos + PREFETCH_SIZE);
+    doc_in_->prefetch(pos, prefetched_ - pos);
+  }
+
   void refill() {
     const auto left = term_state_.docs_count - cur_pos_;
 
+    // if this is the initial doc_id then set it to min() for proper delta value
+    const doc_id_t base = type_limits<type_t::doc_id_t>::valid(doc_.value)
+      ? doc_.value
+      : (type_limits<type_t::doc_id_t>::min)();
+
+    bool decoded = false;
+
     if (left >= postings_writer::BLOCK_SIZE) {
-      // read doc deltas
-      encode::bitpack::read_block(*doc_in_, postings_writer::BLOCK_SIZE, enc_buf_, docs_);
+      prefetch_blocks();
+
+      if (version_ >= postings_writer::FORMAT_SIMD) {
+        // read and decode doc deltas in a single pass
+        encode::bitpack::read_block_delta_simd(
+          *doc_in_, postings_writer::BLOCK_SIZE, enc_buf_, docs_, base
+        );
+        decoded = true;
+      } else {
+        // read doc deltas
+        encode::bitpack::read_block(*doc_in_, postings_writer::BLOCK_SIZE, enc_buf_, docs_);
+      }
 
       if (features_.freq()) {
         // read frequency it is required by
         // the iterator or just skip it otherwise
         if (enabled_.freq()) {
-          encode::bitpack::read_block(
-            *doc_in_,
-            postings_writer::BLOCK_SIZE,
-            enc_buf_,
-            doc_freqs_
-          );
+          read_block(*doc_in_, version_, enc_buf_, doc_freqs_);
         } else {
           encode::bitpack::skip_block32(
             *doc_in_,
@@ -364,14 +635,13 @@ class doc_iterator : public iresearch::doc_iterator {
       end_ = docs_ + left;
     }
 
-    // if this is the initial doc_id then set it to min() for proper delta value
-    // add last doc_id before decoding
-    *docs_ += type_limits<type_t::doc_id_t>::valid(doc_.value)
-      ? doc_.value
-      : (type_limits<type_t::doc_id_t>::min)();
+    if (!decoded) {
+      // add last doc_id before decoding
+      *docs_ += base;
 
-    // decode delta encoded documents block
-    encode::delta::decode(std::begin(docs_), end_);
+      // decode delta encoded documents block
+      encode::delta::decode(std::begin(docs_), end_);
+    }
 
     begin_ = docs_;
     doc_freq_ = docs_ + postings_writer::BLOCK_SIZE;
@@ -389,12 +659,16 @@ class doc_iterator : public iresearch::doc_iterator {
   doc_id_t* end_{docs_};
   uint64_t* doc_freq_{}; // pointer into docs_ to the frequency attribute value for the current doc
   uint64_t term_freq_{}; // total term frequency
+  uint64_t prefetched_{}; // end of the document blocks requested via prefetch
   document doc_;
   frequency freq_;
+  raw_postings raw_;
+  block_max_reader max_freq_; // max frequencies of the document blocks
   index_input::ptr doc_in_;
   version10::term_meta term_state_;
   features features_; // field features
   features enabled_; // enabled iterator features
+  int32_t version_{}; // postings format version
 }; // doc_iterator 
 
 void doc_iterator::seek_to_block(doc_id_t target) {
@@ -406,7 +680,9 @@ void doc_iterator::seek_to_block(doc_id_t target) {
     // init skip writer in lazy fashion
     if (!skip_) {
       index_input::ptr skip_in = doc_in_->dup();
-      skip_in->seek(term_state_.doc_start + term_state_.e_skip_start);
+      const auto skip_start = term_state_.doc_start + term_state_.e_skip_start;
+      skip_in->seek(skip_start);
+      skip_in->prefetch(skip_start, PREFETCH_SIZE); // skip list is read via a number of seeks
 
       skip_.prepare(
         std::move(skip_in),
@@ -476,7 +752,7 @@ class mask_doc_iterator final: public DocIterator {
 
   virtual bool next() override {
     while (doc_iterator_t::next()) {
-      if (mask_.find(this->value()) == mask_.end()) {
+      if (!mask_.contains(this->value())) {
         return true;
       }
     }
@@ -487,7 +763,7 @@ class mask_doc_iterator final: public DocIterator {
   virtual doc_id_t seek(doc_id_t target) override {
     const auto doc = doc_iterator_t::seek(target);
 
-    if (mask_.find(doc) == mask_.end()) {
+    if (!mask_.contains(doc)) {
       return doc;
     }
 
@@ -560,6 +836,7 @@ class pos_iterator: public position {
     enc_buf_ = reinterpret_cast<uint32_t*>(state.enc_buf);
     tail_start_ = state.tail_start;
     tail_length_ = state.tail_length;  
+    version_ = state.version;
   }
 
   // notifies iterator that doc iterator has skipped to a new block
@@ -597,7 +874,7 @@ class pos_iterator: public position {
         }
       }
     } else {
-      encode::bitpack::read_block(*pos_in_, postings_writer::BLOCK_SIZE, enc_buf_, pos_deltas_);
+      read_block(*pos_in_, version_, enc_buf_, pos_deltas_);
     }
   }
 
@@ -632,6 +909,7 @@ class pos_iterator: public position {
   uint32_t buf_pos_{ postings_writer::BLOCK_SIZE } ; /* current position in pos_deltas_ buffer */
   index_input::ptr pos_in_;
   features features_; /* field features */
+  int32_t version_{}; // postings format version
 
  private:
   template<typename T>
@@ -750,12 +1028,12 @@ class offs_pay_iterator final: public pos_iterator {
         }
       }
     } else {
-      encode::bitpack::read_block(*pos_in_, postings_writer::BLOCK_SIZE, enc_buf_, pos_deltas_);
+      read_block(*pos_in_, version_, enc_buf_, pos_deltas_);
 
       // read payloads
       const uint32_t size = pay_in_->read_vint();
       if (size) {
-        encode::bitpack::read_block(*pay_in_, postings_writer::BLOCK_SIZE, enc_buf_, pay_lengths_);
+        read_block(*pay_in_, version_, enc_buf_, pay_lengths_);
         oversize(pay_data_, size);
 
         #ifdef IRESEARCH_DEBUG
@@ -767,8 +1045,8 @@ class offs_pay_iterator final: public pos_iterator {
       }
 
       // read offsets
-      encode::bitpack::read_block(*pay_in_, postings_writer::BLOCK_SIZE, enc_buf_, offs_start_deltas_);
-      encode::bitpack::read_block(*pay_in_, postings_writer::BLOCK_SIZE, enc_buf_, offs_lengts_);
+      read_block(*pay_in_, version_, enc_buf_, offs_start_deltas_);
+      read_block(*pay_in_, version_, enc_buf_, offs_lengts_);
     }
     pay_data_pos_ = 0;
   }
@@ -849,7 +1127,7 @@ class offs_iterator final : public pos_iterator {
         }
       }
     } else {
-      encode::bitpack::read_block(*pos_in_, postings_writer::BLOCK_SIZE, enc_buf_, pos_deltas_);
+      read_block(*pos_in_, version_, enc_buf_, pos_deltas_);
 
       // skip payload
       if (features_.payload()) {
@@ -857,8 +1135,8 @@ class offs_iterator final : public pos_iterator {
       }
 
       // read offsets
-      encode::bitpack::read_block(*pay_in_, postings_writer::BLOCK_SIZE, enc_buf_, offs_start_deltas_);
-      encode::bitpack::read_block(*pay_in_, postings_writer::BLOCK_SIZE, enc_buf_, offs_lengts_);
+      read_block(*pay_in_, version_, enc_buf_, offs_start_deltas_);
+      read_block(*pay_in_, version_, enc_buf_, offs_lengts_);
     }
   }
 
@@ -1004,12 +1282,12 @@ class pay_iterator final : public pos_iterator {
         }
       }
     } else {
-      encode::bitpack::read_block(*pos_in_, postings_writer::BLOCK_SIZE, enc_buf_, pos_deltas_);
+      read_block(*pos_in_, version_, enc_buf_, pos_deltas_);
 
       /* read payloads */
       const uint32_t size = pay_in_->read_vint();
       if (size) {
-        encode::bitpack::read_block(*pay_in_, postings_writer::BLOCK_SIZE, enc_buf_, pay_lengths_);
+        read_block(*pay_in_, version_, enc_buf_, pay_lengths_);
         oversize(pay_data_, size);
 
         #ifdef IRESEARCH_DEBUG
@@ -1079,6 +1357,15 @@ class pos_doc_iterator final: public doc_iterator {
     pos_.prepare(ctx); // notify positions
   }
 
+  virtual void next_batch_notify(const uint64_t* freqs, size_t count) final {
+    // skip positions of the documents
+    for (const auto* end = freqs + count; freqs != end; ++freqs) {
+      pos_.pend_pos_ += *freqs;
+    }
+
+    pos_.clear();
+  }
+
  private:
   PosItrType pos_;
 }; // pos_doc_iterator
@@ -1093,6 +1380,7 @@ void pos_doc_iterator<PosItrType>::prepare_attributes(
   assert(enabled.position());
   attrs_.emplace(freq_);
   term_freq_ = attrs.get<frequency>()->value;
+  prepare_max_freq();
 
   // ...........................................................................
   // position attribute
@@ -1105,6 +1393,7 @@ void pos_doc_iterator<PosItrType>::prepare_attributes(
   state.freq = &freq_.value;
   state.features = features_;
   state.enc_buf = enc_buf_;
+  state.version = version_;
 
   if (term_freq_ < postings_writer::BLOCK_SIZE) {
     state.tail_start = term_state_.pos_start;
@@ -1420,6 +1709,12 @@ void segment_meta_reader::read(
 // --SECTION--                                             document_mask_writer 
 // ----------------------------------------------------------------------------
 
+// type of the document_mask::container
+enum container_type : uint32_t {
+  MASK_ARRAY = 0,
+  MASK_BITMAP
+};
+
 const string_ref document_mask_writer::FORMAT_NAME = "iresearch_10_doc_mask";
 const string_ref document_mask_writer::FORMAT_EXT = "doc_mask";
 
@@ -1449,16 +1744,48 @@ void document_mask_writer::prepare(directory& dir, const segment_meta& meta) {
 }
 
 void document_mask_writer::begin(uint32_t count) {
-  format_utils::write_header(*out_, FORMAT_NAME, FORMAT_MAX);
-  out_->write_vint(count);
+  UNUSED(count);
+  mask_.clear();
 }
 
 void document_mask_writer::write(const doc_id_t& mask) {
-  out_->write_vlong(mask);
+  mask_.insert(mask);
 }
 
 void document_mask_writer::end() {
+  format_utils::write_header(*out_, FORMAT_NAME, FORMAT_MAX);
+  out_->write_vint(static_cast<uint32_t>(mask_.size()));
+
+  auto& containers = mask_.containers();
+  const auto count = std::count_if(
+    containers.begin(), containers.end(),
+    [](const document_mask::container& c) { return 0 != c.size(); }
+  );
+
+  out_->write_vlong(count);
+
+  for (auto& container : containers) {
+    if (!container.size()) {
+      continue; // skip empty containers
+    }
+
+    out_->write_vlong(container.key());
+    out_->write_vint(static_cast<uint32_t>(container.size()));
+    write_enum(*out_, container.is_bitmap() ? MASK_BITMAP : MASK_ARRAY);
+
+    if (container.is_bitmap()) {
+      for (auto word : container.bitmap()) {
+        out_->write_long(static_cast<int64_t>(word));
+      }
+    } else {
+      for (auto value : container.array()) {
+        out_->write_short(static_cast<int16_t>(value));
+      }
+    }
+  }
+
   format_utils::write_footer(*out_);
+  mask_.clear();
 }
 
 // ----------------------------------------------------------------------------
@@ -1510,17 +1837,67 @@ bool document_mask_reader::prepare(
 }
 
 uint32_t document_mask_reader::begin() {
-  format_utils::check_header(
+  version_ = format_utils::check_header(
     *in_,
     document_mask_writer::FORMAT_NAME,
     document_mask_writer::FORMAT_MIN,
     document_mask_writer::FORMAT_MAX
   );
 
-  return in_->read_vint();
+  const auto count = in_->read_vint();
+
+  if (version_ < document_mask_writer::FORMAT_BITMAP) {
+    return count; // flat list of document ids
+  }
+
+  mask_.clear();
+
+  for (auto containers = in_->read_vlong(); containers; --containers) {
+    const auto key = in_->read_vlong();
+    const size_t size = in_->read_vint();
+    const auto type = read_enum<container_type>(*in_);
+
+    if (MASK_BITMAP == type) {
+      std::vector<document_mask::word_t> bitmap(document_mask::BITMAP_WORDS);
+
+      for (auto& word : bitmap) {
+        word = static_cast<document_mask::word_t>(in_->read_long());
+      }
+
+      mask_.push_back(document_mask::container(key, std::move(bitmap)));
+    } else {
+      if (MASK_ARRAY != type || size > document_mask::ARRAY_MAX) {
+        throw index_error(); // corrupted mask
+      }
+
+      std::vector<uint16_t> array(size);
+
+      for (auto& value : array) {
+        value = static_cast<uint16_t>(in_->read_short());
+      }
+
+      mask_.push_back(document_mask::container(key, std::move(array)));
+    }
+  }
+
+  if (mask_.size() != count) {
+    throw index_error(); // corrupted mask
+  }
+
+  it_ = mask_.begin();
+
+  return count;
 }
 
 void document_mask_reader::read(doc_id_t& doc_id) {
+  if (version_ >= document_mask_writer::FORMAT_BITMAP) {
+    assert(it_ != mask_.end());
+    doc_id = *it_;
+    ++it_;
+
+    return;
+  }
+
   auto id = in_->read_vlong();
 
   static_assert(sizeof(doc_id_t) == sizeof(decltype(id)), "sizeof(doc_id) != sizeof(decltype(id))");
@@ -1867,7 +2244,8 @@ class index_block {
 class writer final : public iresearch::columnstore_writer {
  public:
   static const int32_t FORMAT_MIN = 0;
-  static const int32_t FORMAT_MAX = FORMAT_MIN;
+  static const int32_t FORMAT_QUANTIZED_NORMS = 1; // norms are stored as quantized field lengths
+  static const int32_t FORMAT_MAX = FORMAT_QUANTIZED_NORMS;
 
   static const string_ref FORMAT_NAME;
   static const string_ref FORMAT_EXT;
@@ -1875,6 +2253,7 @@ class writer final : public iresearch::columnstore_writer {
   virtual bool prepare(directory& dir, const segment_meta& meta) override;
   virtual column_t push_column() override;
   virtual bool flush() override;
+  virtual size_t memory() const NOEXCEPT override;
 
  private:
   class column final : public iresearch::columnstore_writer::column_output {
@@ -1916,6 +2295,11 @@ class writer final : public iresearch::columnstore_writer {
       return !block_index_.total();
     }
 
+    // current data block and blocks index are kept in memory until flush
+    size_t memory() const NOEXCEPT {
+      return sizeof(column) + block_buf_.capacity() + blocks_index_.file.length();
+    }
+
     void finish() {
       auto& out = *ctx_->data_out_;
       write_enum(out, props_); // column properties
@@ -2106,13 +2490,23 @@ bool writer::flush() {
   return true;
 }
 
+size_t writer::memory() const NOEXCEPT {
+  size_t size = sizeof(writer);
+
+  for (auto& column : columns_) {
+    size += column.memory();
+  }
+
+  return size;
+}
+
 template<typename Block, typename Allocator>
-class block_cache : irs::util::noncopyable {
+class block_storage : irs::util::noncopyable {
  public:
-  block_cache(const Allocator& alloc = Allocator())
+  block_storage(const Allocator& alloc = Allocator())
     : cache_(alloc) {
   }
-  block_cache(block_cache&& rhs) 
+  block_storage(block_storage&& rhs) 
     : cache_(std::move(rhs.cache_)) {
   }
 
@@ -2128,13 +2522,13 @@ class block_cache : irs::util::noncopyable {
 
  private:
   std::deque<Block, Allocator> cache_; // pointers remain valid
-}; // block_cache
+}; // block_storage
 
 template<typename Block, typename Allocator>
 struct block_cache_traits {
   typedef Block block_t;
   typedef typename std::allocator_traits<Allocator>::template rebind_alloc<block_t> allocator_t;
-  typedef block_cache<Block, allocator_t> cache_t;
+  typedef block_storage<Block, allocator_t> cache_t;
 };
 
 // -----------------------------------------------------------------------------
@@ -2317,6 +2711,11 @@ class sparse_block : util::noncopyable {
     return visitor(begin->key, value);
   }
 
+  // returns amount of memory occupied by a block
+  size_t memory() const NOEXCEPT {
+    return sizeof(*this) + data_.capacity();
+  }
+
  private:
   // TODO: use single memory block for both index & data
 
@@ -2491,6 +2890,11 @@ class dense_block : util::noncopyable {
     return visitor(key, value);
   }
 
+  // returns amount of memory occupied by a block
+  size_t memory() const NOEXCEPT {
+    return sizeof(*this) + data_.capacity();
+  }
+
  private:
   // TODO: use single memory block for both index & data
 
@@ -2641,6 +3045,20 @@ class dense_fixed_length_block : util::noncopyable {
     return visitor(key, value);
   }
 
+  // returns amount of memory occupied by a block
+  size_t memory() const NOEXCEPT {
+    return sizeof(*this) + data_.capacity();
+  }
+
+  // returns the first value, all values except the tail
+  // one are stored sequentially and have 'avg_length()' bytes
+  const byte_type* begin() const NOEXCEPT {
+    return data_.c_str() + base_offset_;
+  }
+
+  uint64_t avg_length() const NOEXCEPT { return avg_length_; }
+  doc_id_t size() const NOEXCEPT { return size_; }
+
  private:
   doc_id_t base_key_{}; // base key
   uint64_t base_offset_{}; // base offset
@@ -2756,6 +3174,11 @@ class sparse_mask_block : util::noncopyable {
     return true;
   }
 
+  // returns amount of memory occupied by a block
+  size_t memory() const NOEXCEPT {
+    return sizeof(*this);
+  }
+
  private:
   // all blocks except the tail one are going to be fully filled,
   // so we store keys in a fixed length array since we could
@@ -2846,28 +3269,88 @@ class context_provider : private util::noncopyable {
     : pool_(std::max(size_t(1), max_pool_size)) {
   }
 
-  void prepare(index_input::ptr&& stream) NOEXCEPT {
+  ~context_provider() {
+    if (cache_) {
+      cache_->erase(cache_owner_);
+    }
+  }
+
+  void prepare(
+      index_input::ptr&& stream,
+      const block_cache::ptr& cache) NOEXCEPT {
     stream_ = std::move(stream);
+    cache_ = cache;
+    cache_owner_ = block_cache::next_owner(); // don't reuse blocks of the previous file
   }
 
   bounded_object_pool<read_context_t>::ptr get_context() const {
     return pool_.emplace(*stream_);
   }
 
+  // shared cache of the loaded blocks, nullptr if blocks
+  // are cached for the lifetime of the reader
+  block_cache* cache() const NOEXCEPT { return cache_.get(); }
+
+  // identifies blocks of the reader in the shared cache
+  uint64_t cache_owner() const NOEXCEPT { return cache_owner_; }
+
  private:
   mutable bounded_object_pool<read_context_t> pool_;
   index_input::ptr stream_;
+  block_cache::ptr cache_;
+  uint64_t cache_owner_{};
 }; // context_provider
 
+// in case of success loads block pointed by 'ref'
+// into the shared cache and returns a pointer to
+// cached instance, nullptr otherwise
+template<typename BlockRef>
+std::shared_ptr<const typename BlockRef::block_t> load_shared_block(
+    const context_provider& ctxs,
+    const BlockRef& ref) {
+  typedef typename BlockRef::block_t block_t;
+
+  auto& cache = *ctxs.cache();
+  auto cached = cache.find<block_t>(ctxs.cache_owner(), ref.offset);
+
+  if (!cached) {
+    auto ctx = ctxs.get_context();
+
+    if (!ctx) {
+      // unable to get context
+      return nullptr;
+    }
+
+    auto block = std::make_shared<block_t>();
+
+    if (!ctx->load(*block, ref.offset)) {
+      // failed to load block
+      return nullptr;
+    }
+
+    const auto size = block->memory();
+
+    cached = cache.emplace<block_t>(
+      ctxs.cache_owner(), ref.offset, std::move(block), size
+    );
+  }
+
+  return cached;
+}
+
 // in case of success caches block pointed
 // by 'ref' and retuns a pointer to cached
 // instance, nullptr otherwise
 template<typename BlockRef>
-const typename BlockRef::block_t* load_block(
+std::shared_ptr<const typename BlockRef::block_t> load_block(
     const context_provider& ctxs,
     BlockRef& ref) {
   typedef typename BlockRef::block_t block_t;
 
+  if (ctxs.cache()) {
+    return load_shared_block(ctxs, ref);
+  }
+
   const auto* cached = ref.pblock.load();
 
   if (!cached) {
@@ -2895,19 +3378,30 @@ const typename BlockRef::block_t* load_block(
     }
   }
 
-  return cached;
+  // blocks are owned by the reader
+  return std::shared_ptr<const block_t>(std::shared_ptr<const block_t>(), cached);
 }
 
-// in case of success caches block pointed
-// by 'ref' in the specified 'block' and
-// retuns a pointer to cached instance,
-// nullptr otherwise
+// in case of success loads block pointed
+// by 'ref' into the specified 'block' (unless
+// it is already cached) and retuns a pointer
+// to loaded instance, nullptr otherwise
 template<typename BlockRef>
-const typename BlockRef::block_t* load_block(
+std::shared_ptr<const typename BlockRef::block_t> load_block(
     const context_provider& ctxs,
     const BlockRef& ref,
     typename BlockRef::block_t& block) {
-  const auto* cached = ref.pblock.load();
+  typedef typename BlockRef::block_t block_t;
+
+  std::shared_ptr<const block_t> cached;
+
+  if (ctxs.cache()) {
+    cached = ctxs.cache()->find<block_t>(ctxs.cache_owner(), ref.offset);
+  } else {
+    cached = std::shared_ptr<const block_t>(
+      std::shared_ptr<const block_t>(), ref.pblock.load()
+    );
+  }
 
   if (!cached) {
     auto ctx = ctxs.get_context();
@@ -2922,7 +3416,7 @@ const typename BlockRef::block_t* load_block(
       return nullptr;
     }
 
-    cached = &block;
+    cached = std::shared_ptr<const block_t>(std::shared_ptr<const block_t>(), &block);
   }
 
   return cached;
@@ -2960,6 +3454,8 @@ class column
   size_t avg_block_size() const NOEXCEPT { return avg_block_size_; }
   size_t avg_block_count() const NOEXCEPT { return avg_block_count_; }
   ColumnProperty props() const NOEXCEPT { return props_; }
+  virtual bool quantized_norms() const NOEXCEPT override { return quantized_norms_; }
+  void quantized_norms(bool value) NOEXCEPT { quantized_norms_ = value; }
 
  private:
   doc_id_t max_{ type_limits<type_t::doc_id_t>::eof() };
@@ -2967,6 +3463,7 @@ class column
   size_t avg_block_size_{};
   size_t avg_block_count_{};
   ColumnProperty props_{ CP_SPARSE };
+  bool quantized_norms_{ true }; // see columnstore_reader::column_reader::quantized_norms()
 }; // column
 
 template<typename Column>
@@ -3043,7 +3540,7 @@ class column_iterator final: public irs::doc_iterator {
       return false;
     }
 
-    const auto* cached = load_block(*column_->ctxs_, *begin_);
+    auto cached = load_block(*column_->ctxs_, *begin_);
 
     if (!cached) {
       // unable to load block, seal the iterator
@@ -3057,6 +3554,7 @@ class column_iterator final: public irs::doc_iterator {
     if (block_ != *cached) {
       block_.reset(*cached);
       payload_.value_ = &(block_.value_payload());
+      cached_ = std::move(cached); // prevent block from being evicted
     }
 
     seek_origin_ = begin_++;
@@ -3065,6 +3563,7 @@ class column_iterator final: public irs::doc_iterator {
   }
 
   irs::attribute_view attrs_;
+  std::shared_ptr<const block_t> cached_; // current block
   block_iterator_t block_;
   payload_iterator payload_;
   const typename column_t::block_ref* begin_;
@@ -3079,12 +3578,16 @@ class column_iterator final: public irs::doc_iterator {
 
 template<typename Column>
 columnstore_reader::values_reader_f column_values(const Column& column) {
-if (column.empty()) {
+  if (column.empty()) {
     return columnstore_reader::empty_reader();
   }
 
-  return [&column](doc_id_t key, bytes_ref& value) {
-    return column.value(key, value);
+  // last accessed block, keeps returned values valid
+  // until the next call even if block is evicted
+  std::shared_ptr<const typename Column::block_t> cached;
+
+  return [&column, cached](doc_id_t key, bytes_ref& value) mutable {
+    return column.value(key, value, cached);
   };
 }
 
@@ -3164,7 +3667,10 @@ class sparse_column final : public column {
     return true;
   }
 
-  bool value(doc_id_t key, bytes_ref& value) const {
+  bool value(
+      doc_id_t key,
+      bytes_ref& value,
+      std::shared_ptr<const block_t>& cached) const {
     // find the right block
     const auto rbegin = refs_.rbegin(); // upper bound
     const auto rend = refs_.rend();
@@ -3178,7 +3684,7 @@ class sparse_column final : public column {
       return false;
     }
 
-    const auto* cached = load_block(*ctxs_, *it);
+    cached = load_block(*ctxs_, *it);
 
     if (!cached) {
       // unable to load block
@@ -3194,7 +3700,7 @@ class sparse_column final : public column {
   ) const override {
     block_t block; // don't cache new blocks
     for (auto begin = refs_.begin(), end = refs_.end()-1; begin != end; ++begin) { // -1 for upper bound
-      const auto* cached = load_block(*ctxs_, *begin, block);
+      const auto cached = load_block(*ctxs_, *begin, block);
 
       if (!cached) {
         // unable to load block
@@ -3226,6 +3732,12 @@ class sparse_column final : public column {
     return column_values<column_t>(*this);
   }
 
+  virtual columnstore_reader::values_cursor::ptr cursor() const override {
+    return empty()
+      ? column_reader::cursor()
+      : memory::make_unique<values_cursor>(*this);
+  }
+
  private:
   friend class column_iterator<column_t>;
 
@@ -3291,6 +3803,49 @@ class sparse_column final : public column {
     return irstd::to_forward(it);
   }
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief looks up a block only for documents outside of the current one
+  //////////////////////////////////////////////////////////////////////////////
+  class values_cursor final : public columnstore_reader::values_cursor {
+   public:
+    explicit values_cursor(const column_t& column) NOEXCEPT
+      : column_(&column),
+        ref_(column.refs_.data()) {
+    }
+
+   protected:
+    virtual bool read_block(doc_id_t doc, bytes_ref& value) override {
+      if (!cached_ || doc < ref_->key || doc >= (ref_ + 1)->key) {
+        const auto* begin = column_->refs_.data();
+        const auto* end = begin + column_->refs_.size() - 1; // -1 for upper bound
+
+        cached_.reset();
+        ref_ = column_->find_block(doc < ref_->key ? begin : ref_, end, doc);
+
+        if (ref_ == end) {
+          // document is beyond the column
+          ref_ = begin;
+
+          return false;
+        }
+
+        cached_ = load_block(*column_->ctxs_, *ref_);
+
+        if (!cached_) {
+          // unable to load block
+          return false;
+        }
+      }
+
+      return cached_->value(doc, value);
+    }
+
+   private:
+    const column_t* column_;
+    const block_ref* ref_; // current block
+    std::shared_ptr<const block_t> cached_; // keeps returned values valid
+  }; // values_cursor
+
   const context_provider* ctxs_;
   refs_t refs_; // blocks index
 }; // sparse_column
@@ -3365,7 +3920,10 @@ class dense_fixed_length_column final : public column {
     return true;
   }
 
-  bool value(doc_id_t key, bytes_ref& value) const {
+  bool value(
+      doc_id_t key,
+      bytes_ref& value,
+      std::shared_ptr<const block_t>& cached) const {
     if ((key -= min_) >= this->size()) {
       return false;
     }
@@ -3375,7 +3933,7 @@ class dense_fixed_length_column final : public column {
 
     auto& ref = const_cast<block_ref&>(refs_[block_idx]);
 
-    const auto* cached = load_block(*ctxs_, ref);
+    cached = load_block(*ctxs_, ref);
 
     if (!cached) {
       // unable to load block
@@ -3391,7 +3949,7 @@ class dense_fixed_length_column final : public column {
   ) const override {
     block_t block; // don't cache new blocks
     for (auto& ref : refs_) {
-      const auto* cached = load_block(*ctxs_, ref, block);
+      const auto cached = load_block(*ctxs_, ref, block);
 
       if (!cached) {
         // unable to load block
@@ -3425,9 +3983,64 @@ class dense_fixed_length_column final : public column {
     return column_values<column_t>(*this);
   }
 
+  virtual columnstore_reader::values_cursor::ptr cursor() const override {
+    return empty()
+      ? column_reader::cursor()
+      : memory::make_unique<values_cursor>(*this);
+  }
+
  private:
   friend class column_iterator<column_t>;
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief exposes all but the tail value of the current block as a run of
+  ///        fixed-length values, so they're read without a block lookup
+  //////////////////////////////////////////////////////////////////////////////
+  class values_cursor final : public columnstore_reader::values_cursor {
+   public:
+    explicit values_cursor(const column_t& column) NOEXCEPT
+      : column_(&column) {
+    }
+
+   protected:
+    virtual bool read_block(doc_id_t doc, bytes_ref& value) override {
+      auto key = doc - column_->min_;
+
+      if (key >= column_->size()) {
+        return false;
+      }
+
+      const auto block_idx = key / column_->avg_block_count();
+      assert(block_idx < column_->refs_.size());
+      key -= block_idx*column_->avg_block_count(); // 0-based key in a block
+
+      if (block_idx != block_idx_ || !cached_) {
+        run(0, 0, nullptr, 0); // run points to the data of the previous block
+        cached_ = load_block(*column_->ctxs_, column_->refs_[block_idx]);
+
+        if (!cached_) {
+          // unable to load block
+          return false;
+        }
+
+        block_idx_ = block_idx;
+
+        if (cached_->avg_length()) {
+          const auto base = doc - key;
+
+          run(base, base + cached_->size() - 1, cached_->begin(), cached_->avg_length()); // -1 for tail value
+        }
+      }
+
+      return cached_->value(key, value);
+    }
+
+   private:
+    const column_t* column_;
+    size_t block_idx_{}; // index of the current block
+    std::shared_ptr<const block_t> cached_; // keeps returned values valid
+  }; // values_cursor
+
   struct block_ref {
     typedef typename column_t::block_t block_t;
 
@@ -3569,10 +4182,37 @@ class dense_fixed_length_column<dense_mask_block> final : public column {
   virtual doc_iterator::ptr iterator() const override;
 
   virtual columnstore_reader::values_reader_f values() const override {
-    return column_values<column_t>(*this);
+    if (empty()) {
+      return columnstore_reader::empty_reader();
+    }
+
+    return [this](doc_id_t key, bytes_ref& value) {
+      return this->value(key, value);
+    };
+  }
+
+  virtual columnstore_reader::values_cursor::ptr cursor() const override {
+    return memory::make_unique<values_cursor>(*this);
   }
 
  private:
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief the whole column is a single run of empty values
+  //////////////////////////////////////////////////////////////////////////////
+  class values_cursor final : public columnstore_reader::values_cursor {
+   public:
+    explicit values_cursor(const column_t& column) NOEXCEPT {
+      if (!column.empty()) {
+        run(column.min_ + 1, column.max() + 1, bytes_ref::NIL.c_str(), 0);
+      }
+    }
+
+   protected:
+    virtual bool read_block(doc_id_t, bytes_ref&) override {
+      return false;
+    }
+  }; // values_cursor
+
   class column_iterator final: public doc_iterator {
    public:
     explicit column_iterator(const column_t& column) NOEXCEPT
@@ -3661,7 +4301,8 @@ class IRESEARCH_PLUGIN reader final : public columnstore_reader, public context_
   virtual bool prepare(
     const directory& dir,
     const segment_meta& meta,
-    bool* seen = nullptr
+    bool* seen = nullptr,
+    const block_cache::ptr& cache = nullptr
   ) override;
 
   virtual const column_reader* column(field_id field) const override;
@@ -3677,7 +4318,8 @@ class IRESEARCH_PLUGIN reader final : public columnstore_reader, public context_
 bool reader::prepare(
     const directory& dir,
     const segment_meta& meta,
-    bool* seen /*= nullptr*/
+    bool* seen /*= nullptr*/,
+    const block_cache::ptr& cache /*= nullptr*/
 ) {
   auto filename = file_name<columnstore_writer>(meta);
   bool exists;
@@ -3705,7 +4347,7 @@ bool reader::prepare(
   }
 
   // check header
-  format_utils::check_header(
+  const auto version = format_utils::check_header(
     *stream,
     writer::FORMAT_NAME,
     writer::FORMAT_MIN,
@@ -3739,11 +4381,13 @@ bool reader::prepare(
       return false;
     }
 
+    column->quantized_norms(version >= writer::FORMAT_QUANTIZED_NORMS);
+
     columns.emplace_back(std::move(column));
   }
 
   // noexcept
-  context_provider::prepare(std::move(stream));
+  context_provider::prepare(std::move(stream), cache);
   columns_ = std::move(columns);
 
   if (seen) {
@@ -3777,15 +4421,15 @@ const string_ref postings_writer::PAY_FORMAT_NAME = "iresearch_10_postings_paylo
 const string_ref postings_writer::PAY_EXT = "pay";
 
 void postings_writer::doc_stream::flush(uint64_t* buf, bool freq) {
-  encode::bitpack::write_block(*out, deltas, BLOCK_SIZE, buf);
+  encode::bitpack::write_block_simd(*out, deltas, BLOCK_SIZE, buf);
 
   if (freq) {
-    encode::bitpack::write_block(*out, freqs.get(), BLOCK_SIZE, buf);
+    encode::bitpack::write_block_simd(*out, freqs.get(), BLOCK_SIZE, buf);
   }
 }
 
 void postings_writer::pos_stream::flush(uint32_t* comp_buf) {
-  encode::bitpack::write_block(*out, this->buf, BLOCK_SIZE, comp_buf);
+  encode::bitpack::write_block_simd(*out, this->buf, BLOCK_SIZE, comp_buf);
   size = 0;
 }
 
@@ -3813,14 +4457,14 @@ void postings_writer::pay_stream::flush_payload(uint32_t* buf) {
   if (pay_buf_.empty()) {
     return;
   }
-  encode::bitpack::write_block(*out, pay_sizes, BLOCK_SIZE, buf);
+  encode::bitpack::write_block_simd(*out, pay_sizes, BLOCK_SIZE, buf);
   out->write_bytes(pay_buf_.c_str(), pay_buf_.size());
   pay_buf_.clear();
 }
 
 void postings_writer::pay_stream::flush_offsets(uint32_t* buf) {
-  encode::bitpack::write_block(*out, offs_start_buf, BLOCK_SIZE, buf);
-  encode::bitpack::write_block(*out, offs_len_buf, BLOCK_SIZE, buf);
+  encode::bitpack::write_block_simd(*out, offs_start_buf, BLOCK_SIZE, buf);
+  encode::bitpack::write_block_simd(*out, offs_len_buf, BLOCK_SIZE, buf);
 }
 
 postings_writer::postings_writer(bool volatile_attributes)
@@ -3834,6 +4478,7 @@ void postings_writer::prepare(index_output& out, const iresearch::flush_state& s
 
   // reset writer state
   docs_count = 0;
+  inputs_.clear();
 
   std::string name;
 
@@ -3904,6 +4549,16 @@ void postings_writer::begin_block() {
 
 irs::postings_writer::state postings_writer::write(doc_iterator& docs) {
   REGISTER_TIMER_DETAILED();
+  auto& raw = docs.attributes().get<irs::raw_postings>();
+  const auto* src = raw
+    ? dynamic_cast<const version10::raw_postings*>(raw.get())
+    : nullptr;
+  bool next = docs.next();
+
+  if (src && next && copyable(*src, docs)) {
+    return copy(docs, *src);
+  }
+
   auto& freq = docs.attributes().get<frequency>();
 
   auto& pos = freq
@@ -3929,7 +4584,7 @@ irs::postings_writer::state postings_writer::write(doc_iterator& docs) {
 
   begin_term();
 
-  while (docs.next()) {
+  for (; next; next = docs.next()) {
     const auto did = docs.value();
 
     assert(type_limits<type_t::doc_id_t>::valid(did));
@@ -3961,6 +4616,166 @@ irs::postings_writer::state postings_writer::write(doc_iterator& docs) {
   return make_state(*meta.release());
 }
 
+bool postings_writer::copyable(
+    const raw_postings& src,
+    const doc_iterator& docs) const {
+  // blocks and skip data of a postings list with at least one packed block
+  // refer to absolute doc_ids, such a list may be copied only if doc_ids are
+  // left unchanged
+  return FORMAT_MAX == src.version
+    && features_ == src.field
+    && (src.meta->docs_count < BLOCK_SIZE || src.doc->value == docs.value());
+}
+
+irs::postings_writer::state postings_writer::copy(
+    doc_iterator& docs,
+    const raw_postings& raw) {
+  REGISTER_TIMER_DETAILED();
+  // the source iterator may be released at the end of iteration
+  const auto src = raw;
+  const auto src_meta = *raw.meta;
+  auto& freq = docs.attributes().get<frequency>();
+  const bool has_freq = bool(freq); // attributes may be reset at the end
+  auto meta = memory::allocate_unique<version10::term_meta>(alloc_);
+  uint64_t tfreq = 0;
+
+  // ...........................................................................
+  // documents, either re-encoded or copied along with the skip data
+  // ...........................................................................
+
+  auto& doc_out = *doc.out;
+  auto last = type_limits<type_t::doc_id_t>::min();
+
+  meta->doc_start = doc_out.file_pointer();
+
+  do {
+    const auto did = docs.value();
+
+    assert(type_limits<type_t::doc_id_t>::valid(did) && did >= last);
+    docs_.value.set(did - type_limits<type_t::doc_id_t>::min());
+
+    if (1 == src_meta.docs_count) {
+      meta->e_single_doc = did - type_limits<type_t::doc_id_t>::min();
+    } else if (src_meta.docs_count < BLOCK_SIZE) {
+      detail::write_doc(
+        doc_out, uint32_t(did - last), freq ? &freq->value : nullptr
+      );
+    }
+
+    last = did;
+    ++meta->docs_count;
+
+    if (freq) {
+      tfreq += freq->value;
+    }
+  } while (docs.next());
+
+  // the whole postings list is expected, see copyable(...)
+  assert(meta->docs_count == src_meta.docs_count);
+
+  if (src_meta.docs_count > BLOCK_SIZE) {
+    auto& in = input(*src.doc_in);
+
+    in.seek(src_meta.doc_start + src_meta.e_skip_start);
+
+    for (auto levels = in.read_vint(); levels; --levels) {
+      const auto length = in.read_vlong();
+      in.seek(in.file_pointer() + length);
+    }
+
+    detail::copy_bytes(
+      in, src_meta.doc_start, in.file_pointer() - src_meta.doc_start, doc_out
+    );
+    meta->e_skip_start = src_meta.e_skip_start;
+  } else if (src_meta.docs_count == BLOCK_SIZE) {
+    // a single packed block without skip data
+    auto& in = input(*src.doc_in);
+
+    in.seek(src_meta.doc_start);
+    encode::bitpack::skip_block32(in, BLOCK_SIZE); // doc deltas
+
+    if (features_.freq()) {
+      encode::bitpack::skip_block32(in, BLOCK_SIZE); // frequencies
+    }
+
+    detail::copy_bytes(
+      in, src_meta.doc_start, in.file_pointer() - src_meta.doc_start, doc_out
+    );
+  }
+
+  meta->freq = has_freq ? tfreq : integer_traits<uint64_t>::const_max;
+
+  // ...........................................................................
+  // positions, payloads and offsets are independent of doc_ids
+  // ...........................................................................
+
+  meta->pos_end = src_meta.pos_end;
+
+  if (features_.position()) {
+    assert(pos_ && has_freq);
+    auto& in = input(*src.pos_in);
+
+    // find where the variable length encoded positions start
+    if (tfreq > BLOCK_SIZE) {
+      in.seek(src_meta.pos_start + src_meta.pos_end);
+    } else {
+      in.seek(src_meta.pos_start);
+
+      if (BLOCK_SIZE == tfreq) {
+        detail::skip_positions(in);
+      }
+    }
+
+    detail::skip_positions_tail(in, features_, tfreq % BLOCK_SIZE);
+
+    meta->pos_start = pos_->out->file_pointer();
+    detail::copy_bytes(
+      in, src_meta.pos_start, in.file_pointer() - src_meta.pos_start, *pos_->out
+    );
+
+    if (features_.payload() || features_.offset()) {
+      assert(pay_);
+      auto& pay_in = input(*src.pay_in);
+
+      pay_in.seek(src_meta.pay_start);
+
+      for (auto blocks = tfreq / BLOCK_SIZE; blocks; --blocks) {
+        if (features_.payload()) {
+          detail::skip_payload(pay_in);
+        }
+
+        if (features_.offset()) {
+          detail::skip_offsets(pay_in);
+        }
+      }
+
+      meta->pay_start = pay_->out->file_pointer();
+      detail::copy_bytes(
+        pay_in, src_meta.pay_start,
+        pay_in.file_pointer() - src_meta.pay_start, *pay_->out
+      );
+    }
+  }
+
+  return make_state(*meta.release());
+}
+
+index_input& postings_writer::input(const index_input& src) {
+  auto& in = inputs_[&src];
+
+  if (!in) {
+    in = src.reopen(); // thread-safe, the source may be shared with readers
+
+    if (!in) {
+      IR_FRMT_FATAL("Failed to reopen input in: %s", __FUNCTION__);
+
+      throw detailed_io_error("Failed to reopen input");
+    }
+  }
+
+  return *in;
+}
+
 void postings_writer::release(irs::term_meta *meta) NOEXCEPT {
 #ifdef IRESEARCH_DEBUG
   auto* state = dynamic_cast<version10::term_meta*>(meta);
@@ -3995,6 +4810,8 @@ void postings_writer::begin_term() {
 
   doc.last = type_limits<type_t::doc_id_t>::min(); // for proper delta of 1st id
   doc.block_last = type_limits<type_t::doc_id_t>::invalid();
+  doc.block_freq = 0;
+  std::fill_n(doc.skip_freq, MAX_SKIP_LEVELS, 0);
   skip_.reset();
 }
 
@@ -4011,6 +4828,7 @@ void postings_writer::begin_doc(doc_id_t id, const frequency* freq) {
   doc.doc(id - doc.last);
   if (freq) {
     doc.freq(freq->value);
+    doc.block_freq = std::max(doc.block_freq, freq->value);
   }
 
   doc.next(id);
@@ -4081,20 +4899,11 @@ void postings_writer::end_term(version10::term_meta& meta, const uint64_t* tfreq
      * variable length encoding */
     data_output& out = *doc.out;
     for (uint32_t i = 0; i < doc.size; ++i) {
-      const uint32_t doc_delta = doc.deltas[i];
-
-      if (!features_.freq()) {
-        out.write_vint(doc_delta);
-      } else {
-        assert(doc.freqs);
-        const uint32_t freq = doc.freqs[i];
-        if (1 == freq) {
-          out.write_vint(shift_pack_32(doc_delta, true));
-        } else {
-          out.write_vint(shift_pack_32(doc_delta, false));
-          out.write_vlong(freq);
-        }
-      }
+      assert(!features_.freq() || doc.freqs);
+      detail::write_doc(
+        out, uint32_t(doc.deltas[i]),
+        features_.freq() ? doc.freqs.get() + i : nullptr
+      );
     }
   }
 
@@ -4215,6 +5024,19 @@ void postings_writer::write_skip(size_t level, index_output& out) {
       pay_->skip_ptr[level] = pay_ptr;
     }
   }
+
+  if (features_.freq()) {
+    if (0 == level) {
+      // propagate max frequency of the finished block to all levels
+      for (auto& max_freq : doc.skip_freq) {
+        max_freq = std::max(max_freq, doc.block_freq);
+      }
+      doc.block_freq = 0;
+    }
+
+    out.write_vlong(doc.skip_freq[level]);
+    doc.skip_freq[level] = 0;
+  }
 }
 
 void postings_writer::encode(
@@ -4251,6 +5073,8 @@ void postings_writer::encode(
 }
 
 void postings_writer::end() {
+  inputs_.clear(); // release inputs of the copied postings
+
   format_utils::write_footer(*doc.out);
   doc.out.reset(); // ensure stream is closed
 
@@ -4276,7 +5100,7 @@ bool postings_reader::prepare(
   std::string buf;
 
   // prepare document input
-  detail::prepare_input(
+  version_ = detail::prepare_input(
     buf, doc_in_, irs::IOAdvice::RANDOM, state,
     postings_writer::DOC_EXT,
     postings_writer::DOC_FORMAT_NAME,
@@ -4297,8 +5121,7 @@ bool postings_reader::prepare(
       buf, pos_in_, irs::IOAdvice::RANDOM, state,
       postings_writer::POS_EXT,
       postings_writer::POS_FORMAT_NAME,
-      postings_writer::FORMAT_MIN,
-      postings_writer::FORMAT_MAX
+      version_, version_ // all streams must have the same version
     );
 
     // Since terms pos postings too large
@@ -4314,8 +5137,7 @@ bool postings_reader::prepare(
         buf, pay_in_, irs::IOAdvice::RANDOM, state,
         postings_writer::PAY_EXT,
         postings_writer::PAY_FORMAT_NAME,
-        postings_writer::FORMAT_MIN,
-        postings_writer::FORMAT_MAX
+        version_, version_ // all streams must have the same version
       );
 
       // Since terms pos postings too large
@@ -4410,7 +5232,8 @@ doc_iterator::ptr postings_reader::iterator(
 
   it->prepare(
     features, enabled, attrs,
-    doc_in_.get(), pos_in_.get(), pay_in_.get() 
+    doc_in_.get(), pos_in_.get(), pay_in_.get(),
+    version_
   );
 
   return IMPLICIT_MOVE_WORKAROUND(it);
@@ -45,6 +45,7 @@
 #include "utils/type_limits.hpp"
 
 #include <list>
+#include <unordered_map>
 
 #if defined(_MSC_VER)
   #pragma warning(disable : 4244)
@@ -173,7 +174,8 @@ class document_mask_writer final: public iresearch::document_mask_writer {
   static const string_ref FORMAT_NAME;
 
   static const int32_t FORMAT_MIN = 0;
-  static const int32_t FORMAT_MAX = FORMAT_MIN;
+  static const int32_t FORMAT_BITMAP = 1; // mask is stored as a set of containers
+  static const int32_t FORMAT_MAX = FORMAT_BITMAP;
 
   virtual ~document_mask_writer();
   virtual std::string filename(const segment_meta& meta) const override;
@@ -185,6 +187,7 @@ class document_mask_writer final: public iresearch::document_mask_writer {
 private:
   friend document_mask_reader;
   index_output::ptr out_;
+  document_mask mask_; // accumulated mask
 };
 
 /* -------------------------------------------------------------------
@@ -208,8 +211,26 @@ public:
 private:
   uint64_t checksum_{};
   index_input::ptr in_;
+  document_mask mask_; // mask read by 'begin()' (FORMAT_BITMAP only)
+  document_mask::const_iterator it_; // next document in 'mask_'
+  int32_t version_{};
 };
 
+//////////////////////////////////////////////////////////////////////////////
+/// @class raw_postings
+/// @brief location of the encoded postings of a term in the segment files,
+///        valid as long as the doc iterator exposing it
+//////////////////////////////////////////////////////////////////////////////
+struct raw_postings final : irs::raw_postings {
+  const term_meta* meta{}; // term metadata
+  const document* doc{}; // current document of the doc iterator
+  const index_input* doc_in{}; // document stream
+  const index_input* pos_in{}; // positions stream
+  const index_input* pay_in{}; // payload and offsets stream
+  features field; // field features
+  int32_t version{}; // postings format version
+}; // raw_postings
+
 /* -------------------------------------------------------------------
 * postings_writer
 * 
@@ -234,7 +255,9 @@ class IRESEARCH_PLUGIN postings_writer final: public iresearch::postings_writer
   static const string_ref PAY_EXT;
 
   static const int32_t FORMAT_MIN = 0;
-  static const int32_t FORMAT_MAX = FORMAT_MIN;
+  static const int32_t FORMAT_SIMD = 1; // blocks are packed with SIMD friendly layout
+  static const int32_t FORMAT_BLOCK_MAX = 2; // skip entries store max term frequency
+  static const int32_t FORMAT_MAX = FORMAT_BLOCK_MAX;
 
   static const uint32_t MAX_SKIP_LEVELS = 10;
   static const uint32_t BLOCK_SIZE = 128;
@@ -292,7 +315,9 @@ class IRESEARCH_PLUGIN postings_writer final: public iresearch::postings_writer
 
     doc_id_t deltas[BLOCK_SIZE]{}; // document deltas
     doc_id_t skip_doc[MAX_SKIP_LEVELS]{};
+    uint64_t skip_freq[MAX_SKIP_LEVELS]{}; // max frequency since the previous skip entry
     std::unique_ptr<uint64_t[]> freqs; /* document frequencies */
+    uint64_t block_freq{}; // max frequency in a current block
     doc_id_t last{ type_limits<type_t::doc_id_t>::invalid() }; // last buffered document id
     doc_id_t block_last{}; // last document id in a block
     uint32_t size{};            /* number of buffered elements */
@@ -350,6 +375,9 @@ class IRESEARCH_PLUGIN postings_writer final: public iresearch::postings_writer
   void add_position( uint32_t pos, const offset* offs, const payload* pay );
   void end_doc();
   void end_term(version10::term_meta& state, const uint64_t* tfreq);
+  bool copyable(const raw_postings& src, const doc_iterator& docs) const;
+  irs::postings_writer::state copy(doc_iterator& docs, const raw_postings& raw);
+  index_input& input(const index_input& src);
 
   IRESEARCH_API_PRIVATE_VARIABLES_BEGIN
   memory::memory_pool<> meta_pool_;
@@ -361,6 +389,7 @@ class IRESEARCH_PLUGIN postings_writer final: public iresearch::postings_writer
   doc_stream doc;           /* document stream */
   pos_stream::ptr pos_;      /* proximity stream */
   pay_stream::ptr pay_;      /* payloads and offsets stream */
+  std::unordered_map<const index_input*, index_input::ptr> inputs_; // inputs of the copied postings
   uint64_t docs_count{};      /* count of processed documents */
   version10::documents docs_; /* bit set of all processed documents */
   features features_; /* features supported by current field */
@@ -398,6 +427,7 @@ class IRESEARCH_PLUGIN postings_reader final: public iresearch::postings_reader
   index_input::ptr doc_in_;
   index_input::ptr pos_in_;
   index_input::ptr pay_in_;
+  int32_t version_{}; // postings format version
   IRESEARCH_API_PRIVATE_VARIABLES_END
 };
 
@@ -42,7 +42,7 @@
 #include "utils/attributes.hpp"
 #include "utils/string.hpp"
 #include "utils/log.hpp"
-#include "utils/fst_matcher.hpp"
+#include "utils/numeric_utils.hpp"
 
 #if defined(_MSC_VER)
   // NOOP
@@ -62,14 +62,6 @@
   #pragma GCC diagnostic pop
 #endif
 
-#if defined(_MSC_VER)
-  #pragma warning(disable : 4291)
-#elif defined (__GNUC__)
-  // NOOP
-#endif
-
-#include <fst/matcher.h>
-
 #if defined(_MSC_VER)
   #pragma warning(disable : 4244)
   #pragma warning(disable : 4245)
@@ -86,6 +78,7 @@
   // NOOP
 #endif
 
+#include <algorithm>
 #include <cassert>
 
 #if defined (__GNUC__)
@@ -200,7 +193,7 @@ inline void prepare_output(
   format_utils::write_header(*out, format, version);
 }
 
-inline void prepare_input(
+inline int32_t prepare_input(
     std::string& str,
     index_input::ptr& in,
     irs::IOAdvice advice,
@@ -227,7 +220,7 @@ inline void prepare_input(
     *checksum = format_utils::checksum(*in);
   }
 
-  format_utils::check_header(*in, format, min_ver, max_ver);
+  return format_utils::check_header(*in, format, min_ver, max_ver);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -252,6 +245,161 @@ class fst_buffer : public vector_byte_fst {
   }
 }; // fst_buffer
 
+///////////////////////////////////////////////////////////////////////////////
+/// @brief writes the specified FST in a layout which may be traversed
+///        directly from an index_input without materialization:
+///          state: vint final weight size, final weight, vlong arcs count,
+///                 sorted arc labels, 32-bit offsets of the arc records
+///                 relative to the end of the offsets table, arc records
+///          arc record: vlong target state, vint weight size, weight
+///        states are addressed by their offsets in the output and are
+///        written in post-order, i.e. targets always precede the arcs
+/// @returns offset of the start state
+///////////////////////////////////////////////////////////////////////////////
+uint64_t write_compact_fst(const vector_byte_fst& fst, index_output& out) {
+  typedef vector_byte_fst::StateId stateid_t;
+  typedef fst::ArcIterator<vector_byte_fst> arc_iterator_t;
+
+  static const uint64_t UNDEFINED = integer_traits<uint64_t>::const_max;
+
+  const uint64_t base = out.file_pointer();
+  std::vector<uint64_t> offsets(fst.NumStates(), UNDEFINED);
+  std::vector<std::pair<stateid_t, size_t>> stack; // state + next arc to visit
+
+  stack.emplace_back(fst.Start(), 0);
+
+  while (!stack.empty()) {
+    const stateid_t state = stack.back().first;
+    const size_t arcs_count = fst.NumArcs(state);
+
+    // visit targets first
+    if (stack.back().second < arcs_count) {
+      arc_iterator_t it(fst, state);
+      it.Seek(stack.back().second++);
+
+      const stateid_t next = it.Value().nextstate;
+
+      if (UNDEFINED == offsets[next]) {
+        stack.emplace_back(next, 0);
+      }
+
+      continue;
+    }
+
+    offsets[state] = out.file_pointer() - base;
+
+    const auto final = fst.Final(state);
+    write_string(out, final.c_str(), final.Size());
+    out.write_vlong(arcs_count);
+
+    for (arc_iterator_t it(fst, state); !it.Done(); it.Next()) {
+      assert(it.Value().ilabel <= integer_traits<byte_type>::const_max);
+      out.write_byte(byte_type(it.Value().ilabel));
+    }
+
+    uint32_t record_offset = 0;
+
+    for (arc_iterator_t it(fst, state); !it.Done(); it.Next()) {
+      const auto& arc = it.Value();
+      const uint64_t target = offsets[arc.nextstate];
+      assert(UNDEFINED != target);
+
+      out.write_int(record_offset);
+      record_offset += uint32_t(
+        bytes_io<uint64_t>::vsize(target)
+        + bytes_io<uint32_t>::vsize(uint32_t(arc.weight.Size()))
+        + arc.weight.Size()
+      );
+    }
+
+    for (arc_iterator_t it(fst, state); !it.Done(); it.Next()) {
+      const auto& arc = it.Value();
+      out.write_vlong(offsets[arc.nextstate]);
+      write_string(out, arc.weight.c_str(), arc.weight.Size());
+    }
+
+    stack.pop_back();
+  }
+
+  return offsets[fst.Start()];
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// @class fst_cursor
+/// @brief traverses FST written by 'write_compact_fst' directly from its
+///        serialized representation, states are addressed by their offsets
+///////////////////////////////////////////////////////////////////////////////
+class fst_cursor {
+ public:
+  typedef uint64_t stateid_t;
+
+  struct arc {
+    stateid_t nextstate;
+    byte_weight weight;
+  }; // arc
+
+  void reset(const bytes_ref& data, stateid_t start) NOEXCEPT {
+    data_ = data;
+    start_ = start;
+  }
+
+  explicit operator bool() const NOEXCEPT { return !data_.null(); }
+
+  stateid_t start() const NOEXCEPT { return start_; }
+
+  // reads final weight of the specified state
+  // returns number of outgoing arcs
+  size_t final_weight(stateid_t state, byte_weight& weight) const {
+    assert(state < data_.size());
+    const byte_type* in = data_.c_str() + state;
+    read_weight(in, weight);
+    return irs::vread<uint64_t>(in);
+  }
+
+  // returns false if the specified state has no arc with the given label
+  bool find(stateid_t state, byte_type label, arc& arc) const {
+    assert(state < data_.size());
+    const byte_type* in = data_.c_str() + state;
+
+    // skip final weight
+    const size_t weight_size = irs::vread<uint32_t>(in);
+    in += weight_size;
+
+    const size_t arcs_count = irs::vread<uint64_t>(in);
+    const byte_type* labels_end = in + arcs_count;
+    const byte_type* it = std::lower_bound(in, labels_end, label);
+
+    if (it == labels_end || *it != label) {
+      return false;
+    }
+
+    const byte_type* table = labels_end;
+    const byte_type* entry = table + sizeof(uint32_t)*size_t(it - in);
+    const uint32_t record_offset = irs::read<uint32_t>(entry);
+    in = table + sizeof(uint32_t)*arcs_count + record_offset;
+
+    arc.nextstate = irs::vread<uint64_t>(in);
+    read_weight(in, arc.weight);
+
+    return true;
+  }
+
+ private:
+  static void read_weight(const byte_type*& in, byte_weight& weight) {
+    const size_t size = irs::vread<uint32_t>(in);
+
+    weight.Clear();
+
+    if (size) {
+      weight.PushBack(in, in + size);
+      in += size;
+    }
+  }
+
+  bytes_ref data_; // serialized FST
+  stateid_t start_{};
+}; // fst_cursor
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                              entry implementation
 // -----------------------------------------------------------------------------
@@ -410,6 +558,44 @@ class block_iterator : util::noncopyable {
   bool leaf_{ false }; /* current block is leaf block */
 };
 
+///////////////////////////////////////////////////////////////////////////////
+/// @class point_doc_iterator
+/// @brief passes postings of a term through to the postings writer, while
+///        adding them as points with the term value to the point tree
+///////////////////////////////////////////////////////////////////////////////
+class point_doc_iterator final : public irs::doc_iterator {
+ public:
+  point_doc_iterator(irs::doc_iterator& it, bkd::point_tree_writer& out) NOEXCEPT
+    : it_(&it), out_(&out) {
+  }
+
+  virtual const irs::attribute_view& attributes() const NOEXCEPT override {
+    return it_->attributes();
+  }
+
+  virtual doc_id_t value() const override {
+    return it_->value();
+  }
+
+  virtual bool next() override {
+    if (!it_->next()) {
+      return false;
+    }
+
+    out_->add(it_->value());
+    return true;
+  }
+
+  virtual doc_id_t seek(doc_id_t target) override {
+    while (value() < target && next()) { }
+    return value();
+  }
+
+ private:
+  irs::doc_iterator* it_;
+  bkd::point_tree_writer* out_;
+}; // point_doc_iterator
+
 ///////////////////////////////////////////////////////////////////////////////
 /// @struct cookie
 ///////////////////////////////////////////////////////////////////////////////
@@ -475,14 +661,10 @@ class term_iterator : public iresearch::seek_term_iterator {
   index_input& terms_input() const;
 
  private:
-  typedef term_reader::fst_t fst_t;
-  typedef fst::SortedMatcher<fst_t> sorted_matcher_t;
-  typedef fst::explicit_matcher<sorted_matcher_t> matcher_t; // avoid implicit loops
-
   friend class block_iterator;
 
   struct arc {
-    typedef fst_byte_builder::stateid_t stateid_t;
+    typedef fst_cursor::stateid_t stateid_t;
 
     arc() : block{} { }
 
@@ -522,6 +704,8 @@ class term_iterator : public iresearch::seek_term_iterator {
    * common bytes */ 
   SeekResult seek_equal(const bytes_ref& term);
 
+  fst_cursor& fst() const;
+
   inline block_iterator* pop_block() {
     block_stack_.pop_back();
     return &block_stack_.back();
@@ -539,7 +723,7 @@ class term_iterator : public iresearch::seek_term_iterator {
   }
 
   const term_reader* owner_;
-  matcher_t matcher_;
+  mutable fst_cursor fst_; // cursor over the terms index of the field
   irs::attribute_view attrs_;
   seek_state_t sstate_;
   block_stack_t block_stack_;
@@ -886,7 +1070,6 @@ void block_iterator::reset() {
 
 term_iterator::term_iterator(const term_reader* owner)
   : owner_(owner),
-    matcher_(*owner->fst_, fst::MATCH_INPUT),
     attrs_(2), // version10::term_meta + frequency
     cur_block_(nullptr) {
   assert(owner_);
@@ -910,8 +1093,10 @@ bool term_iterator::next() {
   if (!cur_block_) {
     if (term_.empty()) {
       /* iterator at the beginning */
-      const auto& fst = *owner_->fst_;
-      cur_block_ = push_block(fst.Final(fst.Start()), 0);
+      auto& fst = this->fst();
+      byte_weight weight;
+      fst.final_weight(fst.start(), weight);
+      cur_block_ = push_block(std::move(weight), 0);
       cur_block_->load();
     } else {
       // seek to the term with the specified state was called from
@@ -1022,14 +1207,12 @@ ptrdiff_t term_iterator::seek_cached(
 }
 
 SeekResult term_iterator::seek_equal(const bytes_ref& term) {
-  assert(owner_->fst_);
+  typedef byte_weight weight_t;
 
-  typedef fst_t::Weight weight_t;
-
-  const auto& fst = *owner_->fst_;
+  auto& fst = this->fst();
 
   size_t prefix = 0; // number of current symbol to process
-  arc::stateid_t state = fst.Start(); // start state
+  arc::stateid_t state = fst.start(); // start state
   weight_.Clear(); // clear aggregated fst output
 
   if (cur_block_) {
@@ -1042,26 +1225,29 @@ SeekResult term_iterator::seek_equal(const bytes_ref& term) {
       return SeekResult::FOUND;
     }
   } else {
-    cur_block_ = push_block(fst.Final(state), prefix);
+    byte_weight weight;
+    fst.final_weight(state, weight);
+    cur_block_ = push_block(std::move(weight), prefix);
   }
 
   term_.oversize(term.size());
   term_.reset(prefix); /* reset to common seek prefix */
   sstate_.resize(prefix); /* remove invalid cached arcs */
 
-  bool found = fst_byte_builder::final != state;
+  // state without outgoing arcs is the final one, 'find' fails on it
+  fst_cursor::arc arc;
+  byte_weight weight;
+  bool found = true;
   while (found && prefix < term.size()) {
-    matcher_.SetState(state);
-    if (found = matcher_.Find(term[prefix])) {
-      const auto& arc = matcher_.Value();
-      term_ += byte_type(arc.ilabel);
+    if (found = fst.find(state, term[prefix], arc)) {
+      term_ += term[prefix];
       fst_utils::append(weight_, arc.weight);
       ++prefix;
 
-      const auto weight = fst.Final(state = arc.nextstate);
+      const size_t arcs_count = fst.final_weight(state = arc.nextstate, weight);
       if (weight_t::One() != weight && weight_t::Zero() != weight) {
         cur_block_ = push_block(fst::Times(weight_, weight), prefix);
-      } else if (fst_byte_builder::final == state) {
+      } else if (!arcs_count) {
         cur_block_ = push_block(std::move(weight_), prefix);
         found = false;
       }
@@ -1137,6 +1323,14 @@ doc_iterator::ptr term_iterator::postings(const flags& features) const {
   return pr.iterator(field.features, attrs_, features);
 }
 
+fst_cursor& term_iterator::fst() const {
+  if (!fst_) {
+    fst_.reset(owner_->fst(), owner_->fst_start_);
+  }
+
+  return fst_;
+}
+
 index_input& term_iterator::terms_input() const {
   if (!terms_in_) {
     terms_in_ = owner_->owner_->terms_in_->reopen();
@@ -1162,7 +1356,10 @@ term_reader::term_reader(term_reader&& rhs) NOEXCEPT
     doc_freq_(rhs.doc_freq_),
     term_freq_(rhs.term_freq_),
     field_(std::move(rhs.field_)),
-    fst_(rhs.fst_),
+    fst_data_(std::move(rhs.fst_data_)),
+    fst_mapped_(rhs.fst_mapped_),
+    fst_start_(rhs.fst_start_),
+    points_(std::move(rhs.points_)),
     owner_(rhs.owner_) {
   min_term_ref_ = min_term_;
   max_term_ref_ = max_term_;
@@ -1172,24 +1369,21 @@ term_reader::term_reader(term_reader&& rhs) NOEXCEPT
   rhs.doc_count_ = 0;
   rhs.doc_freq_ = 0;
   rhs.term_freq_ = 0;
-  rhs.fst_ = nullptr;
+  rhs.fst_mapped_ = bytes_ref::NIL;
+  rhs.fst_start_ = 0;
   rhs.owner_ = nullptr;
 }
 
-term_reader::~term_reader() {
-  delete fst_;
-}
-
 seek_term_iterator::ptr term_reader::iterator() const {
   return seek_term_iterator::make<detail::term_iterator>( this );
 }
   
 bool term_reader::prepare(
-    std::istream& in, 
+    index_input& meta_in,
     const feature_map_t& feature_map,
-    field_reader& owner) {
+    field_reader& owner,
+    int32_t version) {
   // read field metadata
-  index_input& meta_in = *static_cast<input_buf*>(in.rdbuf());
   field_.name = read_string<std::string>(meta_in);
 
   if (!read_field_features(meta_in, feature_map, field_.features)) {
@@ -1210,9 +1404,51 @@ bool term_reader::prepare(
     attrs_.emplace(freq_);
   }
 
-  // read fst
-  fst_ = fst_t::Read(in, fst::FstReadOptions());
-  assert(fst_);
+  if (version >= field_writer::FORMAT_POINTS) {
+    points_.prepare(meta_in);
+  }
+
+  if (version >= field_writer::FORMAT_COMPACT_FST) {
+    // fst is traversed directly from its serialized representation,
+    // in place if the terms index is mapped, otherwise from a heap copy
+    const size_t size = meta_in.read_vlong();
+    fst_start_ = meta_in.read_vlong();
+
+    const byte_type* data = meta_in.read_buffer(size);
+
+    if (data) {
+      fst_mapped_ = bytes_ref(data, size);
+    } else {
+      fst_data_.resize(size);
+
+      if (size != meta_in.read_bytes(&(fst_data_[0]), size)) {
+        IR_FRMT_ERROR("Failed to read fst for field: %s", field_.name.c_str());
+        return false;
+      }
+    }
+  } else {
+    // convert legacy fst into the compact layout
+    input_buf isb(&meta_in);
+    std::istream in(&isb); // wrap stream to be OpenFST compliant
+    std::unique_ptr<vector_byte_fst> fst(
+      vector_byte_fst::Read(in, fst::FstReadOptions())
+    );
+
+    if (!fst) {
+      IR_FRMT_ERROR("Failed to read fst for field: %s", field_.name.c_str());
+      return false;
+    }
+
+    memory_output out;
+    fst_start_ = write_compact_fst(*fst, out.stream);
+    out.stream.flush();
+
+    bytes_output data(out.file.length());
+    out.file >> data;
+
+    const bytes_ref ref = data;
+    fst_data_.assign(ref.c_str(), ref.size());
+  }
 
   owner_ = &owner;
   return true;
@@ -1459,15 +1695,18 @@ field_writer::field_writer(
     iresearch::postings_writer::ptr&& pw,
     bool volatile_state,
     uint32_t min_block_size,
-    uint32_t max_block_size)
+    uint32_t max_block_size,
+    int32_t version)
   : pw(std::move(pw)),
     fst_buf_(memory::make_unique<detail::fst_buffer>()),
     prefixes(DEFAULT_SIZE, 0),
     term_count(0),
     min_block_size(min_block_size),
     max_block_size(max_block_size),
+    version_(version),
     volatile_state_(volatile_state) {
   assert(this->pw);
+  assert(version >= FORMAT_MIN && version <= FORMAT_MAX);
   assert(min_block_size > 1);
   assert(min_block_size <= max_block_size);
   assert(2 * (min_block_size - 1) <= max_block_size);
@@ -1489,12 +1728,15 @@ void field_writer::prepare( const iresearch::flush_state& state ) {
 
   // prepare terms and index output
   std::string str;
-  detail::prepare_output(str, terms_out, state, TERMS_EXT, FORMAT_TERMS, FORMAT_MAX);
-  detail::prepare_output(str, index_out, state, TERMS_INDEX_EXT, FORMAT_TERMS_INDEX, FORMAT_MAX);
+  detail::prepare_output(str, terms_out, state, TERMS_EXT, FORMAT_TERMS, version_);
+  detail::prepare_output(str, index_out, state, TERMS_INDEX_EXT, FORMAT_TERMS_INDEX, version_);
   write_segment_features(*index_out, *state.features);
 
   // prepare postings writer
   pw->prepare(*terms_out, state);
+
+  // points file is created on demand
+  points_.prepare(state);
 }
 
 void field_writer::write(
@@ -1509,12 +1751,24 @@ void field_writer::write(
   uint64_t sum_tfreq = 0;
 
   const bool freq_exists = features.check<frequency>();
+  const bool points_exist = version_ >= FORMAT_POINTS && features.check<point_index>();
+  const bool granular = features.check<granularity_prefix>();
   auto& docs = pw->attributes().get<version10::documents>();
   assert(docs);
 
   for (; terms.next();) {
     auto postings = terms.postings(features);
-    auto meta = pw->write(*postings);
+    irs::postings_writer::state meta;
+
+    if (points_exist && (!granular || numeric_utils::exact(terms.value()))) {
+      // index the most precise values as points as well
+      detail::point_doc_iterator points(*postings, points_);
+
+      points_.begin_value(terms.value());
+      meta = pw->write(points);
+    } else {
+      meta = pw->write(*postings);
+    }
 
     if (freq_exists) {
       sum_tfreq += meta->freq;
@@ -1568,6 +1822,7 @@ void field_writer::begin_field(const iresearch::flags& field) {
   term_count = 0;
 
   pw->begin_field(field);
+  points_.begin_field();
 }
 
 void field_writer::write_segment_features(data_output& out, const flags& features) {
@@ -1630,10 +1885,25 @@ void field_writer::end_field(
     index_out->write_vlong(total_term_freq);
   }
 
-  // write fst
-  output_buf isb(index_out.get()); // wrap stream to be OpenFST compliant
-  std::ostream os(&isb);
-  fst.Write(os, fst::FstWriteOptions());
+  if (version_ >= FORMAT_POINTS) {
+    // write points, empty tree for fields without 'point_index'
+    points_.end_field(*index_out);
+  }
+
+  if (version_ >= FORMAT_COMPACT_FST) {
+    // write fst in a layout readers traverse without deserializing it
+    const uint64_t start = write_compact_fst(fst, fst_out_.stream);
+    fst_out_.stream.flush();
+    index_out->write_vlong(fst_out_.stream.file_pointer());
+    index_out->write_vlong(start);
+    fst_out_.file >> *index_out;
+    fst_out_.reset();
+  } else {
+    // write fst in the legacy OpenFST layout
+    output_buf isb(index_out.get());
+    std::ostream os(&isb);
+    fst.Write(os, fst::FstWriteOptions());
+  }
 
   stack.clear();
   ++fields_count;
@@ -1646,6 +1916,9 @@ void field_writer::end() {
   // finish postings
   pw->end();
 
+  // finish points
+  points_.end();
+
   format_utils::write_footer(*terms_out);
   terms_out.reset(); // ensure stream is closed
 
@@ -1681,21 +1954,35 @@ bool field_reader::prepare(
   state.dir = &dir;
   state.meta = &meta;
 
-  // check index header 
+  // check index header, since FORMAT_COMPACT_FST FSTs of the fields are
+  // traversed in place if the term index is mapped (heap copy otherwise)
   index_input::ptr index_in;
-
   int64_t checksum = 0;
 
-  detail::prepare_input(
+  const int32_t version = detail::prepare_input(
     str, index_in,
-    irs::IOAdvice::SEQUENTIAL | irs::IOAdvice::READONCE, state,
+    irs::IOAdvice::RANDOM | irs::IOAdvice::WILLNEED, state,
     field_writer::TERMS_INDEX_EXT,
     field_writer::FORMAT_TERMS_INDEX,
     field_writer::FORMAT_MIN,
-    field_writer::FORMAT_MAX,
-    &checksum
+    field_writer::FORMAT_MAX
   );
 
+  if (version < field_writer::FORMAT_COMPACT_FST) {
+    // legacy term index is read once, converted and verified as a whole
+    index_in.reset();
+
+    detail::prepare_input(
+      str, index_in,
+      irs::IOAdvice::SEQUENTIAL | irs::IOAdvice::READONCE, state,
+      field_writer::TERMS_INDEX_EXT,
+      field_writer::FORMAT_TERMS_INDEX,
+      field_writer::FORMAT_MIN,
+      field_writer::FORMAT_MAX,
+      &checksum
+    );
+  }
+
   if (!detail::read_segment_features(*index_in, feature_map, features)) {
     return false;
   }
@@ -1711,15 +1998,18 @@ bool field_reader::prepare(
 
     fields_count = index_in->read_long();
 
-    // check index checksum
-    format_utils::check_footer(*index_in, checksum);
+    if (version >= field_writer::FORMAT_COMPACT_FST) {
+      // it is too expensive to verify checksum of the entire
+      // term index on every open, perform cheap error detection
+      validate_footer(*index_in);
+    } else {
+      // check index checksum
+      format_utils::check_footer(*index_in, checksum);
+    }
 
     index_in->seek(ptr);
   }
 
-  input_buf isb(index_in.get());
-  std::istream input(&isb); // wrap stream to be OpenFST compliant
-
   // read terms for each indexed field
   fields_.reserve(fields_count);
   name_to_field_.reserve(fields_count);
@@ -1727,7 +2017,7 @@ bool field_reader::prepare(
     fields_.emplace_back();
     auto& field = fields_.back();
 
-    if (!field.prepare(input, feature_map, *this)) {
+    if (!field.prepare(*index_in, feature_map, *this, version)) {
       fields_.pop_back(); // remove inconsistent field
       return false;
     }
@@ -1753,13 +2043,50 @@ bool field_reader::prepare(
       return lhs.meta().name < rhs.meta().name;
   }));
 
+  const bool fst_mapped = std::any_of(
+    fields_.begin(), fields_.end(),
+    [](const detail::term_reader& field) { return !field.fst_mapped_.null(); }
+  );
+
+  if (fst_mapped) {
+    index_in_ = std::move(index_in); // keep mapping of the FSTs alive
+  }
+
+  //-----------------------------------------------------------------
+  // prepare points input
+  //-----------------------------------------------------------------
+
+  const bool points_exist = std::any_of(
+    fields_.begin(), fields_.end(),
+    [](const detail::term_reader& field) { return !field.points_.empty(); }
+  );
+
+  if (points_exist) {
+    // leaves are accessed randomly by the point queries
+    detail::prepare_input(
+      str, points_in_, irs::IOAdvice::RANDOM, state,
+      bkd::point_tree_writer::POINTS_EXT,
+      bkd::point_tree_writer::FORMAT_POINTS,
+      bkd::point_tree_writer::FORMAT_MIN,
+      bkd::point_tree_writer::FORMAT_MAX
+    );
+
+    // perform cheap error detection as for the terms dictionary
+    format_utils::read_checksum(*points_in_);
+
+    for (auto& field : fields_) {
+      field.points_.bind(points_in_.get());
+    }
+  }
+
   //-----------------------------------------------------------------
   // prepare terms input
   //-----------------------------------------------------------------
 
-  // check term header
+  // check term header, term blocks are accessed randomly by every
+  // query, so read the dictionary ahead of the first lookups
   detail::prepare_input(
-    str, terms_in_, irs::IOAdvice::RANDOM, state,
+    str, terms_in_, irs::IOAdvice::RANDOM | irs::IOAdvice::WILLNEED, state,
     field_writer::TERMS_EXT,
     field_writer::FORMAT_TERMS,
     field_writer::FORMAT_MIN,
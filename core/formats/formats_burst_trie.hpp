@@ -26,6 +26,7 @@
 
 #include "formats.hpp"
 #include "formats_10_attributes.hpp"
+#include "point_tree.hpp"
 #include "index/field_meta.hpp"
 
 #include "store/data_output.hpp"
@@ -236,12 +237,12 @@ class term_reader : public iresearch::term_reader,
  public:
   term_reader() = default;
   term_reader(term_reader&& rhs) NOEXCEPT;
-  virtual ~term_reader();
 
   bool prepare(
-    std::istream& in,
+    index_input& in,
     const feature_map_t& features,
-    field_reader& owner
+    field_reader& owner,
+    int32_t version
   );
 
   virtual seek_term_iterator::ptr iterator() const override;
@@ -253,10 +254,13 @@ class term_reader : public iresearch::term_reader,
   virtual const irs::attribute_view& attributes() const NOEXCEPT override {
     return attrs_; 
   }
+  virtual const irs::point_reader* points() const override {
+    return points_.empty() ? nullptr : &points_;
+  }
 
  private:
-  typedef fst::VectorFst<byte_arc> fst_t;
   friend class term_iterator;
+  friend class burst_trie::field_reader;
 
   irs::attribute_view attrs_;
   bstring min_term_;
@@ -269,7 +273,14 @@ class term_reader : public iresearch::term_reader,
   uint64_t term_freq_;
   frequency freq_; // total term freq
   field_meta field_;
-  fst_t* fst_; // TODO: use compact fst here!!!
+  bytes_ref fst() const NOEXCEPT {
+    return fst_mapped_.null() ? bytes_ref(fst_data_) : fst_mapped_;
+  }
+
+  bstring fst_data_; // FST in the compact layout if the terms index isn't mapped (converted for versions before FORMAT_COMPACT_FST)
+  bytes_ref fst_mapped_; // FST within the mapped terms index, null if kept in 'fst_data_'
+  uint64_t fst_start_{}; // offset of the FST start state within fst()
+  bkd::point_tree_reader points_; // points of the field (FORMAT_POINTS only)
   field_reader* owner_;
 }; // term_reader
 
@@ -278,10 +289,12 @@ NS_END // detail
 ///////////////////////////////////////////////////////////////////////////////
 /// @class field_writer
 ///////////////////////////////////////////////////////////////////////////////
-class field_writer final : public iresearch::field_writer {
+class IRESEARCH_PLUGIN field_writer final : public iresearch::field_writer {
  public:
   static const int32_t FORMAT_MIN = 0;
-  static const int32_t FORMAT_MAX = FORMAT_MIN;
+  static const int32_t FORMAT_COMPACT_FST = 1; // FST is written in a layout traversed without deserialization
+  static const int32_t FORMAT_POINTS = 2; // exact values are indexed in a block KD-tree
+  static const int32_t FORMAT_MAX = FORMAT_POINTS;
   static const uint32_t DEFAULT_MIN_BLOCK_SIZE = 25;
   static const uint32_t DEFAULT_MAX_BLOCK_SIZE = 48;
 
@@ -293,7 +306,8 @@ class field_writer final : public iresearch::field_writer {
   field_writer(iresearch::postings_writer::ptr&& pw,
                bool volatile_state,
                uint32_t min_block_size = DEFAULT_MIN_BLOCK_SIZE,
-               uint32_t max_block_size = DEFAULT_MAX_BLOCK_SIZE);
+               uint32_t max_block_size = DEFAULT_MAX_BLOCK_SIZE,
+               int32_t version = FORMAT_MAX); // version of the written format
 
   virtual void prepare( const iresearch::flush_state& state ) override;
   virtual void end() override;
@@ -344,8 +358,10 @@ class field_writer final : public iresearch::field_writer {
   irs::index_output::ptr terms_out; /* output stream for terms */
   irs::index_output::ptr index_out; /* output stream for indexes*/
   irs::postings_writer::ptr pw; /* postings writer */
+  bkd::point_tree_writer points_; // points of the fields with 'point_index'
   std::vector< detail::entry > stack;
   std::unique_ptr<detail::fst_buffer> fst_buf_; // pimpl buffer used for building FST for fields
+  irs::memory_output fst_out_; // compact FST of the current field
   detail::volatile_byte_ref last_term; // last pushed term
   std::vector<size_t> prefixes;
   std::pair<bool, detail::volatile_byte_ref> min_term; // current min term in a block
@@ -354,6 +370,7 @@ class field_writer final : public iresearch::field_writer {
   size_t fields_count{};
   uint32_t min_block_size;
   uint32_t max_block_size;
+  const int32_t version_;
   const bool volatile_state_;
 }; // field_writer
 
@@ -376,12 +393,15 @@ class field_reader final : public iresearch::field_reader {
 
  private:
   friend class detail::term_iterator;
+  friend class detail::term_reader;
 
   std::vector<detail::term_reader> fields_;
   std::unordered_map<hashed_string_ref, term_reader*> name_to_field_;
   std::vector<const detail::term_reader*> fields_mask_;
   iresearch::postings_reader::ptr pr_;
   iresearch::index_input::ptr terms_in_;
+  iresearch::index_input::ptr index_in_; // mapped terms index, FSTs of the fields point into it
+  iresearch::index_input::ptr points_in_; // points (FORMAT_POINTS only)
 }; // field_reader
 
 NS_END // burst_trie
@@ -0,0 +1,323 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Andrey Abramov
+/// @author Vasiliy Nabatchikov
+////////////////////////////////////////////////////////////////////////////////
+
+#include "point_tree.hpp"
+#include "format_utils.hpp"
+#include "error/error.hpp"
+#include "index/file_names.hpp"
+#include "store/store_utils.hpp"
+#include "utils/bitset.hpp"
+#include "utils/log.hpp"
+
+#include <algorithm>
+#include <sstream>
+
+NS_LOCAL
+
+size_t common_prefix(const irs::bstring& lhs, const irs::bstring& rhs) {
+  const auto size = std::min(lhs.size(), rhs.size());
+  size_t i = 0;
+
+  while (i < size && lhs[i] == rhs[i]) {
+    ++i;
+  }
+
+  return i;
+}
+
+NS_END
+
+NS_ROOT
+NS_BEGIN(bkd)
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                  point_tree_writer implementation
+// -----------------------------------------------------------------------------
+
+const string_ref point_tree_writer::FORMAT_POINTS = "block_kd_tree_points";
+const string_ref point_tree_writer::POINTS_EXT = "pt";
+
+void point_tree_writer::prepare(const flush_state& state) {
+  dir_ = state.dir;
+  segment_ = state.name;
+  out_.reset(); // points file is created on demand
+  begin_field();
+}
+
+void point_tree_writer::begin_field() {
+  leaves_.clear();
+  keys_.reset();
+  docs_.reset();
+  value_.clear();
+  last_.clear();
+  last_doc_ = 0;
+  run_ = 0;
+  count_ = 0;
+}
+
+void point_tree_writer::begin_value(const bytes_ref& value) {
+  end_run();
+  value_.assign(value.c_str(), value.size());
+}
+
+void point_tree_writer::add(doc_id_t doc) {
+  if (!run_) {
+    start_run();
+  }
+
+  write_zvlong(docs_.stream, int64_t(doc) - int64_t(last_doc_));
+  last_doc_ = doc;
+  ++run_;
+
+  if (++count_ == LEAF_SIZE) {
+    flush_leaf();
+  }
+}
+
+void point_tree_writer::start_run() {
+  if (!count_) {
+    // first run of the leaf, keys are prefix encoded within a leaf only
+    leaves_.emplace_back();
+    leaves_.back().min = value_;
+    last_.clear();
+    last_doc_ = 0;
+  }
+
+  const auto shared = common_prefix(last_, value_);
+
+  keys_.stream.write_vlong(shared);
+  write_string(keys_.stream, value_.c_str() + shared, value_.size() - shared);
+  last_ = value_;
+}
+
+void point_tree_writer::end_run() {
+  if (run_) {
+    keys_.stream.write_vlong(run_);
+    run_ = 0;
+  }
+}
+
+void point_tree_writer::flush_leaf() {
+  end_run();
+
+  if (!count_) {
+    // nothing to flush
+    return;
+  }
+
+  if (!out_) {
+    std::string str;
+    file_name(str, segment_, POINTS_EXT);
+    out_ = dir_->create(str);
+
+    if (!out_) {
+      std::stringstream ss;
+
+      ss << "Failed to create file, path: " << str;
+
+      throw detailed_io_error(ss.str());
+    }
+
+    format_utils::write_header(*out_, FORMAT_POINTS, FORMAT_MAX);
+  }
+
+  auto& leaf = leaves_.back();
+  leaf.max = last_;
+  leaf.offset = out_->file_pointer();
+  leaf.count = count_;
+
+  keys_.stream.flush();
+  out_->write_vlong(keys_.stream.file_pointer());
+  keys_.file >> *out_;
+  keys_.reset();
+
+  docs_.stream.flush();
+  docs_.file >> *out_;
+  docs_.reset();
+
+  count_ = 0;
+}
+
+void point_tree_writer::end_field(data_output& out) {
+  flush_leaf();
+
+  out.write_vlong(leaves_.size());
+
+  uint64_t offset = 0;
+
+  for (auto& leaf : leaves_) {
+    write_string(out, leaf.min);
+    write_string(out, leaf.max);
+    out.write_vlong(leaf.offset - offset);
+    out.write_vlong(leaf.count);
+    offset = leaf.offset;
+  }
+
+  begin_field();
+}
+
+void point_tree_writer::end() {
+  if (out_) {
+    format_utils::write_footer(*out_);
+    out_.reset(); // ensure stream is closed
+  }
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                  point_tree_reader implementation
+// -----------------------------------------------------------------------------
+
+point_tree_reader::point_tree_reader(point_tree_reader&& rhs) NOEXCEPT
+  : leaves_(std::move(rhs.leaves_)),
+    size_(rhs.size_),
+    in_(rhs.in_) {
+  if (!leaves_.empty()) {
+    min_ = leaves_.front().min;
+    max_ = leaves_.back().max;
+  }
+
+  rhs.min_ = bytes_ref::NIL;
+  rhs.max_ = bytes_ref::NIL;
+  rhs.size_ = 0;
+  rhs.in_ = nullptr;
+}
+
+void point_tree_reader::prepare(data_input& in) {
+  leaves_.resize(in.read_vlong());
+  size_ = 0;
+
+  uint64_t offset = 0;
+
+  for (auto& leaf : leaves_) {
+    leaf.min = read_string<bstring>(in);
+    leaf.max = read_string<bstring>(in);
+    offset += in.read_vlong();
+    leaf.offset = offset;
+    leaf.count = in.read_vlong();
+    size_ += leaf.count;
+  }
+
+  if (!leaves_.empty()) {
+    min_ = leaves_.front().min;
+    max_ = leaves_.back().max;
+  }
+}
+
+uint64_t point_tree_reader::visit(
+    const bytes_ref& min, bool min_inclusive,
+    const bytes_ref& max, bool max_inclusive,
+    bitset& docs) const {
+  // value satisfies the lower bound
+  auto above = [&min, min_inclusive](const bytes_ref& value) {
+    return min.null() || (min_inclusive ? !(value < min) : min < value);
+  };
+
+  // value satisfies the upper bound
+  auto below = [&max, max_inclusive](const bytes_ref& value) {
+    return max.null() || (max_inclusive ? !(max < value) : value < max);
+  };
+
+  // leaves are sorted by both bounds, skip leaves below the range
+  auto leaf = std::partition_point(
+    leaves_.begin(), leaves_.end(),
+    [&above](const leaf_meta& leaf) { return !above(leaf.max); }
+  );
+
+  if (leaf == leaves_.end() || !below(leaf->min)) {
+    // nothing to visit
+    return 0;
+  }
+
+  assert(in_);
+  auto in = in_->reopen();
+
+  if (!in) {
+    IR_FRMT_FATAL("Failed to reopen points input in: %s", __FUNCTION__);
+
+    throw detailed_io_error("Failed to reopen points input");
+  }
+
+  std::vector<std::pair<bool, uint64_t>> runs; // matched, points count
+  bstring key;
+  uint64_t matched = 0;
+
+  for (auto end = leaves_.end(); leaf != end && below(leaf->min); ++leaf) {
+    in->seek(leaf->offset);
+
+    const uint64_t keys_size = in->read_vlong();
+    doc_id_t doc = 0;
+
+    if (above(leaf->min) && below(leaf->max)) {
+      // whole leaf is within the range, skip keys
+      in->seek(in->file_pointer() + keys_size);
+
+      for (uint64_t i = 0; i < leaf->count; ++i) {
+        doc = doc_id_t(doc + read_zvlong(*in));
+        docs.set(doc);
+      }
+
+      matched += leaf->count;
+      continue;
+    }
+
+    // leaf crosses the range bounds, check each run of equal values
+    runs.clear();
+    key.clear();
+
+    for (uint64_t count = 0; count < leaf->count;) {
+      key.resize(in->read_vlong());
+
+      const auto suffix = read_string<bstring>(*in);
+      key += suffix;
+
+      const uint64_t run = in->read_vlong();
+      const bytes_ref value = key;
+
+      runs.emplace_back(above(value) && below(value), run);
+      count += run;
+    }
+
+    for (auto& run : runs) {
+      for (uint64_t i = 0; i < run.second; ++i) {
+        doc = doc_id_t(doc + read_zvlong(*in));
+
+        if (run.first) {
+          docs.set(doc);
+        }
+      }
+
+      if (run.first) {
+        matched += run.second;
+      }
+    }
+  }
+
+  return matched;
+}
+
+NS_END // bkd
+NS_END // ROOT
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                       END-OF-FILE
+// -----------------------------------------------------------------------------
@@ -0,0 +1,144 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Andrey Abramov
+/// @author Vasiliy Nabatchikov
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef IRESEARCH_POINT_TREE_H
+#define IRESEARCH_POINT_TREE_H
+
+#include "formats.hpp"
+#include "store/memory_directory.hpp"
+#include "utils/noncopyable.hpp"
+
+NS_ROOT
+NS_BEGIN(bkd)
+
+////////////////////////////////////////////////////////////////////////////////
+/// @struct leaf_meta
+/// @brief in-memory description of a leaf block of a point tree
+////////////////////////////////////////////////////////////////////////////////
+struct leaf_meta {
+  bstring min; // least significant value in a leaf
+  bstring max; // most significant value in a leaf
+  uint64_t offset; // offset of a leaf in the points file
+  uint64_t count; // number of points in a leaf
+}; // leaf_meta
+
+////////////////////////////////////////////////////////////////////////////////
+/// @class point_tree_writer
+/// @brief writes block KD-trees over the values of the fields, points are
+///        expected in ascending order of the values, i.e. in the order of the
+///        terms of a field, and are packed into the leaf blocks of up to
+///        'LEAF_SIZE' points
+///
+/// Leaf layout (points file):
+///   keys size (vlong)
+///   keys: [ shared prefix (vlong), suffix (string), points count (vlong) ]*
+///   docs: [ doc delta (zvlong) ]*
+///
+/// Tree layout (terms index, per field):
+///   leaves count (vlong)
+///   leaves: [ min (string), max (string), offset delta (vlong), count (vlong) ]*
+///
+/// @note values are one-dimensional, thus the tree degenerates into sorted
+///       leaf blocks, the inner nodes are implicit and are traversed by the
+///       binary search over the leaf bounds held in memory by the reader
+////////////////////////////////////////////////////////////////////////////////
+class point_tree_writer : util::noncopyable {
+ public:
+  static const string_ref FORMAT_POINTS;
+  static const string_ref POINTS_EXT;
+  static const int32_t FORMAT_MIN = 0;
+  static const int32_t FORMAT_MAX = FORMAT_MIN;
+  static const size_t LEAF_SIZE = 512;
+
+  void prepare(const flush_state& state);
+
+  void begin_field();
+
+  // starts points with the specified value
+  void begin_value(const bytes_ref& value);
+
+  // adds point with the current value
+  void add(doc_id_t doc);
+
+  // flushes pending points and writes tree of the field into 'out'
+  void end_field(data_output& out);
+
+  void end();
+
+ private:
+  void start_run();
+  void end_run();
+  void flush_leaf();
+
+  std::vector<leaf_meta> leaves_; // leaves of the current field
+  memory_output keys_; // keys of the current leaf
+  memory_output docs_; // docs of the current leaf
+  index_output::ptr out_; // created on demand
+  directory* dir_{};
+  std::string segment_;
+  bstring value_; // current value
+  bstring last_; // last value written to the current leaf
+  doc_id_t last_doc_{}; // last document written to the current leaf
+  uint64_t run_{}; // number of points in the current run
+  uint64_t count_{}; // number of points in the current leaf
+}; // point_tree_writer
+
+////////////////////////////////////////////////////////////////////////////////
+/// @class point_tree_reader
+/// @brief reads block KD-tree of a field written by 'point_tree_writer'
+////////////////////////////////////////////////////////////////////////////////
+class point_tree_reader final : public irs::point_reader {
+ public:
+  point_tree_reader() = default;
+  point_tree_reader(point_tree_reader&& rhs) NOEXCEPT;
+
+  // reads tree of a field from the terms index
+  void prepare(data_input& in);
+
+  // binds tree to the points file
+  void bind(const index_input* in) NOEXCEPT { in_ = in; }
+
+  bool empty() const NOEXCEPT { return leaves_.empty(); }
+
+  virtual uint64_t size() const override { return size_; }
+  virtual const bytes_ref& (min)() const override { return min_; }
+  virtual const bytes_ref& (max)() const override { return max_; }
+
+  virtual uint64_t visit(
+    const bytes_ref& min, bool min_inclusive,
+    const bytes_ref& max, bool max_inclusive,
+    bitset& docs
+  ) const override;
+
+ private:
+  std::vector<leaf_meta> leaves_;
+  bytes_ref min_{ bytes_ref::NIL };
+  bytes_ref max_{ bytes_ref::NIL };
+  uint64_t size_{};
+  const index_input* in_{};
+}; // point_tree_reader
+
+NS_END // bkd
+NS_END // ROOT
+
+#endif // IRESEARCH_POINT_TREE_H
@@ -177,13 +177,19 @@ class directory_reader_impl :
     return dir_;
   }
 
+  const block_cache::ptr& cache() const NOEXCEPT {
+    return cache_;
+  }
+
   // open a new directory reader
   // if codec == nullptr then use the latest file for all known codecs
   // if cached != nullptr then try to reuse its segments
+  // if cache != nullptr then use it for columnstore blocks
   static composite_reader::ptr open(
     const directory& dir,
     const format* codec = nullptr,
-    const composite_reader::ptr& cached = nullptr
+    const composite_reader::ptr& cached = nullptr,
+    const block_cache::ptr& cache = nullptr
   );
 
  private:
@@ -191,10 +197,12 @@ class directory_reader_impl :
   typedef std::vector<segment_file_refs_t> reader_file_refs_t;
 
   const directory& dir_;
+  block_cache::ptr cache_;
   reader_file_refs_t file_refs_;
 
   directory_reader_impl(
     const directory& dir,
+    const block_cache::ptr& cache,
     reader_file_refs_t&& file_refs,
     index_meta&& meta,
     ctxs_t&& ctxs,
@@ -225,8 +233,9 @@ directory_reader& directory_reader::operator=(
 
 /*static*/ directory_reader directory_reader::open(
     const directory& dir,
-    format::ptr codec /*= nullptr*/) {
-  return directory_reader_impl::open(dir, codec.get());
+    format::ptr codec /*= nullptr*/,
+    const block_cache::ptr& cache /*= nullptr*/) {
+  return directory_reader_impl::open(dir, codec.get(), nullptr, cache);
 }
 
 directory_reader directory_reader::reopen(
@@ -241,7 +250,7 @@ directory_reader directory_reader::reopen(
 #endif
 
   return directory_reader_impl::open(
-    reader_impl.dir(), codec.get(), impl
+    reader_impl.dir(), codec.get(), impl, reader_impl.cache()
   );
 }
 
@@ -251,6 +260,7 @@ directory_reader directory_reader::reopen(
 
 directory_reader_impl::directory_reader_impl(
     const directory& dir,
+    const block_cache::ptr& cache,
     reader_file_refs_t&& file_refs,
     index_meta&& meta,
     ctxs_t&& ctxs,
@@ -258,13 +268,15 @@ directory_reader_impl::directory_reader_impl(
     uint64_t docs_max)
   : composite_reader_impl(std::move(meta), std::move(ctxs), docs_count, docs_max),
     dir_(dir),
+    cache_(cache),
     file_refs_(std::move(file_refs)) {
 }
 
 /*static*/ composite_reader::ptr directory_reader_impl::open(
     const directory& dir,
     const format* codec /*= nullptr*/,
-    const composite_reader::ptr& cached /*= nullptr*/) {
+    const composite_reader::ptr& cached /*= nullptr*/,
+    const block_cache::ptr& cache /*= nullptr*/) {
   index_meta meta;
   index_file_refs::ref_t meta_file_ref = load_newest_index_meta(meta, dir, codec);
 
@@ -316,7 +328,7 @@ directory_reader_impl::directory_reader_impl(
       ctx.reader = (*cached_impl)[itr->second].reopen(segment);
       reuse_candidates.erase(itr);
     } else {
-      ctx.reader = segment_reader::open(dir, segment);
+      ctx.reader = segment_reader::open(dir, segment, cache);
     }
 
     if (!ctx.reader) {
@@ -339,6 +351,7 @@ directory_reader_impl::directory_reader_impl(
     directory_reader_impl,
     reader,
     dir,
+    cache,
     std::move(file_refs),
     std::move(meta),
     std::move(ctxs),
@@ -87,10 +87,13 @@ class IRESEARCH_API directory_reader final
   ////////////////////////////////////////////////////////////////////////////////
   /// @brief create an index reader over the specified directory
   ///        if codec == nullptr then use the latest file for all known codecs
+  ///        if cache != nullptr then columnstore blocks of all segments are
+  ///        kept in the specified shared cache (also used by reopened readers)
   ////////////////////////////////////////////////////////////////////////////////
   static directory_reader open(
     const directory& dir,
-    format::ptr codec = nullptr
+    format::ptr codec = nullptr,
+    const block_cache::ptr& cache = nullptr
   );
 
   ////////////////////////////////////////////////////////////////////////////////
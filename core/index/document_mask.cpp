@@ -0,0 +1,292 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2016 by EMC Corporation, All Rights Reserved
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is EMC Corporation
+///
+/// @author Andrey Abramov
+/// @author Vasiliy Nabatchikov
+////////////////////////////////////////////////////////////////////////////////
+
+#include "document_mask.hpp"
+#include "utils/math_utils.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+NS_LOCAL
+
+typedef irs::document_mask::word_t word_t;
+
+FORCE_INLINE size_t word_index(uint16_t value) NOEXCEPT {
+  return value / irs::bits_required<word_t>();
+}
+
+FORCE_INLINE word_t word_mask(uint16_t value) NOEXCEPT {
+  return word_t(1) << (value % irs::bits_required<word_t>());
+}
+
+NS_END
+
+NS_ROOT
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                        document_mask::container
+// -----------------------------------------------------------------------------
+
+document_mask::container::container(
+    uint64_t key,
+    std::vector<uint16_t>&& array)
+  : array_(std::move(array)),
+    key_(key),
+    size_(array_.size()) {
+  assert(std::is_sorted(array_.begin(), array_.end()));
+  assert(size_ <= ARRAY_MAX);
+}
+
+document_mask::container::container(
+    uint64_t key,
+    std::vector<word_t>&& bitmap)
+  : bitmap_(std::move(bitmap)),
+    key_(key),
+    size_(0) {
+  assert(BITMAP_WORDS == bitmap_.size());
+
+  for (auto word : bitmap_) {
+    size_ += math::math_traits<word_t>::pop(word);
+  }
+}
+
+bool document_mask::container::contains(uint16_t value) const NOEXCEPT {
+  if (is_bitmap()) {
+    return 0 != (bitmap_[word_index(value)] & word_mask(value));
+  }
+
+  return std::binary_search(array_.begin(), array_.end(), value);
+}
+
+bool document_mask::container::insert(uint16_t value) {
+  if (is_bitmap()) {
+    auto& word = bitmap_[word_index(value)];
+    const auto mask = word_mask(value);
+
+    if (word & mask) {
+      return false; // already present
+    }
+
+    word |= mask;
+    ++size_;
+
+    return true;
+  }
+
+  const auto it = std::lower_bound(array_.begin(), array_.end(), value);
+
+  if (it != array_.end() && *it == value) {
+    return false; // already present
+  }
+
+  if (array_.size() >= ARRAY_MAX) {
+    to_bitmap(); // bitmap is smaller than array
+
+    return insert(value);
+  }
+
+  array_.insert(it, value);
+  ++size_;
+
+  return true;
+}
+
+void document_mask::container::reserve() {
+  if (is_bitmap()) {
+    return; // bitmap insertions never allocate
+  }
+
+  if (array_.size() >= ARRAY_MAX) {
+    to_bitmap();
+  } else {
+    array_.reserve(array_.size() + 1);
+  }
+}
+
+void document_mask::container::to_bitmap() {
+  assert(!is_bitmap());
+
+  std::vector<word_t> bitmap(BITMAP_WORDS, 0);
+
+  for (auto value : array_) {
+    bitmap[word_index(value)] |= word_mask(value);
+  }
+
+  bitmap_ = std::move(bitmap);
+  std::vector<uint16_t>().swap(array_); // release memory
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                   document_mask::const_iterator
+// -----------------------------------------------------------------------------
+
+document_mask::const_iterator::const_iterator(
+    const container* begin,
+    const container* end) NOEXCEPT
+  : container_(begin), end_(end) {
+  if (container_ != end_) {
+    word_ = container_->is_bitmap() ? container_->bitmap().front() : 0;
+    next();
+  }
+}
+
+bool document_mask::const_iterator::next_in_container() NOEXCEPT {
+  const auto& c = *container_;
+  const doc_id_t base = c.key() << CONTAINER_BITS;
+
+  if (!c.is_bitmap()) {
+    if (pos_ >= c.array().size()) {
+      return false;
+    }
+
+    value_ = base | c.array()[pos_++];
+
+    return true;
+  }
+
+  // skip empty words
+  while (!word_) {
+    if (++pos_ >= BITMAP_WORDS) {
+      return false;
+    }
+
+    word_ = c.bitmap()[pos_];
+  }
+
+  const auto bit = math::math_traits<word_t>::ctz(word_);
+  word_ &= word_ - 1; // clear lowest set bit
+  value_ = base | (pos_ * bits_required<word_t>() + bit);
+
+  return true;
+}
+
+void document_mask::const_iterator::next() NOEXCEPT {
+  while (container_ != end_) {
+    if (next_in_container()) {
+      return;
+    }
+
+    // advance to the next container
+    pos_ = 0;
+
+    if (++container_ != end_) {
+      word_ = container_->is_bitmap() ? container_->bitmap().front() : 0;
+    }
+  }
+
+  word_ = 0;
+  value_ = 0; // same as end()
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                   document_mask
+// -----------------------------------------------------------------------------
+
+document_mask::document_mask(document_mask&& rhs) NOEXCEPT
+  : containers_(std::move(rhs.containers_)),
+    size_(rhs.size_) {
+  rhs.size_ = 0;
+}
+
+document_mask& document_mask::operator=(document_mask&& rhs) NOEXCEPT {
+  if (this != &rhs) {
+    containers_ = std::move(rhs.containers_);
+    size_ = rhs.size_;
+    rhs.size_ = 0;
+  }
+
+  return *this;
+}
+
+const document_mask::container* document_mask::find(
+    uint64_t key) const NOEXCEPT {
+  const auto it = std::lower_bound(
+    containers_.begin(), containers_.end(), key,
+    [](const container& lhs, uint64_t rhs) {
+      return lhs.key() < rhs;
+  });
+
+  return it == containers_.end() || it->key() != key ? nullptr : &*it;
+}
+
+document_mask::container& document_mask::emplace(uint64_t key) {
+  // fast path for documents added in ascending order
+  if (containers_.empty() || containers_.back().key() < key) {
+    containers_.emplace_back(key);
+
+    return containers_.back();
+  }
+
+  const auto it = std::lower_bound(
+    containers_.begin(), containers_.end(), key,
+    [](const container& lhs, uint64_t rhs) {
+      return lhs.key() < rhs;
+  });
+
+  if (it != containers_.end() && it->key() == key) {
+    return *it;
+  }
+
+  return *containers_.emplace(it, key);
+}
+
+bool document_mask::contains(doc_id_t doc) const NOEXCEPT {
+  const auto* container = find(key(doc));
+
+  return container && container->contains(low(doc));
+}
+
+bool document_mask::insert(doc_id_t doc) {
+  if (!emplace(key(doc)).insert(low(doc))) {
+    return false;
+  }
+
+  ++size_;
+
+  return true;
+}
+
+void document_mask::reserve(doc_id_t doc) {
+  auto& container = emplace(key(doc));
+
+  if (!container.contains(low(doc))) {
+    container.reserve();
+  }
+}
+
+void document_mask::push_back(container&& value) {
+  assert(containers_.empty() || containers_.back().key() < value.key());
+
+  size_ += value.size();
+  containers_.emplace_back(std::move(value));
+}
+
+bool document_mask::operator==(const document_mask& rhs) const NOEXCEPT {
+  return size_ == rhs.size_ && std::equal(begin(), end(), rhs.begin());
+}
+
+NS_END
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                       END-OF-FILE
+// -----------------------------------------------------------------------------
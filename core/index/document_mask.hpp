@@ -0,0 +1,223 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2016 by EMC Corporation, All Rights Reserved
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is EMC Corporation
+///
+/// @author Andrey Abramov
+/// @author Vasiliy Nabatchikov
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef IRESEARCH_DOCUMENT_MASK_H
+#define IRESEARCH_DOCUMENT_MASK_H
+
+#include "shared.hpp"
+#include "types.hpp"
+#include "utils/bit_utils.hpp"
+
+#include <iterator>
+#include <vector>
+
+NS_ROOT
+
+////////////////////////////////////////////////////////////////////////////////
+/// @class document_mask
+/// @brief a compressed set of document identifiers (e.g. removed documents)
+///        the identifier space is split into the chunks of 2^16 documents,
+///        each chunk is stored in a separate container which is either a
+///        sorted array of the low 16 bits (sparse chunks) or a bitmap
+///        (dense chunks)
+////////////////////////////////////////////////////////////////////////////////
+class IRESEARCH_API document_mask {
+ public:
+  typedef uint64_t word_t;
+
+  static const size_t CONTAINER_BITS = 16; // number of low bits stored in container
+  static const size_t CONTAINER_DOCS = size_t(1) << CONTAINER_BITS; // max number of docs in container
+  static const size_t BITMAP_WORDS = CONTAINER_DOCS / bits_required<word_t>(); // number of words in bitmap
+  static const size_t ARRAY_MAX = BITMAP_WORDS * sizeof(word_t) / sizeof(uint16_t); // max docs in array container
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @class container
+  /// @brief a set of documents sharing the same high bits
+  //////////////////////////////////////////////////////////////////////////////
+  class IRESEARCH_API container {
+   public:
+    explicit container(uint64_t key = 0) NOEXCEPT
+      : key_(key) {
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief creates an array container from the sorted low bits
+    ////////////////////////////////////////////////////////////////////////////
+    container(uint64_t key, std::vector<uint16_t>&& array);
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief creates a bitmap container of 'BITMAP_WORDS' words
+    ////////////////////////////////////////////////////////////////////////////
+    container(uint64_t key, std::vector<word_t>&& bitmap);
+
+    // high bits of the documents stored in container
+    uint64_t key() const NOEXCEPT { return key_; }
+
+    // number of documents stored in container
+    size_t size() const NOEXCEPT { return size_; }
+
+    bool is_bitmap() const NOEXCEPT { return !bitmap_.empty(); }
+
+    // sorted low bits of the documents, valid if !is_bitmap()
+    const std::vector<uint16_t>& array() const NOEXCEPT { return array_; }
+
+    // bitmap of the documents, valid if is_bitmap()
+    const std::vector<word_t>& bitmap() const NOEXCEPT { return bitmap_; }
+
+    bool contains(uint16_t value) const NOEXCEPT;
+    bool insert(uint16_t value);
+
+    // ensure subsequent 'insert' will not allocate memory
+    void reserve();
+
+   private:
+    void to_bitmap();
+
+    std::vector<uint16_t> array_;
+    std::vector<word_t> bitmap_;
+    uint64_t key_;
+    size_t size_{};
+  }; // container
+
+  typedef std::vector<container> containers_t;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @class const_iterator
+  /// @brief iterates over the documents in ascending order, bitmaps are
+  ///        traversed word-at-a-time
+  //////////////////////////////////////////////////////////////////////////////
+  class IRESEARCH_API const_iterator
+      : public std::iterator<std::forward_iterator_tag, doc_id_t, ptrdiff_t, const doc_id_t*, const doc_id_t&> {
+   public:
+    const_iterator() = default;
+
+    const doc_id_t& operator*() const NOEXCEPT { return value_; }
+    const doc_id_t* operator->() const NOEXCEPT { return &value_; }
+
+    const_iterator& operator++() NOEXCEPT {
+      next();
+      return *this;
+    }
+
+    const_iterator operator++(int) NOEXCEPT {
+      const auto tmp = *this;
+      next();
+      return tmp;
+    }
+
+    bool operator==(const const_iterator& rhs) const NOEXCEPT {
+      return container_ == rhs.container_ && value_ == rhs.value_;
+    }
+
+    bool operator!=(const const_iterator& rhs) const NOEXCEPT {
+      return !(*this == rhs);
+    }
+
+   private:
+    friend class document_mask;
+
+    const_iterator(
+      const container* begin,
+      const container* end
+    ) NOEXCEPT;
+
+    void next() NOEXCEPT;
+    bool next_in_container() NOEXCEPT;
+
+    const container* container_{};
+    const container* end_{};
+    size_t pos_{}; // position in array or current word in bitmap
+    word_t word_{}; // remaining bits of the current word
+    doc_id_t value_{};
+  }; // const_iterator
+
+  document_mask() = default;
+  document_mask(document_mask&& rhs) NOEXCEPT;
+  document_mask(const document_mask&) = default;
+  document_mask& operator=(document_mask&& rhs) NOEXCEPT;
+  document_mask& operator=(const document_mask&) = default;
+
+  const_iterator begin() const NOEXCEPT {
+    return const_iterator(
+      containers_.data(), containers_.data() + containers_.size()
+    );
+  }
+
+  const_iterator end() const NOEXCEPT {
+    const auto* end = containers_.data() + containers_.size();
+    return const_iterator(end, end);
+  }
+
+  bool contains(doc_id_t doc) const NOEXCEPT;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @returns true if the specified document wasn't in the mask
+  //////////////////////////////////////////////////////////////////////////////
+  bool insert(doc_id_t doc);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief ensure subsequent insertion of the specified document will not
+  ///        allocate memory (i.e. will not throw)
+  //////////////////////////////////////////////////////////////////////////////
+  void reserve(doc_id_t doc);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief appends a container, keys must be appended in ascending order
+  //////////////////////////////////////////////////////////////////////////////
+  void push_back(container&& value);
+
+  void clear() NOEXCEPT {
+    containers_.clear();
+    size_ = 0;
+  }
+
+  const containers_t& containers() const NOEXCEPT { return containers_; }
+  bool empty() const NOEXCEPT { return 0 == size_; }
+  size_t size() const NOEXCEPT { return size_; }
+
+  bool operator==(const document_mask& rhs) const NOEXCEPT;
+  bool operator!=(const document_mask& rhs) const NOEXCEPT {
+    return !(*this == rhs);
+  }
+
+ private:
+  static uint64_t key(doc_id_t doc) NOEXCEPT {
+    return doc >> CONTAINER_BITS;
+  }
+
+  static uint16_t low(doc_id_t doc) NOEXCEPT {
+    return uint16_t(doc);
+  }
+
+  const container* find(uint64_t key) const NOEXCEPT;
+  container& emplace(uint64_t key);
+
+  IRESEARCH_API_PRIVATE_VARIABLES_BEGIN
+  containers_t containers_; // sorted by key
+  size_t size_{}; // total number of documents
+  IRESEARCH_API_PRIVATE_VARIABLES_END
+}; // document_mask
+
+NS_END
+
+#endif
@@ -264,13 +264,12 @@ class term_iterator : public irs::term_iterator {
  public:
   void reset(const field_data& field, const bytes_ref*& min, const bytes_ref*& max) {
     // refill postings
-    postings_.clear();
-    postings_.insert(field.terms_.begin(), field.terms_.end());
+    field.terms_.sort(postings_);
 
     max = min = &irs::bytes_ref::NIL;
     if (!postings_.empty()) {
-      min = &(postings_.begin()->first);
-      max = &((--postings_.end())->first);
+      min = &(postings_.front()->first);
+      max = &(postings_.back()->first);
     }
 
     // set field
@@ -298,7 +297,7 @@ class term_iterator : public irs::term_iterator {
     REGISTER_TIMER_DETAILED();
     assert(itr_ != postings_.end());
 
-    const irs::posting& posting = itr_->second;
+    const irs::posting& posting = (*itr_)->second;
 
     // where the term's data starts
     auto ptr = field_->int_writer_->parent().seek(posting.int_start);
@@ -330,7 +329,7 @@ class term_iterator : public irs::term_iterator {
     }
 
     itr_increment_ = true;
-    term_ = itr_->first;
+    term_ = (*itr_)->first;
 
     return true;
   }
@@ -340,20 +339,10 @@ class term_iterator : public irs::term_iterator {
   }
 
  private:
-  struct utf8_less_t {
-    bool operator()(const bytes_ref& lhs, const bytes_ref& rhs) const {
-      return utf8_less(lhs.c_str(), lhs.size(), rhs.c_str(), rhs.size());
-    }
-  };
-
-  typedef std::map<
-    bytes_ref,
-    std::reference_wrapper<const posting>,
-    utf8_less_t
-  > map_t;
+  typedef std::vector<const postings::value_type*> postings_t;
 
-  map_t postings_;
-  map_t::iterator itr_{ postings_.end() };
+  postings_t postings_;
+  postings_t::const_iterator itr_{ postings_.end() };
   irs::bytes_ref term_;
   const field_data* field_;
   mutable detail::doc_iterator doc_itr_;
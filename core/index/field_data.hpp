@@ -73,6 +73,9 @@ class IRESEARCH_API field_data : util::noncopyable {
   // returns number of terms in a field within a document
   size_t size() const { return len_; }
 
+  // returns number of bytes allocated for the term dictionary of a field
+  size_t memory() const { return terms_.memory(); }
+
   const field_meta& meta() const { return meta_; }
 
   data_output& norms(columnstore_writer& writer);
@@ -132,6 +135,13 @@ class IRESEARCH_API fields_data: util::noncopyable {
     return *this;
   }
   const flags& features() { return features_; }
+
+  // returns number of bytes of the block pools occupied by the inverted data
+  size_t memory() const {
+    return byte_writer_.pool_offset()
+      + int_writer_.pool_offset() * sizeof(int_block_pool::value_type);
+  }
+
   void flush(field_writer& fw, flush_state& state);
   void reset();
 
@@ -93,6 +93,10 @@ struct IRESEARCH_API sub_reader : index_reader {
   // returns iterator over the live documents in current segment
   virtual docs_iterator_t::ptr docs_iterator() const = 0;
 
+  // returns identifier unique to the current state (i.e. document mask) of the
+  // segment, 0 if the state can't be identified
+  virtual uint64_t id() const NOEXCEPT { return 0; }
+
   virtual field_iterator::ptr fields() const = 0;
 
   virtual doc_iterator::ptr mask(doc_iterator::ptr&& it) const {
@@ -27,10 +27,12 @@
 #include "formats/format_utils.hpp"
 #include "utils/directory_utils.hpp"
 #include "utils/index_utils.hpp"
+#include "utils/log.hpp"
 #include "utils/timer_utils.hpp"
 #include "utils/type_limits.hpp"
 #include "index_writer.hpp"
 
+#include <algorithm>
 #include <list>
 
 NS_LOCAL
@@ -92,6 +94,8 @@ const std::string index_writer::WRITE_LOCK_NAME = "write.lock";
 
 index_writer::flush_context::flush_context():
   generation_(0),
+  flush_pending_(nullptr),
+  memory_(0),
   writers_pool_(THREAD_COUNT) {
 }
 
@@ -99,6 +103,9 @@ void index_writer::flush_context::reset() {
   consolidation_policies_.clear();
   generation_.store(0);
   dir_->clear_refs();
+  flushed_segments_.clear();
+  flush_pending_.store(nullptr);
+  memory_.store(0);
   modification_queries_.clear();
   pending_segments_.clear();
   segment_mask_.clear();
@@ -113,15 +120,19 @@ index_writer::index_writer(
     directory& dir,
     format::ptr codec,
     index_meta&& meta,
-    committed_state_t&& committed_state
+    committed_state_t&& committed_state,
+    async_utils::thread_pool* pool
 ) NOEXCEPT:
     codec_(codec),
     committed_state_(std::move(committed_state)),
     dir_(dir),
+    merge_dir_(dir, IOAdvice::DIRECT), // merge streams through candidates once
     flush_context_pool_(2), // 2 because just swap them due to common commit lock
     meta_(std::move(meta)),
     writer_(codec->get_index_meta_writer()),
-    write_lock_(std::move(lock)) {
+    write_lock_(std::move(lock)),
+    memory_limit_(0),
+    pool_(pool) {
   assert(codec);
   flush_context_.store(&flush_context_pool_[0]);
 
@@ -169,7 +180,11 @@ void index_writer::clear() {
   meta_.segments_.clear(); // noexcept op (clear after finish(), to match reset of pending_state_ inside finish(), allows recovery on clear() failure)
 }
 
-index_writer::ptr index_writer::make(directory& dir, format::ptr codec, OPEN_MODE mode) {
+index_writer::ptr index_writer::make(
+    directory& dir,
+    format::ptr codec,
+    OPEN_MODE mode,
+    async_utils::thread_pool* pool /*= nullptr*/) {
   // lock the directory
   auto lock = dir.make_lock(WRITE_LOCK_NAME);
 
@@ -228,7 +243,8 @@ index_writer::ptr index_writer::make(directory& dir, format::ptr codec, OPEN_MOD
     std::move(lock), 
     dir, codec,
     std::move(meta),
-    std::move(comitted_state)
+    std::move(comitted_state),
+    pool
   );
 
   directory_utils::remove_all_unreferenced(dir); // remove non-index files from directory
@@ -310,7 +326,7 @@ bool index_writer::add_document_mask_modified_records(
       // if indexed doc_id was not add()ed after the request for modification
       // and doc_id not already masked then mark query as seen and segment as modified
       if (mod.generation >= min_doc_id_generation &&
-          docs_mask.insert(doc).second) {
+          docs_mask.insert(doc)) {
         assert(meta.live_docs_count);
         --meta.live_docs_count; // decrement count of live docs
         mod.seen = true;
@@ -322,9 +338,10 @@ bool index_writer::add_document_mask_modified_records(
   return modified;
 }
 
+template<typename Segment>
 bool index_writer::add_document_mask_modified_records(
   modification_requests_t& modification_queries,
-  segment_writer& writer,
+  Segment& writer,
   segment_meta& meta
 ) {
   if (modification_queries.empty()) {
@@ -380,9 +397,10 @@ bool index_writer::add_document_mask_modified_records(
   return modified;
 }
 
+template<typename Segment>
 /* static */ bool index_writer::add_document_mask_unused_updates(
     modification_requests_t& modification_queries,
-    segment_writer& writer,
+    Segment& writer,
     segment_meta& meta
 ) {
   UNUSED(meta);
@@ -419,6 +437,37 @@ bool index_writer::add_document_mask_modified_records(
   return modified;
 }
 
+template<typename Segment>
+bool index_writer::flush_document_mask(
+    flush_context& ctx,
+    Segment& writer,
+    index_meta::index_segment_t& segment,
+    std::unordered_set<string_ref>& to_sync) {
+  // if have a writer with potential update-replacement records then check if they were seen
+  add_document_mask_unused_updates(
+    ctx.modification_queries_, writer, segment.meta
+  );
+
+  auto& docs_mask = writer.docs_mask();
+
+  // mask empty segments
+  if (docs_mask.size() == segment.meta.docs_count) {
+    ctx.segment_mask_.emplace(writer.name()); // ref to writer name will not change
+    return false;
+  }
+
+  // write non-empty document mask
+  if (!docs_mask.empty()) {
+    write_document_mask(*(ctx.dir_), segment.meta, docs_mask);
+    segment.filename = write_segment_meta(*(ctx.dir_), segment.meta); // write with new mask
+  }
+
+  // add files from segment to list of files to sync
+  to_sync.insert(segment.meta.files.begin(), segment.meta.files.end());
+
+  return true;
+}
+
 bool index_writer::add_segment_mask_consolidated_records(
     index_meta::index_segment_t& segment,
     directory& dir,
@@ -426,11 +475,33 @@ bool index_writer::add_segment_mask_consolidated_records(
     const index_meta::index_segments_t& segments, // candidates to consider
     const consolidation_acceptor_t& acceptor // functr dictating which segments to consider
 ) {
-  REGISTER_TIMER_DETAILED();
   std::vector<segment_reader> merge_candidates;
-  const index_meta::index_segment_t* merge_candindate_default = nullptr;
   flush_context::segment_mask_t segment_mask;
 
+  if (!get_consolidation_candidates(merge_candidates, segment_mask, segments, acceptor)) {
+    return false; // nothing to merge
+  }
+
+  segment.meta.name = file_name(meta_.increment()); // increment active meta, not fn arg
+
+  if (!merge_segments(segment, dir, merge_candidates)) {
+    return false; // import failure (no files created, nothing to clean up)
+  }
+
+  segments_mask.insert(segment_mask.begin(), segment_mask.end());
+
+  return true;
+}
+
+bool index_writer::get_consolidation_candidates(
+    std::vector<segment_reader>& merge_candidates,
+    flush_context::segment_mask_t& segment_mask,
+    const index_meta::index_segments_t& segments, // candidates to consider
+    const consolidation_acceptor_t& acceptor // functr dictating which segments to consider
+) {
+  REGISTER_TIMER_DETAILED();
+  const index_meta::index_segment_t* merge_candindate_default = nullptr;
+
   // find merge candidates
   for (auto& seg: segments) {
     if (!acceptor(seg.meta)) {
@@ -438,7 +509,7 @@ bool index_writer::add_segment_mask_consolidated_records(
       continue; // fill min threshold not reached
     }
 
-    auto merge_candidate = get_segment_reader(seg.meta);
+    auto merge_candidate = segment_reader::open(merge_dir_, seg.meta);
 
     if (!merge_candidate) {
       continue; // skip empty readers
@@ -458,7 +529,7 @@ bool index_writer::add_segment_mask_consolidated_records(
         return false; // no reason to consolidate a segment without any masked documents
       }
     } else { // if only one merge candidate and another segment available then merge with other
-      auto merge_candidate = get_segment_reader(merge_candindate_default->meta);
+      auto merge_candidate = segment_reader::open(merge_dir_, merge_candindate_default->meta);
 
       if (!merge_candidate) {
         return false; // failed to open segment and nothing else to merge with
@@ -469,9 +540,16 @@ bool index_writer::add_segment_mask_consolidated_records(
     }
   }
 
+  return true;
+}
+
+bool index_writer::merge_segments(
+    index_meta::index_segment_t& segment,
+    directory& dir,
+    const std::vector<segment_reader>& merge_candidates
+) {
   REGISTER_TIMER_DETAILED();
   segment.meta.codec = codec_;
-  segment.meta.name = file_name(meta_.increment()); // increment active meta, not fn arg
 
   merge_writer merge_writer(dir, segment.meta.name);
 
@@ -479,13 +557,7 @@ bool index_writer::add_segment_mask_consolidated_records(
     merge_writer.add(merge_candidate);
   }
 
-  if (!merge_writer.flush(segment.filename, segment.meta)) {
-    return false; // import failure (no files created, nothing to clean up)
-  }
-
-  segments_mask.insert(segment_mask.begin(), segment_mask.end());
-
-  return true;
+  return merge_writer.flush(segment.filename, segment.meta);
 }
 
 void index_writer::consolidate(
@@ -493,45 +565,86 @@ void index_writer::consolidate(
 ) {
   if (immediate) {
     REGISTER_TIMER_DETAILED();
-    auto meta = committed_state_.first;
     index_meta::index_segment_t segment;
-    std::unordered_map<string_ref, const segment_meta*> segment_candidates;
-    SCOPED_LOCK(commit_lock_); // ensure meta_ segments are not modified by concurrent consolidate()/commit()
-    auto ctx = get_flush_context(); // can modify ctx->segment_mask_ without lock since have commit_lock_
+    std::vector<segment_reader> merge_candidates;
+    flush_context::segment_mask_t segment_mask;
+    committed_state_t::first_type meta;
+    flush_context::ptr ctx;
 
-    for (auto& seg: meta_) {
-      if (ctx->segment_mask_.end() == ctx->segment_mask_.find(seg.meta.name)) {
-        segment_candidates.emplace(seg.meta.name, &(seg.meta));
-      }
-    }
+    {
+      SCOPED_LOCK(commit_lock_); // ensure meta_ segments are not modified by concurrent consolidate()/commit()
+      std::unordered_map<string_ref, const segment_meta*> segment_candidates;
 
-    auto acceptor = policy(*(ctx->dir_), *meta);
-    consolidation_acceptor_t acceptor_wrapper = [&acceptor, &segment_candidates](
-      const segment_meta& meta
-    )->bool {
-      auto itr = segment_candidates.find(meta.name);
+      meta = committed_state_.first;
+      ctx = get_flush_context();
 
-      return segment_candidates.end() != itr
-          && meta.version == itr->second->version
-          && acceptor(meta)
-          ;
-    };
+      SCOPED_LOCK(ctx->mutex_); // guard ctx->segment_mask_ against concurrent consolidations
+
+      for (auto& seg: meta_) {
+        if (ctx->segment_mask_.end() == ctx->segment_mask_.find(seg.meta.name)) {
+          segment_candidates.emplace(seg.meta.name, &(seg.meta));
+        }
+      }
+
+      auto acceptor = policy(*(ctx->dir_), *meta);
+      consolidation_acceptor_t acceptor_wrapper = [&acceptor, &segment_candidates](
+        const segment_meta& meta
+      )->bool {
+        auto itr = segment_candidates.find(meta.name);
 
-    // for immediate consolidate consider only comitted segments that are still unmodified in current meta
-    if (add_segment_mask_consolidated_records(segment, *(ctx->dir_), ctx->segment_mask_, meta->segments_, acceptor_wrapper)) {
-      consolidation_policy_t meta_ref = [meta](const directory&, const index_meta&)->consolidation_acceptor_t {
-        return [](const segment_meta&)->bool { return false; };
+        return segment_candidates.end() != itr
+            && meta.version == itr->second->version
+            && acceptor(meta)
+            ;
       };
 
+      // for immediate consolidate consider only comitted segments that are still unmodified in current meta
+      if (!get_consolidation_candidates(merge_candidates, segment_mask, meta->segments_, acceptor_wrapper)) {
+        return; // nothing to merge
+      }
+
+      // reserve the candidates, so concurrent consolidations will skip them
+      ctx->segment_mask_.insert(segment_mask.begin(), segment_mask.end());
+      segment.meta.name = file_name(meta_.increment()); // increment active meta, not fn arg
+    }
+
+    // merge without commit_lock_, the flush context is retained till the end
+    // so that the pending commit will wait for the merged segment
+    bool merged = false;
+
+    try {
+      merged = merge_segments(segment, *(ctx->dir_), merge_candidates);
+    } catch (...) {
       SCOPED_LOCK(ctx->mutex_); // lock due to context modification
 
-      // add a policy to hold a reference to committed_meta so that segment refs do not disapear
-      ctx->consolidation_policies_.emplace_back(std::move(meta_ref));
+      for (auto& name: segment_mask) {
+        ctx->segment_mask_.erase(name);
+      }
+
+      throw;
+    }
+
+    SCOPED_LOCK(ctx->mutex_); // lock due to context modification
+
+    if (!merged) {
+      // import failure (no files created, nothing to clean up)
+      for (auto& name: segment_mask) {
+        ctx->segment_mask_.erase(name);
+      }
 
-      // 0 == merged segments existed before start of tx (all removes apply)
-      ctx->pending_segments_.emplace_back(std::move(segment), 0);
+      return;
     }
 
+    consolidation_policy_t meta_ref = [meta](const directory&, const index_meta&)->consolidation_acceptor_t {
+      return [](const segment_meta&)->bool { return false; };
+    };
+
+    // add a policy to hold a reference to committed_meta so that segment refs do not disapear
+    ctx->consolidation_policies_.emplace_back(std::move(meta_ref));
+
+    // 0 == merged segments existed before start of tx (all removes apply)
+    ctx->pending_segments_.emplace_back(std::move(segment), 0);
+
     return;
   }
 
@@ -678,6 +791,132 @@ void index_writer::remove(filter::ptr&& filter) {
   ctx->modification_queries_.emplace_back(std::move(filter), ctx->generation_++, false);
 }
 
+bool index_writer::flush_writers(
+    flush_context& ctx,
+    index_meta::index_segments_t& segments,
+    std::vector<std::pair<size_t, segment_writer*>>& flushed
+) {
+  REGISTER_TIMER_DETAILED();
+
+  auto visitor = [this, &segments, &flushed](segment_writer& writer)->bool {
+    // writers reset after a flush due to the memory limit might have no documents
+    if (writer.initialized() && writer.docs_cached()) {
+      flushed.emplace_back(segments.size(), &writer);
+      segments.emplace_back(segment_meta(writer.name(), codec_));
+    }
+
+    return true;
+  };
+
+  ctx.writers_pool_.visit(visitor);
+
+  // segment writers are independent of each other, flush them concurrently
+  std::vector<char> succeeded(flushed.size(), false); // not std::vector<bool> since written concurrently
+
+  async_utils::parallel_for(pool_, flushed.size(), [&segments, &flushed, &succeeded](size_t i)->void {
+    auto& segment = segments[flushed[i].first];
+
+    succeeded[i] = flushed[i].second->flush(segment.filename, segment.meta);
+  });
+
+  return std::all_of(
+    succeeded.begin(), succeeded.end(), [](char value) { return value; }
+  );
+}
+
+void index_writer::flush_on_memory_limit(
+    flush_context& ctx,
+    segment_writer& writer,
+    size_t prev_memory) {
+  // account for the growth of 'writer' caused by the last document,
+  // unsigned arithmetic yields the proper total even if the writer shrunk
+  const auto memory = (ctx.memory_ += writer.memory() - prev_memory);
+  const auto limit = memory_limit_.load();
+
+  if (!limit) {
+    return; // no limit
+  }
+
+  auto* pending = ctx.flush_pending_.load();
+
+  if (pending == &writer) {
+    flush_segment(ctx, writer);
+    return;
+  }
+
+  if (memory <= limit) {
+    return; // within the limit
+  }
+
+  if (pending) {
+    // the pending writer is flushed by the thread using it once that thread
+    // finishes its current document, flush it here if it was released already
+    auto idle = ctx.writers_pool_.try_acquire(*pending);
+
+    if (idle) {
+      flush_segment(ctx, *idle);
+    }
+
+    return;
+  }
+
+  const segment_writer* largest = nullptr;
+
+  // writers publish their memory usage atomically, shared visitation is safe,
+  // the scan is performed only once the limit is exceeded
+  ctx.writers_pool_.visit([&largest](const segment_writer& other)->bool {
+    if (!largest || largest->memory() < other.memory()) {
+      largest = &other;
+    }
+
+    return true;
+  }, true);
+
+  if (largest == &writer) {
+    flush_segment(ctx, writer);
+    return;
+  }
+
+  if (largest) {
+    auto idle = ctx.writers_pool_.try_acquire(*largest);
+
+    if (idle) {
+      flush_segment(ctx, *idle); // not in use by any thread, flush right away
+      return;
+    }
+
+    // in use by another thread, which flushes it after its current document
+    ctx.flush_pending_.compare_exchange_strong(pending, largest);
+  }
+}
+
+void index_writer::flush_segment(
+    flush_context& ctx,
+    segment_writer& writer) {
+  REGISTER_TIMER_DETAILED();
+
+  // flush without holding any locks, other writers continue to accept
+  // documents, commit waits for the flush since 'ctx' is held by the caller
+  index_meta::index_segment_t segment(segment_meta(writer.name(), codec_));
+
+  if (!writer.flush(segment.filename, segment.meta)) {
+    IR_FRMT_ERROR("Failed to flush segment '%s' in: %s", writer.name().c_str(), __FUNCTION__);
+
+    throw index_error();
+  }
+
+  {
+    SCOPED_LOCK(ctx.mutex_); // lock due to context modification
+    ctx.flushed_segments_.emplace_back(std::move(segment), writer);
+  }
+
+  const segment_writer* pending = &writer;
+
+  ctx.flush_pending_.compare_exchange_strong(pending, nullptr);
+  ctx.memory_ -= writer.memory();
+  writer.reset(segment_meta(file_name(meta_.increment()), codec_));
+}
+
 index_writer::pending_context_t index_writer::flush_all() {
   REGISTER_TIMER_DETAILED();
   bool modified = !type_limits<type_t::index_gen_t>::valid(meta_.last_gen_);
@@ -745,68 +984,41 @@ index_writer::pending_context_t index_writer::flush_all() {
   }
 
   {
-    struct flush_context {
-      size_t segment_offset;
-      segment_writer& writer;
-      flush_context(
-        size_t v_segment_offset, segment_writer& v_writer
-      ): segment_offset(v_segment_offset), writer(v_writer) {}
-      flush_context& operator=(const flush_context&) = delete; // because of reference
-    };
-
-    std::vector<flush_context> segment_ctxs;
-    auto flush = [this, &ctx, &segments, &segment_ctxs](segment_writer& writer) {
-      if (!writer.initialized()) {
-        return true;
-      }
-
-      segment_ctxs.emplace_back(segments.size(), writer);
-      segments.emplace_back(segment_meta(writer.name(), codec_));
-
-      auto& segment = segments.back();
+    std::vector<std::pair<size_t, flushed_segment*>> flushed_ctxs; // segment offset + flushed segment
+    std::vector<std::pair<size_t, segment_writer*>> segment_ctxs; // segment offset + writer
+
+    // add segments flushed due to the memory limit, they precede the segments
+    // of the writers since the writers were reset after the flush
+    for (auto& flushed: ctx->flushed_segments_) {
+      flushed_ctxs.emplace_back(segments.size(), &flushed);
+      segments.emplace_back(flushed.segment);
+    }
 
-      if (!writer.flush(segment.filename, segment.meta)) {
-        return false;
-      }
+    if (!flush_writers(*ctx, segments, segment_ctxs)) {
+      return pending_context_t();
+    }
 
-      // flush document_mask after regular flush() so remove_query can traverse
+    // flush document_mask after regular flush() so remove_query can traverse,
+    // modification queries are applied in the same order as writers are visited
+    for (auto& segment_ctx: flushed_ctxs) {
       add_document_mask_modified_records(
-        ctx->modification_queries_, writer, segment.meta
+        ctx->modification_queries_, *segment_ctx.second, segments[segment_ctx.first].meta
       );
-
-      return true;
-    };
-
-    if (!ctx->writers_pool_.visit(flush)) {
-      return pending_context_t();
     }
 
-    // write docs_mask if !empty(), if all docs are masked then remove segment altogether
     for (auto& segment_ctx: segment_ctxs) {
-      auto& segment = segments[segment_ctx.segment_offset];
-      auto& writer = segment_ctx.writer;
-
-      // if have a writer with potential update-replacement records then check if they were seen
-      add_document_mask_unused_updates(
-        ctx->modification_queries_, writer, segment.meta
+      add_document_mask_modified_records(
+        ctx->modification_queries_, *segment_ctx.second, segments[segment_ctx.first].meta
       );
+    }
 
-      auto& docs_mask = writer.docs_mask();
-
-      // mask empty segments
-      if (docs_mask.size() == segment.meta.docs_count) {
-        ctx->segment_mask_.emplace(writer.name()); // ref to writer name will not change
-        continue;
-      }
-
-      // write non-empty document mask
-      if (!docs_mask.empty()) {
-        write_document_mask(dir, segment.meta, docs_mask);
-        segment.filename = write_segment_meta(dir, segment.meta); // write with new mask
-      }
+    // write docs_mask if !empty(), if all docs are masked then remove segment altogether
+    for (auto& segment_ctx: flushed_ctxs) {
+      flush_document_mask(*ctx, *segment_ctx.second, segments[segment_ctx.first], to_sync);
+    }
 
-      // add files from segment to list of files to sync
-      to_sync.insert(segment.meta.files.begin(), segment.meta.files.end());
+    for (auto& segment_ctx: segment_ctxs) {
+      flush_document_mask(*ctx, *segment_ctx.second, segments[segment_ctx.first], to_sync);
     }
   }
 
@@ -829,6 +1041,9 @@ index_writer::pending_context_t index_writer::flush_all() {
   }
 
   // add segments generated by deferred merge policies to meta
+  // NOTE: merges are deliberately not run via 'pool_', every policy is given
+  // the meta produced by the previous ones (possibly merging their output),
+  // concurrent immediate consolidate() calls already merge in parallel
   for (auto& policy: ctx->consolidation_policies_) {
     segments.clear();
     segments.emplace_back();
@@ -991,12 +1206,15 @@ bool index_writer::start() {
       meta_.update_generation(*(to_commit.meta));
     });
 
-    // sync files
-    for (auto& file: to_commit.to_sync) {
-      if (!to_commit.ctx->dir_->sync(file)) {
-        throw detailed_io_error("Failed to sync file, path: ") << file;
+    // sync files, files are independent of each other
+    auto& to_sync = to_commit.to_sync;
+    auto& dir = *(to_commit.ctx->dir_);
+
+    async_utils::parallel_for(pool_, to_sync.size(), [&to_sync, &dir](size_t i)->void {
+      if (!dir.sync(to_sync[i])) {
+        throw detailed_io_error("Failed to sync file, path: ") << to_sync[i];
       }
-    }
+    });
   } catch (...) {
     // in case of syncing error, just clear pending meta & peform rollback
     // next commit will create another meta & sync all pending files
@@ -101,11 +101,16 @@ class IRESEARCH_API index_writer : util::noncopyable {
   /// @param dir directory where index will be should reside
   /// @param codec format that will be used for creating new index segments
   /// @param mode specifies how to open a writer
+  /// @param pool thread pool used for flushing independent segments and
+  ///        syncing files during commit, nullptr - use the committing thread,
+  ///        consolidation is not run via the pool (see flush_all())
+  /// @note the pool must outlive the writer
   ////////////////////////////////////////////////////////////////////////////
   static index_writer::ptr make(
     directory& dir,
     format::ptr codec,
-    OPEN_MODE mode);
+    OPEN_MODE mode,
+    async_utils::thread_pool* pool = nullptr);
 
   ////////////////////////////////////////////////////////////////////////////
   /// @brief destructor 
@@ -117,6 +122,22 @@ class IRESEARCH_API index_writer : util::noncopyable {
   ////////////////////////////////////////////////////////////////////////////
   uint64_t buffered_docs() const;
 
+  ////////////////////////////////////////////////////////////////////////////
+  /// @brief sets the limit of memory occupied by the buffered documents of all
+  ///        segment writers, once the limit is exceeded the largest segment
+  ///        writer is flushed into a new segment, either right away if it is
+  ///        not in use or by the thread using it after its current document,
+  ///        while documents are still being inserted into the other writers
+  /// @param limit number of bytes, 0 - no limit
+  /// @note flushed segments become visible to readers only after commit()
+  ////////////////////////////////////////////////////////////////////////////
+  void memory_limit(size_t limit) NOEXCEPT { memory_limit_ = limit; }
+
+  ////////////////////////////////////////////////////////////////////////////
+  /// @returns limit of memory occupied by the buffered documents, 0 - no limit
+  ////////////////////////////////////////////////////////////////////////////
+  size_t memory_limit() const NOEXCEPT { return memory_limit_; }
+
   ////////////////////////////////////////////////////////////////////////////
   /// @brief Clears the existing index repository by staring an empty index.
   ///        Previously opened readers still remain valid.
@@ -139,6 +160,8 @@ class IRESEARCH_API index_writer : util::noncopyable {
     bool has_next = true;
 
     do {
+      const auto memory = writer->memory();
+
       writer->begin(make_update_context(*ctx));
       try {
         has_next = func(doc);
@@ -147,6 +170,8 @@ class IRESEARCH_API index_writer : util::noncopyable {
         writer->rollback();
         throw;
       }
+
+      flush_on_memory_limit(*ctx, *writer, memory);
     } while (has_next);
 
     return writer->valid();
@@ -240,6 +265,9 @@ class IRESEARCH_API index_writer : util::noncopyable {
   /// @param immediate apply the policy immediately but only to previously
   ///        committed segments, or defer defragment until the commit stage
   ///        and apply the policy to all segments in the commit
+  /// @note immediate consolidations of disjoint sets of segments may be
+  ///       executed concurrently, segments are merged without holding the
+  ///       commit lock
   ////////////////////////////////////////////////////////////////////////////
   void consolidate(const consolidation_policy_t& policy, bool immediate);
 
@@ -350,12 +378,45 @@ class IRESEARCH_API index_writer : util::noncopyable {
     const index_meta::index_segment_t segment;
   }; // import_context
 
+  // segment flushed before commit due to the memory limit, retains document
+  // contexts required to apply modification queries during commit
+  struct flushed_segment : util::noncopyable {
+    flushed_segment(index_meta::index_segment_t&& segment, segment_writer& writer)
+      : segment(std::move(segment)),
+        docs_context_(writer.docs_context()),
+        docs_mask_(writer.docs_mask()) {
+    }
+    flushed_segment(flushed_segment&& other) NOEXCEPT
+      : segment(std::move(other.segment)),
+        docs_context_(std::move(other.docs_context_)),
+        docs_mask_(std::move(other.docs_mask_)) {
+    }
+    flushed_segment& operator=(const flushed_segment&) = delete;
+
+    const segment_writer::update_contexts& docs_context() const NOEXCEPT {
+      return docs_context_;
+    }
+    const document_mask& docs_mask() const NOEXCEPT { return docs_mask_; }
+    const std::string& name() const NOEXCEPT { return segment.meta.name; }
+    bool remove(doc_id_t doc_id) { // expect 0-based doc_id
+      return doc_id < docs_context_.size()
+        && docs_mask_.insert(type_limits<type_t::doc_id_t>::min() + doc_id);
+    }
+
+    index_meta::index_segment_t segment;
+
+   private:
+    segment_writer::update_contexts docs_context_;
+    document_mask docs_mask_;
+  }; // flushed_segment
+
   typedef std::unordered_map<std::string, segment_reader> cached_readers_t;
   typedef std::pair<std::shared_ptr<index_meta>, file_refs_t> committed_state_t;
   typedef std::vector<consolidation_context> consolidation_requests_t;
   typedef std::vector<modification_context> modification_requests_t;
 
   struct IRESEARCH_API flush_context {
+    typedef std::vector<flushed_segment> flushed_segments_t;
     typedef std::vector<import_context> imported_segments_t;
     typedef std::unordered_set<string_ref> segment_mask_t;
     typedef bounded_object_pool<segment_writer> segment_writers_t;
@@ -417,6 +478,9 @@ class IRESEARCH_API index_writer : util::noncopyable {
     std::atomic<size_t> generation_; // current modification/update generation
     ref_tracking_directory::ptr dir_; // ref tracking directory used by this context (tracks all/only refs for this context)
     async_utils::read_write_mutex flush_mutex_; // guard for the current context during flush (write) operations vs update (read)
+    flushed_segments_t flushed_segments_; // segments flushed due to the memory limit to be added during next commit
+    std::atomic<const segment_writer*> flush_pending_; // the largest writer to be flushed by the thread using it due to the memory limit
+    std::atomic<size_t> memory_; // memory occupied by the buffered documents of all writers
     modification_requests_t modification_queries_; // sequential list of modification requests (remove/update)
     std::mutex mutex_; // guard for the current context during struct update operations, e.g. modification_queries_, pending_segments_
     flush_context* next_context_; // the next context to switch to
@@ -450,7 +514,8 @@ class IRESEARCH_API index_writer : util::noncopyable {
     directory& dir, 
     format::ptr codec,
     index_meta&& meta, 
-    committed_state_t&& committed_state
+    committed_state_t&& committed_state,
+    async_utils::thread_pool* pool
   ) NOEXCEPT;
 
   // on open failure returns an empty pointer
@@ -465,18 +530,32 @@ class IRESEARCH_API index_writer : util::noncopyable {
     size_t min_doc_id_generation = 0
   ); // return if any new records were added (modification_queries_ modified)
 
+  // 'Segment' is either 'segment_writer' or 'flushed_segment'
+  template<typename Segment>
   bool add_document_mask_modified_records(
     modification_requests_t& requests,
-    segment_writer& writer,
+    Segment& segment,
     segment_meta& meta
   ); // return if any new records were added (modification_queries_ modified)
 
+  // 'Segment' is either 'segment_writer' or 'flushed_segment'
+  template<typename Segment>
   static bool add_document_mask_unused_updates(
     modification_requests_t& requests,
-    segment_writer& writer,
+    Segment& segment,
     segment_meta& meta
   ); // return if any new records were added (modification_queries_ modified)
 
+  // writes document mask of a flushed segment, returns false if all
+  // documents of the segment are masked
+  template<typename Segment>
+  bool flush_document_mask(
+    flush_context& ctx,
+    Segment& segment_ctx,
+    index_meta::index_segment_t& segment,
+    std::unordered_set<string_ref>& to_sync
+  );
+
   bool add_segment_mask_consolidated_records(
     index_meta::index_segment_t& segment, // the newly created segment
     directory& dir, // directory to create merged segment in
@@ -485,8 +564,41 @@ class IRESEARCH_API index_writer : util::noncopyable {
     const consolidation_acceptor_t& acceptor // functr dictating which segments to consider
   ); // return if any new records were added (pending_segments_/segment_mask_ modified)
 
+  // function access controlled by commit_lock_, candidates are opened via merge_dir_
+  bool get_consolidation_candidates(
+    std::vector<segment_reader>& candidates, // readers of the segments to merge
+    flush_context::segment_mask_t& segment_mask, // names of the segments to merge
+    const index_meta::index_segments_t& segments, // candidates to consider
+    const consolidation_acceptor_t& acceptor // functr dictating which segments to consider
+  ); // return if there is anything to merge
+
+  bool merge_segments(
+    index_meta::index_segment_t& segment, // the newly created segment, name must be set
+    directory& dir, // directory to create merged segment in
+    const std::vector<segment_reader>& candidates // readers of the segments to merge
+  ); // return if merged segment was created
+
+  // flushes initialized writers of the context (via pool_ if specified)
+  bool flush_writers(
+    flush_context& ctx,
+    index_meta::index_segments_t& segments,
+    std::vector<std::pair<size_t, segment_writer*>>& flushed
+  );
+
   pending_context_t flush_all();
 
+  // accounts for the memory of the specified writer grown from 'prev_memory',
+  // once the memory limit is exceeded flushes the largest writer if it is
+  // either the specified one or not in use, otherwise marks it for flush
+  void flush_on_memory_limit(
+    flush_context& ctx,
+    segment_writer& writer,
+    size_t prev_memory
+  );
+
+  // flushes the specified writer into a segment to be added during next commit
+  void flush_segment(flush_context& ctx, segment_writer& writer);
+
   flush_context::ptr get_flush_context(bool shared = true);
   index_writer::flush_context::segment_writers_t::ptr get_segment_context(flush_context& ctx);
 
@@ -500,6 +612,7 @@ class IRESEARCH_API index_writer : util::noncopyable {
 
   template<typename Func>
   bool update(flush_context& ctx, segment_writer& writer, Func func) {
+    const auto memory = writer.memory();
     segment_writer::document doc(writer);
 
     try {
@@ -520,6 +633,8 @@ class IRESEARCH_API index_writer : util::noncopyable {
       return false;
     }
 
+    flush_on_memory_limit(ctx, writer, memory);
+
     return true;
   }
 
@@ -532,12 +647,15 @@ class IRESEARCH_API index_writer : util::noncopyable {
   std::mutex commit_lock_; // guard for cached_segment_readers_, commit_pool_, meta_ (modification during commit()/defragment())
   committed_state_t committed_state_; // last successfully committed state
   directory& dir_; // directory used for initialization of readers
+  advising_directory merge_dir_; // 'dir_' bypassing OS page cache, used for initialization of merge candidates
   std::vector<flush_context> flush_context_pool_; // collection of contexts that collect data to be flushed, 2 because just swap them
   std::atomic<flush_context*> flush_context_; // currently active context accumulating data to be processed during the next flush
   index_meta meta_; // latest/active state of index metadata
   pending_state_t pending_state_; // current state awaiting commit completion
   index_meta_writer::ptr writer_;
   index_lock::ptr write_lock_; // exclusive write lock for directory
+  std::atomic<size_t> memory_limit_; // limit of memory occupied by the buffered documents (0 == no limit)
+  async_utils::thread_pool* pool_; // pool for flushing segments and syncing files (may be nullptr)
   IRESEARCH_API_PRIVATE_VARIABLES_END
 }; // index_writer
 
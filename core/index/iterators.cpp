@@ -54,6 +54,7 @@ struct empty_doc_iterator : doc_iterator {
   virtual doc_id_t value() const override { return type_limits<type_t::doc_id_t>::eof(); }
   virtual bool next() override { return false; }
   virtual doc_id_t seek(doc_id_t) override { return type_limits<type_t::doc_id_t>::eof(); }
+  virtual size_t next_batch(doc_id_t*, size_t) override { return 0; }
   virtual const irs::attribute_view& attributes() const NOEXCEPT override {
     static irs::attribute_view empty = empty_doc_iterator_attributes();
     return empty;
@@ -154,6 +155,16 @@ doc_iterator::ptr doc_iterator::empty() {
   return instance;
 }
 
+size_t doc_iterator::next_batch(doc_id_t* docs, size_t size) {
+  size_t count = 0;
+
+  while (count < size && next()) {
+    docs[count++] = value();
+  }
+
+  return count;
+}
+
 // ----------------------------------------------------------------------------
 // --SECTION--                                                   field_iterator 
 // ----------------------------------------------------------------------------
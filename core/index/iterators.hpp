@@ -62,6 +62,16 @@ struct IRESEARCH_API doc_iterator
   /// return NO_MORE_DOCS
   //////////////////////////////////////////////////////////////////////////////
   virtual doc_id_t seek(doc_id_t target) = 0;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief advances the iterator by up to 'size' documents and stores their
+  ///        identifiers into 'docs' in ascending order
+  /// @returns number of stored documents, if less than 'size' the iterator is
+  ///          exhausted, otherwise it's positioned at the last stored document
+  /// @note attributes (e.g. score) aren't evaluated for the skipped documents
+  /// @note the default implementation calls 'next()' for every document
+  //////////////////////////////////////////////////////////////////////////////
+  virtual size_t next_batch(doc_id_t* docs, size_t size);
 }; // doc_iterator
 
 // ----------------------------------------------------------------------------
@@ -25,6 +25,7 @@
 #include <unordered_map>
 
 #include "merge_writer.hpp"
+#include "analysis/token_attributes.hpp"
 #include "index/field_meta.hpp"
 #include "index/index_meta.hpp"
 #include "index/segment_reader.hpp"
@@ -38,17 +39,62 @@
 
 NS_LOCAL
 
-// mapping of old doc_id to new doc_id (reader doc_ids are sequential 0 based)
-// masked doc_ids have value of MASKED_DOC_ID
-typedef std::vector<irs::doc_id_t> doc_id_map_t;
+const irs::doc_id_t MASKED_DOC_ID = irs::integer_traits<irs::doc_id_t>::const_max; // masked doc_id (ignore)
+
+//////////////////////////////////////////////////////////////////////////////
+/// @class doc_id_map_t
+/// @brief mapping of old doc_id to new doc_id (reader doc_ids are sequential
+///        0 based), masked doc_ids have value of MASKED_DOC_ID
+/// @note doc_ids of a segment without deletions are remapped by a plain shift,
+///       so no per-document table is materialized and looked up for them, and
+///       postings of the terms found only in such a segment may be copied
+///       by the postings writer without re-encoding
+//////////////////////////////////////////////////////////////////////////////
+class doc_id_map_t {
+ public:
+  // remap 'docs_count' doc_ids by a plain shift starting from 'next_id'
+  void shift(uint64_t docs_count, irs::doc_id_t next_id) NOEXCEPT {
+    map_.clear();
+    base_ = next_id;
+    count_ = irs::doc_id_t(docs_count);
+  }
+
+  // remap each of 'docs_count' doc_ids individually, all doc_ids are masked
+  void resize(uint64_t docs_count) {
+    map_.resize(docs_count + irs::type_limits<irs::type_t::doc_id_t>::min(), MASKED_DOC_ID);
+    base_ = irs::type_limits<irs::type_t::doc_id_t>::min();
+    count_ = irs::doc_id_t(docs_count);
+  }
+
+  // true if no doc_ids are masked
+  bool shifted() const NOEXCEPT { return map_.empty(); }
+
+  irs::doc_id_t& operator[](irs::doc_id_t doc) NOEXCEPT {
+    assert(doc < map_.size());
+    return map_[doc];
+  }
+
+  irs::doc_id_t operator[](irs::doc_id_t doc) const NOEXCEPT {
+    const auto offset = irs::doc_id_t(doc - irs::type_limits<irs::type_t::doc_id_t>::min());
+
+    if (offset >= count_) {
+      return MASKED_DOC_ID; // invalid doc_id
+    }
+
+    return map_.empty() ? base_ + offset : map_[doc];
+  }
+
+ private:
+  std::vector<irs::doc_id_t> map_; // empty for shifted doc_ids
+  irs::doc_id_t base_{}; // new doc_id of the first document if shifted
+  irs::doc_id_t count_{}; // number of the valid doc_ids
+}; // doc_id_map_t
 
 // mapping of old field_id to new field_id
 typedef std::vector<irs::field_id> id_map_t;
 
 typedef std::unordered_map<irs::string_ref, const irs::field_meta*> field_meta_map_t;
 
-const irs::doc_id_t MASKED_DOC_ID = irs::integer_traits<irs::doc_id_t>::const_max; // masked doc_id (ignore)
-
 //////////////////////////////////////////////////////////////////////////////
 /// @class compound_attributes
 /// @brief compound view of multiple attributes as a single object
@@ -133,8 +179,13 @@ struct compound_doc_iterator : public irs::doc_iterator {
   void add(irs::doc_iterator::ptr&& postings, const doc_id_map_t& doc_id_map) {
     if (iterators.empty()) {
       attrs.set(postings->attributes()); // add keys and set values
+
+      if (!doc_id_map.shifted()) {
+        attrs.remove<irs::raw_postings>(); // postings with masked docs can't be copied
+      }
     } else {
       attrs.add(postings->attributes()); // only add missing keys
+      attrs.remove<irs::raw_postings>(); // postings of multiple segments can't be copied
     }
 
     iterators.emplace_back(std::move(postings), &doc_id_map);
@@ -177,19 +228,14 @@ bool compound_doc_iterator::next() {
 
     if (update_attributes) {
       attrs.set(itr->attributes());
+      attrs.remove<irs::raw_postings>(); // postings of multiple segments can't be copied
     }
 
     while (itr->next()) {
-      auto doc = itr->value();
-
-      if (doc >= id_map->size()) {
-        continue; // invalid doc_id
-      }
-
-      current_id = (*id_map)[doc];
+      current_id = (*id_map)[itr->value()];
 
       if (current_id == MASKED_DOC_ID) {
-        continue; // masked doc_id
+        continue; // masked or invalid doc_id
       }
 
       return true;
@@ -580,9 +626,18 @@ irs::doc_id_t compute_doc_ids(
   irs::doc_id_t next_id
 ) NOEXCEPT {
   REGISTER_TIMER_DETAILED();
+  const auto docs_count = reader.docs_count();
+
+  if (reader.live_docs_count() == docs_count) {
+    // no deleted documents, doc_ids are shifted only
+    doc_id_map.shift(docs_count, next_id);
+
+    return irs::doc_id_t(next_id + docs_count);
+  }
+
   // assume not a lot of space wasted if type_limits<type_t::doc_id_t>::min() > 0
   try {
-    doc_id_map.resize(reader.docs_count() + irs::type_limits<irs::type_t::doc_id_t>::min(), MASKED_DOC_ID);
+    doc_id_map.resize(docs_count);
   } catch (...) {
     IR_FRMT_ERROR(
       "Failed to resize merge_writer::doc_id_map to accommodate element: " IR_UINT64_T_SPECIFIER,
@@ -676,6 +731,35 @@ class columnstore {
     });
   }
 
+  // inserts live norms of the specified field, norms of the previous format
+  // versions are converted into quantized field lengths
+  bool insert_norms(
+      const irs::sub_reader& reader,
+      irs::field_id column,
+      const doc_id_map_t& doc_id_map) {
+    const auto* column_reader = reader.column_reader(column);
+
+    if (!column_reader || column_reader->quantized_norms()) {
+      return insert(reader, column, doc_id_map);
+    }
+
+    return column_reader->visit(
+      [this, &doc_id_map](irs::doc_id_t doc, const irs::bytes_ref& in) {
+        const auto mapped_doc = doc_id_map[doc];
+        if (MASKED_DOC_ID == mapped_doc) {
+          // skip deleted document
+          return true;
+        }
+
+        empty_ = false;
+
+        irs::bytes_ref_input stream(in);
+        auto& out = column_.second(mapped_doc);
+        out.write_byte(irs::norm::quantize_norm(irs::read_zvfloat(stream)));
+        return true;
+    });
+  }
+
   void reset() {
     if (!empty_) {
       column_ = writer_->push_column();
@@ -772,7 +856,7 @@ bool write(
       const irs::field_meta& field) {
     // merge field norms if present
     if (irs::type_limits<irs::type_t::field_id_t>::valid(field.norm)) {
-      cs.insert(segment, field.norm, doc_id_map);
+      cs.insert_norms(segment, field.norm, doc_id_map);
     }
 
     return true;
@@ -21,11 +21,99 @@
 /// @author Vasiliy Nabatchikov
 ////////////////////////////////////////////////////////////////////////////////
 
-#include "utils/map_utils.hpp"
+#include "utils/integer.hpp"
+#include "utils/misc.hpp"
 #include "utils/timer_utils.hpp"
 #include "utils/type_limits.hpp"
+#include "utils/unicode_utils.hpp"
 #include "postings.hpp"
 
+#include <algorithm>
+#include <tuple>
+
+NS_LOCAL
+
+using namespace irs;
+
+typedef const postings::value_type* value_ptr;
+
+// ranges smaller than that are sorted by comparison
+const size_t RADIX_SORT_THRESHOLD = 32;
+
+// initial number of slots in the hash table
+const size_t MIN_SLOTS = 16;
+
+const uint32_t EMPTY_SLOT = integer_traits<uint32_t>::const_max;
+
+inline size_t key_at(value_ptr value, size_t depth) NOEXCEPT {
+  // terms ending before 'depth' go to the first bucket
+  return depth < value->first.size() ? 1 + size_t(value->first[depth]) : 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief MSD radix sort of terms, produces the same order as 'utf8_less'
+////////////////////////////////////////////////////////////////////////////////
+void msd_radix_sort(value_ptr* values, size_t size) {
+  std::vector<value_ptr> buf(size);
+  std::vector<std::tuple<size_t, size_t, size_t>> ranges; // begin, end, depth
+  size_t offsets[1 + 256 + 1];
+
+  ranges.emplace_back(0, size, 0);
+
+  while (!ranges.empty()) {
+    size_t begin, end, depth;
+    std::tie(begin, end, depth) = ranges.back();
+    ranges.pop_back();
+
+    auto* first = values + begin;
+    auto* last = values + end;
+
+    if (end - begin < RADIX_SORT_THRESHOLD) {
+      std::sort(first, last, [depth](value_ptr lhs, value_ptr rhs) {
+        const auto& lhs_term = lhs->first;
+        const auto& rhs_term = rhs->first;
+
+        return utf8_less(
+          lhs_term.c_str() + depth, lhs_term.size() - depth,
+          rhs_term.c_str() + depth, rhs_term.size() - depth
+        );
+      });
+      continue;
+    }
+
+    std::fill(std::begin(offsets), std::end(offsets), 0);
+
+    for (auto* it = first; it != last; ++it) {
+      ++offsets[1 + key_at(*it, depth)];
+    }
+
+    for (size_t i = 1; i < IRESEARCH_COUNTOF(offsets); ++i) {
+      offsets[i] += offsets[i - 1];
+    }
+
+    // 'offsets[i]' now denotes the start of the i-th bucket
+    for (auto* it = first; it != last; ++it) {
+      buf[offsets[key_at(*it, depth)]++] = *it;
+    }
+
+    std::copy(buf.begin(), buf.begin() + (end - begin), first);
+
+    // 'offsets[i]' now denotes the end of the i-th bucket,
+    // terms from the first bucket are all of size 'depth' and thus equal
+    for (size_t i = 1, bucket_begin = offsets[0]; i <= 256; ++i) {
+      const auto bucket_end = offsets[i];
+
+      if (bucket_end - bucket_begin > 1) {
+        ranges.emplace_back(begin + bucket_begin, begin + bucket_end, depth + 1);
+      }
+
+      bucket_begin = bucket_end;
+    }
+  }
+}
+
+NS_END
+
 NS_ROOT
 
 // -----------------------------------------------------------------------------
@@ -36,6 +124,34 @@ postings::postings(writer_t& writer):
   writer_(writer) {
 }
 
+void postings::clear() {
+  values_.clear();
+  std::fill(slots_.begin(), slots_.end(), slot{ EMPTY_SLOT, 0 });
+}
+
+void postings::rehash(size_t capacity) {
+  assert(0 == (capacity & (capacity - 1))); // power of 2
+  const auto mask = capacity - 1;
+
+  std::vector<slot> slots(capacity, slot{ EMPTY_SLOT, 0 });
+
+  for (auto& entry : slots_) {
+    if (EMPTY_SLOT == entry.id) {
+      continue;
+    }
+
+    auto pos = entry.hash & mask;
+
+    while (EMPTY_SLOT != slots[pos].id) {
+      pos = (pos + 1) & mask;
+    }
+
+    slots[pos] = entry;
+  }
+
+  slots_ = std::move(slots);
+}
+
 postings::emplace_result postings::emplace(const bytes_ref& term) {
   REGISTER_TIMER_DETAILED();
   auto& parent = writer_.parent();
@@ -46,7 +162,30 @@ postings::emplace_result postings::emplace(const bytes_ref& term) {
   if (writer_t::container::block_type::SIZE < max_term_len) {
     // TODO: maybe move big terms it to a separate storage
     // reject terms that do not fit in a block
-    return std::make_pair(map_.end(), false);
+    return std::make_pair(values_.end(), false);
+  }
+
+  assert(size() < type_limits<type_t::doc_id_t>::eof()); // not larger then the static flag
+
+  // keep load factor below 1/2
+  if (2*(values_.size() + 1) > slots_.size()) {
+    rehash((std::max)(MIN_SLOTS, 2*slots_.size()));
+  }
+
+  const auto hash = static_cast<uint32_t>(std::hash<irs::bytes_ref>()(term));
+  const auto mask = slots_.size() - 1;
+  auto pos = hash & mask;
+
+  for (;; pos = (pos + 1) & mask) {
+    const auto& entry = slots_[pos];
+
+    if (EMPTY_SLOT == entry.id) {
+      break;
+    }
+
+    if (hash == entry.hash && term == values_[entry.id].first) {
+      return std::make_pair(values_.begin() + entry.id, false);
+    }
   }
 
   const auto slice_end = writer_.pool_offset() + max_term_len;
@@ -59,26 +198,30 @@ postings::emplace_result postings::emplace(const bytes_ref& term) {
     writer_.seek(next_block_start);
   }
 
-  assert(size() < type_limits<type_t::doc_id_t>::eof()); // not larger then the static flag
+  // for new terms also write out their value
+  writer_.write(term.c_str(), term.size());
 
-  auto generator = [&term, this](const hashed_bytes_ref& key, const posting&) {
-    // for new terms also write out their value
-    writer_.write(term.c_str(), term.size());
-
-    // reuse hash but point ref at data in pool
-    return hashed_bytes_ref(
-      key.hash(),
-      (writer_.position() - term.size()).buffer(), term.size()
-    );
-  };
-
-  // replace original reference to 'term' provided by the caller
-  // with a reference to the cached copy in 'writer_'
-  return map_utils::try_emplace_update_key(
-    map_,                                     // container
-    generator,                                // key generator
-    make_hashed_ref(term, std::hash<irs::bytes_ref>()) // key
+  // point ref at data in pool
+  values_.emplace_back(
+    std::piecewise_construct,
+    std::forward_as_tuple((writer_.position() - term.size()).buffer(), term.size()),
+    std::forward_as_tuple()
   );
+  slots_[pos] = slot{ static_cast<uint32_t>(values_.size() - 1), hash };
+
+  return std::make_pair(values_.end() - 1, true);
+}
+
+void postings::sort(std::vector<const value_type*>& out) const {
+  REGISTER_TIMER_DETAILED();
+  out.clear();
+  out.reserve(values_.size());
+
+  for (auto& value : values_) {
+    out.emplace_back(&value);
+  }
+
+  msd_radix_sort(out.data(), out.size());
 }
 
 NS_END
@@ -24,7 +24,7 @@
 #ifndef IRESEARCH_POSTINGS_H
 #define IRESEARCH_POSTINGS_H
 
-#include <unordered_map>
+#include <vector>
 
 #include "shared.hpp"
 #include "utils/block_pool.hpp"
@@ -52,30 +52,62 @@ struct posting {
   uint32_t offs = 0;
 };
 
+////////////////////////////////////////////////////////////////////////////////
+/// @class postings
+/// @brief in-memory term dictionary of a field being indexed
+///        term data is stored in the 'writer' byte pool, posting records are
+///        kept in a dense array indexed by term id, lookups go through an
+///        open-addressing (linear probing) table of term ids
+////////////////////////////////////////////////////////////////////////////////
 class IRESEARCH_API postings: util::noncopyable {
  public:
-  typedef std::unordered_map<hashed_bytes_ref, posting> map_t;
-  typedef std::pair<map_t::iterator, bool> emplace_result;
+  typedef std::pair<bytes_ref, posting> value_type;
+  typedef std::vector<value_type> values_t;
+  typedef values_t::iterator iterator;
+  typedef values_t::const_iterator const_iterator;
+  typedef std::pair<iterator, bool> emplace_result;
   typedef byte_block_pool::inserter writer_t;
 
   postings(writer_t& writer);
 
-  inline map_t::const_iterator begin() const { return map_.begin(); }
+  inline const_iterator begin() const { return values_.begin(); }
 
-  inline void clear() { map_.clear(); }
+  void clear();
 
   // on error returns std::ptr(end(), false)
+  // NOTE: returned iterator is invalidated by subsequent calls to emplace(...)
   emplace_result emplace(const bytes_ref& term);
 
-  inline bool empty() const { return map_.empty(); }
+  inline bool empty() const { return values_.empty(); }
+
+  inline iterator end() { return values_.end(); }
+  inline const_iterator end() const { return values_.end(); }
 
-  inline map_t::const_iterator end() const { return map_.end(); }
+  // returns number of bytes allocated for the posting records and the lookup
+  // table, term data is accounted by the owner of the byte pool
+  inline size_t memory() const {
+    return values_.capacity() * sizeof(value_type)
+      + slots_.capacity() * sizeof(slot);
+  }
 
-  inline size_t size() const { return map_.size(); }
+  inline size_t size() const { return values_.size(); }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief fills 'out' with pointers to the stored values ordered by term
+  //////////////////////////////////////////////////////////////////////////////
+  void sort(std::vector<const value_type*>& out) const;
 
  private:
+  struct slot {
+    uint32_t id; // term id, i.e. offset in 'values_'
+    uint32_t hash; // lower 32 bits of the term hash
+  }; // slot
+
+  void rehash(size_t capacity);
+
   IRESEARCH_API_PRIVATE_VARIABLES_BEGIN
-  map_t map_;
+  std::vector<slot> slots_; // size is either 0 or a power of 2
+  values_t values_;
   writer_t& writer_;
   IRESEARCH_API_PRIVATE_VARIABLES_END
 };
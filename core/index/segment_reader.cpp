@@ -31,10 +31,16 @@
 #include "utils/singleton.hpp"
 #include "utils/type_limits.hpp"
 
+#include <atomic>
 #include <unordered_map>
 
 NS_LOCAL
 
+uint64_t next_reader_id() NOEXCEPT {
+  static std::atomic<uint64_t> id{};
+  return ++id;
+}
+
 class iterator_impl: public iresearch::index_reader::reader_iterator_impl {
  public:
   explicit iterator_impl(const iresearch::sub_reader* rdr = nullptr) NOEXCEPT
@@ -66,7 +72,7 @@ class mask_doc_iterator final : public irs::doc_iterator {
 
   virtual bool next() override {
     while (it_->next()) {
-      if (mask_.find(value()) == mask_.end()) {
+      if (!mask_.contains(value())) {
         return true;
       }
     }
@@ -77,7 +83,7 @@ class mask_doc_iterator final : public irs::doc_iterator {
   virtual irs::doc_id_t seek(irs::doc_id_t target) override {
     const auto doc = it_->seek(target);
 
-    if (mask_.find(doc) == mask_.end()) {
+    if (!mask_.contains(doc)) {
       return doc;
     }
 
@@ -86,6 +92,31 @@ class mask_doc_iterator final : public irs::doc_iterator {
     return value();
   }
 
+  // documents are fetched in batches no larger than the free space
+  // of 'docs', so 'it_' is positioned at the last stored document
+  // once 'docs' is filled
+  virtual size_t next_batch(irs::doc_id_t* docs, size_t size) override {
+    size_t count = 0;
+
+    while (count < size) {
+      const auto left = size - count;
+      auto* begin = docs + count;
+      const auto* end = begin + it_->next_batch(begin, left);
+
+      for (auto* doc = begin; doc != end; ++doc) {
+        if (!mask_.contains(*doc)) {
+          docs[count++] = *doc;
+        }
+      }
+
+      if (size_t(end - begin) < left) {
+        break; // 'it_' is exhausted
+      }
+    }
+
+    return count;
+  }
+
   virtual irs::doc_id_t value() const override {
     return it_->value();
   }
@@ -109,7 +140,8 @@ class masked_docs_iterator
     const iresearch::document_mask& docs_mask
   ) :
     current_(iresearch::type_limits<iresearch::type_t::doc_id_t>::invalid()),
-    docs_mask_(docs_mask),
+    mask_begin_(docs_mask.begin()),
+    mask_end_(docs_mask.end()),
     end_(end),
     next_(begin) {
   }
@@ -120,7 +152,13 @@ class masked_docs_iterator
     while (next_ < end_) {
       current_ = next_++;
 
-      if (docs_mask_.find(current_) == docs_mask_.end()) {
+      // masked documents are traversed along with the
+      // candidates, so no lookups in the mask required
+      while (mask_begin_ != mask_end_ && *mask_begin_ < current_) {
+        ++mask_begin_;
+      }
+
+      if (mask_begin_ == mask_end_ || *mask_begin_ != current_) {
         return true;
       }
     }
@@ -136,7 +174,8 @@ class masked_docs_iterator
 
  private:
   iresearch::doc_id_t current_;
-  const iresearch::document_mask& docs_mask_;
+  iresearch::document_mask::const_iterator mask_begin_; // next masked doc
+  iresearch::document_mask::const_iterator mask_end_;
   const iresearch::doc_id_t end_; // past last valid doc_id
   iresearch::doc_id_t next_;
 };
@@ -203,9 +242,14 @@ class segment_reader_impl : public sub_reader {
  public:
   static sub_reader::ptr open(
     const directory& dir, 
-    const segment_meta& meta
+    const segment_meta& meta,
+    const block_cache::ptr& cache
   );
 
+  const block_cache::ptr& cache() const NOEXCEPT {
+    return cache_;
+  }
+
   const directory& dir() const NOEXCEPT { 
     return dir_;
   }
@@ -224,6 +268,10 @@ class segment_reader_impl : public sub_reader {
 
   virtual docs_iterator_t::ptr docs_iterator() const override;
 
+  virtual uint64_t id() const NOEXCEPT override {
+    return id_;
+  }
+
   virtual doc_iterator::ptr mask(doc_iterator::ptr&& it) const override {
     if (docs_mask_.empty()) {
       return std::move(it);
@@ -262,10 +310,12 @@ class segment_reader_impl : public sub_reader {
   DECLARE_SPTR(segment_reader_impl); // required for NAMED_PTR(...)
   std::vector<column_meta> columns_;
   columnstore_reader::ptr columnstore_reader_;
+  block_cache::ptr cache_; // shared cache for columnstore blocks
   const directory& dir_;
   uint64_t docs_count_;
   document_mask docs_mask_;
   field_reader::ptr field_reader_;
+  uint64_t id_; // unique across all the readers opened by the process
   std::vector<column_meta*> id_to_column_;
   uint64_t meta_version_;
   std::unordered_map<hashed_string_ref, column_meta*> name_to_column_;
@@ -315,8 +365,9 @@ template<>
 
 /*static*/ segment_reader segment_reader::open(
     const directory& dir,
-    const segment_meta& meta) {
-  return segment_reader_impl::open(dir, meta);
+    const segment_meta& meta,
+    const block_cache::ptr& cache /*= nullptr*/) {
+  return segment_reader_impl::open(dir, meta, cache);
 }
 
 segment_reader segment_reader::reopen(const segment_meta& meta) const {
@@ -332,7 +383,7 @@ segment_reader segment_reader::reopen(const segment_meta& meta) const {
   // reuse self if no changes to meta
   return reader_impl.meta_version() == meta.version
     ? *this
-    : segment_reader_impl::open(reader_impl.dir(), meta);
+    : segment_reader_impl::open(reader_impl.dir(), meta, reader_impl.cache());
 }
 
 // -------------------------------------------------------------------
@@ -345,6 +396,7 @@ segment_reader_impl::segment_reader_impl(
     uint64_t docs_count)
   : dir_(dir),
     docs_count_(docs_count),
+    id_(next_reader_id()),
     meta_version_(meta_version) {
 }
 
@@ -392,9 +444,13 @@ sub_reader::docs_iterator_t::ptr segment_reader_impl::docs_iterator() const {
 }
 
 /*static*/ sub_reader::ptr segment_reader_impl::open(
-    const directory& dir, const segment_meta& meta) {
+    const directory& dir,
+    const segment_meta& meta,
+    const block_cache::ptr& cache) {
   PTR_NAMED(segment_reader_impl, reader, dir, meta.version, meta.docs_count);
 
+  reader->cache_ = cache;
+
   index_utils::read_document_mask(reader->docs_mask_, dir, meta);
 
   auto& codec = *meta.codec;
@@ -411,7 +467,7 @@ sub_reader::docs_iterator_t::ptr segment_reader_impl::docs_iterator() const {
 
   // initialize column reader (if available)
   if (segment_reader::has<irs::columnstore_reader>(meta)
-      && columnstore_reader->prepare(dir, meta)) {
+      && columnstore_reader->prepare(dir, meta, nullptr, cache)) {
     reader->columnstore_reader_ = std::move(columnstore_reader);
   }
 
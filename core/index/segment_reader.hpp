@@ -43,7 +43,16 @@ class IRESEARCH_API segment_reader final
   template<typename T>
   static bool has(const segment_meta& meta) NOEXCEPT;
 
-  static segment_reader open(const directory& dir, const segment_meta& meta);
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief open a segment reader over the specified directory
+  /// @param cache shared cache for the columnstore blocks, if nullptr then
+  ///        blocks are cached for the lifetime of the reader
+  ////////////////////////////////////////////////////////////////////////////////
+  static segment_reader open(
+    const directory& dir,
+    const segment_meta& meta,
+    const block_cache::ptr& cache = nullptr
+  );
 
   segment_reader() = default; // required for context<segment_reader>
   segment_reader(const segment_reader& other) NOEXCEPT;
@@ -79,6 +88,10 @@ class IRESEARCH_API segment_reader final
     return impl_->docs_iterator();
   }
 
+  virtual uint64_t id() const NOEXCEPT override {
+    return impl_->id();
+  }
+
   // FIXME find a better way to mask documents
   virtual doc_iterator::ptr mask(doc_iterator::ptr&& it) const override {
     return impl_->mask(std::move(it));
@@ -57,7 +57,7 @@ segment_writer::segment_writer(directory& dir) NOEXCEPT
 // expect 0-based doc_id
 bool segment_writer::remove(doc_id_t doc_id) {
   return doc_id < docs_cached()
-    && docs_mask_.insert(type_limits<type_t::doc_id_t>::min() + doc_id).second;
+    && docs_mask_.insert(type_limits<type_t::doc_id_t>::min() + doc_id);
 }
 
 bool segment_writer::index(
@@ -69,10 +69,15 @@ bool segment_writer::index(
   const doc_id_t doc_id = docs_cached();
   auto& slot = fields_.get(name);
   auto& slot_features = slot.meta().features;
+  const auto slot_memory = slot.memory();
 
   // invert only if new field features are a subset of slot features
-  if ((slot.empty() || features.is_subset_of(slot_features)) &&
-      slot.invert(tokens, slot.empty() ? features : slot_features, doc_id)) {
+  const bool inverted = (slot.empty() || features.is_subset_of(slot_features))
+    && slot.invert(tokens, slot.empty() ? features : slot_features, doc_id);
+
+  postings_memory_ += slot.memory() - slot_memory; // track dictionary growth
+
+  if (inverted) {
     if (features.check<norm>()) {
       norm_fields_.insert(&slot);
     }
@@ -109,14 +114,21 @@ void segment_writer::finish() {
   REGISTER_TIMER_DETAILED();
 
   // write document normalization factors (for each field marked for normalization))
-  float_t value;
+  // as quantized field lengths, documents of length 1 (i.e. norm::DEFAULT()) are omitted
   for (auto* field : norm_fields_) {
-    value = 1.f / float_t(std::sqrt(double_t(field->size())));
-    if (value != norm::DEFAULT()) {
+    const auto length = uint32_t(field->size()); // stored as uint32_t
+    if (1 != length) {
       auto& stream = field->norms(*col_writer_);
-      write_zvfloat(stream, value);
+      stream.write_byte(norm::quantize(length));
     }
   }
+
+  // stored fields and norms are buffered by the columnstore until flush
+  memory_ = fields_.memory()
+    + postings_memory_
+    + col_writer_->memory()
+    + columns_.size() * sizeof(decltype(columns_)::value_type)
+    + docs_context_.capacity() * sizeof(update_context);
 }
 
 bool segment_writer::flush(std::string& filename, segment_meta& meta) {
@@ -194,6 +206,8 @@ void segment_writer::reset() {
   docs_context_.clear();
   docs_mask_.clear();
   fields_.reset();
+  postings_memory_ = 0;
+  memory_ = 0;
 }
 
 void segment_writer::reset(const segment_meta& meta) {
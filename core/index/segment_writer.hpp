@@ -30,6 +30,8 @@
 #include "utils/directory_utils.hpp"
 #include "utils/noncopyable.hpp"
 
+#include <atomic>
+
 NS_ROOT
 
 struct segment_meta;
@@ -166,7 +168,7 @@ class IRESEARCH_API segment_writer: util::noncopyable {
   void begin(const update_context& ctx) {
     valid_ = true;
     norm_fields_.clear(); // clear norm fields
-    docs_mask_.reserve(docs_mask_.size() + 1); // reserve space for potential rollback
+    docs_mask_.reserve(type_limits<type_t::doc_id_t>::min() + docs_cached()); // reserve space for potential rollback
     docs_context_.emplace_back(ctx);
   }
 
@@ -214,6 +216,11 @@ class IRESEARCH_API segment_writer: util::noncopyable {
   const update_context& doc_context() const { return docs_context_.back(); }
   const document_mask& docs_mask() NOEXCEPT { return docs_mask_; }
   bool initialized() const NOEXCEPT { return initialized_; }
+
+  // returns estimated number of bytes occupied by the buffered documents,
+  // updated at the end of each document, may be called concurrently
+  size_t memory() const NOEXCEPT { return memory_.load(); }
+
   bool remove(doc_id_t doc_id); // expect 0-based doc_id
   bool valid() const NOEXCEPT { return valid_; }
   void reset();
@@ -325,6 +332,8 @@ class IRESEARCH_API segment_writer: util::noncopyable {
   column_meta_writer::ptr col_meta_writer_;
   columnstore_writer::ptr col_writer_;
   tracking_directory dir_;
+  std::atomic<size_t> memory_{ 0 }; // estimated memory of the buffered documents
+  size_t postings_memory_{ 0 }; // memory of the term dictionaries of all fields
   bool initialized_;
   bool valid_{ true }; // current state
   IRESEARCH_API_PRIVATE_VARIABLES_END
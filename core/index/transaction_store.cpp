@@ -22,6 +22,7 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "composite_reader_impl.hpp"
+#include "analysis/token_streams.hpp"
 #include "search/bitset_doc_iterator.hpp"
 #include "store/store_utils.hpp"
 
@@ -211,8 +212,9 @@ class store_reader_impl final: public irs::sub_reader {
     ): column_reader_t(std::move(entries)), meta_(meta) { assert(meta_); }
   };
 
-  typedef std::map<irs::string_ref, named_column_reader_t> columns_named_t;
-  typedef std::map<irs::field_id, column_reader_t> columns_unnamed_t;
+  // readers are shared between snapshots with the same column/field state
+  typedef std::map<irs::string_ref, std::shared_ptr<const named_column_reader_t>> columns_named_t;
+  typedef std::map<irs::field_id, std::shared_ptr<const column_reader_t>> columns_unnamed_t;
 
   struct term_entry_t {
     document_entries_t entries_;
@@ -249,7 +251,7 @@ class store_reader_impl final: public irs::sub_reader {
     virtual size_t size() const override { return terms_.size(); }
   };
 
-  typedef std::map<irs::string_ref, term_reader_t> fields_t;
+  typedef std::map<irs::string_ref, std::shared_ptr<const term_reader_t>> fields_t;
 
   virtual index_reader::reader_iterator begin() const override;
   virtual const irs::column_meta* column(const irs::string_ref& name) const override;
@@ -264,6 +266,11 @@ class store_reader_impl final: public irs::sub_reader {
   virtual uint64_t live_docs_count() const override { return documents_.count(); }
   virtual size_t size() const override { return 1; } // only 1 segment
 
+  const columns_named_t& columns_named() const NOEXCEPT { return columns_named_; }
+  const columns_unnamed_t& columns_unnamed() const NOEXCEPT { return columns_unnamed_; }
+  const fields_t& fields_map() const NOEXCEPT { return fields_; }
+  size_t generation() const NOEXCEPT { return generation_; }
+
  private:
   friend irs::store_reader irs::store_reader::reopen() const;
   friend bool irs::store_writer::commit();
@@ -300,7 +307,7 @@ class store_column_iterator final: public irs::column_iterator {
       return false; // already at end
     }
 
-    value_ = itr_->second.meta_.get();
+    value_ = itr_->second->meta_.get();
     ++itr_;
 
     return true;
@@ -576,7 +583,7 @@ class store_field_iterator final: public irs::field_iterator {
       return false; // already at end
     }
 
-    value_ = &(itr_->second);
+    value_ = itr_->second.get();
     ++itr_;
 
     return true;
@@ -840,13 +847,13 @@ store_reader_impl::store_reader_impl(
   auto& column_by_id = const_cast<column_by_id_t&>(column_by_id_); // initialize map
 
   for (auto& entry: columns_named_) {
-    auto& column = entry.second;
+    auto& column = *(entry.second);
 
     column_by_id.emplace(column.meta_->id, &column);
   }
 
   for (auto& entry: columns_unnamed_) {
-    column_by_id.emplace(entry.first, &(entry.second));
+    column_by_id.emplace(entry.first, entry.second.get());
   }
 }
 
@@ -861,7 +868,7 @@ const irs::column_meta* store_reader_impl::column(
 ) const {
   auto itr = columns_named_.find(name);
 
-  return itr == columns_named_.end() ? nullptr : itr->second.meta_.get();
+  return itr == columns_named_.end() ? nullptr : itr->second->meta_.get();
 }
 
 irs::column_iterator::ptr store_reader_impl::columns() const {
@@ -901,7 +908,7 @@ const irs::term_reader* store_reader_impl::field(
 ) const {
   auto itr = fields_.find(field);
 
-  return itr == fields_.end() ? nullptr : &(itr->second);
+  return itr == fields_.end() ? nullptr : itr->second.get();
 }
 
 irs::field_iterator::ptr store_reader_impl::fields() const {
@@ -910,6 +917,278 @@ irs::field_iterator::ptr store_reader_impl::fields() const {
   return irs::memory::make_managed<irs::field_iterator, true>(std::move(ptr));
 }
 
+// ----------------------------------------------------------------------------
+// --SECTION--                                          segment export helpers
+// ----------------------------------------------------------------------------
+
+// a token of a field in a document as read back from a reader
+struct export_token_t {
+  irs::doc_id_t doc;
+  size_t field; // field offset in the list of exported fields
+  uint32_t pos;
+  uint32_t offs_start;
+  uint32_t offs_end;
+  irs::bytes_ref term;
+  irs::bytes_ref payload;
+};
+
+bool operator<(const export_token_t& lhs, const export_token_t& rhs) {
+  if (lhs.doc != rhs.doc) {
+    return lhs.doc < rhs.doc;
+  }
+
+  return lhs.field == rhs.field ? lhs.pos < rhs.pos : lhs.field < rhs.field;
+}
+
+// replays tokens of a single document field in position order
+class export_token_stream final: public irs::token_stream {
+ public:
+  export_token_stream(): attrs_(4) { // increment + offset + payload + term
+    attrs_.emplace(inc_);
+    attrs_.emplace(offs_);
+    attrs_.emplace(pay_);
+    attrs_.emplace(term_);
+  }
+
+  virtual const irs::attribute_view& attributes() const NOEXCEPT override {
+    return attrs_;
+  }
+
+  virtual bool next() override {
+    if (begin_ == end_) {
+      return false;
+    }
+
+    inc_.value = begin_->pos - pos_; // first increment relative to an invalid position, same as in field_data
+    pos_ = begin_->pos;
+    offs_.start = begin_->offs_start;
+    offs_.end = begin_->offs_end;
+    pay_.value = begin_->payload;
+    term_.value(begin_->term);
+    ++begin_;
+
+    return true;
+  }
+
+  void reset(const export_token_t* begin, const export_token_t* end) {
+    begin_ = begin;
+    end_ = end;
+    pos_ = irs::integer_traits<uint32_t>::const_max;
+  }
+
+ private:
+  irs::attribute_view attrs_;
+  const export_token_t* begin_{};
+  const export_token_t* end_{};
+  irs::increment inc_;
+  irs::offset offs_;
+  irs::payload pay_;
+  uint32_t pos_;
+  irs::basic_term term_;
+};
+
+// an indexed field satisfying the 'Field' concept
+struct export_field_t {
+  const irs::flags* features_;
+  irs::string_ref name_;
+  export_token_stream* tokens_;
+
+  const irs::flags& features() const { return *features_; }
+  irs::token_stream& get_tokens() const { return *tokens_; }
+  const irs::string_ref& name() const { return name_; }
+};
+
+// a stored field satisfying the 'Attribute' concept
+struct export_value_t {
+  irs::string_ref name_;
+  irs::bytes_ref value_;
+
+  const irs::string_ref& name() const { return name_; }
+  bool write(irs::data_output& out) const {
+    out.write_bytes(value_.c_str(), value_.size());
+    return true;
+  }
+};
+
+// postings of a term positioned at the next document to export
+struct export_postings_t {
+  size_t field; // field offset in the list of exported fields
+  irs::bytes_ref term;
+  irs::doc_iterator::ptr docs;
+  const irs::frequency* freq;
+  irs::position* pos;
+  const irs::offset* offs;
+  const irs::payload* pay;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief insert all live documents of 'reader' into 'writer' in batches of
+///        at most 'batch_size' documents, postings of all terms are kept open
+///        and advanced through the batches, so only tokens of the documents
+///        in the current batch are reconstructed in memory
+/// @return all documents inserted successfully
+////////////////////////////////////////////////////////////////////////////////
+bool export_documents(
+    irs::index_writer& writer,
+    const irs::sub_reader& reader,
+    size_t batch_size
+) {
+  typedef std::pair<const irs::column_meta*, irs::columnstore_reader::values_reader_f> column_t;
+
+  std::vector<const irs::term_reader*> fields;
+  std::vector<column_t> columns;
+  std::vector<export_postings_t> postings;
+
+  for (auto itr = reader.fields(); itr->next();) {
+    fields.emplace_back(&(itr->value()));
+  }
+
+  for (auto itr = reader.columns(); itr->next();) {
+    auto& meta = itr->value();
+    auto* column = reader.column_reader(meta.id);
+
+    if (column) {
+      columns.emplace_back(&meta, column->values());
+    }
+  }
+
+  // open postings of every term at its first document, term refs point into the store
+  for (size_t field_id = 0, fields_count = fields.size(); field_id < fields_count; ++field_id) {
+    auto& field = *(fields[field_id]);
+    auto& features = field.meta().features;
+
+    for (auto terms = field.iterator(); terms->next();) {
+      export_postings_t entry;
+
+      entry.field = field_id;
+      entry.term = terms->value();
+      entry.docs = terms->postings(features);
+
+      if (!entry.docs->next()) {
+        continue; // no live documents
+      }
+
+      entry.freq = entry.docs->attributes().get<irs::frequency>().get();
+      entry.pos = entry.docs->attributes().get<irs::position>().get();
+      entry.offs = entry.pos ? entry.pos->attributes().get<irs::offset>().get() : nullptr;
+      entry.pay = entry.pos ? entry.pos->attributes().get<irs::payload>().get() : nullptr;
+      postings.emplace_back(std::move(entry));
+    }
+  }
+
+  std::vector<irs::doc_id_t> batch;
+  std::vector<export_token_t> tokens;
+  export_token_stream stream;
+  irs::bytes_ref value;
+  bool valid = true;
+
+  batch_size = std::max(size_t(1), batch_size);
+  batch.reserve(batch_size);
+
+  for (auto docs = reader.docs_iterator(); valid;) {
+    batch.clear();
+
+    while (batch.size() < batch_size && docs->next()) {
+      batch.emplace_back(docs->value());
+    }
+
+    if (batch.empty()) {
+      break; // all documents exported
+    }
+
+    tokens.clear();
+
+    // collect tokens of the documents in [batch.front(), batch.back()]
+    for (auto& entry: postings) {
+      for (auto doc = entry.docs->value(); doc <= batch.back();) {
+        export_token_t token;
+
+        token.doc = doc;
+        token.field = entry.field;
+        token.offs_start = 0;
+        token.offs_end = 0;
+        token.term = entry.term;
+
+        if (!entry.pos) {
+          // no positions to preserve, each occurence is at the next position
+          for (uint32_t i = 0, count = entry.freq ? entry.freq->value : 1; i < count; ++i) {
+            token.pos = i;
+            tokens.emplace_back(token);
+          }
+        } else {
+          while (entry.pos->next()) {
+            token.pos = entry.pos->value();
+
+            if (entry.offs) {
+              token.offs_start = entry.offs->start;
+              token.offs_end = entry.offs->end;
+            }
+
+            token.payload = entry.pay ? entry.pay->value : irs::bytes_ref::NIL;
+            tokens.emplace_back(token);
+          }
+        }
+
+        doc = entry.docs->next()
+          ? entry.docs->value()
+          : irs::type_limits<irs::type_t::doc_id_t>::eof();
+      }
+    }
+
+    // release postings of the exhausted terms
+    postings.erase(
+      std::remove_if(
+        postings.begin(), postings.end(),
+        [](const export_postings_t& entry)->bool {
+          return irs::type_limits<irs::type_t::doc_id_t>::eof(entry.docs->value());
+      }),
+      postings.end()
+    );
+
+    std::sort(tokens.begin(), tokens.end());
+
+    // insert documents of the current batch (in the same order)
+    auto token_itr = tokens.cbegin();
+    auto doc_itr = batch.cbegin();
+
+    valid = writer.insert([&](irs::segment_writer::document& dst)->bool {
+      const auto doc = *doc_itr;
+
+      while (token_itr != tokens.cend() && token_itr->doc < doc) {
+        ++token_itr; // not a live document of the snapshot
+      }
+
+      while (token_itr != tokens.cend() && token_itr->doc == doc) {
+        auto field_begin = token_itr;
+
+        while (token_itr != tokens.cend()
+               && token_itr->doc == doc
+               && token_itr->field == field_begin->field) {
+          ++token_itr;
+        }
+
+        auto& field = *(fields[field_begin->field]);
+        export_field_t indexed{ &(field.meta().features), field.meta().name, &stream };
+
+        stream.reset(&*field_begin, &*field_begin + (token_itr - field_begin));
+        valid = dst.insert(irs::action::index, indexed) && valid;
+      }
+
+      for (auto& column: columns) {
+        if (column.second(doc, value)) {
+          export_value_t stored{ column.first->name, value };
+
+          valid = dst.insert(irs::action::store, stored) && valid;
+        }
+      }
+
+      return ++doc_itr != batch.cend();
+    }) && valid;
+  }
+
+  return valid;
+}
+
 NS_END
 
 NS_ROOT
@@ -918,6 +1197,11 @@ class transaction_store::store_reader_helper {
  public:
   ////////////////////////////////////////////////////////////////////////////////
   /// @brief fill reader state only for the specified documents
+  /// @param base reader state to reuse columns/fields from, i.e. ones without
+  ///        commits since base.generation() and not modified by 'writer',
+  ///        nullptr == rebuild everything
+  /// @param writer the writer whose columns/fields must be rebuilt since they
+  ///        contain uncommitted documents, nullptr == no such writer
   /// @note caller must have read lock on store.mutex_
   ////////////////////////////////////////////////////////////////////////////////
   static size_t get_reader_state_unsafe(
@@ -925,7 +1209,9 @@ class transaction_store::store_reader_helper {
       store_reader_impl::columns_named_t& columns_named,
       store_reader_impl::columns_unnamed_t& columns_unnamed,
       const transaction_store& store,
-      const bitvector& documents
+      const bitvector& documents,
+      const store_reader_impl* base = nullptr,
+      const store_writer* writer = nullptr
   ) {
     fields.clear();
     columns_named.clear();
@@ -933,10 +1219,25 @@ class transaction_store::store_reader_helper {
 
     // copy over non-empty columns into an ordered map
     for (auto& columns_entry: store.columns_named_) {
+      auto& column = columns_entry.second;
+
+      // reuse column state from 'base' if column was not modified since
+      if (base
+          && column.generation_ <= base->generation()
+          && (!writer || writer->modified_columns_.find(&column) == writer->modified_columns_.end())) {
+        auto itr = base->columns_named().find(columns_entry.first);
+
+        if (itr != base->columns_named().end()) {
+          columns_named.emplace(itr->first, itr->second);
+        }
+
+        continue;
+      }
+
       store_reader_impl::document_entries_t entries;
 
       // copy over valid documents
-      for (auto& entry: columns_entry.second.entries_) {
+      for (auto& entry: column.entries_) {
         if (entry.buf_ && documents.test(entry.doc_id_)) {
           entries.emplace_back(entry);
         }
@@ -948,18 +1249,34 @@ class transaction_store::store_reader_helper {
 
       std::sort(entries.begin(), entries.end(), DOC_LESS); // sort by doc_id
       columns_named.emplace(
-        std::piecewise_construct,
-        std::forward_as_tuple(columns_entry.first), // key
-        std::forward_as_tuple(columns_entry.second.meta_, std::move(entries)) // value
+        columns_entry.first, // key
+        std::make_shared<store_reader_impl::named_column_reader_t>(
+          column.meta_, std::move(entries)
+        ) // value
       );
     }
 
     // copy over non-empty columns into an ordered map
     for (auto& columns_entry: store.columns_unnamed_) {
+      auto& column = columns_entry.second;
+
+      // reuse column state from 'base' if column was not modified since
+      if (base
+          && column.generation_ <= base->generation()
+          && (!writer || writer->modified_columns_.find(&column) == writer->modified_columns_.end())) {
+        auto itr = base->columns_unnamed().find(columns_entry.first);
+
+        if (itr != base->columns_unnamed().end()) {
+          columns_unnamed.emplace(itr->first, itr->second);
+        }
+
+        continue;
+      }
+
       store_reader_impl::document_entries_t entries;
 
       // copy over valid documents
-      for (auto& entry: columns_entry.second.entries_) {
+      for (auto& entry: column.entries_) {
         if (entry.buf_ && documents.test(entry.doc_id_)) {
           entries.emplace_back(entry);
         }
@@ -971,19 +1288,33 @@ class transaction_store::store_reader_helper {
 
       std::sort(entries.begin(), entries.end(), DOC_LESS); // sort by doc_id
       columns_unnamed.emplace(
-        std::piecewise_construct,
-        std::forward_as_tuple(columns_entry.first), // key
-        std::forward_as_tuple(std::move(entries)) // value
+        columns_entry.first, // key
+        std::make_shared<store_reader_impl::column_reader_t>(std::move(entries)) // value
       );
     }
 
     // copy over non-empty fields into an ordered map
     for (auto& field_entry: store.fields_) {
+      auto& field = field_entry.second;
+
+      // reuse field state from 'base' if field was not modified since
+      if (base
+          && field.generation_ <= base->generation()
+          && (!writer || writer->modified_fields_.find(&field) == writer->modified_fields_.end())) {
+        auto itr = base->fields_map().find(field_entry.first);
+
+        if (itr != base->fields_map().end()) {
+          fields.emplace(itr->first, itr->second);
+        }
+
+        continue;
+      }
+
       bitvector field_docs;
-      store_reader_impl::term_reader_t terms(field_entry.second.meta_);
+      auto terms = std::make_shared<store_reader_impl::term_reader_t>(field.meta_);
 
       // copy over non-empty terms into an ordered map
-      for (auto& term_entry: field_entry.second.terms_) {
+      for (auto& term_entry: field.terms_) {
         store_reader_impl::document_entries_t postings;
 
         // copy over valid postings
@@ -1000,35 +1331,52 @@ class transaction_store::store_reader_helper {
 
         std::sort(postings.begin(), postings.end(), DOC_LESS); // sort by doc_id
 
-        auto& term = terms.terms_.emplace(
+        auto& term = terms->terms_.emplace(
           std::piecewise_construct,
           std::forward_as_tuple(term_entry.first), // key
           std::forward_as_tuple(term_entry.second.name_, term_entry.second.meta_, std::move(postings)) // value
         ).first->first;
 
-        if (terms.min_term_.null() || terms.min_term_ > term) {
-          terms.min_term_ = term; // point at term in reader map
+        if (terms->min_term_.null() || terms->min_term_ > term) {
+          terms->min_term_ = term; // point at term in reader map
         }
 
-        if (terms.max_term_.null() || terms.max_term_ < term) {
-          terms.max_term_ = term; // point at term in reader map
+        if (terms->max_term_.null() || terms->max_term_ < term) {
+          terms->max_term_ = term; // point at term in reader map
         }
       }
 
-      if (terms.terms_.empty()) {
+      if (terms->terms_.empty()) {
         continue; // no terms in field, skip
       }
 
-      terms.doc_count_ = field_docs.count();
-      map_utils::try_emplace(
-        fields,
-        field_entry.first, // key
-        std::move(terms) // value
-      );
+      terms->doc_count_ = field_docs.count();
+      fields.emplace(field_entry.first, std::move(terms));
     }
 
     return store.generation_; // obtain store generation while under lock
   }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @return the last reader state cached by the store, nullptr == none
+  ////////////////////////////////////////////////////////////////////////////////
+  static std::shared_ptr<sub_reader> snapshot(const transaction_store& store) {
+    SCOPED_LOCK(store.snapshot_mutex_);
+
+    return store.snapshot_;
+  }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief replace the reader state cached by the store
+  /// @note caller must have a lock on store.mutex_
+  ////////////////////////////////////////////////////////////////////////////////
+  static void snapshot(
+      const transaction_store& store, std::shared_ptr<sub_reader> snapshot
+  ) {
+    SCOPED_LOCK(store.snapshot_mutex_);
+
+    store.snapshot_.swap(snapshot);
+  }
 };
 
 store_reader::store_reader(impl_ptr&& impl) NOEXCEPT
@@ -1110,6 +1458,8 @@ bool store_writer::commit() {
     // cannot remove from 'store_.used_doc_ids_' because docs are still in postings
 
     // reset for next run
+    modified_columns_.clear();
+    modified_fields_.clear();
     modification_queries_.clear();
     next_doc_id_ = type_limits<type_t::doc_id_t>::min();
     used_doc_ids_.clear();
@@ -1123,7 +1473,7 @@ bool store_writer::commit() {
     modified_lock.lock(); // prevent concurrent removals/updates (ensure reader stays valid until store state update is complete)
 
     async_utils::read_write_mutex::read_mutex mutex(store_.mutex_);
-    SCOPED_LOCK(mutex); // reading 'store_.visible_docs_' and get_reader_state_unsafe(...)
+    SCOPED_LOCK_NAMED(mutex, lock); // reading 'store_.visible_docs_' and get_reader_state_unsafe(...)
     bitvector candidate_documents = used_doc_ids_; // all documents since some of them might be updates
 
     candidate_documents |= store_.visible_docs_; // all documents used by writer + all visible documents in store
@@ -1132,9 +1482,21 @@ bool store_writer::commit() {
     store_reader_impl::columns_unnamed_t columns_unnamed;
     bitvector documents = store_.visible_docs_; // all visible doc ids from store + all visible doc ids from writer up to the current update generation
     store_reader_impl::fields_t fields;
+    auto snapshot = transaction_store::store_reader_helper::snapshot(store_);
+
+    // share columns/fields of the last reader not modified since (writer documents are only in the ones modified by writer)
     auto generation = transaction_store::store_reader_helper::get_reader_state_unsafe(
-      fields, columns_named, columns_unnamed, store_, candidate_documents
+      fields,
+      columns_named,
+      columns_unnamed,
+      store_,
+      candidate_documents,
+      static_cast<const store_reader_impl*>(snapshot.get()),
+      this
     );
+
+    lock.unlock(); // filters are evaluated without blocking the store, 'store_.generation_mutex_' prevents concurrent removals/updates
+
     bitvector processed_documents; // all visible doc ids from writer up to the current update generation
     store_reader_impl reader(
       store_,
@@ -1203,6 +1565,20 @@ bool store_writer::commit() {
   ++(store_.generation_); // mark store state as modified
   store_.visible_docs_ |= valid_doc_ids_; // commit doc_ids
   store_.visible_docs_ -= invalid_doc_ids; // commit removals
+
+  // mark columns/fields with newly visible documents as modified
+  for (auto& entry: modified_columns_) {
+    entry.second->generation_ = store_.generation_;
+  }
+
+  for (auto& entry: modified_fields_) {
+    entry.second->generation_ = store_.generation_;
+  }
+
+  // removed documents may be in any column/field, do not reuse any reader state
+  if (invalid_doc_ids.any()) {
+    transaction_store::store_reader_helper::snapshot(store_, nullptr);
+  }
   used_doc_ids_ -= valid_doc_ids_; // exclude 'valid' from 'used' (so commited docs would remain valid when transaction is cleaned up)
   used_doc_ids_ |= invalid_doc_ids; // include 'invalid' into 'used' (so removed docs would be invalidated when transaction is cleaned up)
 
@@ -1250,6 +1626,13 @@ bool store_writer::index(
     return false;
   }
 
+  modified_fields_.emplace(&*field, field); // field will have to be reread on commit
+
+  // the 'norm' column of the field is written together with the field
+  if (field->norm_col_ref_) {
+    modified_columns_.emplace(&*(field->norm_col_ref_), field->norm_col_ref_); // column will have to be reread on commit
+  }
+
   bool has_freq = field->meta_->features.check<frequency>();
   bool has_offs = has_freq && field->meta_->features.check<offset>() && offs;
   bool has_pay = has_offs && pay;
@@ -1465,6 +1848,8 @@ bool store_writer::store(
     return false;
   }
 
+  modified_columns_.emplace(&*column, transaction_store::ref_t<transaction_store::column_t>(*column)); // column will have to be reread on commit
+
   auto& column_state_offset = map_utils::try_emplace(
     state.offsets_,
     &*column, // key
@@ -1637,6 +2022,7 @@ void transaction_store::clear() {
   *reusable_ = false; // prevent existing writers from commiting into the store
   reusable_ = std::move(reusable); // mark new generation
   visible_docs_.clear(); // mark all documents are non-visible
+  store_reader_helper::snapshot(*this, nullptr); // reader state no longer valid
 }
 
 store_reader transaction_store::flush() {
@@ -1650,8 +2036,63 @@ store_reader transaction_store::flush() {
     ++generation_; // mark state as modified
     valid_doc_ids_ -= visible_docs_; // remove flushed ids from 'valid'
     visible_docs_.clear(); // remove flushed ids from 'visible'
+    store_reader_helper::snapshot(*this, nullptr); // reader state no longer valid
+  }
+
+  return reader;
+}
+
+store_reader transaction_store::flush(
+    index_writer& writer, size_t batch_size /*= DEFAULT_FLUSH_BATCH_SIZE*/
+) {
+  REGISTER_TIMER_DETAILED();
+  store_reader reader;
+
+  {
+    SCOPED_LOCK(generation_mutex_); // do not snapshot in the middle of an in-progress writer commit with removals/updates
+    reader = transaction_store::reader(); // documents are exported without holding a lock on 'mutex_'/'generation_mutex_'
+  }
+
+  if (!reader) {
+    return reader;
+  }
+
+  if (!export_documents(writer, reader, batch_size)) {
+    IR_FRMT_ERROR(
+      "failed to export " IR_UINT64_T_SPECIFIER " transaction store documents into index writer",
+      reader.live_docs_count()
+    );
+
+    return store_reader();
+  }
+
+  bitvector exported;
+
+  for (auto itr = reader.docs_iterator(); itr->next();) {
+    exported.set(itr->value());
+  }
+
+  SCOPED_LOCK(generation_mutex_); // prevent concurrent removals/updates while checking for conflicts
+  async_utils::read_write_mutex::write_mutex mutex(mutex_);
+  SCOPED_LOCK(mutex);
+  bitvector removed = exported;
+
+  removed -= visible_docs_; // exported documents removed/updated/cleared during export
+
+  if (removed.any()) {
+    IR_FRMT_ERROR(
+      "failed to export transaction store documents into index writer, " IR_SIZE_T_SPECIFIER " exported documents were removed concurrently",
+      removed.count()
+    );
+
+    return store_reader();
   }
 
+  ++generation_; // mark state as modified
+  valid_doc_ids_ -= exported; // remove exported ids from 'valid'
+  visible_docs_ -= exported; // remove exported ids from 'visible', documents commited during export remain
+  store_reader_helper::snapshot(*this, nullptr); // reader state no longer valid
+
   return reader;
 }
 
@@ -1822,17 +2263,27 @@ store_reader transaction_store::reader() const {
   store_reader_impl::columns_unnamed_t columns_unnamed;
   bitvector documents;
   store_reader_impl::fields_t fields;
-  size_t generation;
+  async_utils::read_write_mutex::read_mutex mutex(mutex_);
+  SCOPED_LOCK(mutex); // hold lock until new snapshot is cached (prevent generation modification)
+  auto snapshot = store_reader_helper::snapshot(*this);
 
-  {
-    async_utils::read_write_mutex::read_mutex mutex(mutex_);
-    SCOPED_LOCK(mutex);
-    documents = visible_docs_;
-    generation = transaction_store::store_reader_helper::get_reader_state_unsafe(
-      fields, columns_named, columns_unnamed, *this, documents
-    );
+  #ifdef IRESEARCH_DEBUG
+    auto* base = dynamic_cast<const store_reader_impl*>(snapshot.get());
+  #else
+    auto* base = static_cast<const store_reader_impl*>(snapshot.get());
+  #endif
+
+  if (base && base->generation() == generation_) {
+    return store_reader(std::move(snapshot)); // reuse same reader since there were no changes in store
   }
 
+  documents = visible_docs_;
+
+  // only columns/fields with commits after 'base' are rebuilt, others are shared
+  auto generation = store_reader_helper::get_reader_state_unsafe(
+    fields, columns_named, columns_unnamed, *this, documents, base
+  );
+
   documents.shrink_to_fit();
 
   PTR_NAMED(
@@ -1845,8 +2296,11 @@ store_reader transaction_store::reader() const {
     std::move(columns_unnamed),
     generation
   );
+  std::shared_ptr<sub_reader> impl(std::move(reader));
+
+  store_reader_helper::snapshot(*this, impl);
 
-  return store_reader(std::move(reader));
+  return store_reader(std::move(impl));
 }
 
 NS_END // ROOT
@@ -183,6 +183,27 @@ class IRESEARCH_API transaction_store: private util::noncopyable {
   ////////////////////////////////////////////////////////////////////////////
   store_reader flush();
 
+  ////////////////////////////////////////////////////////////////////////////
+  /// @brief export all completed transactions directly into new segments of
+  ///        'writer' and remove them from the store, i.e. documents are
+  ///        inserted via the writer's segment_writer instead of being merged
+  ///        from a flushed reader via index_writer::import(...)
+  /// @note may be run in a background thread, new transactions (including
+  ///       removals/updates) may commit concurrently, the export fails if
+  ///       any of the exported documents was removed/updated meanwhile
+  /// @note exported documents are visible via 'writer' only after its
+  ///       commit(), until then they are visible via the returned reader
+  /// @param batch_size max number of documents reconstructed in memory and
+  ///        inserted per index_writer::insert(...)
+  /// @return reader with the exported state or false on failure (export
+  ///         error or concurrent removal/update of an exported document),
+  ///         documents remain in the store but the ones already inserted
+  ///         remain in 'writer', the caller must rollback() 'writer'
+  ////////////////////////////////////////////////////////////////////////////
+  store_reader flush(
+    index_writer& writer, size_t batch_size = DEFAULT_FLUSH_BATCH_SIZE
+  );
+
   ////////////////////////////////////////////////////////////////////////////////
   /// @brief create an index reader over already commited documents in the store
   ////////////////////////////////////////////////////////////////////////////////
@@ -242,6 +263,7 @@ class IRESEARCH_API transaction_store: private util::noncopyable {
 
   struct column_t: private util::noncopyable { // no copy because of ref tracking
     std::vector<document_entry_t> entries_;
+    size_t generation_{}; // store generation of the last commit with documents in this column
     std::atomic<size_t> refs_{}; // ref tracking for term addition/write-pending operations
   };
 
@@ -271,6 +293,7 @@ class IRESEARCH_API transaction_store: private util::noncopyable {
 
   struct terms_t: private util::noncopyable { // no copy because of ref tracking
     const field_meta_builder::ptr meta_;
+    size_t generation_{}; // store generation of the last commit with documents in this field
     ref_t<column_t> norm_col_ref_;
     std::atomic<size_t> refs_{}; // ref tracking for term addition/write-pending operations
     std::unordered_map<hashed_bytes_ref, postings_t> terms_;
@@ -287,6 +310,7 @@ class IRESEARCH_API transaction_store: private util::noncopyable {
   typedef ref_t<terms_t> field_ref_t;
   typedef std::shared_ptr<bool> reusable_t;
 
+  static const size_t DEFAULT_FLUSH_BATCH_SIZE = 1024; // arbitrary value
   static const size_t DEFAULT_POOL_SIZE = 128; // arbitrary value
   bstring_pool_t bstring_pool_;
   column_meta_pool_t column_meta_pool_;
@@ -298,6 +322,8 @@ class IRESEARCH_API transaction_store: private util::noncopyable {
   std::mutex generation_mutex_; // prevent generation modification during writer commit with removals/updates and flush (used before aquiring write lock on mutex_)
   mutable async_utils::read_write_mutex mutex_; // mutex for 'columns_', 'fields_', 'generation_', 'visible_docs_'
   reusable_t reusable_;
+  mutable std::shared_ptr<sub_reader> snapshot_; // last reader state, its unmodified fields/columns are shared with the next reader, nullptr == rebuild everything
+  mutable std::mutex snapshot_mutex_; // mutex for 'snapshot_' (used after aquiring lock on mutex_)
   bitvector used_column_ids_; // true == column id is in use by some column
 
   // doc_id states: used -> valid -> visible
@@ -556,6 +582,8 @@ class IRESEARCH_API store_writer final: private util::noncopyable {
   }
 
  private:
+  friend class transaction_store::store_reader_helper; // for access to 'modified_columns_'/'modified_fields_'
+
   // a data_output implementation backed by an output_iterator
   struct bstring_data_output: public data_output {
     bstring_output& out_;
@@ -609,6 +637,8 @@ class IRESEARCH_API store_writer final: private util::noncopyable {
   transaction_store& store_;
   bitvector used_doc_ids_; // true == doc_id allocated to this writer, false == doc_id not allocated to this writer
   bitvector valid_doc_ids_; // true == commit pending, false == do not commit
+  std::unordered_map<const transaction_store::column_t*, transaction_store::ref_t<transaction_store::column_t>> modified_columns_; // columns (user and system) with documents from this writer
+  std::unordered_map<const transaction_store::terms_t*, transaction_store::field_ref_t> modified_fields_; // fields with documents from this writer
 
   ////////////////////////////////////////////////////////////////////////////
   /// @brief insert documents provided by 'func' into store
@@ -101,6 +101,7 @@
         virtual parser::token_type yylex(parser::semantic_type& value, parser::location_type& location) = 0;
 
         // value operations
+        virtual parser::semantic_type placeholder(parser::location_type const& location) = 0;
         virtual parser::semantic_type sequence(parser::location_type const& location) = 0;
 
         // node operations
@@ -198,6 +199,7 @@
 %token IQL_UNKNOWN   "unknown token marker"
 %token IQL_SEP       "token separator"
 %token IQL_SEQUENCE  "data sub-sequence"
+%token IQL_PLACEHOLDER "bound value placeholder"
 
 // logical operators
 %token IQL_NOT       "negation operator"
@@ -330,6 +332,11 @@ sequence:
   plain_literal
 | dquoted_literal
 | squoted_literal
+| placeholder
+;
+
+placeholder:
+  IQL_PLACEHOLDER { if (!($$ = ctx.placeholder(@1))) YYERROR; @$.begin = @1.begin; @$.end = @1.end; }
 ;
 
 plain_literal:
@@ -25,6 +25,7 @@
   #include <string.h>
 #endif
 
+#include <numeric>
 #include <stdint.h>
 #include <unordered_map>
 #include <unordered_set>
@@ -53,8 +54,14 @@ namespace {
 // -----------------------------------------------------------------------------
 
 parser_context::parser_context(
-  std::string const& sData, functions const& functions /*= defaults::FUNCTIONS*/
-): m_sData(sData), m_functions(functions), m_nNext(0), m_eState(StateType::NONE)
+  std::string const& sData,
+  functions const& functions /*= defaults::FUNCTIONS*/,
+  bool bPlaceholders /*= false*/
+): m_sData(sData),
+   m_functions(functions),
+   m_nNext(0),
+   m_bPlaceholders(bPlaceholders),
+   m_eState(StateType::NONE)
 {
   m_nodes.resize(2); // add an error node at position 0 (a.k.a. UNKNOWN)
 
@@ -110,6 +117,41 @@ parser::token_type parser_context::yylex(
 // --SECTION--                                                  value operations
 // -----------------------------------------------------------------------------
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create a node representing a placeholder of a value supplied later
+///        when building the query, i.e. '$N' is the N-th bound value
+/// @return ID of the node with the placeholder or UNKNOWN on error
+////////////////////////////////////////////////////////////////////////////////
+parser::semantic_type parser_context::placeholder(
+  parser::location_type const& location
+) {
+  if (location.end.column < location.begin.column + 2 || // +2 for '$' and a digit
+      m_sData.size() < location.end.column) {
+    return *const_cast<parser::semantic_type*>(&UNKNOWN); // index out of bounds
+  }
+
+  char const* pcStart = &(m_sData.c_str()[location.begin.column + 1]); // +1 for '$'
+  char* pcNext;
+  auto nValue = strtoul(pcStart, &pcNext, 10);
+
+  if (pcNext - pcStart != location.end.column - location.begin.column - 1 ||
+      !nValue) {
+    return *const_cast<parser::semantic_type*>(&UNKNOWN); // placeholders start from '$1'
+  }
+
+  parser::semantic_type value;
+  auto& node = create_node(value);
+
+  node.type = query_node::NodeType::PLACEHOLDER;
+  node.nPlaceholder = nValue - 1;
+  node.sValue = m_sData.substr(
+    location.begin.column, location.end.column - location.begin.column
+  );
+  m_placeholders.emplace_back(value);
+
+  return value; // ID of new node
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief create a node representing a sequence literal
 /// @return ID of the node with the literal or UNKNOWN on error
@@ -210,6 +252,7 @@ parser::semantic_type parser_context::function(
   case query_node::NodeType::BOOL_TRUE: // fall through
   case query_node::NodeType::EQUAL: // fall through
   case query_node::NodeType::LIKE: // fall through
+  case query_node::NodeType::PLACEHOLDER: // fall through
   case query_node::NodeType::SEQUENCE:
     nArgsCount = 1;
     bArgsDirect = true;
@@ -383,8 +426,8 @@ parser::semantic_type parser_context::range(
   auto& maxNode = find_node(maxNodeId);
 
   // only support values are range parameters
-  if (!((query_node::NodeType::FUNCTION == minNode.type && minNode.pFnSequence) || query_node::NodeType::SEQUENCE == minNode.type || query_node::NodeType::UNKNOWN == minNode.type) ||
-      !((query_node::NodeType::FUNCTION == maxNode.type && maxNode.pFnSequence) || query_node::NodeType::SEQUENCE == maxNode.type || query_node::NodeType::UNKNOWN == maxNode.type) ||
+  if (!((query_node::NodeType::FUNCTION == minNode.type && minNode.pFnSequence) || query_node::NodeType::SEQUENCE == minNode.type || query_node::NodeType::PLACEHOLDER == minNode.type || query_node::NodeType::UNKNOWN == minNode.type) ||
+      !((query_node::NodeType::FUNCTION == maxNode.type && maxNode.pFnSequence) || query_node::NodeType::SEQUENCE == maxNode.type || query_node::NodeType::PLACEHOLDER == maxNode.type || query_node::NodeType::UNKNOWN == maxNode.type) ||
       (query_node::NodeType::UNKNOWN == minNode.type && query_node::NodeType::UNKNOWN == maxNode.type)) {
     return *const_cast<parser::semantic_type*>(&UNKNOWN);
   }
@@ -418,7 +461,7 @@ parser::semantic_type parser_context::op_eq(
   auto& rangeNode = find_node(rangeNodeId);
 
   // only support values are range parameters
-  if (!((query_node::NodeType::FUNCTION == nameNode.type && nameNode.pFnSequence) || query_node::NodeType::SEQUENCE == nameNode.type) ||
+  if (!((query_node::NodeType::FUNCTION == nameNode.type && nameNode.pFnSequence) || query_node::NodeType::SEQUENCE == nameNode.type || query_node::NodeType::PLACEHOLDER == nameNode.type) ||
       query_node::NodeType::RANGE != rangeNode.type) {
     return *const_cast<parser::semantic_type*>(&UNKNOWN);
   }
@@ -446,8 +489,8 @@ parser::semantic_type parser_context::op_like(
   auto& node2 = find_node(rightNodeId);
 
   // only support values are range parameters
-  if (!((query_node::NodeType::FUNCTION == node1.type && node1.pFnSequence) || query_node::NodeType::SEQUENCE == node1.type) ||
-      !((query_node::NodeType::FUNCTION == node2.type && node2.pFnSequence) || query_node::NodeType::SEQUENCE == node2.type)) {
+  if (!((query_node::NodeType::FUNCTION == node1.type && node1.pFnSequence) || query_node::NodeType::SEQUENCE == node1.type || query_node::NodeType::PLACEHOLDER == node1.type) ||
+      !((query_node::NodeType::FUNCTION == node2.type && node2.pFnSequence) || query_node::NodeType::SEQUENCE == node2.type || query_node::NodeType::PLACEHOLDER == node2.type)) {
     return *const_cast<parser::semantic_type*>(&UNKNOWN);
   }
 
@@ -804,7 +847,13 @@ parser_context::query_state parser_context::current_state() const {
     /*pnFilter =*/ m_filter.first ? &m_filter.second : nullptr,
     /*order =*/    m_order,
     /*pnLimit =*/  m_limit.first ? &m_limit.second : nullptr,
-    /*pError =*/   m_error.first ? &m_error.second : nullptr
+    /*pError =*/   m_error.first ? &m_error.second : nullptr,
+    /*nPlaceholders =*/ std::accumulate(
+      m_placeholders.begin(), m_placeholders.end(), size_t(0),
+      [this](size_t nCount, size_t nodeId)->size_t {
+        return (std::max)(nCount, find_node(nodeId).nPlaceholder + 1);
+      }
+    )
   };
 }
 
@@ -837,7 +886,7 @@ parser_context::query_node const& parser_context::find_node(
 ////////////////////////////////////////////////////////////////////////////////
 void parser_context::print(
   std::ostream & out, parser::semantic_type const& root, bool bBoost, bool bId
-) {
+) const {
   auto const& node = find_node(root);
   std::string sChildDelim = "";
 
@@ -881,6 +930,10 @@ void parser_context::print(
     out << "'" << node.sValue << "'";
     if (bId) out << "@" << root;
     return;
+  case query_node::NodeType::PLACEHOLDER:
+    out << node.sValue;
+    if (bId) out << "@" << root;
+    return;
   default:
     out << "\?\?\?(" << node.type << ")";
     if (bId) out << "@" << root;
@@ -1114,6 +1167,14 @@ parser::token_type parser_context::next() {
     return type;
   }
 
+  // ...........................................................................
+  // check if it's a placeholder (only for queries compiled for later binding)
+  // ...........................................................................
+  if (m_bPlaceholders &&
+      (type = nextPlaceholder()) != parser::token_type::IQL_UNKNOWN) {
+    return type;
+  }
+
   bool bSeen = false;
 
   while (m_nNext < m_sData.size() &&
@@ -1237,6 +1298,38 @@ parser::token_type parser_context::nextOperator() {
   return parser::token_type::IQL_UNKNOWN;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief read next token as a placeholder, i.e. '$' followed by digits
+///        do not modify m_nNext if IQL_UNKNOWN
+/// @return token type or IQL_UNKNOWN if not a placeholder
+////////////////////////////////////////////////////////////////////////////////
+parser::token_type parser_context::nextPlaceholder() {
+  if ('$' != m_sData[m_nNext]) {
+    return parser::token_type::IQL_UNKNOWN;
+  }
+
+  size_t nEnd = m_nNext + 1; // +1 for '$'
+
+  // find end of digits
+  for (size_t nCount = m_sData.size(); nEnd < nCount; ++nEnd) {
+    if (!isdigit((uint8_t)(m_sData[nEnd]))) {
+      break;
+    }
+  }
+
+  // must have digits and be followed by a token boundary, e.g. '$1a' is a sequence
+  if (nEnd == m_nNext + 1 ||
+      (nEnd < m_sData.size() &&
+       !isspace((uint8_t)(m_sData[nEnd])) &&
+       !ispunct((uint8_t)(m_sData[nEnd])))) {
+    return parser::token_type::IQL_UNKNOWN;
+  }
+
+  m_nNext = nEnd;
+
+  return parser::token_type::IQL_PLACEHOLDER;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief read next token as a start of a quoted sequence
 ///        do not modify m_nNext if IQL_UNKNOWN
@@ -34,7 +34,7 @@ namespace iresearch {
   namespace iql {
     class parser_context: public context {
     public:
-      parser_context(std::string const& sData, functions const& functions = functions::DEFAULT());
+      parser_context(std::string const& sData, functions const& functions = functions::DEFAULT(), bool bPlaceholders = false);
       parser_context& operator=(parser_context&) = delete; // because of references
 
       // parser operations
@@ -42,6 +42,7 @@ namespace iresearch {
       virtual parser::token_type yylex(parser::semantic_type& value, parser::location_type& location) final override;
 
       // value operations
+      virtual parser::semantic_type placeholder(parser::location_type const& location) final override;
       virtual parser::semantic_type sequence(parser::location_type const& location) final override;
 
       // node operations
@@ -66,7 +67,7 @@ namespace iresearch {
       virtual bool setQuery(parser::semantic_type const& value) final override;
     protected:
       struct query_node {
-        enum NodeType { UNKNOWN, UNION, INTERSECTION, FUNCTION, EQUAL, LIKE, LIST, RANGE, SEQUENCE, BOOL_TRUE } type = NodeType::UNKNOWN;
+        enum NodeType { UNKNOWN, UNION, INTERSECTION, FUNCTION, EQUAL, LIKE, LIST, RANGE, SEQUENCE, BOOL_TRUE, PLACEHOLDER } type = NodeType::UNKNOWN;
 
         // valid for FUNCTION
         boolean_function const* pFnBoolean;
@@ -77,9 +78,12 @@ namespace iresearch {
         // valid for FUNCTION
         sequence_function const* pFnSequence;
 
-        // valid for SEQUENCE, (for: FUNCTION - may contain function name, used by print(...) only)
+        // valid for SEQUENCE, (for: FUNCTION - may contain function name, PLACEHOLDER - placeholder text, used by print(...) only)
         std::string sValue;
 
+        // valid for PLACEHOLDER (offset of the bound value, i.e. N - 1 for '$N')
+        size_t nPlaceholder;
+
         // valid for RANGE
         bool bBeginInclusive;
         bool bEndInclusive;
@@ -104,13 +108,15 @@ namespace iresearch {
         std::vector<std::pair<size_t, bool>> const& order; // the order portion (nodeID, ascending) of the query
         size_t const* pnLimit; // the limit value of the query, or nullptr if unset
         query_position const* pError; // the last encountered error, or nullptr if no errors seen
+        size_t nPlaceholders; // the number of values required to bind all placeholders of the query
         query_state(
           size_t v_nOffset,
           size_t const* v_pnFilter,
           std::vector<std::pair<size_t, bool>> const& v_order,
           size_t const* v_pnLimit,
-          query_position const* v_pError
-        ): nOffset(v_nOffset), pnFilter(v_pnFilter), order(v_order), pnLimit(v_pnLimit), pError(v_pError) {}
+          query_position const* v_pError,
+          size_t v_nPlaceholders
+        ): nOffset(v_nOffset), pnFilter(v_pnFilter), order(v_order), pnLimit(v_pnLimit), pError(v_pError), nPlaceholders(v_nPlaceholders) {}
         query_state& operator=(query_state&) = delete; // because of references
       };
 
@@ -118,7 +124,7 @@ namespace iresearch {
       query_node const& find_node(parser::semantic_type const& value) const;
       template<typename T>
       typename T::contextual_function_t const& function(T const& fn) const { return fn.m_fnContextual; }
-      void print(std::ostream& out, parser::semantic_type const& root, bool bBoost = false, bool bId = false);
+      void print(std::ostream& out, parser::semantic_type const& root, bool bBoost = false, bool bId = false) const;
     private:
       std::string const& m_sData;
       std::pair<bool, query_position> m_error;
@@ -126,6 +132,8 @@ namespace iresearch {
       functions const& m_functions;
       std::pair<bool, size_t> m_limit;
       size_t m_nNext;
+      bool m_bPlaceholders; // recognize '$N' as a placeholder, otherwise it is a sequence
+      std::vector<size_t> m_placeholders; // IDs of PLACEHOLDER nodes
       std::deque<query_node> m_nodes; // a type that allows O(1) random access and does not invalidate on resize // FIXME seperate into different type vectors?
       std::unordered_map<size_t, size_t> m_negatedNodeCache;
       std::vector<std::pair<size_t, bool>> m_order;
@@ -144,6 +152,7 @@ namespace iresearch {
       parser::token_type nextKeyword();
       parser::token_type nextNumber();
       parser::token_type nextOperator();
+      parser::token_type nextPlaceholder();
       parser::token_type nextQuoted(bool bStart);
       parser::token_type nextSeperator();
       parser::token_type nextSequence(char cSep);
@@ -297,17 +297,30 @@ const irs::iql::query_builder::branch_builder_function_t SIMILAR_BRANCH_BUILDER
       const std::locale& locale,
       void* cookie,
       const irs::iql::functions& functions,
-      const irs::iql::query_builder::branch_builders& branch_builders
+      const irs::iql::query_builder::branch_builders& branch_builders,
+      bool bPlaceholders = false
     );
+    parse_context(
+      const parse_context& parsed,
+      const std::vector<iresearch::string_ref>& values,
+      const std::locale& locale,
+      void* cookie
+    ); // view of an already parsed query for building with bound values and a different locale/cookie
+    query_state current_state() const {
+      return m_parsed.parser_context::current_state();
+    }
     irs::iql::query build();
     irs::iql::query buildError();
 
    private:
+    static const std::string EMPTY_QUERY;
     static const irs::iql::parser::semantic_type SUCCESS;
     static const irs::iql::parser::semantic_type UNKNOWN;
     const irs::iql::query_builder::branch_builders& m_branch_builders;
     void* m_cookie;
     const std::locale& m_locale;
+    const parse_context& m_parsed; // the parsed query state, i.e. *this or the shared compiled query
+    const std::vector<iresearch::string_ref>* m_pValues; // values bound to placeholders, nullptr == none
 
     irs::iql::parser::semantic_type append_function_arg(
       irs::iql::function_arg::fn_args_t& buf,
@@ -331,7 +344,19 @@ const irs::iql::query_builder::branch_builder_function_t SIMILAR_BRANCH_BUILDER
       irs::iql::parser::semantic_type const& value
     ) const {
       // force visibility only of const fn for GCC, otherwise it tries private fn
-      return parser_context::find_node(value);
+      return m_parsed.parser_context::find_node(value);
+    }
+    void print(
+      std::ostream& out, irs::iql::parser::semantic_type const& root, bool bBoost, bool bId
+    ) const {
+      m_parsed.parser_context::print(out, root, bBoost, bId);
+    }
+    iresearch::string_ref value(const query_node& node) const {
+      assert(query_node::NodeType::SEQUENCE == node.type || query_node::NodeType::PLACEHOLDER == node.type);
+
+      return query_node::NodeType::PLACEHOLDER == node.type
+        ? (*m_pValues)[node.nPlaceholder] // number of values checked by build()
+        : iresearch::string_ref(node.sValue);
     }
     template <typename T> // @return SUCCESS or ID of failed node, or UNKNOWN for self
     irs::iql::parser::semantic_type init(T& node, const query_node& src) const;
@@ -351,6 +376,7 @@ const irs::iql::query_builder::branch_builder_function_t SIMILAR_BRANCH_BUILDER
     ) const; // @return SUCCESS or ID of failed node
   };
 
+  const std::string parse_context::EMPTY_QUERY;
   const irs::iql::parser::semantic_type parse_context::SUCCESS =
     std::numeric_limits<irs::iql::parser::semantic_type>::max(); // init() success
   const irs::iql::parser::semantic_type parse_context::UNKNOWN =
@@ -361,12 +387,43 @@ const irs::iql::query_builder::branch_builder_function_t SIMILAR_BRANCH_BUILDER
     const std::locale& locale,
     void* cookie,
     const irs::iql::functions& functions,
-    const irs::iql::query_builder::branch_builders& branch_builders
+    const irs::iql::query_builder::branch_builders& branch_builders,
+    bool bPlaceholders /*= false*/
   ):
-    parser_context(sQuery, functions),
+    parser_context(sQuery, functions, bPlaceholders),
     m_branch_builders(branch_builders),
     m_cookie(cookie),
-    m_locale(locale) {
+    m_locale(locale),
+    m_parsed(*this),
+    m_pValues(nullptr) {
+  }
+
+  parse_context::parse_context(
+    const parse_context& parsed,
+    const std::vector<iresearch::string_ref>& values,
+    const std::locale& locale,
+    void* cookie
+  ):
+    parser_context(EMPTY_QUERY), // own parser state is never used, nodes are read from 'parsed'
+    m_branch_builders(parsed.m_branch_builders),
+    m_cookie(cookie),
+    m_locale(locale),
+    m_parsed(parsed),
+    m_pValues(&values) {
+  }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief link the query into both the root and result.filter via two LinkNodes
+  ////////////////////////////////////////////////////////////////////////////////
+  irs::iql::query& link(irs::iql::query& result, irs::iql::proxy_filter* root) {
+    if (root && !result.error) {
+      auto& link = root->proxy<LinkNode>(result.filter.get());
+      result.filter.release();
+
+      result.filter = LinkNode::make(link);
+    }
+
+    return result;
   }
 
   // add implementation before any calls to the function
@@ -502,6 +559,19 @@ const irs::iql::query_builder::branch_builder_function_t SIMILAR_BRANCH_BUILDER
       return buildError();
     }
 
+    // ensure every placeholder has a bound value
+    if (state.nPlaceholders > (m_pValues ? m_pValues->size() : 0)) {
+      std::stringstream error;
+
+      error << "bind error, expected " << state.nPlaceholders
+            << " value(s), got " << (m_pValues ? m_pValues->size() : 0);
+      result.filter = ErrorNode::make<ErrorNode>();
+      result.error = &(static_cast<ErrorNode*>(result.filter.get())->sError);
+      *(result.error) = error.str();
+
+      return result;
+    }
+
     query_node root;
 
     root.type = query_node::NodeType::UNION;
@@ -693,8 +763,9 @@ const irs::iql::query_builder::branch_builder_function_t SIMILAR_BRANCH_BUILDER
         );
       });
       return SUCCESS;
-     case query_node::NodeType::SEQUENCE:
-      buf.emplace_back(iresearch::ref_cast<iresearch::byte_type>(iresearch::string_ref(node.sValue)));
+     case query_node::NodeType::SEQUENCE: // fall through
+     case query_node::NodeType::PLACEHOLDER:
+      buf.emplace_back(iresearch::ref_cast<iresearch::byte_type>(value(node)));
       return SUCCESS;
      default: {} // NOOP
     }
@@ -745,8 +816,9 @@ const irs::iql::query_builder::branch_builder_function_t SIMILAR_BRANCH_BUILDER
     const query_node& src
   ) const {
     switch(src.type) {
-     case query_node::NodeType::SEQUENCE:
-      buf.append(iresearch::ref_cast<iresearch::byte_type>(iresearch::string_ref(src.sValue)));
+     case query_node::NodeType::SEQUENCE: // fall through
+     case query_node::NodeType::PLACEHOLDER:
+      buf.append(iresearch::ref_cast<iresearch::byte_type>(value(src)));
       break;
      case query_node::NodeType::FUNCTION:
       if (src.pFnSequence) {
@@ -913,6 +985,19 @@ query_builder::query_builder(
 ): branch_builders_(branch_builders), iql_functions_(iql_functions) {
 }
 
+struct query_template::impl {
+  std::string query; // parse_context references the query text
+  std::unique_ptr<parse_context> ctx;
+  std::string error; // empty if parsed successfully
+  explicit impl(const std::string& v_query): query(v_query) {}
+};
+
+query_template::query_template(std::unique_ptr<impl>&& impl)
+  : impl_(std::move(impl)) {
+}
+
+query_template::~query_template() {}
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                  public functions
 // -----------------------------------------------------------------------------
@@ -944,17 +1029,108 @@ query query_builder::build(
 
   auto result = ctx.build();
 
-  // link the query into both the root and result.filter via two LinkNodes
-  if (!result.error) {
-    auto& link = root->proxy<LinkNode>(result.filter.get());
-    result.filter.release();
+  link(result, root);
+
+  return result;
+}
+
+query_template::ptr query_builder::compile(const std::string& query) const {
+  std::unique_ptr<query_template::impl> impl(new query_template::impl(query));
+  impl->ctx.reset(new parse_context(
+    impl->query, std::locale::classic(), nullptr, iql_functions_, branch_builders_, true
+  ));
+
+  parser parser(*(impl->ctx));
+
+  if (parser.parse()) {
+    impl->error = std::move(*(impl->ctx->buildError().error));
+  }
+
+  return query_template::ptr(new query_template(std::move(impl)));
+}
+
+query query_template::build(
+  const std::vector<string_ref>& values,
+  const std::locale& locale,
+  void* cookie /*= nullptr*/,
+  proxy_filter* root /*= nullptr*/
+) const {
+  // parsed nodes are only read, so share them and keep only values/locale/cookie per build
+  parse_context ctx(*(impl_->ctx), values, locale, cookie);
 
-    result.filter = LinkNode::make(link);
+  if (!impl_->error.empty()) {
+    return ctx.buildError();
   }
 
+  auto result = ctx.build();
+
+  link(result, root);
+
   return result;
 }
 
+const std::string* query_template::error() const NOEXCEPT {
+  return impl_->error.empty() ? nullptr : &(impl_->error);
+}
+
+size_t query_template::placeholders() const NOEXCEPT {
+  return impl_->ctx->current_state().nPlaceholders;
+}
+
+query_cache::query_cache(
+    const query_builder& builder,
+    size_t max_size /*= DEFAULT_MAX_SIZE*/
+): builder_(builder), max_size_(max_size) {
+}
+
+query_template::ptr query_cache::get(const std::string& query) {
+  {
+    SCOPED_LOCK(mutex_);
+    auto itr = map_.find(query);
+
+    if (itr != map_.end()) {
+      lru_.splice(lru_.begin(), lru_, itr->second); // mark as most recently used
+
+      return itr->second->second;
+    }
+  }
+
+  auto compiled = builder_.compile(query); // compile outside of the lock
+
+  SCOPED_LOCK(mutex_);
+  auto itr = map_.find(query);
+
+  if (itr != map_.end()) {
+    return itr->second->second; // compiled concurrently by another thread
+  }
+
+  if (!max_size_) {
+    return compiled;
+  }
+
+  while (lru_.size() >= max_size_) {
+    map_.erase(lru_.back().first);
+    lru_.pop_back();
+  }
+
+  lru_.emplace_front(query, compiled);
+  map_.emplace(lru_.front().first, lru_.begin());
+
+  return compiled;
+}
+
+void query_cache::clear() {
+  SCOPED_LOCK(mutex_);
+  map_.clear();
+  lru_.clear();
+}
+
+size_t query_cache::size() const {
+  SCOPED_LOCK(mutex_);
+
+  return lru_.size();
+}
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                 private functions
 // -----------------------------------------------------------------------------
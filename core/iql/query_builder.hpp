@@ -24,9 +24,14 @@
 #ifndef IRESEARCH_IQL_QUERY_BUILDER_H
 #define IRESEARCH_IQL_QUERY_BUILDER_H
 
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
 #include "shared.hpp"
 #include "parser_common.hpp"
 #include "search/filter.hpp"
+#include "utils/noncopyable.hpp"
 
 namespace iresearch {
   namespace iql {
@@ -105,6 +110,55 @@ namespace iresearch {
       }
     };
 
+    class query_builder;
+
+    ////////////////////////////////////////////////////////////////////////////////
+    /// @brief a textual query parsed once, with '$N' placeholders in place of
+    ///        values which are supplied for every build(...) of the query
+    ///        instances are immutable and may be shared between threads
+    ////////////////////////////////////////////////////////////////////////////////
+    class IRESEARCH_API query_template {
+     public:
+      typedef std::shared_ptr<const query_template> ptr;
+
+      ~query_template();
+
+      ////////////////////////////////////////////////////////////////////////////////
+      /// @brief bind values to placeholders and build an iResearch query
+      /// @param values the values to bind, i.e. '$N' is bound to values[N - 1]
+      /// @param locale the locale to use for building the query
+      /// @param cookie a user-defined value passed verbatum to function invocations
+      /// @param root the node to attach the query under (if not null)
+      /// @return built query, iff error <return>.error != nullptr
+      ////////////////////////////////////////////////////////////////////////////////
+      query build(
+        const std::vector<string_ref>& values,
+        const std::locale& locale,
+        void* cookie = nullptr,
+        proxy_filter* root = nullptr
+      ) const;
+
+      ////////////////////////////////////////////////////////////////////////////////
+      /// @return the parse error of the query, or nullptr if parsed successfully
+      ////////////////////////////////////////////////////////////////////////////////
+      const std::string* error() const NOEXCEPT;
+
+      ////////////////////////////////////////////////////////////////////////////////
+      /// @return the number of values required by build(...), i.e. the max 'N'
+      ////////////////////////////////////////////////////////////////////////////////
+      size_t placeholders() const NOEXCEPT;
+
+     private:
+      friend class query_builder;
+      struct impl;
+
+      IRESEARCH_API_PRIVATE_VARIABLES_BEGIN
+      std::unique_ptr<impl> impl_;
+      IRESEARCH_API_PRIVATE_VARIABLES_END
+
+      explicit query_template(std::unique_ptr<impl>&& impl);
+    };
+
     ////////////////////////////////////////////////////////////////////////////////
     /// @brief helper class for transforming a textual query into an iResearch query
     ////////////////////////////////////////////////////////////////////////////////
@@ -173,10 +227,57 @@ namespace iresearch {
         proxy_filter* root = nullptr
       ) const;
 
+      ////////////////////////////////////////////////////////////////////////////////
+      /// @brief parse a textual query with '$N' placeholders for later binding
+      ///        NOTE: '$N' is a placeholder only here, build(...) treats it as
+      ///              a plain sequence
+      /// @param query the query to parse
+      /// @return parsed query, iff error <return>->error() != nullptr
+      ////////////////////////////////////////////////////////////////////////////////
+      query_template::ptr compile(const std::string& query) const;
+
      private:
       const branch_builders& branch_builders_;
       const functions& iql_functions_;
     };
+
+    ////////////////////////////////////////////////////////////////////////////////
+    /// @brief thread-safe LRU cache of compiled queries keyed by the query text
+    ////////////////////////////////////////////////////////////////////////////////
+    class IRESEARCH_API query_cache: private util::noncopyable {
+     public:
+      static const size_t DEFAULT_MAX_SIZE = 1024;
+
+      ////////////////////////////////////////////////////////////////////////////////
+      /// @param builder the builder used to compile queries, must outlive the cache
+      /// @param max_size maximum number of cached queries
+      ////////////////////////////////////////////////////////////////////////////////
+      explicit query_cache(
+        const query_builder& builder,
+        size_t max_size = DEFAULT_MAX_SIZE
+      );
+
+      ////////////////////////////////////////////////////////////////////////////////
+      /// @return the compiled query, compiling it on a cache miss
+      ////////////////////////////////////////////////////////////////////////////////
+      query_template::ptr get(const std::string& query);
+
+      void clear();
+      size_t max_size() const NOEXCEPT { return max_size_; }
+      size_t size() const;
+
+     private:
+      typedef std::pair<std::string, query_template::ptr> entry_t;
+      typedef std::list<entry_t> lru_t; // most recently used are in front
+
+      IRESEARCH_API_PRIVATE_VARIABLES_BEGIN
+      const query_builder& builder_;
+      lru_t lru_;
+      std::unordered_map<string_ref, lru_t::iterator> map_; // keys point into lru_
+      size_t max_size_;
+      mutable std::mutex mutex_;
+      IRESEARCH_API_PRIVATE_VARIABLES_END
+    };
   }
 }
 
@@ -67,6 +67,47 @@ bool bitset_doc_iterator::next() NOEXCEPT {
   );
 }
 
+size_t bitset_doc_iterator::next_batch(doc_id_t* docs, size_t size) NOEXCEPT {
+  if (!size || type_limits<type_t::doc_id_t>::eof(doc_.value)) {
+    return 0;
+  }
+
+  typedef bitset::word_t word_t;
+
+  const doc_id_t target = doc_.value + 1;
+  const auto* pword = begin_ + bitset::word(target);
+  size_t count = 0;
+
+  if (pword < end_) {
+    // skip bits preceding the target in its word
+    auto word = *pword & (~word_t(0) << bitset::bit(target));
+    auto base = bitset::bit_offset(std::distance(begin_, pword));
+
+    for (;;) {
+      for (; word; word &= word - 1) { // reset the lowest set bit
+        docs[count] = doc_id_t(base + math::math_traits<word_t>::ctz(word));
+
+        if (++count == size) {
+          doc_.value = docs[count - 1];
+
+          return count;
+        }
+      }
+
+      if (++pword >= end_) {
+        break;
+      }
+
+      word = *pword;
+      base += bits_required<word_t>();
+    }
+  }
+
+  doc_.value = type_limits<type_t::doc_id_t>::eof();
+
+  return count;
+}
+
 doc_id_t bitset_doc_iterator::seek(doc_id_t target) NOEXCEPT {
   const auto* pword = begin_ + bitset::word(target);
 
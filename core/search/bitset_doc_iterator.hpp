@@ -42,6 +42,7 @@ class bitset_doc_iterator final: public doc_iterator_base, util::noncopyable {
 
   virtual bool next() NOEXCEPT override;
   virtual doc_id_t seek(doc_id_t target) NOEXCEPT override;
+  virtual size_t next_batch(doc_id_t* docs, size_t size) NOEXCEPT override;
   virtual doc_id_t value() const NOEXCEPT override { return doc_.value; }
 
  private:
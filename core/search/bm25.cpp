@@ -204,10 +204,18 @@ struct stats final : stored_attribute {
     norm_const = 1.f;
     norm_length = 0.f;
   }
+
+  // precompute denominators 'k*(1-b) + k*b/avgD*norm' for every quantized norm
+  void prepare_norms() NOEXCEPT {
+    for (size_t i = 0; i < norms.size(); ++i) {
+      norms[i] = norm_const + norm_length * norm::dequantize(byte_type(i));
+    }
+  }
   
   float_t idf; // precomputed idf value
   float_t norm_const; // precomputed k*(1-b)
   float_t norm_length; // precomputed k*b/avgD
+  std::array<float_t, norm::QUANTIZED_VALUES()> norms; // precomputed denominators
 }; // stats
 
 DEFINE_ATTRIBUTE_TYPE(iresearch::bm25::stats);
@@ -235,6 +243,18 @@ class scorer : public iresearch::sort::scorer_base<bm25::score_t> {
     score_cast(score_buf) = num_ * freq / (norm_const_ + freq);
   }
 
+  virtual bool max_score(byte_type* score_buf, uint64_t freq) const override {
+    if (num_ < 0.f || norm_const_ < 0.f || norm_length_ < 0.f) {
+      return false; // the score isn't monotonic in term frequency
+    }
+
+    // the score grows with 'tf' and is maximal for the shortest document,
+    // i.e. the norm related part of the denominator is ignored
+    const float_t tf = float_t(std::sqrt(freq));
+    score_cast(score_buf) = num_ * tf / (norm_const_ + tf);
+    return true;
+  }
+
  protected:
   FORCE_INLINE float_t tf() const {
     return float_t(std::sqrt(freq_->value));
@@ -243,6 +263,7 @@ class scorer : public iresearch::sort::scorer_base<bm25::score_t> {
   const frequency* freq_; // document frequency
   float_t num_; // partially precomputed numerator : boost * (k + 1) * idf
   float_t norm_const_; // 'k' factor
+  float_t norm_length_{ 0.f }; // precomputed 'k*b/avgD' if norms presetn, '0' otherwise
 }; // scorer
 
 class norm_scorer final : public scorer {
@@ -256,7 +277,8 @@ class norm_scorer final : public scorer {
       const frequency* freq,
       const iresearch::norm* norm)
     : scorer(k, boost, stats, freq),
-      norm_(norm) {
+      norm_(norm),
+      norms_(stats->norms.data()) {
     assert(norm_);
 
     // if there is no norms, assume that b==0
@@ -268,12 +290,12 @@ class norm_scorer final : public scorer {
 
   virtual void score(byte_type* score_buf) override {
     const float_t freq = tf();
-    score_cast(score_buf) = num_ * freq / (norm_const_ + norm_length_ * norm_->read() + freq);
+    score_cast(score_buf) = num_ * freq / (norms_[norm_->read_quantized()] + freq);
   }
 
  private:
   const iresearch::norm* norm_;
-  float_t norm_length_{ 0.f }; // precomputed 'k*b/avgD' if norms presetn, '0' otherwise
+  const float_t* norms_; // precomputed denominators per quantized norm
 }; // norm_scorer
 
 class collector final : public iresearch::sort::collector {
@@ -324,6 +346,7 @@ class collector final : public iresearch::sort::collector {
       const auto avg_doc_len = float_t(total_term_freq) / docs_with_field;
       bm25stats->norm_length /= avg_doc_len;
     }
+    bm25stats->prepare_norms();
 
     // add norm attribute
     filter_attrs.emplace<norm>();
@@ -399,6 +422,10 @@ class sort final : iresearch::sort::prepared_base<bm25::score_t> {
     return lhs < rhs;
   }
 
+  virtual bool float_score() const NOEXCEPT override {
+    return std::is_same<score_t, float_t>::value;
+  }
+
  private:
   float_t k_;
   float_t b_;
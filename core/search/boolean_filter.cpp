@@ -82,6 +82,52 @@ irs::doc_iterator::ptr make_disjunction(
   );
 }
 
+//////////////////////////////////////////////////////////////////////////////
+/// @returns disjunction iterator created from the specified queries, which
+///          omits the documents that can't exceed the specified threshold if
+///          all of the sub iterators provide score bounds
+//////////////////////////////////////////////////////////////////////////////
+template<typename QueryIterator>
+irs::doc_iterator::ptr make_block_max_disjunction(
+    const irs::sub_reader& rdr,
+    const irs::order::prepared& ord,
+    const irs::attribute_view& ctx,
+    const irs::score_threshold& threshold,
+    QueryIterator begin,
+    QueryIterator end) {
+  static_assert(
+    std::is_same<
+      irs::disjunction::doc_iterators_t,
+      irs::block_max_disjunction::doc_iterators_t
+    >::value,
+    "disjunctions must accept the same sub iterators"
+  );
+
+  irs::disjunction::doc_iterators_t itrs;
+  itrs.reserve(size_t(std::distance(begin, end)));
+
+  bool bounded = true;
+
+  for (;begin != end; ++begin) {
+    // execute query - get doc iterator
+    irs::doc_iterator::ptr docs = begin->execute(rdr, ord, ctx);
+
+    // filter out empty iterators
+    if (!irs::type_limits<irs::type_t::doc_id_t>::eof(docs->value())) {
+      bounded &= docs->attributes().contains<irs::score_bound>();
+      itrs.emplace_back(std::move(docs));
+    }
+  }
+
+  if (!bounded || itrs.size() < 2) {
+    return irs::make_disjunction<irs::disjunction>(std::move(itrs), ord);
+  }
+
+  return irs::doc_iterator::make<irs::block_max_disjunction>(
+    std::move(itrs), ord, threshold
+  );
+}
+
 //////////////////////////////////////////////////////////////////////////////
 /// @returns conjunction iterator created from the specified queries
 //////////////////////////////////////////////////////////////////////////////
@@ -251,6 +297,17 @@ class or_query final : public boolean_query {
       const attribute_view& ctx,
       iterator begin,
       iterator end) const override {
+    auto& threshold = ctx.get<score_threshold>();
+
+    // only the root query is allowed to omit non-competitive documents
+    if (threshold && threshold->query == this
+        && 1 == std::distance(ord.begin(), ord.end())
+        && ord[0].reverse && ord[0].bucket->float_score()) {
+      return ::make_block_max_disjunction(
+        rdr, ord, ctx, *threshold, begin, end
+      );
+    }
+
     return ::make_disjunction(rdr, ord, ctx, begin, end);
   }
 }; // or_query
@@ -0,0 +1,366 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Andrey Abramov
+/// @author Vasiliy Nabatchikov
+////////////////////////////////////////////////////////////////////////////////
+
+#include "cached_filter.hpp"
+#include "bitset_doc_iterator.hpp"
+#include "index/index_reader.hpp"
+#include "utils/hash_utils.hpp"
+#include "utils/thread_utils.hpp"
+#include "utils/type_limits.hpp"
+
+#include <boost/functional/hash.hpp>
+
+NS_LOCAL
+
+// number of the approximate request counters
+const size_t FREQUENCY_SLOTS = 4096;
+
+// number of the requests after which all counters are halved
+const size_t FREQUENCY_DECAY = 8 * FREQUENCY_SLOTS;
+
+// number of documents fetched at once while materializing a doc set
+const size_t BATCH_SIZE = 1024;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief holds a cached doc set for the lifetime of the iterator over it
+////////////////////////////////////////////////////////////////////////////////
+struct cached_doc_iterator {
+  cached_doc_iterator(
+      const irs::sub_reader& rdr,
+      const irs::attribute_store& prepared_filter_attrs,
+      irs::filter_cache::value_ptr&& docs,
+      const irs::order::prepared& ord)
+    : docs(std::move(docs)),
+      it(rdr, prepared_filter_attrs, *this->docs, ord) {
+  }
+
+  irs::filter_cache::value_ptr docs;
+  irs::bitset_doc_iterator it;
+}; // cached_doc_iterator
+
+irs::doc_iterator::ptr make_iterator(
+    const irs::sub_reader& rdr,
+    const irs::attribute_store& prepared_filter_attrs,
+    irs::filter_cache::value_ptr&& docs,
+    const irs::order::prepared& ord) {
+  auto holder = std::make_shared<cached_doc_iterator>(
+    rdr, prepared_filter_attrs, std::move(docs), ord
+  );
+
+  // share ownership of the doc set with the iterator
+  return irs::doc_iterator::ptr(holder, &holder->it);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @class cached_query
+/// @brief serves the documents matched by the wrapped query from the cache,
+///        populating the cache on demand
+////////////////////////////////////////////////////////////////////////////////
+class cached_query final : public irs::filter::prepared {
+ public:
+  cached_query(
+      irs::filter::prepared::ptr&& query,
+      const std::shared_ptr<const irs::filter>& filter,
+      const irs::filter_cache::ptr& cache)
+    : query_(std::move(query)),
+      filter_(filter),
+      cache_(cache) {
+    assert(query_ && filter_ && cache_);
+  }
+
+  virtual irs::doc_iterator::ptr execute(
+      const irs::sub_reader& rdr,
+      const irs::order::prepared& ord,
+      const irs::attribute_view& ctx) const override {
+    const auto segment = rdr.id();
+
+    if (!segment || !ord.empty()) {
+      // segment can't be identified or documents have to be scored
+      return query_->execute(rdr, ord, ctx);
+    }
+
+    auto docs = cache_->find(segment, *filter_);
+
+    if (!docs) {
+      if (!cache_->admit(segment, *filter_)) {
+        return query_->execute(rdr, ord, ctx);
+      }
+
+      irs::bitset set(
+        irs::type_limits<irs::type_t::doc_id_t>::min() + rdr.docs_count()
+      );
+
+      irs::doc_id_t batch[BATCH_SIZE];
+      auto it = query_->execute(rdr, ord, ctx);
+
+      // fetch documents in batches, avoids a virtual call per document
+      for (size_t count = BATCH_SIZE; count == BATCH_SIZE;) {
+        count = it->next_batch(batch, BATCH_SIZE);
+
+        for (size_t i = 0; i < count; ++i) {
+          set.set(batch[i]);
+        }
+      }
+
+      docs = cache_->emplace(
+        segment, filter_, std::make_shared<const irs::bitset>(std::move(set))
+      );
+    }
+
+    return make_iterator(rdr, query_->attributes(), std::move(docs), ord);
+  }
+
+ private:
+  irs::filter::prepared::ptr query_;
+  std::shared_ptr<const irs::filter> filter_;
+  irs::filter_cache::ptr cache_;
+}; // cached_query
+
+NS_END
+
+NS_ROOT
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                       filter_cache implementation
+// -----------------------------------------------------------------------------
+
+/*static*/ filter_cache::ptr filter_cache::make(
+    size_t max_size,
+    size_t min_frequency /*= DEFAULT_MIN_FREQUENCY*/) {
+  return std::make_shared<filter_cache>(max_size, min_frequency);
+}
+
+/*static*/ filter_cache::key filter_cache::make_key(
+    uint64_t segment,
+    const irs::filter& filter) NOEXCEPT {
+  return key{
+    segment,
+    &filter,
+    hash_combine(std::hash<uint64_t>()(segment), filter.hash())
+  };
+}
+
+filter_cache::filter_cache(
+    size_t max_size,
+    size_t min_frequency /*= DEFAULT_MIN_FREQUENCY*/)
+  : frequencies_(FREQUENCY_SLOTS),
+    max_size_(max_size),
+    min_frequency_(min_frequency) {
+}
+
+filter_cache::value_ptr filter_cache::find(
+    uint64_t segment,
+    const irs::filter& filter) {
+  const auto id = make_key(segment, filter);
+
+  SCOPED_LOCK(mutex_);
+
+  const auto it = map_.find(id);
+
+  if (it == map_.end()) {
+    ++misses_;
+
+    return nullptr;
+  }
+
+  // mark as most recently used
+  lru_.splice(lru_.begin(), lru_, it->second);
+  ++hits_;
+
+  return it->second->value;
+}
+
+bool filter_cache::admit(uint64_t segment, const irs::filter& filter) {
+  const auto id = make_key(segment, filter);
+
+  SCOPED_LOCK(mutex_);
+
+  if (++requests_ >= FREQUENCY_DECAY) {
+    // age the counters so that formerly hot doc sets may be displaced
+    for (auto& frequency : frequencies_) {
+      frequency >>= 1;
+    }
+
+    requests_ = 0;
+  }
+
+  auto& frequency = frequencies_[id.hash % frequencies_.size()];
+
+  if (frequency < std::numeric_limits<uint8_t>::max()) {
+    ++frequency;
+  }
+
+  return frequency >= min_frequency_;
+}
+
+filter_cache::value_ptr filter_cache::emplace(
+    uint64_t segment,
+    const std::shared_ptr<const irs::filter>& filter,
+    value_ptr&& value) {
+  assert(filter && value);
+  const auto id = make_key(segment, *filter);
+  const auto size = value->words() * sizeof(bitset::word_t);
+  lru_t evicted; // destroy evicted doc sets outside of the lock
+
+  SCOPED_LOCK(mutex_);
+
+  const auto it = map_.find(id);
+
+  if (it != map_.end()) {
+    // already cached by another thread
+    lru_.splice(lru_.begin(), lru_, it->second);
+
+    return it->second->value;
+  }
+
+  if (size > max_size_) {
+    // doc set is too large to be cached
+    return std::move(value);
+  }
+
+  // evict least recently used doc sets
+  while (size_ + size > max_size_) {
+    assert(!lru_.empty());
+    auto last = std::prev(lru_.end());
+
+    size_ -= last->size;
+    map_.erase(last->id);
+    evicted.splice(evicted.end(), lru_, last);
+    ++evictions_;
+  }
+
+  lru_.emplace_front();
+
+  auto& entry = lru_.front();
+  entry.id = id;
+  entry.filter = filter;
+  entry.value = std::move(value);
+  entry.size = size;
+
+  try {
+    map_.emplace(id, lru_.begin());
+  } catch (...) {
+    lru_.pop_front();
+    throw;
+  }
+
+  size_ += size;
+
+  return entry.value;
+}
+
+void filter_cache::erase(uint64_t segment) {
+  lru_t erased; // destroy erased doc sets outside of the lock
+
+  SCOPED_LOCK(mutex_);
+
+  for (auto it = lru_.begin(); it != lru_.end();) {
+    auto next = std::next(it);
+
+    if (it->id.segment == segment) {
+      size_ -= it->size;
+      map_.erase(it->id);
+      erased.splice(erased.end(), lru_, it);
+    }
+
+    it = next;
+  }
+}
+
+void filter_cache::clear() {
+  lru_t erased; // destroy erased doc sets outside of the lock
+
+  SCOPED_LOCK(mutex_);
+
+  map_.clear();
+  erased.swap(lru_);
+  size_ = 0;
+}
+
+filter_cache::stats_t filter_cache::stats() const {
+  stats_t stats;
+
+  SCOPED_LOCK(mutex_);
+
+  stats.hits = hits_;
+  stats.misses = misses_;
+  stats.evictions = evictions_;
+  stats.size = size_;
+  stats.count = lru_.size();
+
+  return stats;
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                             cached implementation
+// -----------------------------------------------------------------------------
+
+DEFINE_FILTER_TYPE(cached);
+DEFINE_FACTORY_DEFAULT(cached);
+
+cached::cached() NOEXCEPT
+  : irs::filter(cached::type()) {
+}
+
+filter::prepared::ptr cached::prepare(
+    const index_reader& rdr,
+    const order::prepared& ord,
+    boost_t boost,
+    const attribute_view& ctx) const {
+  if (!filter_) {
+    return prepared::empty();
+  }
+
+  auto query = filter_->prepare(rdr, ord, boost * this->boost(), ctx);
+
+  if (!cache_ || !ord.empty()) {
+    // scored documents aren't cached
+    return query;
+  }
+
+  return filter::prepared::make<cached_query>(
+    std::move(query), filter_, cache_
+  );
+}
+
+size_t cached::hash() const NOEXCEPT {
+  size_t seed = 0;
+  ::boost::hash_combine(seed, irs::filter::hash());
+  if (filter_) {
+    ::boost::hash_combine<const irs::filter&>(seed, *filter_);
+  }
+  return seed;
+}
+
+bool cached::equals(const irs::filter& rhs) const NOEXCEPT {
+  const cached& typed_rhs = static_cast<const cached&>(rhs);
+  return irs::filter::equals(rhs)
+    && ((!empty() && !typed_rhs.empty() && *filter_ == *typed_rhs.filter_)
+       || (empty() && typed_rhs.empty()));
+}
+
+NS_END // ROOT
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                       END-OF-FILE
+// -----------------------------------------------------------------------------
@@ -0,0 +1,239 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Andrey Abramov
+/// @author Vasiliy Nabatchikov
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef IRESEARCH_CACHED_FILTER_H
+#define IRESEARCH_CACHED_FILTER_H
+
+#include "filter.hpp"
+#include "utils/bitset.hpp"
+#include "utils/noncopyable.hpp"
+
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+NS_ROOT
+
+////////////////////////////////////////////////////////////////////////////////
+/// @class filter_cache
+/// @brief a thread-safe cache of the documents matched by a filter in a
+///        segment, bounded by the total size of the cached doc sets, entries
+///        are evicted in LRU order
+/// @note an entry is identified by the pair <segment, filter>, where 'segment'
+///       is 'sub_reader::id()' and 'filter' is compared via 'filter::hash()'
+///       and 'filter::operator==(...)'
+/// @note a segment reader gets a new identifier whenever its document mask
+///       changes, entries of the dropped/reopened segments are never matched
+///       again and are evicted by the newer ones
+/// @note a doc set is cached only after it has been requested 'min_frequency'
+///       times, the frequencies are tracked approximately and decay over time,
+///       so one-off filters don't push the hot ones out of the cache
+////////////////////////////////////////////////////////////////////////////////
+class IRESEARCH_API filter_cache : private util::noncopyable {
+ public:
+  DECLARE_SPTR(filter_cache);
+  typedef std::shared_ptr<const bitset> value_ptr;
+
+  static const size_t DEFAULT_MIN_FREQUENCY = 2;
+
+  struct stats_t {
+    uint64_t hits{}; // number of successful lookups
+    uint64_t misses{}; // number of failed lookups
+    uint64_t evictions{}; // number of doc sets evicted due to the size limit
+    size_t size{}; // total size of the cached doc sets (in bytes)
+    size_t count{}; // total number of the cached doc sets
+  }; // stats_t
+
+  static ptr make(
+    size_t max_size,
+    size_t min_frequency = DEFAULT_MIN_FREQUENCY
+  );
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @param max_size maximum total size of the cached doc sets (in bytes)
+  /// @param min_frequency number of the requests of a doc set required for it
+  ///        to be admitted into the cache
+  //////////////////////////////////////////////////////////////////////////////
+  explicit filter_cache(
+    size_t max_size,
+    size_t min_frequency = DEFAULT_MIN_FREQUENCY
+  );
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @returns cached doc set identified by the specified key, nullptr if the
+  ///          doc set isn't cached
+  //////////////////////////////////////////////////////////////////////////////
+  value_ptr find(uint64_t segment, const filter& key);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief registers a request of the doc set identified by the specified key
+  /// @returns the doc set should be put into the cache
+  //////////////////////////////////////////////////////////////////////////////
+  bool admit(uint64_t segment, const filter& key);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief puts the specified doc set into the cache
+  /// @returns the cached doc set, which may differ from the specified one in
+  ///          case if the doc set has been already cached by another thread
+  //////////////////////////////////////////////////////////////////////////////
+  value_ptr emplace(
+    uint64_t segment,
+    const std::shared_ptr<const filter>& key,
+    value_ptr&& value
+  );
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief removes all doc sets belonging to the specified segment
+  //////////////////////////////////////////////////////////////////////////////
+  void erase(uint64_t segment);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief removes all cached doc sets
+  //////////////////////////////////////////////////////////////////////////////
+  void clear();
+
+  size_t max_size() const NOEXCEPT { return max_size_; }
+  size_t min_frequency() const NOEXCEPT { return min_frequency_; }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @returns a snapshot of the cache counters
+  //////////////////////////////////////////////////////////////////////////////
+  stats_t stats() const;
+
+ private:
+  struct key {
+    bool operator==(const key& rhs) const NOEXCEPT {
+      return segment == rhs.segment && *filter == *rhs.filter;
+    }
+
+    uint64_t segment;
+    const irs::filter* filter;
+    size_t hash;
+  }; // key
+
+  struct key_hash {
+    size_t operator()(const key& value) const NOEXCEPT {
+      return value.hash;
+    }
+  }; // key_hash
+
+  struct entry {
+    key id;
+    std::shared_ptr<const irs::filter> filter; // holds 'id.filter'
+    value_ptr value;
+    size_t size;
+  }; // entry
+
+  typedef std::list<entry> lru_t; // most recently used are in front
+
+  static key make_key(uint64_t segment, const filter& filter) NOEXCEPT;
+
+  IRESEARCH_API_PRIVATE_VARIABLES_BEGIN
+  mutable std::mutex mutex_;
+  lru_t lru_;
+  std::unordered_map<key, lru_t::iterator, key_hash> map_;
+  std::vector<uint8_t> frequencies_; // approximate request counters
+  size_t requests_{}; // number of requests since the last decay
+  size_t size_{}; // total size of the cached doc sets
+  size_t max_size_; // total size limit
+  size_t min_frequency_;
+  uint64_t hits_{};
+  uint64_t misses_{};
+  uint64_t evictions_{};
+  IRESEARCH_API_PRIVATE_VARIABLES_END
+}; // filter_cache
+
+////////////////////////////////////////////////////////////////////////////////
+/// @class cached
+/// @brief user-side filter caching the documents matched by the wrapped filter
+///        in the specified 'filter_cache', intended for the frequent unscored
+///        constraints (e.g. ACL, tenant or date bucket restrictions)
+/// @note only unordered queries are served from the cache, ordered ones are
+///       evaluated by the wrapped filter as is
+/// @note the wrapped filter is immutable once set since it identifies the
+///       cached doc sets and is shared with the cache
+////////////////////////////////////////////////////////////////////////////////
+class IRESEARCH_API cached : public filter {
+ public:
+  DECLARE_FILTER_TYPE();
+  DECLARE_FACTORY_DEFAULT();
+
+  cached() NOEXCEPT;
+
+  const iresearch::filter* filter() const NOEXCEPT {
+    return filter_.get();
+  }
+
+  template<typename T>
+  const T* filter() const {
+    typedef typename std::enable_if <
+      std::is_base_of<iresearch::filter, T>::value, T
+    >::type type;
+
+    return static_cast<const type*>(filter_.get());
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief sets the filter to wrap, the filter has to be fully built since
+  ///        it can't be modified afterwards
+  //////////////////////////////////////////////////////////////////////////////
+  cached& filter(iresearch::filter::ptr&& filter) {
+    filter_ = std::move(filter);
+    return *this;
+  }
+
+  const filter_cache::ptr& cache() const NOEXCEPT { return cache_; }
+
+  cached& cache(const filter_cache::ptr& cache) {
+    cache_ = cache;
+    return *this;
+  }
+
+  void clear() { filter_.reset(); }
+  bool empty() const { return nullptr == filter_; }
+
+  using filter::prepare;
+
+  virtual filter::prepared::ptr prepare(
+    const index_reader& rdr,
+    const order::prepared& ord,
+    boost_t boost,
+    const attribute_view& ctx
+  ) const override;
+
+  virtual size_t hash() const NOEXCEPT override;
+
+ protected:
+  virtual bool equals(const iresearch::filter& rhs) const NOEXCEPT override;
+
+ private:
+  IRESEARCH_API_PRIVATE_VARIABLES_BEGIN
+  std::shared_ptr<const iresearch::filter> filter_;
+  filter_cache::ptr cache_;
+  IRESEARCH_API_PRIVATE_VARIABLES_END
+}; // cached
+
+NS_END // ROOT
+
+#endif // IRESEARCH_CACHED_FILTER_H
@@ -0,0 +1,248 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Andrey Abramov
+/// @author Vasiliy Nabatchikov
+////////////////////////////////////////////////////////////////////////////////
+
+#include <rapidjson/rapidjson/document.h> // for rapidjson::Document
+
+#include "column_sort.hpp"
+
+#include "scorers.hpp"
+#include "analysis/token_attributes.hpp"
+#include "formats/formats.hpp"
+#include "index/index_reader.hpp"
+
+NS_LOCAL
+
+irs::sort::ptr make_from_string(
+    const rapidjson::Document& json,
+    const irs::string_ref& /*args*/) {
+  assert(json.IsString());
+
+  PTR_NAMED(irs::column_sort, ptr, json.GetString());
+  return ptr;
+}
+
+irs::sort::ptr make_from_object(
+    const rapidjson::Document& json,
+    const irs::string_ref& args) {
+  assert(json.IsObject());
+
+  PTR_NAMED(irs::column_sort, ptr);
+
+  #ifdef IRESEARCH_DEBUG
+    auto& scorer = dynamic_cast<irs::column_sort&>(*ptr);
+  #else
+    auto& scorer = static_cast<irs::column_sort&>(*ptr);
+  #endif
+
+  {
+    // required string
+    const auto* key = "column";
+
+    if (!json.HasMember(key) || !json[key].IsString()) {
+      IR_FRMT_ERROR("Missing or non-string value in '%s' while constructing column scorer from jSON arguments: %s", key, args.c_str());
+
+      return nullptr;
+    }
+
+    scorer.column(json[key].GetString());
+  }
+
+  {
+    // optional unsigned
+    const auto* key = "length";
+
+    if (json.HasMember(key)) {
+      if (!json[key].IsUint64() || !json[key].GetUint64()) {
+        IR_FRMT_ERROR("Non-positive value in '%s' while constructing column scorer from jSON arguments: %s", key, args.c_str());
+
+        return nullptr;
+      }
+
+      scorer.length(json[key].GetUint64());
+    }
+  }
+
+  return ptr;
+}
+
+irs::sort::ptr make_json(const irs::string_ref& args) {
+  if (args.null()) {
+    PTR_NAMED(irs::column_sort, ptr);
+    return ptr;
+  }
+
+  rapidjson::Document json;
+
+  if (json.Parse(args.c_str(), args.size()).HasParseError()) {
+    IR_FRMT_ERROR(
+      "Invalid jSON arguments passed while constructing column scorer, arguments: %s",
+      args.c_str()
+    );
+
+    return nullptr;
+  }
+
+  switch (json.GetType()) {
+    case rapidjson::kStringType:
+      return make_from_string(json, args);
+    case rapidjson::kObjectType:
+      return make_from_object(json, args);
+    default: // wrong type
+      IR_FRMT_ERROR(
+        "Invalid jSON arguments passed while constructing column scorer, arguments: %s",
+        args.c_str()
+      );
+
+      return nullptr;
+  }
+}
+
+REGISTER_SCORER_JSON(irs::column_sort, make_json);
+
+NS_END // LOCAL
+
+NS_ROOT
+NS_BEGIN(column)
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief score is a 'present' flag followed by the key of a document, so
+///        the whole score is compared as raw bytes
+////////////////////////////////////////////////////////////////////////////////
+class scorer final : public irs::sort::scorer {
+ public:
+  DECLARE_FACTORY(scorer);
+
+  scorer(
+      columnstore_reader::values_cursor::ptr&& values,
+      const document& doc,
+      size_t length) NOEXCEPT
+    : values_(std::move(values)),
+      doc_(&doc),
+      length_(length) {
+    assert(values_);
+  }
+
+  virtual void score(byte_type* score_buf) override {
+    bytes_ref value;
+
+    if (!values_->read(doc_->value, value)) {
+      std::memset(score_buf, 0, 1 + length_);
+      return;
+    }
+
+    *score_buf++ = 1;
+
+    if (value.size() >= length_) {
+      std::memcpy(score_buf, value.c_str(), length_);
+    } else {
+      std::memcpy(score_buf, value.c_str(), value.size());
+      std::memset(score_buf + value.size(), 0, length_ - value.size());
+    }
+  }
+
+ private:
+  columnstore_reader::values_cursor::ptr values_;
+  const document* doc_;
+  size_t length_;
+}; // scorer
+
+class sort final : public irs::sort::prepared {
+ public:
+  DECLARE_FACTORY(prepared);
+
+  sort(const std::string& column, size_t length)
+    : column_(column), length_(length) {
+  }
+
+  virtual const flags& features() const override {
+    return flags::empty_instance();
+  }
+
+  virtual irs::sort::collector::ptr prepare_collector() const override {
+    return nullptr; // no statistics required
+  }
+
+  virtual irs::sort::scorer::ptr prepare_scorer(
+      const sub_reader& segment,
+      const term_reader& /*field*/,
+      const attribute_store& /*query_attrs*/,
+      const attribute_view& doc_attrs
+  ) const override {
+    const auto* column = segment.column_reader(column_);
+    auto& doc = doc_attrs.get<document>();
+
+    if (!column || !doc) {
+      return nullptr; // all documents of the segment have no value
+    }
+
+    return column::scorer::make<column::scorer>(column->cursor(), *doc, length_);
+  }
+
+  virtual void prepare_score(byte_type* score) const override {
+    std::memset(score, 0, size());
+  }
+
+  virtual void add(byte_type* dst, const byte_type* src) const override {
+    // all scorers of a document read the same value, keep the greatest
+    if (less(dst, src)) {
+      std::memcpy(dst, src, size());
+    }
+  }
+
+  virtual bool less(const byte_type* lhs, const byte_type* rhs) const override {
+    return std::memcmp(lhs, rhs, size()) < 0;
+  }
+
+  virtual size_t size() const override {
+    return 1 + length_; // +1 for 'present' flag
+  }
+
+ private:
+  std::string column_;
+  size_t length_;
+}; // sort
+
+NS_END // column
+
+DEFINE_SORT_TYPE_NAMED(iresearch::column_sort, "column");
+DEFINE_FACTORY_DEFAULT(irs::column_sort);
+
+column_sort::column_sort(std::string column /*= ""*/, size_t length /*= LENGTH()*/)
+  : sort(column_sort::type()),
+    column_(std::move(column)),
+    length_(length) {
+}
+
+/*static*/ void column_sort::init() {
+  REGISTER_SCORER_JSON(column_sort, make_json); // match registration above
+}
+
+sort::prepared::ptr column_sort::prepare() const {
+  return column::sort::make<column::sort>(column_, length_);
+}
+
+NS_END // ROOT
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                       END-OF-FILE
+// -----------------------------------------------------------------------------
@@ -0,0 +1,79 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Andrey Abramov
+/// @author Vasiliy Nabatchikov
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef IRESEARCH_COLUMN_SORT_H
+#define IRESEARCH_COLUMN_SORT_H
+
+#include "scorers.hpp"
+
+NS_ROOT
+
+////////////////////////////////////////////////////////////////////////////////
+/// @class column_sort
+/// @brief orders documents by the raw bytes of their values in a column, e.g.
+///        big-endian encoded timestamps, values are read via
+///        'column_reader::cursor()' and compared as fixed-length keys
+/// @note values shorter than 'length()' are padded with zeroes, longer ones
+///       are truncated, documents without a value precede all others
+////////////////////////////////////////////////////////////////////////////////
+class IRESEARCH_API column_sort : public sort {
+ public:
+  DECLARE_SORT_TYPE();
+
+  static CONSTEXPR size_t LENGTH() NOEXCEPT {
+    return sizeof(uint64_t);
+  }
+
+  static void init(); // for trigering registration in a static build
+
+  // for use with irs::order::add<T>() and default args (static build)
+  DECLARE_FACTORY_DEFAULT();
+
+  explicit column_sort(std::string column = "", size_t length = LENGTH());
+
+  const std::string& column() const NOEXCEPT { return column_; }
+
+  column_sort& column(std::string column) {
+    column_ = std::move(column);
+    return *this;
+  }
+
+  size_t length() const NOEXCEPT { return length_; }
+
+  column_sort& length(size_t length) NOEXCEPT {
+    length_ = length;
+    return *this;
+  }
+
+  virtual sort::prepared::ptr prepare() const override;
+
+ private:
+  IRESEARCH_API_PRIVATE_VARIABLES_BEGIN
+  std::string column_;
+  IRESEARCH_API_PRIVATE_VARIABLES_END
+  size_t length_;
+}; // column_sort
+
+NS_END // ROOT
+
+#endif // IRESEARCH_COLUMN_SORT_H
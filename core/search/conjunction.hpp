@@ -138,6 +138,41 @@ class conjunction : public doc_iterator_base {
     return converge(target);
   }
 
+  // candidates are fetched from the lead in batches no larger than the free
+  // space of 'docs', so the lead is positioned at the last stored document
+  // once 'docs' is filled
+  virtual size_t next_batch(doc_id_t* docs, size_t size) override {
+    size_t count = 0;
+
+    while (count < size) {
+      const auto left = size - count;
+      auto* begin = docs + count;
+      const auto* end = begin + front_->next_batch(begin, left);
+
+      // keep candidates matched by the rest of iterators,
+      // candidates below 'rest' are known to be rejected
+      doc_id_t rest = type_limits<type_t::doc_id_t>::invalid();
+
+      for (auto* candidate = begin; candidate != end; ++candidate) {
+        if (*candidate < rest) {
+          continue;
+        }
+
+        rest = seek_rest(*candidate);
+
+        if (*candidate == rest) {
+          docs[count++] = *candidate;
+        }
+      }
+
+      if (size_t(end - begin) < left) {
+        break; // lead is exhausted
+      }
+    }
+
+    return count;
+  }
+
  private:
   // tries to converge front_ and other iterators to the specified target.
   // if it impossible tries to find first convergence place
@@ -25,10 +25,15 @@
 #define IRESEARCH_DISJUNCTION_H
 
 #include "conjunction.hpp"
+#include "filter.hpp"
+#include "utils/bit_utils.hpp"
+#include "utils/math_utils.hpp"
 #include "utils/std.hpp"
 #include "utils/type_limits.hpp"
 #include "index/iterators.hpp"
 
+#include <cmath>
+#include <limits>
 #include <queue>
 
 NS_ROOT
@@ -109,6 +114,16 @@ class basic_disjunction final : public doc_iterator_base {
     return (doc_ = std::min(lhs_->value(), rhs_->value()));
   }
 
+  virtual size_t next_batch(doc_id_t* docs, size_t size) override {
+    size_t count = 0;
+
+    while (count < size && basic_disjunction::next()) {
+      docs[count++] = doc_;
+    }
+
+    return count;
+  }
+
  private:
   struct resolve_overload_tag { };
 
@@ -254,6 +269,92 @@ class disjunction : public doc_iterator_base {
     return doc_ = lead()->value();
   }
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief collects matching documents window by window instead of
+  ///        maintaining the heap for every document: each iterator marks its
+  ///        documents falling into the window [base, base + width) in a
+  ///        bitmap, which is then emitted in order. The window is never wider
+  ///        than the free space of 'docs', so every marked document fits and
+  ///        all iterators end up past the last stored one
+  //////////////////////////////////////////////////////////////////////////////
+  virtual size_t next_batch(doc_id_t* docs, size_t size) override {
+    typedef uint64_t word_t;
+    static const size_t WORD_BITS = bits_required<word_t>();
+    static const size_t WINDOW_WORDS = 64;
+
+    if (type_limits<type_t::doc_id_t>::eof(doc_)) {
+      return 0;
+    }
+
+    // move iterators out of the current document
+    for (auto& it : itrs_) {
+      const auto doc = it->value();
+
+      if (doc == doc_) {
+        it->next();
+      } else if (doc < doc_) {
+        it->seek(doc_ + 1);
+      }
+    }
+
+    remove_exhausted();
+
+    word_t window[WINDOW_WORDS];
+    size_t count = 0;
+
+    while (count < size && !itrs_.empty()) {
+      auto base = type_limits<type_t::doc_id_t>::eof();
+
+      for (auto& it : itrs_) {
+        base = std::min(base, it->value());
+      }
+
+      const auto width = std::min(size - count, WINDOW_WORDS*WORD_BITS);
+      const auto words = (width + WORD_BITS - 1) / WORD_BITS;
+      const auto end = std::min(
+        uint64_t(base) + width,
+        uint64_t(type_limits<type_t::doc_id_t>::eof()) // exclude exhausted iterators
+      );
+
+      std::fill_n(window, words, word_t(0));
+
+      for (auto& it : itrs_) {
+        for (uint64_t doc = it->value(); doc < end; doc = it->value()) {
+          const auto offset = doc - base;
+          set_bit(window[offset / WORD_BITS], offset % WORD_BITS);
+
+          if (!it->next()) {
+            break;
+          }
+        }
+      }
+
+      remove_exhausted();
+
+      // emit marked documents in order, there is at least one ('base')
+      for (size_t i = 0; i < words; ++i) {
+        for (auto word = window[i]; word; word &= word - 1) { // reset the lowest set bit
+          docs[count++] = doc_id_t(base + i*WORD_BITS + math::math_traits<word_t>::ctz(word));
+        }
+      }
+
+      doc_ = docs[count - 1];
+    }
+
+    if (count < size) {
+      doc_ = type_limits<type_t::doc_id_t>::eof();
+    } else if (!itrs_.empty()) {
+      // restore the heap, lead is the iterator with the lowest document
+      auto begin = itrs_.begin(), end = itrs_.end();
+      std::make_heap(begin, end, [](const doc_iterator_t& lhs, const doc_iterator_t& rhs) {
+        return lhs->value() > rhs->value();
+      });
+      pop(begin, end);
+    }
+
+    return count;
+  }
+
  private:
   struct resolve_overload_tag{};
 
@@ -305,6 +406,18 @@ class disjunction : public doc_iterator_base {
     return !itrs_.empty();
   }
 
+  // removes exhausted iterators, order of the rest is not preserved
+  inline void remove_exhausted() {
+    for (size_t i = 0; i < itrs_.size();) {
+      if (type_limits<type_t::doc_id_t>::eof(itrs_[i]->value())) {
+        std::swap(itrs_[i], itrs_.back());
+        itrs_.pop_back();
+      } else {
+        ++i;
+      }
+    }
+  }
+
   inline void refresh_lead() {
     auto begin = itrs_.begin(), end = itrs_.end();
     push(begin, end);
@@ -387,6 +500,241 @@ class disjunction : public doc_iterator_base {
   doc_id_t doc_;
 }; // disjunction
 
+////////////////////////////////////////////////////////////////////////////////
+/// @class block_max_disjunction
+/// @brief scored disjunction which omits the documents that can't exceed the
+///        specified score threshold (MaxScore algorithm with block-max bounds)
+///-----------------------------------------------------------------------------
+///   [0]   <-- begin
+///   [1]      | non-essential iterators, sum of their max scores
+///   ...      | can't exceed the threshold
+///   [e]   <-- essential iterators, only these are used for
+///   ...      | document candidates generation
+///   [n-1] <-- end
+///-----------------------------------------------------------------------------
+/// iterators are ordered by their max score in ascending order, each candidate
+/// is checked against the block-max bounds before scoring, so the whole blocks
+/// of documents that can't exceed the threshold are skipped
+/// @note applicable to the orders consisting of a single 'float_t' score, where
+///       higher score is better, every sub iterator has to provide 'score_bound'
+////////////////////////////////////////////////////////////////////////////////
+class block_max_disjunction : public doc_iterator_base {
+ public:
+  typedef score_iterator_adapter doc_iterator_t;
+  typedef std::vector<doc_iterator_t> doc_iterators_t;
+
+  block_max_disjunction(
+      doc_iterators_t&& itrs,
+      const order::prepared& ord,
+      const score_threshold& threshold)
+    : doc_iterator_base(ord),
+      threshold_(&threshold),
+      doc_(type_limits<type_t::doc_id_t>::invalid()) {
+    assert(!itrs.empty());
+    assert(1 == std::distance(ord.begin(), ord.end()));
+
+    nodes_.reserve(itrs.size());
+
+    for (auto& it : itrs) {
+      auto& bound = it->attributes().get<score_bound>();
+      assert(bound);
+
+      nodes_.emplace_back(std::move(it), *bound);
+    }
+
+    // sort sub iterators in ascending order by their max score
+    std::sort(
+      nodes_.begin(), nodes_.end(),
+      [](const node& lhs, const node& rhs) {
+        return lhs.max < rhs.max;
+    });
+
+    // prefix sums of max scores
+    max_sums_.reserve(nodes_.size() + 1);
+    max_sums_.emplace_back(0.f);
+
+    for (auto& node : nodes_) {
+      max_sums_.emplace_back(max_sums_.back() + node.max);
+    }
+
+    // estimate disjunction
+    estimate([this](){
+      return std::accumulate(
+        nodes_.begin(), nodes_.end(), cost::cost_t(0),
+        [](cost::cost_t lhs, const node& rhs) {
+          return lhs + cost::extract(rhs.it->attributes(), 0);
+      });
+    });
+
+    // prepare score
+    prepare_score([this](byte_type* score) {
+      reinterpret_cast<float_t&>(*score) = score_;
+    });
+  }
+
+  virtual doc_id_t value() const override {
+    return doc_;
+  }
+
+  virtual bool next() override {
+    if (type_limits<type_t::doc_id_t>::eof(doc_)) {
+      return false;
+    }
+
+    return !type_limits<type_t::doc_id_t>::eof(advance(doc_ + 1));
+  }
+
+  virtual doc_id_t seek(doc_id_t target) override {
+    if (target <= doc_) {
+      return doc_;
+    }
+
+    return advance(target);
+  }
+
+ private:
+  struct node {
+    node(doc_iterator_t&& it, score_bound& bound)
+      : it(std::move(it)), bound(&bound), max(bound.max()) {
+    }
+
+    node(node&& rhs) NOEXCEPT
+      : it(std::move(rhs.it)), bound(rhs.bound), max(rhs.max) {
+    }
+
+    node& operator=(node&& rhs) NOEXCEPT {
+      if (this != &rhs) {
+        it = std::move(rhs.it);
+        bound = rhs.bound;
+        max = rhs.max;
+      }
+      return *this;
+    }
+
+    doc_iterator_t it;
+    score_bound* bound;
+    float_t max; // max score of the iterator
+  }; // node
+
+  // bounds are evaluated in a different order than the actual score,
+  // the slack compensates the rounding errors
+  bool competitive(float_t bound) const NOEXCEPT {
+    return bound + std::fabs(bound) * 1e-5f >= threshold_->value;
+  }
+
+  static float_t score(const doc_iterator_t& it) {
+    it.score->evaluate();
+    return *reinterpret_cast<const float_t*>(it.score->c_str());
+  }
+
+  doc_id_t advance(doc_id_t target) {
+    const size_t size = nodes_.size();
+
+    for (;;) {
+      // move iterators which can't exceed the threshold to non-essential ones
+      while (essential_ < size && !competitive(max_sums_[essential_ + 1])) {
+        ++essential_;
+      }
+
+      if (essential_ == size) {
+        // none of the remaining documents can exceed the threshold
+        return (doc_ = type_limits<type_t::doc_id_t>::eof());
+      }
+
+      // find next candidate among essential iterators
+      auto doc = type_limits<type_t::doc_id_t>::eof();
+
+      for (size_t i = essential_; i < size; ++i) {
+        auto& it = nodes_[i].it;
+
+        if (it->value() < target) {
+          it->seek(target);
+        }
+
+        doc = std::min(doc, it->value());
+      }
+
+      if (type_limits<type_t::doc_id_t>::eof(doc)) {
+        return (doc_ = doc);
+      }
+
+      const bool prune = threshold_->value > -std::numeric_limits<float_t>::infinity();
+      float_t matched_max = 0.f; // block bound of the iterators matching 'doc'
+
+      if (prune) {
+        auto block_end = type_limits<type_t::doc_id_t>::eof();
+        float_t block_max = 0.f; // block bound of all iterators
+
+        for (size_t i = 0; i < size; ++i) {
+          auto& node = nodes_[i];
+          block_end = std::min(block_end, node.bound->shallow_seek(doc));
+          block_max += node.bound->block_max();
+
+          if (i < essential_ || node.it->value() == doc) {
+            matched_max += node.bound->block_max();
+          }
+        }
+
+        if (!competitive(block_max)) {
+          // none of the documents up to the end of the block can exceed
+          // the threshold
+          if (type_limits<type_t::doc_id_t>::eof(block_end)) {
+            return (doc_ = block_end);
+          }
+
+          target = block_end + 1;
+          continue;
+        }
+
+        if (!competitive(matched_max)) {
+          target = doc + 1;
+          continue;
+        }
+      }
+
+      float_t doc_score = 0.f;
+
+      for (size_t i = essential_; i < size; ++i) {
+        auto& node = nodes_[i];
+
+        if (node.it->value() == doc) {
+          doc_score += score(node.it);
+          matched_max -= node.bound->block_max();
+        }
+      }
+
+      // check non-essential iterators in descending order by their max score
+      for (size_t i = essential_; i && competitive(doc_score + matched_max);) {
+        auto& node = nodes_[--i];
+
+        matched_max -= node.bound->block_max();
+
+        if (node.it->value() < doc) {
+          node.it->seek(doc);
+        }
+
+        if (node.it->value() == doc) {
+          doc_score += score(node.it);
+        }
+      }
+
+      if (!prune || competitive(doc_score)) {
+        score_ = doc_score;
+        return (doc_ = doc);
+      }
+
+      target = doc + 1;
+    }
+  }
+
+  std::vector<node> nodes_; // sorted by max score
+  std::vector<float_t> max_sums_; // prefix sums of max scores
+  const score_threshold* threshold_;
+  size_t essential_{}; // index of the first essential iterator
+  doc_id_t doc_;
+  float_t score_{}; // score of the current document
+}; // block_max_disjunction
+
 //////////////////////////////////////////////////////////////////////////////
 /// @returns disjunction iterator created from the specified sub iterators
 //////////////////////////////////////////////////////////////////////////////
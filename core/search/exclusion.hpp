@@ -63,6 +63,36 @@ class exclusion final : public doc_iterator {
     return next(target);
   }
 
+  // candidates are fetched from 'incl_' in batches no larger than the free
+  // space of 'docs', so 'incl_' is positioned at the last stored document
+  // once 'docs' is filled
+  virtual size_t next_batch(doc_id_t* docs, size_t size) override {
+    size_t count = 0;
+    auto excl = excl_->value();
+
+    while (count < size) {
+      const auto left = size - count;
+      auto* begin = docs + count;
+      const auto* end = begin + incl_->next_batch(begin, left);
+
+      for (auto* candidate = begin; candidate != end; ++candidate) {
+        if (excl < *candidate) {
+          excl = excl_->seek(*candidate);
+        }
+
+        if (excl != *candidate) {
+          docs[count++] = *candidate;
+        }
+      }
+
+      if (size_t(end - begin) < left) {
+        break; // 'incl_' is exhausted
+      }
+    }
+
+    return count;
+  }
+
   virtual const attribute_view& attributes() const NOEXCEPT override {
     return incl_->attributes();
   }
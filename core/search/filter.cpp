@@ -63,6 +63,12 @@ filter::prepared::prepared(attribute_store&& attrs)
 
 filter::prepared::~prepared() {}
 
+// -----------------------------------------------------------------------------
+// --SECTION--                                                   score_threshold
+// -----------------------------------------------------------------------------
+
+DEFINE_ATTRIBUTE_TYPE(irs::score_threshold);
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                             empty
 // -----------------------------------------------------------------------------
@@ -30,6 +30,7 @@
 
 #include <unordered_map>
 #include <functional>
+#include <limits>
 
 NS_ROOT
 
@@ -199,6 +200,26 @@ class IRESEARCH_API filter {
   const type_id* type_;
 }; // filter
 
+////////////////////////////////////////////////////////////////////////////////
+/// @class score_threshold
+/// @brief the score a document has to exceed in order to be of interest to
+///        the consumer of the documents of the specified query (e.g. the worst
+///        score of a full top-K heap), the value may grow during iteration
+/// @note passed via 'ctx' to 'filter::prepared::execute(...)', applicable to
+///       the orders consisting of a single 'float_t' score, where higher score
+///       is better, only
+/// @note only the specified query may omit non-competitive documents, nested
+///       queries have to return all the matched documents
+////////////////////////////////////////////////////////////////////////////////
+struct IRESEARCH_API score_threshold : attribute {
+  DECLARE_ATTRIBUTE_TYPE();
+
+  score_threshold() = default;
+
+  const filter::prepared* query{};
+  float_t value{ -std::numeric_limits<float_t>::infinity() };
+}; // score_threshold
+
 #define DECLARE_FILTER_TYPE() DECLARE_TYPE_ID(::iresearch::type_id)
 #define DEFINE_FILTER_TYPE(class_name) DEFINE_TYPE_ID(class_name,::iresearch::type_id) { \
   static ::iresearch::type_id type; \
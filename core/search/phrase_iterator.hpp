@@ -67,6 +67,11 @@ class phrase_iterator final : public conjunction {
     return this->value();
   }
 
+  virtual size_t next_batch(doc_id_t* docs, size_t size) override {
+    // positions have to be checked for every candidate
+    return doc_iterator::next_batch(docs, size);
+  }
+
  private:
   // returns frequency of the phrase
   frequency::value_t phrase_freq() {
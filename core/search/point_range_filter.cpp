@@ -0,0 +1,215 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Andrey Abramov
+/// @author Vasiliy Nabatchikov
+////////////////////////////////////////////////////////////////////////////////
+
+#include "point_range_filter.hpp"
+#include "bitset_doc_iterator.hpp"
+#include "analysis/token_attributes.hpp"
+#include "formats/formats.hpp"
+#include "index/field_meta.hpp"
+#include "index/index_reader.hpp"
+#include "utils/numeric_utils.hpp"
+#include "utils/type_limits.hpp"
+
+#include <boost/functional/hash.hpp>
+
+NS_LOCAL
+
+typedef irs::detail::range<irs::bstring> range_t;
+
+irs::bytes_ref bound(const irs::bstring& term, irs::Bound_Type type) {
+  return irs::Bound_Type::UNBOUNDED == type ? irs::bytes_ref::NIL : irs::bytes_ref(term);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief marks documents of the terms within the specified range, used for
+///        segments without points of the field
+////////////////////////////////////////////////////////////////////////////////
+void collect_terms(
+    const irs::term_reader& field,
+    const irs::bytes_ref& min, bool min_inclusive,
+    const irs::bytes_ref& max, bool max_inclusive,
+    irs::bitset& docs) {
+  const bool granular = field.meta().features.check<irs::granularity_prefix>();
+  auto terms = field.iterator();
+
+  bool valid = min.null()
+    ? terms->next()
+    : min_inclusive
+      ? irs::seek_min<true>(*terms, min)
+      : irs::seek_min<false>(*terms, min);
+
+  for (; valid; valid = terms->next()) {
+    const auto& term = terms->value();
+
+    if (!max.null() && (max_inclusive ? max < term : !(term < max))) {
+      break;
+    }
+
+    if (granular && !irs::numeric_utils::exact(term)) {
+      continue; // skip less precise terms
+    }
+
+    for (auto it = terms->postings(irs::flags::empty_instance()); it->next();) {
+      docs.set(it->value());
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief holds matched documents for the lifetime of the iterator over them
+////////////////////////////////////////////////////////////////////////////////
+struct point_doc_iterator {
+  point_doc_iterator(
+      const irs::sub_reader& rdr,
+      const irs::attribute_store& prepared_filter_attrs,
+      irs::bitset&& docs,
+      const irs::order::prepared& ord)
+    : docs(std::move(docs)),
+      it(rdr, prepared_filter_attrs, this->docs, ord) {
+  }
+
+  irs::bitset docs;
+  irs::bitset_doc_iterator it;
+}; // point_doc_iterator
+
+////////////////////////////////////////////////////////////////////////////////
+/// @class point_range_query
+/// @brief evaluates the range over the points of a field in a segment
+////////////////////////////////////////////////////////////////////////////////
+class point_range_query final : public irs::filter::prepared {
+ public:
+  point_range_query(
+      const std::string& field,
+      const range_t& rng,
+      irs::attribute_store&& attrs)
+    : irs::filter::prepared(std::move(attrs)),
+      field_(field),
+      rng_(rng) {
+  }
+
+  virtual irs::doc_iterator::ptr execute(
+      const irs::sub_reader& rdr,
+      const irs::order::prepared& ord,
+      const irs::attribute_view& /*ctx*/) const override {
+    const auto* field = rdr.field(field_);
+
+    if (!field) {
+      // no such field in this reader
+      return irs::doc_iterator::empty();
+    }
+
+    const auto min = bound(rng_.min, rng_.min_type);
+    const bool min_inclusive = irs::Bound_Type::INCLUSIVE == rng_.min_type;
+    const auto max = bound(rng_.max, rng_.max_type);
+    const bool max_inclusive = irs::Bound_Type::INCLUSIVE == rng_.max_type;
+
+    irs::bitset docs(
+      irs::type_limits<irs::type_t::doc_id_t>::min() + rdr.docs_count()
+    );
+
+    const auto* points = field->points();
+
+    if (points) {
+      points->visit(min, min_inclusive, max, max_inclusive, docs);
+    } else {
+      collect_terms(*field, min, min_inclusive, max, max_inclusive, docs);
+    }
+
+    if (docs.none()) {
+      return irs::doc_iterator::empty();
+    }
+
+    auto holder = std::make_shared<point_doc_iterator>(
+      rdr, attributes(), std::move(docs), ord
+    );
+
+    // share ownership of the doc set with the iterator
+    return irs::doc_iterator::ptr(holder, &holder->it);
+  }
+
+ private:
+  std::string field_;
+  range_t rng_;
+}; // point_range_query
+
+NS_END
+
+NS_ROOT
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                     by_point_range implementation
+// -----------------------------------------------------------------------------
+
+DEFINE_FILTER_TYPE(by_point_range);
+DEFINE_FACTORY_DEFAULT(by_point_range);
+
+by_point_range::by_point_range() NOEXCEPT
+  : filter(by_point_range::type()) {
+}
+
+bool by_point_range::equals(const filter& rhs) const NOEXCEPT {
+  const auto& trhs = static_cast<const by_point_range&>(rhs);
+  return filter::equals(rhs) && fld_ == trhs.fld_ && rng_ == trhs.rng_;
+}
+
+size_t by_point_range::hash() const NOEXCEPT {
+  size_t seed = 0;
+  ::boost::hash_combine(seed, filter::hash());
+  ::boost::hash_combine(seed, fld_);
+  ::boost::hash_combine(seed, rng_.min);
+  ::boost::hash_combine(seed, rng_.min_type);
+  ::boost::hash_combine(seed, rng_.max);
+  ::boost::hash_combine(seed, rng_.max_type);
+  return seed;
+}
+
+filter::prepared::ptr by_point_range::prepare(
+    const index_reader& rdr,
+    const order::prepared& ord,
+    boost_t boost,
+    const attribute_view& /*ctx*/) const {
+  if (Bound_Type::UNBOUNDED != rng_.min_type
+      && Bound_Type::UNBOUNDED != rng_.max_type
+      && (rng_.max < rng_.min
+          || (rng_.min == rng_.max
+              && (Bound_Type::INCLUSIVE != rng_.min_type
+                  || Bound_Type::INCLUSIVE != rng_.max_type)))) {
+    // can't satisfy condition
+    return prepared::empty();
+  }
+
+  attribute_store attrs;
+
+  // skip field-level/term-level statistics, all documents are scored equally
+  ord.prepare_stats().finish(attrs, rdr);
+
+  irs::boost::apply(attrs, this->boost() * boost); // apply boost
+
+  return filter::prepared::make<point_range_query>(fld_, rng_, std::move(attrs));
+}
+
+NS_END // ROOT
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                       END-OF-FILE
+// -----------------------------------------------------------------------------
@@ -0,0 +1,142 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Andrey Abramov
+/// @author Vasiliy Nabatchikov
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef IRESEARCH_POINT_RANGE_FILTER_H
+#define IRESEARCH_POINT_RANGE_FILTER_H
+
+#include "range_filter.hpp"
+
+NS_ROOT
+
+//////////////////////////////////////////////////////////////////////////////
+/// @class by_point_range
+/// @brief user-side range filter evaluated over the block KD-tree of a field
+///        indexed with the 'point_index' feature, bounds are the most precise
+///        values, e.g. as returned by 'numeric_token_stream::value(...)'
+/// @note segments without points of the field are evaluated over the terms
+///       of the field, for 'granularity_prefix' fields only the most precise
+///       terms are considered
+/// @note all matched documents get the same score
+//////////////////////////////////////////////////////////////////////////////
+class IRESEARCH_API by_point_range : public filter {
+ public:
+  DECLARE_FILTER_TYPE();
+  DECLARE_FACTORY_DEFAULT();
+
+  by_point_range() NOEXCEPT;
+
+  using filter::prepare;
+
+  virtual filter::prepared::ptr prepare(
+    const index_reader& rdr,
+    const order::prepared& ord,
+    boost_t boost,
+    const attribute_view& ctx
+  ) const override;
+
+  by_point_range& field(std::string fld) {
+    fld_ = std::move(fld);
+    return *this;
+  }
+
+  const std::string& field() const {
+    return fld_;
+  }
+
+  template<Bound B>
+  const bstring& term() const {
+    return get<B>::term(rng_);
+  }
+
+  template<Bound B>
+  by_point_range& term(bstring&& term) {
+    get<B>::term(rng_) = std::move(term);
+
+    if (Bound_Type::UNBOUNDED == get<B>::type(rng_)) {
+      get<B>::type(rng_) = Bound_Type::EXCLUSIVE;
+    }
+
+    return *this;
+  }
+
+  template<Bound B>
+  by_point_range& term(const bytes_ref& term) {
+    get<B>::term(rng_) = term;
+
+    if (term.null()) {
+      get<B>::type(rng_) = Bound_Type::UNBOUNDED;
+    } else if (Bound_Type::UNBOUNDED == get<B>::type(rng_)) {
+      get<B>::type(rng_) = Bound_Type::EXCLUSIVE;
+    }
+
+    return *this;
+  }
+
+  template<Bound B>
+  by_point_range& term(const string_ref& term) {
+    return this->term<B>(ref_cast<byte_type>(term));
+  }
+
+  template<Bound B>
+  by_point_range& include(bool incl) {
+    get<B>::type(rng_) = incl ? Bound_Type::INCLUSIVE : Bound_Type::EXCLUSIVE;
+    return *this;
+  }
+
+  template<Bound B>
+  bool include() const {
+    return Bound_Type::INCLUSIVE == get<B>::type(rng_);
+  }
+
+  virtual size_t hash() const NOEXCEPT override;
+
+ protected:
+  virtual bool equals(const filter& rhs) const NOEXCEPT override;
+
+ private:
+  typedef detail::range<bstring> range_t;
+  template<Bound B> struct get;
+
+  IRESEARCH_API_PRIVATE_VARIABLES_BEGIN
+  std::string fld_;
+  range_t rng_;
+  IRESEARCH_API_PRIVATE_VARIABLES_END
+}; // by_point_range
+
+template<> struct by_point_range::get<Bound::MIN> {
+  static bstring& term(range_t& rng) { return rng.min; }
+  static const bstring& term(const range_t& rng) { return rng.min; }
+  static Bound_Type& type(range_t& rng) { return rng.min_type; }
+  static const Bound_Type& type(const range_t& rng) { return rng.min_type; }
+}; // get<Bound::MIN>
+
+template<> struct by_point_range::get<Bound::MAX> {
+  static bstring& term(range_t& rng) { return rng.max; }
+  static const bstring& term(const range_t& rng) { return rng.max; }
+  static Bound_Type& type(range_t& rng) { return rng.max_type; }
+  static const Bound_Type& type(const range_t& rng) { return rng.max_type; }
+}; // get<Bound::MAX>
+
+NS_END // ROOT
+
+#endif // IRESEARCH_POINT_RANGE_FILTER_H
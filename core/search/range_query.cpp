@@ -31,6 +31,9 @@
 
 NS_LOCAL
 
+// number of documents fetched at once from postings
+const size_t BATCH_SIZE = 128;
+
 void set_doc_ids(irs::bitset& buf, const irs::term_iterator& term) {
   auto itr = term.postings(irs::flags::empty_instance());
 
@@ -38,8 +41,15 @@ void set_doc_ids(irs::bitset& buf, const irs::term_iterator& term) {
     return; // no doc_ids in iterator
   }
 
-  while(itr->next()) {
-    buf.set(itr->value());
+  irs::doc_id_t batch[BATCH_SIZE];
+
+  // fetch documents in batches, avoids a virtual call per document
+  for (size_t count = BATCH_SIZE; count == BATCH_SIZE;) {
+    count = itr->next_batch(batch, BATCH_SIZE);
+
+    for (size_t i = 0; i < count; ++i) {
+      buf.set(batch[i]);
+    }
   }
 }
 
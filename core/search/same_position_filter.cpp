@@ -78,6 +78,11 @@ class same_position_iterator final : public conjunction {
     return this->value();
   }
 
+  virtual size_t next_batch(doc_id_t* docs, size_t size) override {
+    // positions have to be checked for every candidate
+    return doc_iterator::next_batch(docs, size);
+  }
+
  private:
   bool find_same_position() {
     auto target = type_limits<type_t::pos_t>::min();
@@ -46,4 +46,10 @@ score::score() NOEXCEPT
   : func_([](byte_type*){}) {
 }
 
+// ----------------------------------------------------------------------------
+// --SECTION--                                                      score_bound
+// ----------------------------------------------------------------------------
+
+DEFINE_ATTRIBUTE_TYPE(iresearch::score_bound);
+
 NS_END // ROOT
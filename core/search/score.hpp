@@ -88,6 +88,37 @@ class IRESEARCH_API score : public attribute {
   IRESEARCH_API_PRIVATE_VARIABLES_END
 }; // score
 
+//////////////////////////////////////////////////////////////////////////////
+/// @class score_bound
+/// @brief upper bounds of the document scores produced by a scored iterator,
+///        defined for the orders consisting of a single 'float_t' score only
+/// @note shallow_seek(...) targets are expected in ascending order
+//////////////////////////////////////////////////////////////////////////////
+class IRESEARCH_API score_bound : public attribute {
+ public:
+  DECLARE_REF(score_bound);
+  DECLARE_TYPE_ID(attribute::type_id);
+
+  virtual ~score_bound() = default;
+
+  ////////////////////////////////////////////////////////////////////////////
+  /// @returns upper bound of the score over all documents
+  ////////////////////////////////////////////////////////////////////////////
+  virtual float_t max() const = 0;
+
+  ////////////////////////////////////////////////////////////////////////////
+  /// @brief moves to the block of documents which may contain the specified
+  ///        target, doesn't affect the position of the iterator
+  /// @returns the last document of the block, 'eof' for the last block
+  ////////////////////////////////////////////////////////////////////////////
+  virtual doc_id_t shallow_seek(doc_id_t target) = 0;
+
+  ////////////////////////////////////////////////////////////////////////////
+  /// @returns upper bound of the score in the current block
+  ////////////////////////////////////////////////////////////////////////////
+  virtual float_t block_max() const = 0;
+}; // score_bound
+
 NS_END // ROOT
 
 #endif // IRESEARCH_SCORE_H
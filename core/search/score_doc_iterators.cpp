@@ -60,6 +60,64 @@ basic_doc_iterator::basic_doc_iterator(
   prepare_score([this](byte_type* score) {
     scorers_.score(*ord_, score);
   });
+
+  // set score bounds
+  auto& freq = it_->attributes().get<frequency_bound>();
+
+  if (freq && bound_.prepare(*this, *freq)) {
+    attrs_.emplace<score_bound>(bound_);
+  }
+}
+
+bool basic_doc_iterator::term_score_bound::prepare(
+    const basic_doc_iterator& owner,
+    frequency_bound& freq) {
+  const auto& ord = *owner.ord_;
+
+  // bounds are defined for a single 'float_t' score only
+  if (1 != std::distance(ord.begin(), ord.end())
+      || !ord[0].bucket->float_score()) {
+    return false;
+  }
+
+  owner_ = &owner;
+  freq_ = &freq;
+  buf_.resize(ord.size());
+  block_freq_ = freq.max();
+
+  if (!evaluate(block_freq_, max_)) {
+    return false;
+  }
+
+  block_max_ = max_;
+  return true;
+}
+
+doc_id_t basic_doc_iterator::term_score_bound::shallow_seek(doc_id_t target) {
+  const auto end = freq_->shallow_seek(target);
+  const auto block_freq = freq_->block_max();
+
+  if (block_freq != block_freq_) {
+    block_freq_ = block_freq;
+    evaluate(block_freq_, block_max_); // can't fail since succeeded in 'prepare'
+  }
+
+  return end;
+}
+
+bool basic_doc_iterator::term_score_bound::evaluate(
+    uint64_t freq, float_t& score) {
+  auto* buf = &buf_[0];
+  const auto& ord = *owner_->ord_;
+
+  ord.prepare_score(buf);
+
+  if (!owner_->scorers_.max_score(ord, buf, freq)) {
+    return false;
+  }
+
+  score = ord.get<float_t>(buf, 0);
+  return true;
 }
 
 #if defined(_MSC_VER)
@@ -91,10 +91,38 @@ class basic_doc_iterator final : public doc_iterator_base {
     return it_->seek(target);
   }
 
+  virtual size_t next_batch(doc_id_t* docs, size_t size) override {
+    return it_->next_batch(docs, size);
+  }
+
  private:
+  //////////////////////////////////////////////////////////////////////////////
+  /// @class term_score_bound
+  /// @brief score bounds evaluated from the term frequency bounds
+  //////////////////////////////////////////////////////////////////////////////
+  class term_score_bound final : public score_bound {
+   public:
+    bool prepare(const basic_doc_iterator& owner, frequency_bound& freq);
+
+    virtual float_t max() const override { return max_; }
+    virtual doc_id_t shallow_seek(doc_id_t target) override;
+    virtual float_t block_max() const override { return block_max_; }
+
+   private:
+    bool evaluate(uint64_t freq, float_t& score);
+
+    const basic_doc_iterator* owner_{};
+    frequency_bound* freq_{};
+    bstring buf_; // score buffer as per 'order::prepared'
+    uint64_t block_freq_{}; // frequency bound of the current block
+    float_t max_{};
+    float_t block_max_{};
+  }; // term_score_bound
+
   order::prepared::scorers scorers_;
   doc_iterator::ptr it_;
   const attribute_store* stats_;
+  term_score_bound bound_;
 }; // basic_doc_iterator
 
 NS_END // ROOT
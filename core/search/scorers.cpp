@@ -28,6 +28,7 @@
 #endif
 
 #include "utils/register.hpp"
+#include "column_sort.hpp"
 #include "scorers.hpp"
 
 NS_LOCAL
@@ -106,6 +107,8 @@ NS_ROOT
 }
 
 /*static*/ void scorers::init() {
+  irs::column_sort::init(); // part of the core library
+
   #ifndef IRESEARCH_DLL
     irs::bm25_sort::init();
     irs::tfidf_sort::init();
@@ -224,6 +224,24 @@ void order::prepared::scorers::score(
   });
 }
 
+bool order::prepared::scorers::max_score(
+  const order::prepared& ord, byte_type* scr, uint64_t freq
+) const {
+  size_t i = 0;
+
+  for (auto& scorer : scorers_) {
+    // no scorer means the score is the same for all documents
+    if (scorer && !scorer->max_score(scr, freq)) {
+      return false;
+    }
+
+    const sort::prepared& bucket = *ord[i++].bucket;
+    scr += bucket.size();
+  }
+
+  return true;
+}
+
 order::prepared::prepared() : size_(0) { }
 
 order::prepared::stats 
@@ -137,6 +137,17 @@ class IRESEARCH_API sort {
     /// @brief set the document score based on the stored state
     ////////////////////////////////////////////////////////////////////////////////
     virtual void score(byte_type* score_buf) = 0;
+
+    ////////////////////////////////////////////////////////////////////////////////
+    /// @brief set the upper bound of the score of the documents having
+    ///        the term frequency not greater than the specified one
+    /// @returns false if the bound can't be evaluated
+    ////////////////////////////////////////////////////////////////////////////////
+    virtual bool max_score(byte_type* score_buf, uint64_t freq) const {
+      UNUSED(score_buf);
+      UNUSED(freq);
+      return false;
+    }
   }; // scorer
 
   template <typename T>
@@ -206,6 +217,13 @@ class IRESEARCH_API sort {
     ////////////////////////////////////////////////////////////////////////////////
     virtual size_t size() const = 0;
 
+    ////////////////////////////////////////////////////////////////////////////////
+    /// @return true if the score is a single 'float_t' value and less(...) is
+    ///         equivalent to 'operator<', i.e. collectors may compare scores
+    ///         directly without virtual calls
+    ////////////////////////////////////////////////////////////////////////////////
+    virtual bool float_score() const NOEXCEPT { return false; }
+
    private:
     attribute_view attrs_;
   }; // prepared
@@ -444,6 +462,13 @@ class IRESEARCH_API order final {
 
       void score(const prepared& ord, byte_type* score) const;
 
+      //////////////////////////////////////////////////////////////////////////
+      /// @brief set the upper bound of the score of the documents having
+      ///        the term frequency not greater than the specified one
+      /// @returns false if any of the scorers can't evaluate the bound
+      //////////////////////////////////////////////////////////////////////////
+      bool max_score(const prepared& ord, byte_type* score, uint64_t freq) const;
+
      private:
       IRESEARCH_API_PRIVATE_VARIABLES_BEGIN
       scorers_t scorers_;
@@ -224,6 +224,16 @@ class scorer : public iresearch::sort::scorer_base<tfidf::score_t> {
     score_cast(score_buf) = tfidf();
   }
 
+  virtual bool max_score(byte_type* score_buf, uint64_t freq) const override {
+    if (idf_ < 0.f) {
+      return false; // the score isn't monotonic in term frequency
+    }
+
+    // norm values don't exceed 1, so the non-normalized score is the bound
+    score_cast(score_buf) = idf_ * float_t(std::sqrt(freq));
+    return true;
+  }
+
  protected:
   FORCE_INLINE float_t tfidf() const {
    return idf_ * float_t(std::sqrt(freq_->value));
@@ -313,6 +323,10 @@ class sort final: iresearch::sort::prepared_base<tfidf::score_t> {
     return lhs < rhs;
   }
 
+  virtual bool float_score() const NOEXCEPT override {
+    return std::is_same<score_t, float_t>::value;
+  }
+
  private:
   const std::function<bool(score_t, score_t)>* less_;
   bool normalize_;
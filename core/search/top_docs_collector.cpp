@@ -0,0 +1,476 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Andrey Abramov
+/// @author Vasiliy Nabatchikov
+////////////////////////////////////////////////////////////////////////////////
+
+
+#include "top_docs_collector.hpp"
+#include "score.hpp"
+#include "index/index_reader.hpp"
+#include "utils/async_utils.hpp"
+
+#include <algorithm>
+
+NS_LOCAL
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief generic comparer, 'true' if 'lhs' score ranks before the 'rhs' one
+////////////////////////////////////////////////////////////////////////////////
+class order_less {
+ public:
+  explicit order_less(const irs::order::prepared& ord) NOEXCEPT
+    : ord_(&ord) {
+  }
+
+  bool operator()(const irs::byte_type* lhs, const irs::byte_type* rhs) const {
+    return ord_->less(lhs, rhs);
+  }
+
+ private:
+  const irs::order::prepared* ord_;
+}; // order_less
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief comparer for the order consisting of a single 'float_t' score
+////////////////////////////////////////////////////////////////////////////////
+template<bool Reverse>
+struct float_less {
+  FORCE_INLINE static float_t value(const irs::byte_type* score) NOEXCEPT {
+    return *reinterpret_cast<const float_t*>(score);
+  }
+
+  bool operator()(
+      const irs::byte_type* lhs,
+      const irs::byte_type* rhs) const NOEXCEPT {
+    return Reverse ? value(rhs) < value(lhs) : value(lhs) < value(rhs);
+  }
+}; // float_less
+
+template<typename Less>
+FORCE_INLINE bool ranks_before(
+    const Less& less,
+    const irs::byte_type* lhs_score, size_t lhs_ordinal, irs::doc_id_t lhs_doc,
+    const irs::byte_type* rhs_score, size_t rhs_ordinal, irs::doc_id_t rhs_doc) {
+  if (less(lhs_score, rhs_score)) {
+    return true;
+  }
+
+  if (less(rhs_score, lhs_score)) {
+    return false;
+  }
+
+  // equal scores, earlier documents first
+  return lhs_ordinal < rhs_ordinal
+    || (lhs_ordinal == rhs_ordinal && lhs_doc < rhs_doc);
+}
+
+enum class compare_mode {
+  GENERIC, // compare via virtual 'order::prepared::less(...)'
+  FLOAT_ASC, // single 'float_t' score, lower is better
+  FLOAT_DESC // single 'float_t' score, higher is better
+};
+
+compare_mode get_mode(const irs::order::prepared& ord) NOEXCEPT {
+  if (1 == std::distance(ord.begin(), ord.end())
+      && ord[0].bucket->float_score()) {
+    return ord[0].reverse ? compare_mode::FLOAT_DESC : compare_mode::FLOAT_ASC;
+  }
+
+  return compare_mode::GENERIC;
+}
+
+// saturating addition of the query costs
+irs::cost::cost_t add_cost(irs::cost::cost_t lhs, irs::cost::cost_t rhs) NOEXCEPT {
+  return rhs > irs::cost::MAX - lhs ? irs::cost::MAX : lhs + rhs;
+}
+
+NS_END // LOCAL
+
+NS_ROOT
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                 top_docs_collector implementation
+// -----------------------------------------------------------------------------
+
+top_docs_collector::top_docs_collector(
+    const order::prepared& ord,
+    size_t limit)
+  : ord_(&ord),
+    limit_(limit) {
+  heap_.reserve(limit_);
+}
+
+top_docs_collector::top_docs_collector(top_docs_collector&& rhs) NOEXCEPT
+  : ord_(rhs.ord_),
+    heap_(std::move(rhs.heap_)),
+    limit_(rhs.limit_),
+    hits_(rhs.hits_),
+    ordinal_(rhs.ordinal_) {
+  rhs.hits_ = 0;
+  rhs.ordinal_ = 0;
+}
+
+bool top_docs_collector::before(const node& lhs, const node& rhs) const {
+  const auto* lhs_score = lhs.value.score.c_str();
+  const auto* rhs_score = rhs.value.score.c_str();
+
+  switch (get_mode(*ord_)) {
+    case compare_mode::FLOAT_ASC:
+      return ranks_before(
+        float_less<false>(),
+        lhs_score, lhs.ordinal, lhs.value.doc,
+        rhs_score, rhs.ordinal, rhs.value.doc
+      );
+    case compare_mode::FLOAT_DESC:
+      return ranks_before(
+        float_less<true>(),
+        lhs_score, lhs.ordinal, lhs.value.doc,
+        rhs_score, rhs.ordinal, rhs.value.doc
+      );
+    default:
+      return ranks_before(
+        order_less(*ord_),
+        lhs_score, lhs.ordinal, lhs.value.doc,
+        rhs_score, rhs.ordinal, rhs.value.doc
+      );
+  }
+}
+
+template<typename Less>
+void top_docs_collector::collect(
+    const sub_reader& segment,
+    size_t ordinal,
+    doc_iterator& docs,
+    const Less& less,
+    score_threshold* threshold) {
+  auto heap_less = [&less](const node& lhs, const node& rhs) {
+    return ranks_before(
+      less,
+      lhs.value.score.c_str(), lhs.ordinal, lhs.value.doc,
+      rhs.value.score.c_str(), rhs.ordinal, rhs.value.doc
+    );
+  };
+
+  const auto& score = irs::score::extract(docs.attributes());
+  const bool scored = !ord_->empty() && !score.empty();
+  bstring default_score;
+  const byte_type* score_value;
+
+  if (scored) {
+    score_value = score.c_str();
+  } else {
+    // all documents get the same (default) score
+    default_score.resize(ord_->size());
+    ord_->prepare_score(&default_score[0]);
+    score_value = default_score.c_str();
+  }
+
+  const auto score_size = ord_->size();
+
+  while (docs.next()) {
+    ++hits_;
+
+    if (!limit_) {
+      continue; // nothing to collect, just count
+    }
+
+    if (scored) {
+      score.evaluate();
+    }
+
+    const auto doc = docs.value();
+
+    if (heap_.size() < limit_) {
+      heap_.emplace_back();
+
+      auto& top = heap_.back();
+      top.value.segment = &segment;
+      top.value.doc = doc;
+      top.value.score.assign(score_value, score_size);
+      top.ordinal = ordinal;
+      std::push_heap(heap_.begin(), heap_.end(), heap_less);
+
+      if (threshold && heap_.size() == limit_) {
+        threshold->value = float_less<true>::value(heap_.front().value.score.c_str());
+      }
+
+      continue;
+    }
+
+    auto& worst = heap_.front();
+
+    if (!ranks_before(less,
+                      score_value, ordinal, doc,
+                      worst.value.score.c_str(), worst.ordinal, worst.value.doc)) {
+      if (!scored) {
+        // documents arrive in ascending order having the same score,
+        // none of the remaining documents can get into the result
+        break;
+      }
+
+      continue;
+    }
+
+    // replace the worst document, reuse its score buffer
+    std::pop_heap(heap_.begin(), heap_.end(), heap_less);
+
+    auto& top = heap_.back();
+    top.value.segment = &segment;
+    top.value.doc = doc;
+    top.value.score.assign(score_value, score_size);
+    top.ordinal = ordinal;
+    std::push_heap(heap_.begin(), heap_.end(), heap_less);
+
+    if (threshold) {
+      threshold->value = float_less<true>::value(heap_.front().value.score.c_str());
+    }
+  }
+}
+
+doc_iterator::ptr top_docs_collector::execute(
+    const sub_reader& segment,
+    const filter::prepared& filter,
+    score_threshold& threshold) const {
+  attribute_view ctx;
+
+  if (compare_mode::FLOAT_DESC == get_mode(*ord_) && limit_) {
+    // let the query skip documents which can't get into the result
+    threshold.query = &filter;
+    ctx.emplace(threshold);
+  }
+
+  return filter.execute(segment, *ord_, ctx);
+}
+
+void top_docs_collector::collect(
+    const sub_reader& segment,
+    size_t ordinal,
+    doc_iterator& docs,
+    score_threshold& threshold) {
+  switch (get_mode(*ord_)) {
+    case compare_mode::FLOAT_ASC:
+      collect(segment, ordinal, docs, float_less<false>(), nullptr);
+      break;
+    case compare_mode::FLOAT_DESC:
+      if (threshold.query && heap_.size() == limit_) {
+        // documents collected so far define the threshold
+        threshold.value = float_less<true>::value(heap_.front().value.score.c_str());
+      }
+
+      collect(segment, ordinal, docs, float_less<true>(), &threshold);
+      break;
+    default:
+      collect(segment, ordinal, docs, order_less(*ord_), nullptr);
+  }
+}
+
+void top_docs_collector::collect(
+    const sub_reader& segment,
+    const filter::prepared& filter) {
+  const auto ordinal = ordinal_++;
+  score_threshold threshold;
+  auto docs = execute(segment, filter, threshold);
+
+  if (docs) {
+    collect(segment, ordinal, *docs, threshold);
+  }
+}
+
+void top_docs_collector::collect(
+    const index_reader& index,
+    const filter::prepared& filter) {
+  for (auto& segment : index) {
+    collect(segment, filter);
+  }
+}
+
+void top_docs_collector::collect(
+    const index_reader& index,
+    const filter::prepared& filter,
+    async_utils::thread_pool& pool,
+    cost::cost_t min_task_cost /*= MIN_TASK_COST*/) {
+  struct segment_state {
+    const sub_reader* segment;
+    score_threshold threshold;
+    cost::cost_t estimation;
+  };
+
+  // queries must see the thresholds at the stable addresses
+  std::vector<segment_state> segments(index.size());
+  cost::cost_t total_cost = 0;
+  size_t i = 0;
+
+  // the number of documents is an upper bound of the query cost which is
+  // known without executing the query, term lookups are done by the tasks
+  for (auto& segment : index) {
+    auto& state = segments[i++];
+    state.segment = &segment;
+    state.estimation = segment.docs_count();
+    total_cost = add_cost(total_cost, state.estimation);
+  }
+
+  // executes the query in the specified segment and collects the matches
+  auto collect_segment = [this, &segments, &filter](
+      top_docs_collector& collector, size_t idx)->void {
+    auto& state = segments[idx];
+    auto docs = execute(*state.segment, filter, state.threshold);
+
+    if (docs) {
+      collector.collect(*state.segment, ordinal_ + idx, *docs, state.threshold);
+    }
+  };
+
+  // number of tasks is bounded by the pool size and by the total cost,
+  // so the tiny segments are collected together
+  size_t tasks = std::min(segments.size(), std::max(size_t(1), pool.max_threads()));
+
+  if (min_task_cost) {
+    tasks = std::min(tasks, size_t(std::max(cost::cost_t(1), total_cost / min_task_cost)));
+  }
+
+  if (tasks <= 1) {
+    for (i = 0; i < segments.size(); ++i) {
+      collect_segment(*this, i);
+    }
+
+    ordinal_ += segments.size();
+    return;
+  }
+
+  // assign the most expensive segments first to the least loaded task
+  std::vector<size_t> order(segments.size());
+
+  for (i = 0; i < order.size(); ++i) {
+    order[i] = i;
+  }
+
+  std::stable_sort(
+    order.begin(), order.end(),
+    [&segments](size_t lhs, size_t rhs) {
+      return segments[lhs].estimation > segments[rhs].estimation;
+  });
+
+  std::vector<std::vector<size_t>> batches(tasks);
+  std::vector<cost::cost_t> loads(tasks);
+
+  for (auto idx : order) {
+    const auto task = std::distance(
+      loads.begin(), std::min_element(loads.begin(), loads.end())
+    );
+
+    batches[task].emplace_back(idx);
+    loads[task] = add_cost(loads[task], segments[idx].estimation);
+  }
+
+  std::vector<top_docs_collector> collectors;
+
+  collectors.reserve(tasks);
+
+  for (i = 0; i < tasks; ++i) {
+    collectors.emplace_back(*ord_, limit_);
+
+    // the order of segments within a task doesn't affect the result
+    std::sort(batches[i].begin(), batches[i].end());
+  }
+
+  async_utils::parallel_for(&pool, tasks, [&](size_t i)->void {
+    for (auto idx : batches[i]) {
+      collect_segment(collectors[i], idx);
+    }
+  });
+
+  // the documents are totally ordered, so the merge order doesn't matter
+  for (auto& collector : collectors) {
+    merge(std::move(collector));
+  }
+
+  ordinal_ += segments.size();
+}
+
+void top_docs_collector::merge(top_docs_collector&& rhs) {
+  auto heap_less = [this](const node& lhs, const node& rhs) {
+    return before(lhs, rhs);
+  };
+
+  hits_ += rhs.hits_;
+
+  for (auto& candidate : rhs.heap_) {
+    if (heap_.size() < limit_) {
+      heap_.emplace_back(std::move(candidate));
+      std::push_heap(heap_.begin(), heap_.end(), heap_less);
+      continue;
+    }
+
+    if (!limit_ || !before(candidate, heap_.front())) {
+      continue;
+    }
+
+    std::pop_heap(heap_.begin(), heap_.end(), heap_less);
+    heap_.back() = std::move(candidate);
+    std::push_heap(heap_.begin(), heap_.end(), heap_less);
+  }
+
+  rhs.clear();
+}
+
+const byte_type* top_docs_collector::threshold() const NOEXCEPT {
+  return limit_ && heap_.size() == limit_
+    ? heap_.front().value.score.c_str()
+    : nullptr;
+}
+
+top_docs_collector::entries_t top_docs_collector::top() const {
+  std::vector<const node*> sorted;
+
+  sorted.reserve(heap_.size());
+
+  for (auto& top : heap_) {
+    sorted.emplace_back(&top);
+  }
+
+  std::sort(
+    sorted.begin(), sorted.end(),
+    [this](const node* lhs, const node* rhs) {
+      return before(*lhs, *rhs);
+  });
+
+  entries_t entries;
+
+  entries.reserve(sorted.size());
+
+  for (auto* top : sorted) {
+    entries.emplace_back(top->value);
+  }
+
+  return entries;
+}
+
+void top_docs_collector::clear() NOEXCEPT {
+  heap_.clear();
+  hits_ = 0;
+  ordinal_ = 0;
+}
+
+NS_END // ROOT
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                       END-OF-FILE
+// -----------------------------------------------------------------------------
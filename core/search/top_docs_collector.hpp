@@ -0,0 +1,171 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Andrey Abramov
+/// @author Vasiliy Nabatchikov
+////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef IRESEARCH_TOP_DOCS_COLLECTOR_H
+#define IRESEARCH_TOP_DOCS_COLLECTOR_H
+
+#include "cost.hpp"
+#include "filter.hpp"
+#include "sort.hpp"
+#include "utils/noncopyable.hpp"
+
+#include <vector>
+
+NS_ROOT
+
+struct index_reader;
+struct sub_reader;
+
+NS_BEGIN(async_utils)
+class thread_pool;
+NS_END // async_utils
+
+////////////////////////////////////////////////////////////////////////////////
+/// @class top_docs_collector
+/// @brief collects the best 'limit' documents matched by a prepared filter
+///        according to the specified order, documents are kept in a bounded
+///        heap, so candidates which can't make it into the result are
+///        rejected without any allocations
+/// @note if the order consists of a single 'float' score (e.g. bm25, tfidf)
+///       scores are compared directly without virtual calls
+/// @note documents having equal scores are ordered by segment, then by doc id
+/// @note for the orders consisting of a single 'float' score, where higher
+///       score is better, the current threshold is passed to the query (see
+///       'score_threshold'), so the query may skip non-competitive documents
+////////////////////////////////////////////////////////////////////////////////
+class IRESEARCH_API top_docs_collector : private util::noncopyable {
+ public:
+  struct entry {
+    const sub_reader* segment;
+    doc_id_t doc;
+    bstring score; // score buffer as per 'order::prepared'
+  }; // entry
+
+  typedef std::vector<entry> entries_t;
+
+  // default lower bound of the query cost collected by a single task
+  static const cost::cost_t MIN_TASK_COST = 4096;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @param ord order used for preparing the filters passed to 'collect(...)'
+  /// @param limit maximum number of the collected documents
+  //////////////////////////////////////////////////////////////////////////////
+  top_docs_collector(const order::prepared& ord, size_t limit);
+  top_docs_collector(top_docs_collector&& rhs) NOEXCEPT;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief collects documents matched by the filter in all index segments
+  //////////////////////////////////////////////////////////////////////////////
+  void collect(const index_reader& index, const filter::prepared& filter);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief collects documents matched by the filter in all index segments,
+  ///        segments are processed concurrently by the specified pool and the
+  ///        per-task results are merged afterwards, the query is executed
+  ///        (terms looked up, postings opened) by the tasks as well
+  /// @param min_task_cost segments are distributed among at most
+  ///        'pool.max_threads()' tasks according to the number of documents
+  ///        in each segment, a task gets at least 'min_task_cost', so the
+  ///        tiny segments are collected together, 0 - no lower bound
+  /// @note the returned documents are the same as of the sequential
+  ///       collect(...), 'total_hits()' may differ if the query skips
+  ///       non-competitive documents
+  //////////////////////////////////////////////////////////////////////////////
+  void collect(
+    const index_reader& index,
+    const filter::prepared& filter,
+    async_utils::thread_pool& pool,
+    cost::cost_t min_task_cost = MIN_TASK_COST
+  );
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief collects documents matched by the filter in the specified segment
+  //////////////////////////////////////////////////////////////////////////////
+  void collect(const sub_reader& segment, const filter::prepared& filter);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @return the worst score a document must beat to get into the result,
+  ///         nullptr if the result isn't full yet
+  //////////////////////////////////////////////////////////////////////////////
+  const byte_type* threshold() const NOEXCEPT;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @return collected documents, the best first
+  //////////////////////////////////////////////////////////////////////////////
+  entries_t top() const;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @return number of the matched documents,
+  ///         for unordered queries collection stops as soon as 'limit'
+  ///         documents are found, queries may skip non-competitive
+  ///         documents, so the value is a lower bound
+  //////////////////////////////////////////////////////////////////////////////
+  uint64_t total_hits() const NOEXCEPT { return hits_; }
+
+  size_t limit() const NOEXCEPT { return limit_; }
+  size_t size() const NOEXCEPT { return heap_.size(); }
+  bool empty() const NOEXCEPT { return heap_.empty(); }
+
+  void clear() NOEXCEPT;
+
+ private:
+  struct node {
+    entry value;
+    size_t ordinal; // segment ordinal used for ordering documents with equal scores
+  }; // node
+
+  template<typename Less>
+  void collect(
+    const sub_reader& segment,
+    size_t ordinal,
+    doc_iterator& docs,
+    const Less& less,
+    score_threshold* threshold // updated as the result gets better
+  );
+  doc_iterator::ptr execute(
+    const sub_reader& segment,
+    const filter::prepared& filter,
+    score_threshold& threshold // must outlive the returned iterator
+  ) const;
+  void collect(
+    const sub_reader& segment,
+    size_t ordinal,
+    doc_iterator& docs,
+    score_threshold& threshold
+  );
+  void merge(top_docs_collector&& rhs);
+  bool before(const node& lhs, const node& rhs) const;
+
+  IRESEARCH_API_PRIVATE_VARIABLES_BEGIN
+  const order::prepared* ord_;
+  std::vector<node> heap_; // the worst document on top
+  size_t limit_;
+  uint64_t hits_{};
+  size_t ordinal_{}; // ordinal of the next segment
+  IRESEARCH_API_PRIVATE_VARIABLES_END
+}; // top_docs_collector
+
+NS_END // ROOT
+
+#endif
@@ -146,6 +146,19 @@
   #define GCC_ONLY(...)
 #endif
 
+// x86/x86_64 specific code (SIMD intrinsics, CPUID)
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+  #define IRESEARCH_X86
+#endif
+
+// enables the specified instruction set within a function, the
+// function must be called only after a runtime check via 'cpuinfo'
+#if defined(__GNUC__)
+  #define IRESEARCH_TARGET(x) __attribute__ ((target(x)))
+#else
+  #define IRESEARCH_TARGET(x)
+#endif
+
 // hool for Valgrind-only code
 #if !defined(IRESEARCH_VALGRIND)
   #define VALGRIND_ONLY(...) __VA_ARGS__
@@ -102,6 +102,18 @@ struct IRESEARCH_API index_input : public data_input {
   // specified offset without changing current position
   virtual int64_t checksum(size_t offset) const = 0;
 
+  // hints that the specified range is going to be read soon, so it may be
+  // fetched asynchronously, the call must not block or change the position
+  virtual void prefetch(size_t /*offset*/, size_t /*length*/) NOEXCEPT { }
+
+  // returns pointer to the next 'size' bytes of the input and skips them,
+  // the data stays valid as long as the input or any of its duplicates is
+  // open (e.g. memory mapped file), nullptr if not supported or out of range,
+  // the position is not changed in that case
+  virtual const byte_type* read_buffer(size_t /*size*/) NOEXCEPT {
+    return nullptr;
+  }
+
  private:
   index_input& operator=( const index_input& ) = delete;
 }; // index_input
@@ -118,6 +118,21 @@ enum class IOAdvice : uint32_t {
   ///        explicitly required for MSVC2013
   ////////////////////////////////////////////////////////////////////////////
   READONCE_RANDOM = 6,
+
+  ////////////////////////////////////////////////////////////////////////////
+  /// @brief Indicates that caller expects to access the whole data soon,
+  ///        so it may be read ahead of time, may be combined with the values
+  ///        above, e.g. RANDOM | WILLNEED for a term dictionary
+  ////////////////////////////////////////////////////////////////////////////
+  WILLNEED = 8,
+
+  ////////////////////////////////////////////////////////////////////////////
+  /// @brief Indicates that caller streams through the data once and it
+  ///        should bypass the OS page cache where supported, e.g. O_DIRECT
+  ///        reads in fs_directory during merge, may be combined with the
+  ///        values above
+  ////////////////////////////////////////////////////////////////////////////
+  DIRECT = 16,
 }; // IOAdvice
 
 ENABLE_BITMASK_ENUM(IOAdvice); // enable bitmap operations on the enum
@@ -43,6 +43,23 @@ void fd_pool_size::clear() {
   size = FD_POOL_DEFAULT_SIZE;
 }
 
+// -----------------------------------------------------------------------------
+// --SECTION--                                                  read_buffer_size
+// -----------------------------------------------------------------------------
+
+DEFINE_ATTRIBUTE_TYPE(read_buffer_size);
+DEFINE_FACTORY_DEFAULT(read_buffer_size);
+
+const size_t READ_BUFFER_DEFAULT_SIZE = 1024;
+
+read_buffer_size::read_buffer_size()
+  : size(READ_BUFFER_DEFAULT_SIZE) {
+}
+
+void read_buffer_size::clear() {
+  size = READ_BUFFER_DEFAULT_SIZE;
+}
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                   index_file_refs
 // -----------------------------------------------------------------------------
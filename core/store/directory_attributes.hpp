@@ -44,6 +44,20 @@ struct IRESEARCH_API fd_pool_size: public stored_attribute {
   void clear();
 };
 
+//////////////////////////////////////////////////////////////////////////////
+/// @class read_buffer_size
+/// @brief the size of the read buffer of each input stream instance
+///        where applicable, e.g. fs_directory
+//////////////////////////////////////////////////////////////////////////////
+struct IRESEARCH_API read_buffer_size: public stored_attribute {
+  DECLARE_ATTRIBUTE_TYPE();
+  DECLARE_FACTORY_DEFAULT();
+  size_t size;
+
+  read_buffer_size();
+  void clear();
+};
+
 //////////////////////////////////////////////////////////////////////////////
 /// @class index_file_refs
 /// @brief represents a ref_counter for index related files
@@ -25,22 +25,23 @@
 #include "directory_attributes.hpp"
 #include "fs_directory.hpp"
 #include "error/error.hpp"
+#include "utils/crc.hpp"
 #include "utils/log.hpp"
+#include "utils/misc.hpp"
 #include "utils/object_pool.hpp"
 #include "utils/utf8_path.hpp"
 #include "utils/file_utils.hpp"
 
 #ifdef _WIN32
   #include <Windows.h> // for GetLastError()
+#else
+  #include <fcntl.h> // for open(...)
+  #include <unistd.h> // for pread(...)
 #endif
 
-#include <boost/locale/encoding.hpp>
+#include <atomic>
 
-MSVC_ONLY(__pragma(warning(push)))
-MSVC_ONLY(__pragma(warning(disable:4244)))
-MSVC_ONLY(__pragma(warning(disable:4245)))
-#include <boost/crc.hpp>
-MSVC_ONLY(__pragma(warning(pop)))
+#include <boost/locale/encoding.hpp>
 
 NS_LOCAL
 
@@ -63,7 +64,8 @@ inline size_t buffer_size(FILE* file) NOEXCEPT {
 /// @brief converts the specified IOAdvice to corresponding posix fadvice
 //////////////////////////////////////////////////////////////////////////////
 inline int get_posix_fadvice(irs::IOAdvice advice) {
-  switch (advice) {
+  // WILLNEED/DIRECT are hints on top of the access pattern
+  switch (advice & ~(irs::IOAdvice::WILLNEED | irs::IOAdvice::DIRECT)) {
     case irs::IOAdvice::NORMAL:
       return IR_FADVICE_NORMAL;
     case irs::IOAdvice::SEQUENTIAL:
@@ -76,6 +78,9 @@ inline int get_posix_fadvice(irs::IOAdvice advice) {
       return IR_FADVICE_SEQUENTIAL | IR_FADVICE_NOREUSE;
     case irs::IOAdvice::READONCE_RANDOM:
       return IR_FADVICE_RANDOM | IR_FADVICE_NOREUSE;
+    case irs::IOAdvice::WILLNEED: // fall through
+    case irs::IOAdvice::DIRECT:
+      break; // not an access pattern, masked off above
   }
 
   IR_FRMT_ERROR(
@@ -243,27 +248,51 @@ class fs_index_output : public buffered_index_output {
   }
 
   file_utils::handle_t handle;
-  boost::crc_32_type crc;
+  crc32c crc;
 }; // fs_index_output
 
 //////////////////////////////////////////////////////////////////////////////
 /// @class fs_index_input
+/// @note on POSIX platforms instances read via 'pread' and share a single
+///       file descriptor, i.e. 'dup()' and 'reopen()' are lock-free
 //////////////////////////////////////////////////////////////////////////////
+#ifdef _WIN32
 class pooled_fs_index_input; // predeclaration used by fs_index_input
+#endif
 class fs_index_input : public buffered_index_input {
  public:
   virtual int64_t checksum(size_t offset) const final {
-    const auto begin = handle_->pos;
-    const auto end = (std::min)(begin + offset, handle_->size);
-
-    boost::crc_32_type crc;
+    crc32c crc;
     byte_type buf[1024];
 
+    const auto begin = file_pointer();
+    const auto end = (std::min)(begin + offset, handle_->size);
+
+#ifdef _WIN32
+    // read via the shared handle starting at the current file pointer,
+    // restore the position of the underlying stream afterwards
+    auto& self = const_cast<fs_index_input&>(*this);
+    const auto pos = pos_;
+    auto restore_pos = make_finally([&self, pos]()->void { self.pos_ = pos; });
+
+    for (self.pos_ = begin; self.pos_ < end; ) {
+      const auto to_read = (std::min)(end - self.pos_, sizeof buf);
+      self.read_internal(buf, to_read);
+      crc.process_bytes(buf, to_read);
+    }
+#else
+    // positional reads do not affect the state of the stream
     for (auto pos = begin; pos < end; ) {
       const auto to_read = (std::min)(end - pos, sizeof buf);
-      pos += const_cast<fs_index_input*>(this)->read_internal(buf, to_read);
+
+      if (to_read != positional_read(file_no(*handle_), buf, to_read, pos)) {
+        throw eof_error(); // read past eof
+      }
+
       crc.process_bytes(buf, to_read);
+      pos += to_read;
     }
+#endif
 
     return crc.checksum();
   }
@@ -271,9 +300,10 @@ class fs_index_input : public buffered_index_input {
   virtual ptr dup() const NOEXCEPT override;
 
   static index_input::ptr open(
-    const file_path_t name, size_t pool_size, IOAdvice /*advice*/
-  ) NOEXCEPT {
-    // FIXME honor IOAdvice
+      const file_path_t name,
+      size_t pool_size,
+      size_t buffer_size,
+      IOAdvice advice) NOEXCEPT {
     // FIXME On Windows use FILE_FLAG_SEQUENTIAL_SCAN in CreateFile
 
     assert(name);
@@ -309,12 +339,23 @@ class fs_index_input : public buffered_index_input {
 
     handle->size = size;
 
-    const auto buf_size = ::buffer_size(handle->handle.get());
+#ifdef O_DIRECT
+    if (bool(advice & IOAdvice::DIRECT)) {
+      handle->direct_fd = ::open(name, O_RDONLY | O_DIRECT);
+
+      if (handle->direct_fd < 0) {
+        // e.g. not supported by the underlying file system
+        IR_FRMT_WARN("Failed to open input file with O_DIRECT, error: %d, path: %s", errno, name);
+      }
+    }
+#else
+    UNUSED(advice);
+#endif
 
     try {
       return fs_index_input::make<fs_index_input>(
         std::move(handle),
-        buf_size,
+        buffer_size,
         pool_size
       );
     } catch(...) {
@@ -341,6 +382,7 @@ class fs_index_input : public buffered_index_input {
     pos_ = pos;
   }
 
+#ifdef _WIN32
   virtual size_t read_internal(byte_type* b, size_t len) override {
     assert(b);
     assert(handle_->handle);
@@ -377,9 +419,30 @@ class fs_index_input : public buffered_index_input {
     assert(handle_->pos == pos_);
     return read;
   }
+#else
+  virtual size_t read_internal(byte_type* b, size_t len) override {
+    assert(b);
+    assert(handle_->handle);
+
+    const size_t read = handle_->direct_fd < 0 || handle_->direct_failed
+      ? positional_read(file_no(*handle_), b, len, pos_)
+      : direct_read(b, len);
+
+    pos_ += read;
+
+    if (read != len) {
+      // read past eof
+      throw eof_error();
+    }
+
+    return read;
+  }
+#endif
 
  private:
+#ifdef _WIN32
   friend pooled_fs_index_input;
+#endif
 
   /* use shared wrapper here since we don't want to
   * call "ftell" every time we need to know current 
@@ -388,13 +451,152 @@ class fs_index_input : public buffered_index_input {
     DECLARE_SPTR(file_handle);
     DECLARE_FACTORY_DEFAULT();
 
+#ifndef _WIN32
+    file_handle() = default;
+    ~file_handle() {
+      if (direct_fd >= 0) {
+        ::close(direct_fd);
+      }
+    }
+#endif
+
     operator FILE*() const { return handle.get(); }
 
     file_utils::handle_t handle; /* native file handle */
     size_t size{}; /* file size */
+#ifdef _WIN32
     size_t pos{}; /* current file position*/
+#else
+    int direct_fd{ -1 }; // descriptor opened with O_DIRECT, -1 if not used
+    std::atomic<bool> direct_failed{ false }; // O_DIRECT reads rejected, use 'handle'
+#endif
   }; // file_handle
 
+#ifndef _WIN32
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief reads up to 'len' bytes starting at 'offset' without affecting
+  ///        the file position, returns less than 'len' only at the end of file
+  //////////////////////////////////////////////////////////////////////////////
+  static size_t positional_read(int fd, byte_type* b, size_t len, size_t offset) {
+    size_t read = 0;
+    const auto error = positional_read(fd, b, len, offset, read);
+
+    if (error) {
+      throw detailed_io_error("Failed to read from input file, read ")
+              << std::to_string(read)
+              << " out of " << std::to_string(len)
+              << " bytes, error " << std::to_string(error);
+    }
+
+    return read;
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief same as above, but reports failures via the returned 'errno'
+  ///        value (0 on success), 'read' is set to the number of bytes read
+  //////////////////////////////////////////////////////////////////////////////
+  static int positional_read(
+      int fd, byte_type* b, size_t len, size_t offset, size_t& read
+  ) NOEXCEPT {
+    read = 0;
+
+    while (read < len) {
+      const auto res = ::pread(fd, b + read, len - read, offset + read);
+
+      if (res < 0) {
+        if (EINTR == errno) {
+          continue;
+        }
+
+        return errno;
+      }
+
+      if (0 == res) {
+        break; // eof
+      }
+
+      read += size_t(res);
+    }
+
+    return 0;
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief aligned per instance buffer for reads via O_DIRECT descriptor,
+  ///        copies start with an empty buffer
+  //////////////////////////////////////////////////////////////////////////////
+  struct direct_buffer {
+    static const size_t ALIGNMENT = 4096;
+    static const size_t SIZE = 64 * ALIGNMENT;
+
+    struct deleter {
+      void operator()(byte_type* p) const NOEXCEPT { ::free(p); }
+    };
+
+    direct_buffer() = default;
+    direct_buffer(const direct_buffer&) NOEXCEPT { }
+    direct_buffer& operator=(const direct_buffer&) = delete;
+
+    std::unique_ptr<byte_type, deleter> data;
+    size_t begin{}; // file offset of the buffered data
+    size_t end{}; // file offset past the end of the buffered data
+  }; // direct_buffer
+
+  size_t direct_read(byte_type* b, size_t len) {
+    if (!direct_.data) {
+      void* data;
+
+      if (::posix_memalign(&data, direct_buffer::ALIGNMENT, direct_buffer::SIZE)) {
+        throw std::bad_alloc();
+      }
+
+      direct_.data.reset(static_cast<byte_type*>(data));
+    }
+
+    size_t read = 0;
+
+    while (read < len) {
+      const auto pos = pos_ + read;
+
+      if (pos < direct_.begin || pos >= direct_.end) {
+        // O_DIRECT requires aligned offsets, lengths and buffers
+        size_t buffered;
+        direct_.begin = pos & ~(direct_buffer::ALIGNMENT - 1);
+        const auto error = positional_read(
+          handle_->direct_fd, direct_.data.get(), direct_buffer::SIZE, direct_.begin, buffered
+        );
+
+        if (EINVAL == error) {
+          // alignment requirements of the file system are not met,
+          // e.g. bigger logical block size, use the regular descriptor
+          IR_FRMT_WARN("O_DIRECT read rejected by the file system, falling back to buffered reads");
+          handle_->direct_failed = true;
+          direct_.begin = direct_.end = 0;
+
+          return read + positional_read(file_no(*handle_), b + read, len - read, pos);
+        }
+
+        if (error) {
+          throw detailed_io_error("Failed to read from input file, error ")
+                  << std::to_string(error);
+        }
+
+        direct_.end = direct_.begin + buffered;
+
+        if (pos >= direct_.end) {
+          break; // eof
+        }
+      }
+
+      const auto to_copy = (std::min)(direct_.end - pos, len - read);
+      std::memcpy(b + read, direct_.data.get() + (pos - direct_.begin), to_copy);
+      read += to_copy;
+    }
+
+    return read;
+  }
+#endif
+
   DECLARE_FACTORY(index_input);
 
   fs_index_input(
@@ -414,10 +616,26 @@ class fs_index_input : public buffered_index_input {
   file_handle::ptr handle_; /* shared file handle */
   size_t pool_size_; // size of pool for instances of pooled_fs_index_input
   size_t pos_; /* current input stream position */
+#ifndef _WIN32
+  direct_buffer direct_;
+#endif
 }; // fs_index_input
 
 DEFINE_FACTORY_DEFAULT(fs_index_input::file_handle);
 
+index_input::ptr fs_index_input::dup() const NOEXCEPT {
+  try {
+    PTR_NAMED(fs_index_input, ptr, *this);
+    return ptr;
+  } catch(...) {
+    IR_LOG_EXCEPTION();
+  }
+
+  return nullptr;
+}
+
+#ifdef _WIN32
+
 class pooled_fs_index_input final : public fs_index_input {
  public:
   explicit pooled_fs_index_input(const fs_index_input& in);
@@ -433,17 +651,6 @@ class pooled_fs_index_input final : public fs_index_input {
   file_handle::ptr reopen(const file_handle& src) const NOEXCEPT;
 };
 
-index_input::ptr fs_index_input::dup() const NOEXCEPT {
-  try {
-    PTR_NAMED(fs_index_input, ptr, *this);
-    return ptr;
-  } catch(...) {
-    IR_LOG_EXCEPTION();
-  }
-
-  return nullptr;
-}
-
 index_input::ptr fs_index_input::reopen() const NOEXCEPT {
   auto ptr = index_input::make<pooled_fs_index_input>(*this);
 
@@ -513,6 +720,14 @@ fs_index_input::file_handle::ptr pooled_fs_index_input::reopen(
   return handle;
 }
 
+#else
+
+index_input::ptr fs_index_input::reopen() const NOEXCEPT {
+  return dup(); // positional reads on a shared descriptor are thread-safe
+}
+
+#endif
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                       fs_directory implementation
 // -----------------------------------------------------------------------------
@@ -592,12 +807,13 @@ index_input::ptr fs_directory::open(
     IOAdvice advice) const NOEXCEPT {
   try {
     utf8_path path;
-    auto pool_size =
-      const_cast<attribute_store&>(attributes()).emplace<fd_pool_size>()->size;
+    auto& attrs = const_cast<attribute_store&>(attributes());
+    auto pool_size = attrs.emplace<fd_pool_size>()->size;
+    auto buffer_size = attrs.emplace<read_buffer_size>()->size;
 
     (path/=dir_)/=name;
 
-    return fs_index_input::open(path.c_str(), pool_size, advice);
+    return fs_index_input::open(path.c_str(), pool_size, buffer_size, advice);
   } catch(...) {
     IR_LOG_EXCEPTION();
   }
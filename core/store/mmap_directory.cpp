@@ -33,22 +33,24 @@ using irs::mmap_utils::mmap_handle;
 typedef std::shared_ptr<mmap_handle> mmap_handle_ptr;
 
 //////////////////////////////////////////////////////////////////////////////
-/// @brief converts the specified IOAdvice to corresponding posix madvice
+/// @brief converts the access pattern of the specified IOAdvice to
+///        corresponding posix madvice, READONCE and WILLNEED are handled
+///        separately, DIRECT is not applicable to memory mapped files
 //////////////////////////////////////////////////////////////////////////////
 inline int get_posix_madvice(irs::IOAdvice advice) {
-  switch (advice) {
+  const auto pattern = advice & ~(
+    irs::IOAdvice::READONCE | irs::IOAdvice::WILLNEED | irs::IOAdvice::DIRECT
+  );
+
+  switch (pattern) {
     case irs::IOAdvice::NORMAL:
       return IR_MADVICE_NORMAL;
     case irs::IOAdvice::SEQUENTIAL:
       return IR_MADVICE_SEQUENTIAL;
     case irs::IOAdvice::RANDOM:
       return IR_MADVICE_RANDOM;
-    case irs::IOAdvice::READONCE:
-      return IR_MADVICE_NORMAL;
-    case irs::IOAdvice::READONCE_SEQUENTIAL:
-      return IR_MADVICE_SEQUENTIAL;
-    case irs::IOAdvice::READONCE_RANDOM:
-      return IR_MADVICE_RANDOM;
+    default:
+      break;
   }
 
   IR_FRMT_ERROR(
@@ -90,6 +92,12 @@ class mmap_index_input : public irs::bytes_ref_input {
       IR_FRMT_ERROR("Failed to madvise input file, path: " IR_FILEPATH_SPECIFIER ", error %d", file, errno);
     }
 
+    // read ahead the whole file (e.g. term dictionary)
+    if (bool(advice & irs::IOAdvice::WILLNEED)
+        && !handle->advise(IR_MADVICE_WILLNEED)) {
+      IR_FRMT_ERROR("Failed to madvise input file, path: " IR_FILEPATH_SPECIFIER ", error %d", file, errno);
+    }
+
     handle->dontneed(bool(advice & irs::IOAdvice::READONCE));
 
     return mmap_index_input::make<mmap_index_input>(std::move(handle));
@@ -103,6 +111,25 @@ class mmap_index_input : public irs::bytes_ref_input {
     return dup();
   }
 
+  virtual void prefetch(size_t offset, size_t length) NOEXCEPT override {
+    // failure to prefetch isn't an error, just a missed hint
+    if (handle_) {
+      handle_->prefetch(offset, length);
+    }
+  }
+
+  virtual const irs::byte_type* read_buffer(size_t size) NOEXCEPT override {
+    const size_t offset = file_pointer();
+
+    if (!handle_ || size > length() - offset) {
+      return nullptr;
+    }
+
+    skip(size); // mapping is shared by duplicates, see dup()
+
+    return reinterpret_cast<const irs::byte_type*>(handle_->addr()) + offset;
+  }
+
  private:
   DECLARE_FACTORY(index_input);
 
@@ -25,10 +25,9 @@
 #include "store_utils.hpp"
 
 #include "utils/std.hpp"
+#include "utils/crc.hpp"
 #include "utils/memory.hpp"
 
-#include <boost/crc.hpp>
-
 NS_ROOT
 
 // ----------------------------------------------------------------------------
@@ -294,6 +293,202 @@ uint32_t write_block(
 }
 
 
+void read_block_simd(
+    data_input& in,
+    uint32_t size,
+    uint32_t* RESTRICT encoded,
+    uint32_t* RESTRICT decoded) {
+  assert(size && 0 == size % packed::SIMD_BLOCK_SIZE_32);
+  assert(encoded);
+  assert(decoded);
+
+  const uint32_t bits = in.read_vint();
+  if (ALL_EQUAL == bits) {
+    std::fill(decoded, decoded + size, in.read_vint());
+  } else {
+    const size_t reqiured = packed::bytes_required_32(size, bits);
+
+#ifdef IRESEARCH_DEBUG
+    const auto read = in.read_bytes(
+      reinterpret_cast<byte_type*>(encoded),
+      reqiured
+    );
+    assert(read == reqiured);
+#else
+    in.read_bytes(
+      reinterpret_cast<byte_type*>(encoded),
+      reqiured
+    );
+#endif // IRESEARCH_DEBUG
+
+    packed::unpack_simd(decoded, decoded + size, encoded, bits);
+  }
+}
+
+void read_block_simd(
+    data_input& in,
+    uint32_t size,
+    uint64_t* RESTRICT encoded,
+    uint64_t* RESTRICT decoded) {
+  assert(size && 0 == size % packed::SIMD_BLOCK_SIZE_32);
+  assert(encoded);
+  assert(decoded);
+
+  const uint32_t bits = in.read_vint();
+  if (ALL_EQUAL == bits) {
+    std::fill(decoded, decoded + size, in.read_vlong());
+  } else {
+    const auto reqiured = packed::bytes_required_64(size, bits);
+
+#ifdef IRESEARCH_DEBUG
+    const auto read = in.read_bytes(
+      reinterpret_cast<byte_type*>(encoded),
+      reqiured
+    );
+    assert(read == reqiured);
+#else
+    in.read_bytes(
+      reinterpret_cast<byte_type*>(encoded),
+      reqiured
+    );
+#endif // IRESEARCH_DEBUG
+
+    if (bits > 32) {
+      packed::unpack(decoded, decoded + size, encoded, bits);
+    } else {
+      packed::unpack_simd(
+        decoded, decoded + size,
+        reinterpret_cast<const uint32_t*>(encoded),
+        bits
+      );
+    }
+  }
+}
+
+uint64_t read_block_delta_simd(
+    data_input& in,
+    uint32_t size,
+    uint64_t* RESTRICT encoded,
+    uint64_t* RESTRICT decoded,
+    uint64_t base) {
+  assert(size && 0 == size % packed::SIMD_BLOCK_SIZE_32);
+  assert(encoded);
+  assert(decoded);
+
+  const uint32_t bits = in.read_vint();
+  if (ALL_EQUAL == bits) {
+    const uint64_t delta = in.read_vlong();
+
+    for (auto* end = decoded + size; decoded != end; ++decoded) {
+      *decoded = (base += delta);
+    }
+
+    return base;
+  }
+
+  const auto reqiured = packed::bytes_required_64(size, bits);
+
+#ifdef IRESEARCH_DEBUG
+  const auto read = in.read_bytes(
+    reinterpret_cast<byte_type*>(encoded),
+    reqiured
+  );
+  assert(read == reqiured);
+#else
+  in.read_bytes(
+    reinterpret_cast<byte_type*>(encoded),
+    reqiured
+  );
+#endif // IRESEARCH_DEBUG
+
+  if (bits > 32) {
+    packed::unpack(decoded, decoded + size, encoded, bits);
+    *decoded += base;
+    delta::decode(decoded, decoded + size);
+  } else {
+    packed::unpack_delta_simd(
+      decoded, decoded + size,
+      reinterpret_cast<const uint32_t*>(encoded),
+      bits, base
+    );
+  }
+
+  return decoded[size - 1];
+}
+
+uint32_t write_block_simd(
+    data_output& out,
+    const uint32_t* RESTRICT decoded,
+    uint32_t size,
+    uint32_t* RESTRICT encoded) {
+  assert(size && 0 == size % packed::SIMD_BLOCK_SIZE_32);
+  assert(encoded);
+  assert(decoded);
+
+  if (irstd::all_equal(decoded, decoded + size)) {
+    out.write_vint(ALL_EQUAL);
+    out.write_vint(*decoded);
+    return ALL_EQUAL;
+  }
+
+  const auto bits = packed::bits_required_32(
+    *std::max_element(decoded, decoded + size)
+  );
+
+  packed::pack_simd(decoded, decoded + size, encoded, bits);
+
+  out.write_vint(bits);
+  out.write_bytes(
+    reinterpret_cast<const byte_type*>(encoded),
+    packed::bytes_required_32(size, bits)
+  );
+
+  return bits;
+}
+
+uint32_t write_block_simd(
+    data_output& out,
+    const uint64_t* RESTRICT decoded,
+    uint32_t size,
+    uint64_t* RESTRICT encoded) {
+  assert(size && 0 == size % packed::SIMD_BLOCK_SIZE_32);
+  assert(encoded);
+  assert(decoded);
+
+  if (irstd::all_equal(decoded, decoded + size)) {
+    out.write_vint(ALL_EQUAL);
+    out.write_vlong(*decoded);
+    return ALL_EQUAL;
+  }
+
+  const auto bits = packed::bits_required_64(
+    *std::max_element(decoded, decoded + size)
+  );
+
+  if (bits > 32) {
+    std::memset(encoded, 0, sizeof(uint64_t) * size);
+    packed::pack(decoded, decoded + size, encoded, bits);
+  } else {
+    auto* encoded32 = reinterpret_cast<uint32_t*>(encoded);
+    uint32_t buf[packed::SIMD_BLOCK_SIZE_32]; // narrowed values
+
+    for (auto* end = decoded + size; decoded != end; ) {
+      std::copy(decoded, decoded + packed::SIMD_BLOCK_SIZE_32, buf);
+      packed::pack_simd(std::begin(buf), std::end(buf), encoded32, bits);
+      decoded += packed::SIMD_BLOCK_SIZE_32;
+      encoded32 += bits * packed::SIMD_BLOCK_SIZE_32 / 32;
+    }
+  }
+
+  out.write_vint(bits);
+  out.write_bytes(
+    reinterpret_cast<const byte_type*>(encoded),
+    packed::bytes_required_64(size, bits)
+  );
+
+  return bits;
+}
+
 NS_END // bitpack
 NS_END // encode
 
@@ -350,7 +545,7 @@ void bytes_ref_input::read_bytes(bstring& buf, size_t size) {
 }
 
 int64_t bytes_ref_input::checksum(size_t offset) const {
-  boost::crc_32_type crc;
+  crc32c crc;
 
   crc.process_block(pos_, std::min(pos_ + offset, data_.end()));
 
@@ -377,6 +377,10 @@ class IRESEARCH_API bytes_output final : public data_output {
     return buf_.size();
   }
 
+  size_t capacity() const NOEXCEPT {
+    return buf_.capacity();
+  }
+
   operator bytes_ref() const NOEXCEPT {
     return buf_;
   }
@@ -620,6 +624,69 @@ IRESEARCH_API uint32_t write_block(
   uint64_t* RESTRICT encoded
 );
 
+// ----------------------------------------------------------------------------
+// SIMD friendly blocks:
+//   - 'size' must be a multiple of 'packed::SIMD_BLOCK_SIZE_32'
+//   - values requiring up to 32 bits are packed with 'packed::pack_simd'
+//   - 64-bit values requiring more than 32 bits are packed with 'packed::pack'
+//   - encoded blocks have the same size as the ones produced by 'write_block',
+//     so they may be skipped via 'skip_block32'/'skip_block64'
+// ----------------------------------------------------------------------------
+
+// reads block of the specified size from the stream
+// that was previously encoded with the corresponding
+// 'write_block_simd' funcion
+IRESEARCH_API void read_block_simd(
+  data_input& in,
+  uint32_t size,
+  uint32_t* RESTRICT encoded,
+  uint32_t* RESTRICT decoded
+);
+
+// reads block of the specified size from the stream
+// that was previously encoded with the corresponding
+// 'write_block_simd' funcion
+IRESEARCH_API void read_block_simd(
+  data_input& in,
+  uint32_t size,
+  uint64_t* RESTRICT encoded,
+  uint64_t* RESTRICT decoded
+);
+
+// reads block of deltas of the specified size from the stream
+// that was previously encoded with the corresponding 'write_block_simd'
+// function and decodes them starting from 'base' in a single pass
+// returns last decoded value
+IRESEARCH_API uint64_t read_block_delta_simd(
+  data_input& in,
+  uint32_t size,
+  uint64_t* RESTRICT encoded,
+  uint64_t* RESTRICT decoded,
+  uint64_t base
+);
+
+// writes block of the specified size to stream
+//   all values are equal -> RL encoding,
+//   otherwise            -> SIMD friendly bit packing
+// returns number of bits used to encoded the block (0 == RL)
+IRESEARCH_API uint32_t write_block_simd(
+  data_output& out,
+  const uint32_t* RESTRICT decoded,
+  uint32_t size,
+  uint32_t* RESTRICT encoded
+);
+
+// writes block of the specified size to stream
+//   all values are equal -> RL encoding,
+//   otherwise            -> SIMD friendly bit packing
+// returns number of bits used to encoded the block (0 == RL)
+IRESEARCH_API uint32_t write_block_simd(
+  data_output& out,
+  const uint64_t* RESTRICT decoded,
+  uint32_t size,
+  uint64_t* RESTRICT encoded
+);
+
 
 NS_END
 
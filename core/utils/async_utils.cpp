@@ -21,7 +21,10 @@
 /// @author Vasiliy Nabatchikov
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
 #include <cassert>
+#include <exception>
+#include <memory>
 
 #include "log.hpp"
 #include "thread_utils.hpp"
@@ -341,6 +344,19 @@ size_t thread_pool::threads() {
   return pool_.size();
 }
 
+bool thread_pool::is_worker_thread() {
+  std::lock_guard<decltype(lock_)> lock(lock_);
+  auto this_id = std::this_thread::get_id();
+
+  for (auto& thread: pool_) {
+    if (thread.get_id() == this_id) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
 void thread_pool::run() {
   std::unique_lock<decltype(lock_)> lock(lock_);
 
@@ -408,6 +424,70 @@ void thread_pool::run() {
   }
 }
 
+void parallel_for(
+    thread_pool* pool,
+    size_t count,
+    const std::function<void(size_t)>& task) {
+  // state is shared with the helpers which might start after return
+  struct state_t {
+    std::atomic<size_t> next;
+    size_t done;
+    std::exception_ptr error;
+    std::condition_variable finished;
+    std::mutex mutex;
+    state_t(): next(0), done(0) {}
+  };
+
+  auto state = std::make_shared<state_t>();
+  auto* fn = &task; // only dereferenced for claimed tasks, i.e. before return
+  auto worker = [state, fn, count]()->void {
+    for (size_t i; (i = state->next++) < count;) {
+      std::exception_ptr error;
+
+      try {
+        (*fn)(i);
+      } catch (...) {
+        error = std::current_exception();
+      }
+
+      std::lock_guard<std::mutex> lock(state->mutex);
+
+      if (error && !state->error) {
+        state->error = std::move(error);
+      }
+
+      if (++state->done == count) {
+        state->finished.notify_all();
+      }
+    }
+  };
+
+  size_t helpers = 0;
+
+  if (pool && count > 1 && !pool->is_worker_thread()) {
+    const auto busy = pool->tasks_active() + pool->tasks_pending();
+    const auto max = pool->max_threads();
+
+    helpers = std::min(count - 1, max > busy ? max - busy : 0);
+  }
+
+  for (; helpers && pool->run(worker); --helpers) { }
+
+  worker(); // the calling thread processes tasks until none are left
+
+  {
+    std::unique_lock<std::mutex> lock(state->mutex);
+
+    while (state->done < count) {
+      state->finished.wait(lock); // only tasks already started are awaited
+    }
+  }
+
+  if (state->error) {
+    std::rethrow_exception(state->error);
+  }
+}
+
 NS_END
 NS_END
 
@@ -27,6 +27,7 @@
 #include <atomic>
 #include <condition_variable>
 #include <functional>
+#include <mutex>
 #include <queue>
 #include <thread>
 
@@ -130,6 +131,7 @@ class IRESEARCH_API thread_pool {
   virtual size_t tasks_active();
   virtual size_t tasks_pending();
   virtual size_t threads();
+  bool is_worker_thread(); // the calling thread is one of the pool threads
  private:
    IRESEARCH_API_PRIVATE_VARIABLES_BEGIN
    size_t active_;
@@ -145,6 +147,20 @@ class IRESEARCH_API thread_pool {
    void run();
 };
 
+//////////////////////////////////////////////////////////////////////////////
+/// @brief executes 'task(i)' for every 'i' in [0, count), the calling thread
+///        processes tasks too, the pool is only asked for as many helpers as
+///        it has spare threads (none if 'pool' is nullptr or the caller is a
+///        thread of 'pool'), hence waiting never depends on queued tasks
+///        and a saturated pool cannot deadlock
+/// @note blocks until all tasks finish, rethrows the first task failure
+//////////////////////////////////////////////////////////////////////////////
+IRESEARCH_API void parallel_for(
+  thread_pool* pool,
+  size_t count,
+  const std::function<void(size_t)>& task
+);
+
 NS_END
 NS_END
 
@@ -24,9 +24,15 @@
 #include "shared.hpp"
 #include "bit_packing.hpp"
 
+#include "cpuinfo.hpp"
+
 #include <cassert>
 #include <cstring>
 
+#if defined(IRESEARCH_X86)
+  #include <immintrin.h>
+#endif
+
 NS_LOCAL
 
 #if defined(_MSC_VER)
@@ -553,6 +559,524 @@ MSVC_ONLY(__pragma(warning(push)))
 
 NS_END // NS_LOCAL
 
+// ----------------------------------------------------------------------------
+// --SECTION--                                        vertical (SIMD) packing
+// ----------------------------------------------------------------------------
+//
+// 'SIMD_BLOCK_SIZE_32' values are distributed among 'SIMD_LANES' lanes,
+// i.e. value 'i' goes to the lane 'i % SIMD_LANES', each lane is packed
+// independently and the words of the lanes are interleaved:
+//   <lane0 word0><lane1 word0><lane2 word0><lane3 word0><lane0 word1>...
+//
+// Row 'r' of a block denotes values [r*SIMD_LANES;(r+1)*SIMD_LANES), all
+// values of a row are processed by a single SSE (or half of AVX2) instruction.
+// The scalar implementation produces exactly the same layout.
+//
+// ----------------------------------------------------------------------------
+
+NS_LOCAL
+
+const uint32_t SIMD_LANES = iresearch::packed::SIMD_BLOCK_SIZE_32
+  / iresearch::packed::BLOCK_SIZE_32;
+
+void scalar_pack_vertical(
+    const uint32_t* RESTRICT in, uint32_t* RESTRICT out, const uint32_t bit
+) NOEXCEPT {
+  const uint32_t mask = iresearch::packed::max_value<uint32_t>(bit);
+
+  std::memset(out, 0, sizeof(uint32_t)*SIMD_LANES*bit);
+
+  for (uint32_t row = 0; row < iresearch::packed::BLOCK_SIZE_32; ++row) {
+    const uint32_t word = (row*bit) / 32;
+    const uint32_t shift = (row*bit) % 32;
+
+    for (uint32_t lane = 0; lane < SIMD_LANES; ++lane) {
+      const uint32_t value = in[row*SIMD_LANES + lane] & mask;
+
+      out[word*SIMD_LANES + lane] |= value << shift;
+
+      if (shift + bit > 32) {
+        out[(word + 1)*SIMD_LANES + lane] |= value >> (32 - shift);
+      }
+    }
+  }
+}
+
+void scalar_unpack_vertical(
+    const uint32_t* RESTRICT in, uint32_t* RESTRICT out, const uint32_t bit
+) NOEXCEPT {
+  const uint32_t mask = iresearch::packed::max_value<uint32_t>(bit);
+
+  for (uint32_t row = 0; row < iresearch::packed::BLOCK_SIZE_32; ++row) {
+    const uint32_t word = (row*bit) / 32;
+    const uint32_t shift = (row*bit) % 32;
+
+    for (uint32_t lane = 0; lane < SIMD_LANES; ++lane) {
+      uint32_t value = in[word*SIMD_LANES + lane] >> shift;
+
+      if (shift + bit > 32) {
+        value |= in[(word + 1)*SIMD_LANES + lane] << (32 - shift);
+      }
+
+      *out++ = value & mask;
+    }
+  }
+}
+
+void scalar_pack32(
+    const uint32_t* RESTRICT in, uint32_t* RESTRICT out, const uint32_t bit
+) NOEXCEPT {
+  scalar_pack_vertical(in, out, bit);
+}
+
+void scalar_unpack32(
+    const uint32_t* RESTRICT in, uint32_t* RESTRICT out, const uint32_t bit
+) NOEXCEPT {
+  scalar_unpack_vertical(in, out, bit);
+}
+
+void scalar_unpack64(
+    const uint32_t* RESTRICT in, uint64_t* RESTRICT out, const uint32_t bit
+) NOEXCEPT {
+  uint32_t buf[iresearch::packed::SIMD_BLOCK_SIZE_32];
+  scalar_unpack_vertical(in, buf, bit);
+  std::copy(std::begin(buf), std::end(buf), out);
+}
+
+uint64_t scalar_unpack_delta64(
+    const uint32_t* RESTRICT in, uint64_t* RESTRICT out,
+    const uint32_t bit, uint64_t base
+) NOEXCEPT {
+  uint32_t buf[iresearch::packed::SIMD_BLOCK_SIZE_32];
+  scalar_unpack_vertical(in, buf, bit);
+
+  for (auto delta : buf) {
+    *out++ = (base += delta);
+  }
+
+  return base;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief invokes 'Kernel::apply<N>' with 'N' equal to 'bit'
+////////////////////////////////////////////////////////////////////////////////
+template<typename Kernel, typename... Args>
+typename Kernel::result_type fastpack_dispatch(
+    const uint32_t bit, Args... args
+) NOEXCEPT {
+  switch (bit) {
+    case 1:  return Kernel::template apply<1>(args...);
+    case 2:  return Kernel::template apply<2>(args...);
+    case 3:  return Kernel::template apply<3>(args...);
+    case 4:  return Kernel::template apply<4>(args...);
+    case 5:  return Kernel::template apply<5>(args...);
+    case 6:  return Kernel::template apply<6>(args...);
+    case 7:  return Kernel::template apply<7>(args...);
+    case 8:  return Kernel::template apply<8>(args...);
+    case 9:  return Kernel::template apply<9>(args...);
+    case 10: return Kernel::template apply<10>(args...);
+    case 11: return Kernel::template apply<11>(args...);
+    case 12: return Kernel::template apply<12>(args...);
+    case 13: return Kernel::template apply<13>(args...);
+    case 14: return Kernel::template apply<14>(args...);
+    case 15: return Kernel::template apply<15>(args...);
+    case 16: return Kernel::template apply<16>(args...);
+    case 17: return Kernel::template apply<17>(args...);
+    case 18: return Kernel::template apply<18>(args...);
+    case 19: return Kernel::template apply<19>(args...);
+    case 20: return Kernel::template apply<20>(args...);
+    case 21: return Kernel::template apply<21>(args...);
+    case 22: return Kernel::template apply<22>(args...);
+    case 23: return Kernel::template apply<23>(args...);
+    case 24: return Kernel::template apply<24>(args...);
+    case 25: return Kernel::template apply<25>(args...);
+    case 26: return Kernel::template apply<26>(args...);
+    case 27: return Kernel::template apply<27>(args...);
+    case 28: return Kernel::template apply<28>(args...);
+    case 29: return Kernel::template apply<29>(args...);
+    case 30: return Kernel::template apply<30>(args...);
+    case 31: return Kernel::template apply<31>(args...);
+    case 32: return Kernel::template apply<32>(args...);
+    default: assert(false); return typename Kernel::result_type();
+  }
+}
+
+#if defined(IRESEARCH_X86)
+
+// ----------------------------------------------------------------------------
+// SSE4.1 kernels, 1 row (4 values) per iteration
+// ----------------------------------------------------------------------------
+
+// ensure all computations are constexr, i.e. no conditional jumps, no loops
+template<int N, int R>
+struct sse_pack_rows {
+  static_assert(N > 0 && N <= 32, "N <= 0 || N > 32");
+
+  IRESEARCH_TARGET("sse4.1") static FORCE_INLINE void apply(
+      const __m128i* RESTRICT in, __m128i* RESTRICT out,
+      const __m128i mask, __m128i acc) NOEXCEPT {
+    const int word = (N * R) / 32;
+    const int shift = (N * R) % 32;
+    const __m128i value = _mm_and_si128(_mm_loadu_si128(in + R), mask);
+
+    acc = shift ? _mm_or_si128(acc, _mm_slli_epi32(value, shift)) : value;
+
+    if (shift + N >= 32) {
+      _mm_storeu_si128(out + word, acc);
+      acc = _mm_srli_epi32(value, 32 - shift); // remaining bits of the row
+    }
+
+    sse_pack_rows<N, R + 1>::apply(in, out, mask, acc);
+  }
+};
+
+template<int N>
+struct sse_pack_rows<N, 32> {
+  IRESEARCH_TARGET("sse4.1") static FORCE_INLINE void apply(
+      const __m128i* RESTRICT, __m128i* RESTRICT, const __m128i, __m128i
+  ) NOEXCEPT { }
+};
+
+// ensure all computations are constexr, i.e. no conditional jumps, no loops
+template<int N, int R>
+struct sse_unpack_rows {
+  static_assert(N > 0 && N <= 32, "N <= 0 || N > 32");
+
+  template<typename Sink>
+  IRESEARCH_TARGET("sse4.1") static FORCE_INLINE void apply(
+      const __m128i* RESTRICT in, const __m128i mask, Sink& sink) NOEXCEPT {
+    const int word = (N * R) / 32;
+    const int shift = (N * R) % 32;
+    __m128i value = _mm_srli_epi32(_mm_loadu_si128(in + word), shift);
+
+    if (shift + N > 32) {
+      // row spans 2 words
+      value = _mm_or_si128(
+        value, _mm_slli_epi32(_mm_loadu_si128(in + word + 1), 32 - shift)
+      );
+    }
+
+    sink(R, _mm_and_si128(value, mask));
+    sse_unpack_rows<N, R + 1>::apply(in, mask, sink);
+  }
+};
+
+template<int N>
+struct sse_unpack_rows<N, 32> {
+  template<typename Sink>
+  IRESEARCH_TARGET("sse4.1") static FORCE_INLINE void apply(
+      const __m128i* RESTRICT, const __m128i, Sink&
+  ) NOEXCEPT { }
+};
+
+struct sse_store32 {
+  IRESEARCH_TARGET("sse4.1") FORCE_INLINE void operator()(
+      int row, __m128i value) NOEXCEPT {
+    _mm_storeu_si128(out + row, value);
+  }
+
+  __m128i* out;
+}; // sse_store32
+
+struct sse_store64 {
+  IRESEARCH_TARGET("sse4.1") FORCE_INLINE void operator()(
+      int row, __m128i value) NOEXCEPT {
+    _mm_storeu_si128(out + 2*row, _mm_cvtepu32_epi64(value));
+    _mm_storeu_si128(out + 2*row + 1, _mm_cvtepu32_epi64(_mm_srli_si128(value, 8)));
+  }
+
+  __m128i* out;
+}; // sse_store64
+
+struct sse_delta64 {
+  IRESEARCH_TARGET("sse4.1") FORCE_INLINE void operator()(
+      int row, __m128i value) NOEXCEPT {
+    __m128i lo = _mm_cvtepu32_epi64(value); // [a, b]
+    __m128i hi = _mm_cvtepu32_epi64(_mm_srli_si128(value, 8)); // [c, d]
+
+    lo = _mm_add_epi64(lo, _mm_slli_si128(lo, 8)); // [a, a+b]
+    lo = _mm_add_epi64(lo, prev);
+    hi = _mm_add_epi64(hi, _mm_slli_si128(hi, 8)); // [c, c+d]
+    hi = _mm_add_epi64(hi, _mm_unpackhi_epi64(lo, lo));
+    prev = _mm_unpackhi_epi64(hi, hi);
+
+    _mm_storeu_si128(out + 2*row, lo);
+    _mm_storeu_si128(out + 2*row + 1, hi);
+  }
+
+  __m128i* out;
+  __m128i prev; // last decoded value in both 64-bit lanes
+}; // sse_delta64
+
+struct sse_pack32 {
+  typedef void result_type;
+
+  template<int N>
+  IRESEARCH_TARGET("sse4.1") static void apply(
+      const uint32_t* RESTRICT in, uint32_t* RESTRICT out) NOEXCEPT {
+    const __m128i mask = _mm_set1_epi32(int(iresearch::packed::max_value<uint32_t>(N)));
+
+    sse_pack_rows<N, 0>::apply(
+      reinterpret_cast<const __m128i*>(in),
+      reinterpret_cast<__m128i*>(out),
+      mask, _mm_setzero_si128()
+    );
+  }
+}; // sse_pack32
+
+struct sse_unpack32 {
+  typedef void result_type;
+
+  template<int N>
+  IRESEARCH_TARGET("sse4.1") static void apply(
+      const uint32_t* RESTRICT in, uint32_t* RESTRICT out) NOEXCEPT {
+    const __m128i mask = _mm_set1_epi32(int(iresearch::packed::max_value<uint32_t>(N)));
+    sse_store32 sink{ reinterpret_cast<__m128i*>(out) };
+
+    sse_unpack_rows<N, 0>::apply(reinterpret_cast<const __m128i*>(in), mask, sink);
+  }
+}; // sse_unpack32
+
+struct sse_unpack64 {
+  typedef void result_type;
+
+  template<int N>
+  IRESEARCH_TARGET("sse4.1") static void apply(
+      const uint32_t* RESTRICT in, uint64_t* RESTRICT out) NOEXCEPT {
+    const __m128i mask = _mm_set1_epi32(int(iresearch::packed::max_value<uint32_t>(N)));
+    sse_store64 sink{ reinterpret_cast<__m128i*>(out) };
+
+    sse_unpack_rows<N, 0>::apply(reinterpret_cast<const __m128i*>(in), mask, sink);
+  }
+}; // sse_unpack64
+
+struct sse_unpack_delta64 {
+  typedef uint64_t result_type;
+
+  template<int N>
+  IRESEARCH_TARGET("sse4.1") static uint64_t apply(
+      const uint32_t* RESTRICT in, uint64_t* RESTRICT out, uint64_t base) NOEXCEPT {
+    const __m128i mask = _mm_set1_epi32(int(iresearch::packed::max_value<uint32_t>(N)));
+    sse_delta64 sink{
+      reinterpret_cast<__m128i*>(out),
+      _mm_set1_epi64x(static_cast<int64_t>(base))
+    };
+
+    sse_unpack_rows<N, 0>::apply(reinterpret_cast<const __m128i*>(in), mask, sink);
+
+    return out[iresearch::packed::SIMD_BLOCK_SIZE_32 - 1];
+  }
+}; // sse_unpack_delta64
+
+// ----------------------------------------------------------------------------
+// AVX2 kernels, 2 rows (8 values) per iteration
+// ----------------------------------------------------------------------------
+
+// ensure all computations are constexr, i.e. no conditional jumps, no loops
+template<int N, int R>
+struct avx2_unpack_rows {
+  static_assert(N > 0 && N <= 32, "N <= 0 || N > 32");
+  static_assert(0 == R % 2, "R % 2 != 0");
+
+  template<typename Sink>
+  IRESEARCH_TARGET("avx2") static FORCE_INLINE void apply(
+      const __m128i* RESTRICT in, const __m256i mask, Sink& sink) NOEXCEPT {
+    const int word0 = (N * R) / 32;
+    const int shift0 = (N * R) % 32;
+    const int word1 = (N * (R + 1)) / 32;
+    const int shift1 = (N * (R + 1)) % 32;
+
+    __m256i value = _mm256_srlv_epi32(
+      _mm256_inserti128_si256(
+        _mm256_castsi128_si256(_mm_loadu_si128(in + word0)),
+        _mm_loadu_si128(in + word1), 1
+      ),
+      _mm256_setr_epi32(shift0, shift0, shift0, shift0, shift1, shift1, shift1, shift1)
+    );
+
+    if (shift0 + N > 32 || shift1 + N > 32) {
+      // at least one of the rows spans 2 words, for the other one
+      // read the same word and shift it out completely (count >= 32)
+      const bool span0 = shift0 + N > 32;
+      const bool span1 = shift1 + N > 32;
+      const int next0 = span0 ? word0 + 1 : word0;
+      const int next1 = span1 ? word1 + 1 : word1;
+      const int count0 = span0 ? 32 - shift0 : 32;
+      const int count1 = span1 ? 32 - shift1 : 32;
+
+      value = _mm256_or_si256(
+        value,
+        _mm256_sllv_epi32(
+          _mm256_inserti128_si256(
+            _mm256_castsi128_si256(_mm_loadu_si128(in + next0)),
+            _mm_loadu_si128(in + next1), 1
+          ),
+          _mm256_setr_epi32(count0, count0, count0, count0, count1, count1, count1, count1)
+        )
+      );
+    }
+
+    sink(R, _mm256_and_si256(value, mask));
+    avx2_unpack_rows<N, R + 2>::apply(in, mask, sink);
+  }
+};
+
+template<int N>
+struct avx2_unpack_rows<N, 32> {
+  template<typename Sink>
+  IRESEARCH_TARGET("avx2") static FORCE_INLINE void apply(
+      const __m128i* RESTRICT, const __m256i, Sink&
+  ) NOEXCEPT { }
+};
+
+struct avx2_store32 {
+  IRESEARCH_TARGET("avx2") FORCE_INLINE void operator()(
+      int row, __m256i value) NOEXCEPT {
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + SIMD_LANES*row), value);
+  }
+
+  uint32_t* out;
+}; // avx2_store32
+
+struct avx2_store64 {
+  IRESEARCH_TARGET("avx2") FORCE_INLINE void operator()(
+      int row, __m256i value) NOEXCEPT {
+    auto* begin = reinterpret_cast<__m256i*>(out + SIMD_LANES*row);
+    _mm256_storeu_si256(begin, _mm256_cvtepu32_epi64(_mm256_castsi256_si128(value)));
+    _mm256_storeu_si256(begin + 1, _mm256_cvtepu32_epi64(_mm256_extracti128_si256(value, 1)));
+  }
+
+  uint64_t* out;
+}; // avx2_store64
+
+struct avx2_delta64 {
+  // computes running sum of [a, b, c, d] starting from 'prev'
+  IRESEARCH_TARGET("avx2") FORCE_INLINE __m256i prefix_sum(__m256i value) NOEXCEPT {
+    value = _mm256_add_epi64(value, _mm256_slli_si256(value, 8)); // [a, a+b, c, c+d]
+    value = _mm256_add_epi64(
+      value,
+      _mm256_blend_epi32(
+        _mm256_setzero_si256(),
+        _mm256_permute4x64_epi64(value, 0x55), // broadcast a+b
+        0xF0
+      )
+    ); // [a, a+b, a+b+c, a+b+c+d]
+    value = _mm256_add_epi64(value, prev);
+    prev = _mm256_permute4x64_epi64(value, 0xFF); // broadcast last value
+
+    return value;
+  }
+
+  IRESEARCH_TARGET("avx2") FORCE_INLINE void operator()(
+      int row, __m256i value) NOEXCEPT {
+    auto* begin = reinterpret_cast<__m256i*>(out + SIMD_LANES*row);
+    _mm256_storeu_si256(begin, prefix_sum(_mm256_cvtepu32_epi64(_mm256_castsi256_si128(value))));
+    _mm256_storeu_si256(begin + 1, prefix_sum(_mm256_cvtepu32_epi64(_mm256_extracti128_si256(value, 1))));
+  }
+
+  uint64_t* out;
+  __m256i prev; // last decoded value in all 64-bit lanes
+}; // avx2_delta64
+
+struct avx2_unpack32 {
+  typedef void result_type;
+
+  template<int N>
+  IRESEARCH_TARGET("avx2") static void apply(
+      const uint32_t* RESTRICT in, uint32_t* RESTRICT out) NOEXCEPT {
+    const __m256i mask = _mm256_set1_epi32(int(iresearch::packed::max_value<uint32_t>(N)));
+    avx2_store32 sink{ out };
+
+    avx2_unpack_rows<N, 0>::apply(reinterpret_cast<const __m128i*>(in), mask, sink);
+  }
+}; // avx2_unpack32
+
+struct avx2_unpack64 {
+  typedef void result_type;
+
+  template<int N>
+  IRESEARCH_TARGET("avx2") static void apply(
+      const uint32_t* RESTRICT in, uint64_t* RESTRICT out) NOEXCEPT {
+    const __m256i mask = _mm256_set1_epi32(int(iresearch::packed::max_value<uint32_t>(N)));
+    avx2_store64 sink{ out };
+
+    avx2_unpack_rows<N, 0>::apply(reinterpret_cast<const __m128i*>(in), mask, sink);
+  }
+}; // avx2_unpack64
+
+struct avx2_unpack_delta64 {
+  typedef uint64_t result_type;
+
+  template<int N>
+  IRESEARCH_TARGET("avx2") static uint64_t apply(
+      const uint32_t* RESTRICT in, uint64_t* RESTRICT out, uint64_t base) NOEXCEPT {
+    const __m256i mask = _mm256_set1_epi32(int(iresearch::packed::max_value<uint32_t>(N)));
+    avx2_delta64 sink{ out, _mm256_set1_epi64x(static_cast<int64_t>(base)) };
+
+    avx2_unpack_rows<N, 0>::apply(reinterpret_cast<const __m128i*>(in), mask, sink);
+
+    return out[iresearch::packed::SIMD_BLOCK_SIZE_32 - 1];
+  }
+}; // avx2_unpack_delta64
+
+#endif // IRESEARCH_X86
+
+// ----------------------------------------------------------------------------
+// runtime dispatch
+// ----------------------------------------------------------------------------
+
+template<typename Kernel>
+void pack32(const uint32_t* RESTRICT in, uint32_t* RESTRICT out, const uint32_t bit) NOEXCEPT {
+  fastpack_dispatch<Kernel>(bit, in, out);
+}
+
+template<typename Kernel>
+void unpack32(const uint32_t* RESTRICT in, uint32_t* RESTRICT out, const uint32_t bit) NOEXCEPT {
+  fastpack_dispatch<Kernel>(bit, in, out);
+}
+
+template<typename Kernel>
+void unpack64(const uint32_t* RESTRICT in, uint64_t* RESTRICT out, const uint32_t bit) NOEXCEPT {
+  fastpack_dispatch<Kernel>(bit, in, out);
+}
+
+template<typename Kernel>
+uint64_t unpack_delta64(
+    const uint32_t* RESTRICT in, uint64_t* RESTRICT out,
+    const uint32_t bit, uint64_t base) NOEXCEPT {
+  return fastpack_dispatch<Kernel>(bit, in, out, base);
+}
+
+struct simd_kernels {
+  simd_kernels() NOEXCEPT {
+#if defined(IRESEARCH_X86)
+    if (iresearch::cpuinfo::support_avx2()) {
+      pack32 = &::pack32<sse_pack32>; // row-wise packing gains nothing from AVX2
+      unpack32 = &::unpack32<avx2_unpack32>;
+      unpack64 = &::unpack64<avx2_unpack64>;
+      unpack_delta64 = &::unpack_delta64<avx2_unpack_delta64>;
+    } else if (iresearch::cpuinfo::support_sse4_1()) {
+      pack32 = &::pack32<sse_pack32>;
+      unpack32 = &::unpack32<sse_unpack32>;
+      unpack64 = &::unpack64<sse_unpack64>;
+      unpack_delta64 = &::unpack_delta64<sse_unpack_delta64>;
+    }
+#endif
+  }
+
+  void (*pack32)(const uint32_t*, uint32_t*, uint32_t) { &scalar_pack32 };
+  void (*unpack32)(const uint32_t*, uint32_t*, uint32_t) { &scalar_unpack32 };
+  void (*unpack64)(const uint32_t*, uint64_t*, uint32_t) { &scalar_unpack64 };
+  uint64_t (*unpack_delta64)(const uint32_t*, uint64_t*, uint32_t, uint64_t) { &scalar_unpack_delta64 };
+}; // simd_kernels
+
+const simd_kernels& kernels() NOEXCEPT {
+  static const simd_kernels instance; // lazy initialization, relies on 'cpuinfo'
+  return instance;
+}
+
+NS_END // NS_LOCAL
+
 NS_ROOT
 NS_BEGIN(packed)
 
@@ -832,5 +1356,50 @@ void unpack(
   }
 }
 
+void pack_simd(
+    const uint32_t* first, const uint32_t* last, uint32_t* out, const uint32_t bit
+) NOEXCEPT {
+  assert(0 == (last - first) % SIMD_BLOCK_SIZE_32);
+  const auto pack_block = kernels().pack32;
+
+  for (; first < last; first += SIMD_BLOCK_SIZE_32, out += SIMD_LANES*bit) {
+    pack_block(first, out, bit);
+  }
+}
+
+void unpack_simd(
+    uint32_t* first, uint32_t* last, const uint32_t* in, const uint32_t bit
+) NOEXCEPT {
+  assert(0 == (last - first) % SIMD_BLOCK_SIZE_32);
+  const auto unpack_block = kernels().unpack32;
+
+  for (; first < last; first += SIMD_BLOCK_SIZE_32, in += SIMD_LANES*bit) {
+    unpack_block(in, first, bit);
+  }
+}
+
+void unpack_simd(
+    uint64_t* first, uint64_t* last, const uint32_t* in, const uint32_t bit
+) NOEXCEPT {
+  assert(0 == (last - first) % SIMD_BLOCK_SIZE_32);
+  const auto unpack_block = kernels().unpack64;
+
+  for (; first < last; first += SIMD_BLOCK_SIZE_32, in += SIMD_LANES*bit) {
+    unpack_block(in, first, bit);
+  }
+}
+
+void unpack_delta_simd(
+    uint64_t* first, uint64_t* last, const uint32_t* in,
+    const uint32_t bit, uint64_t base
+) NOEXCEPT {
+  assert(0 == (last - first) % SIMD_BLOCK_SIZE_32);
+  const auto unpack_block = kernels().unpack_delta64;
+
+  for (; first < last; first += SIMD_BLOCK_SIZE_32, in += SIMD_LANES*bit) {
+    base = unpack_block(in, first, bit, base);
+  }
+}
+
 NS_END // packed
 NS_END
@@ -37,6 +37,10 @@ NS_BEGIN( packed )
 const uint32_t BLOCK_SIZE_32 = sizeof(uint32_t) * 8; // block size is tied to number of bits in value
 const uint32_t BLOCK_SIZE_64 = sizeof(uint64_t) * 8; // block size is tied to number of bits in value
 
+// number of values in a block packed with SIMD friendly (vertical) layout,
+// 4 lanes (128-bit word) of 'BLOCK_SIZE_32' values each
+const uint32_t SIMD_BLOCK_SIZE_32 = 4 * BLOCK_SIZE_32;
+
 const uint32_t VERSION = 1U;
 
 inline uint32_t bits_required_64(uint64_t val) {
@@ -84,7 +88,7 @@ inline uint64_t iterations_required( uint32_t count ) {
 
 template< typename T >
 inline T max_value(uint32_t bits) {
-  assert( bits >= 0U && bits <= sizeof( T ) * 8U );
+  assert( bits <= sizeof( T ) * 8U );
 
   return bits == sizeof( T ) * 8U
     ? (std::numeric_limits<T>::max)() 
@@ -125,6 +129,53 @@ IRESEARCH_API void unpack(
   const uint64_t* in, 
   const uint32_t bit) NOEXCEPT;
 
+//////////////////////////////////////////////////////////////////////////////
+/// @brief packs values using SIMD friendly (vertical) layout, value 'i' of a
+///        block is stored in the lane 'i % 4' of the 128-bit words, i.e.
+///        the output is not compatible with the one produced by 'pack'
+/// @note the layout doesn't depend on instruction set, the fastest available
+///       implementation is chosen at runtime
+/// @note std::distance(first, last) must be a multiple of 'SIMD_BLOCK_SIZE_32'
+//////////////////////////////////////////////////////////////////////////////
+IRESEARCH_API void pack_simd(
+  const uint32_t* first,
+  const uint32_t* last,
+  uint32_t* out,
+  const uint32_t bit) NOEXCEPT;
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief unpacks values previously packed with 'pack_simd'
+/// @note std::distance(first, last) must be a multiple of 'SIMD_BLOCK_SIZE_32'
+//////////////////////////////////////////////////////////////////////////////
+IRESEARCH_API void unpack_simd(
+  uint32_t* first,
+  uint32_t* last,
+  const uint32_t* in,
+  const uint32_t bit) NOEXCEPT;
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief unpacks 32-bit values previously packed with 'pack_simd' and
+///        widens them to 64-bit
+/// @note std::distance(first, last) must be a multiple of 'SIMD_BLOCK_SIZE_32'
+//////////////////////////////////////////////////////////////////////////////
+IRESEARCH_API void unpack_simd(
+  uint64_t* first,
+  uint64_t* last,
+  const uint32_t* in,
+  const uint32_t bit) NOEXCEPT;
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief unpacks deltas previously packed with 'pack_simd' and decodes
+///        them in a single pass, i.e. first[i] = base + sum(delta[0..i])
+/// @note std::distance(first, last) must be a multiple of 'SIMD_BLOCK_SIZE_32'
+//////////////////////////////////////////////////////////////////////////////
+IRESEARCH_API void unpack_delta_simd(
+  uint64_t* first,
+  uint64_t* last,
+  const uint32_t* in,
+  const uint32_t bit,
+  uint64_t base) NOEXCEPT;
+
 template<typename T>
 class iterator : public std::iterator<std::random_access_iterator_tag, T> {
  public:
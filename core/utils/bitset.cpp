@@ -0,0 +1,372 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2016 by EMC Corporation, All Rights Reserved
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is EMC Corporation
+///
+/// @author Andrey Abramov
+/// @author Vasiliy Nabatchikov
+////////////////////////////////////////////////////////////////////////////////
+
+#include "shared.hpp"
+#include "bitset.hpp"
+
+#include "cpuinfo.hpp"
+
+#if defined(IRESEARCH_X86)
+  #include <immintrin.h>
+#endif
+
+NS_LOCAL
+
+typedef irs::bitset::word_t word_t;
+
+// ----------------------------------------------------------------------------
+// boolean operations
+// ----------------------------------------------------------------------------
+
+struct op_and {
+  static FORCE_INLINE word_t apply(word_t lhs, word_t rhs) NOEXCEPT {
+    return lhs & rhs;
+  }
+
+#if defined(IRESEARCH_X86)
+  IRESEARCH_TARGET("avx2") static FORCE_INLINE __m256i apply(
+      __m256i lhs, __m256i rhs) NOEXCEPT {
+    return _mm256_and_si256(lhs, rhs);
+  }
+
+  IRESEARCH_TARGET("avx512f") static FORCE_INLINE __m512i apply(
+      __m512i lhs, __m512i rhs) NOEXCEPT {
+    return _mm512_and_si512(lhs, rhs);
+  }
+#endif
+}; // op_and
+
+struct op_or {
+  static FORCE_INLINE word_t apply(word_t lhs, word_t rhs) NOEXCEPT {
+    return lhs | rhs;
+  }
+
+#if defined(IRESEARCH_X86)
+  IRESEARCH_TARGET("avx2") static FORCE_INLINE __m256i apply(
+      __m256i lhs, __m256i rhs) NOEXCEPT {
+    return _mm256_or_si256(lhs, rhs);
+  }
+
+  IRESEARCH_TARGET("avx512f") static FORCE_INLINE __m512i apply(
+      __m512i lhs, __m512i rhs) NOEXCEPT {
+    return _mm512_or_si512(lhs, rhs);
+  }
+#endif
+}; // op_or
+
+struct op_andnot {
+  static FORCE_INLINE word_t apply(word_t lhs, word_t rhs) NOEXCEPT {
+    return lhs & ~rhs;
+  }
+
+#if defined(IRESEARCH_X86)
+  IRESEARCH_TARGET("avx2") static FORCE_INLINE __m256i apply(
+      __m256i lhs, __m256i rhs) NOEXCEPT {
+    return _mm256_andnot_si256(rhs, lhs); // ~rhs & lhs
+  }
+
+  IRESEARCH_TARGET("avx512f") static FORCE_INLINE __m512i apply(
+      __m512i lhs, __m512i rhs) NOEXCEPT {
+    return _mm512_andnot_si512(rhs, lhs); // ~rhs & lhs
+  }
+#endif
+}; // op_andnot
+
+struct op_xor {
+  static FORCE_INLINE word_t apply(word_t lhs, word_t rhs) NOEXCEPT {
+    return lhs ^ rhs;
+  }
+
+#if defined(IRESEARCH_X86)
+  IRESEARCH_TARGET("avx2") static FORCE_INLINE __m256i apply(
+      __m256i lhs, __m256i rhs) NOEXCEPT {
+    return _mm256_xor_si256(lhs, rhs);
+  }
+
+  IRESEARCH_TARGET("avx512f") static FORCE_INLINE __m512i apply(
+      __m512i lhs, __m512i rhs) NOEXCEPT {
+    return _mm512_xor_si512(lhs, rhs);
+  }
+#endif
+}; // op_xor
+
+// ----------------------------------------------------------------------------
+// scalar implementation
+// ----------------------------------------------------------------------------
+
+template<typename Op>
+void scalar_assign(word_t* lhs, const word_t* rhs, size_t size) NOEXCEPT {
+  for (; size; --size, ++lhs, ++rhs) {
+    *lhs = Op::apply(*lhs, *rhs);
+  }
+}
+
+size_t scalar_count(const word_t* data, size_t size) NOEXCEPT {
+  size_t count = 0;
+
+  for (; size; --size, ++data) {
+    count += irs::math::math_traits<word_t>::pop(*data);
+  }
+
+  return count;
+}
+
+size_t scalar_and_count(
+    const word_t* lhs, const word_t* rhs, size_t size) NOEXCEPT {
+  size_t count = 0;
+
+  for (; size; --size, ++lhs, ++rhs) {
+    count += irs::math::math_traits<word_t>::pop(*lhs & *rhs);
+  }
+
+  return count;
+}
+
+#if defined(IRESEARCH_X86)
+
+// ----------------------------------------------------------------------------
+// POPCNT implementation
+// ----------------------------------------------------------------------------
+
+IRESEARCH_TARGET("popcnt") FORCE_INLINE size_t pop(word_t value) NOEXCEPT {
+#if defined(_MSC_VER)
+  return irs::math::math_traits<word_t>::pop(value); // dispatched via 'cpuinfo'
+#else
+  return __builtin_popcountll(value);
+#endif
+}
+
+IRESEARCH_TARGET("popcnt") size_t popcnt_count(
+    const word_t* data, size_t size) NOEXCEPT {
+  size_t count = 0;
+
+  for (; size; --size, ++data) {
+    count += pop(*data);
+  }
+
+  return count;
+}
+
+IRESEARCH_TARGET("popcnt") size_t popcnt_and_count(
+    const word_t* lhs, const word_t* rhs, size_t size) NOEXCEPT {
+  size_t count = 0;
+
+  for (; size; --size, ++lhs, ++rhs) {
+    count += pop(*lhs & *rhs);
+  }
+
+  return count;
+}
+
+// ----------------------------------------------------------------------------
+// AVX2 implementation
+// ----------------------------------------------------------------------------
+
+const size_t AVX2_WORDS = sizeof(__m256i) / sizeof(word_t);
+
+template<typename Op>
+IRESEARCH_TARGET("avx2") void avx2_assign(
+    word_t* lhs, const word_t* rhs, size_t size) NOEXCEPT {
+  for (; size >= AVX2_WORDS; size -= AVX2_WORDS, lhs += AVX2_WORDS, rhs += AVX2_WORDS) {
+    const auto l = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lhs));
+    const auto r = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rhs));
+
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(lhs), Op::apply(l, r));
+  }
+
+  scalar_assign<Op>(lhs, rhs, size);
+}
+
+// adds number of bits set in each 64-bit lane of 'value' to 'acc',
+// nibble lookup via 'pshufb' followed by horizontal byte sum via 'psadbw'
+IRESEARCH_TARGET("avx2") FORCE_INLINE __m256i avx2_pop(
+    __m256i acc, __m256i value) NOEXCEPT {
+  const auto lookup = _mm256_setr_epi8(
+    0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+    0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4
+  );
+  const auto low_mask = _mm256_set1_epi8(0x0F);
+  const auto lo = _mm256_and_si256(value, low_mask);
+  const auto hi = _mm256_and_si256(_mm256_srli_epi16(value, 4), low_mask);
+  const auto bytes = _mm256_add_epi8(
+    _mm256_shuffle_epi8(lookup, lo), _mm256_shuffle_epi8(lookup, hi)
+  );
+
+  return _mm256_add_epi64(acc, _mm256_sad_epu8(bytes, _mm256_setzero_si256()));
+}
+
+IRESEARCH_TARGET("avx2") FORCE_INLINE size_t avx2_sum(__m256i acc) NOEXCEPT {
+  uint64_t lanes[4];
+  _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), acc);
+
+  return size_t(lanes[0] + lanes[1] + lanes[2] + lanes[3]);
+}
+
+IRESEARCH_TARGET("avx2,popcnt") size_t avx2_count(
+    const word_t* data, size_t size) NOEXCEPT {
+  auto acc = _mm256_setzero_si256();
+
+  for (; size >= AVX2_WORDS; size -= AVX2_WORDS, data += AVX2_WORDS) {
+    acc = avx2_pop(acc, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data)));
+  }
+
+  return avx2_sum(acc) + popcnt_count(data, size);
+}
+
+IRESEARCH_TARGET("avx2,popcnt") size_t avx2_and_count(
+    const word_t* lhs, const word_t* rhs, size_t size) NOEXCEPT {
+  auto acc = _mm256_setzero_si256();
+
+  for (; size >= AVX2_WORDS; size -= AVX2_WORDS, lhs += AVX2_WORDS, rhs += AVX2_WORDS) {
+    const auto l = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lhs));
+    const auto r = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rhs));
+
+    acc = avx2_pop(acc, _mm256_and_si256(l, r));
+  }
+
+  return avx2_sum(acc) + popcnt_and_count(lhs, rhs, size);
+}
+
+// ----------------------------------------------------------------------------
+// AVX-512 implementation
+// ----------------------------------------------------------------------------
+
+const size_t AVX512_WORDS = sizeof(__m512i) / sizeof(word_t);
+
+template<typename Op>
+IRESEARCH_TARGET("avx512f") void avx512_assign(
+    word_t* lhs, const word_t* rhs, size_t size) NOEXCEPT {
+  for (; size >= AVX512_WORDS; size -= AVX512_WORDS, lhs += AVX512_WORDS, rhs += AVX512_WORDS) {
+    const auto l = _mm512_loadu_si512(lhs);
+    const auto r = _mm512_loadu_si512(rhs);
+
+    _mm512_storeu_si512(lhs, Op::apply(l, r));
+  }
+
+  scalar_assign<Op>(lhs, rhs, size);
+}
+
+IRESEARCH_TARGET("avx512f,avx512vpopcntdq,popcnt") size_t avx512_count(
+    const word_t* data, size_t size) NOEXCEPT {
+  auto acc = _mm512_setzero_si512();
+
+  for (; size >= AVX512_WORDS; size -= AVX512_WORDS, data += AVX512_WORDS) {
+    acc = _mm512_add_epi64(acc, _mm512_popcnt_epi64(_mm512_loadu_si512(data)));
+  }
+
+  return size_t(_mm512_reduce_add_epi64(acc)) + popcnt_count(data, size);
+}
+
+IRESEARCH_TARGET("avx512f,avx512vpopcntdq,popcnt") size_t avx512_and_count(
+    const word_t* lhs, const word_t* rhs, size_t size) NOEXCEPT {
+  auto acc = _mm512_setzero_si512();
+
+  for (; size >= AVX512_WORDS; size -= AVX512_WORDS, lhs += AVX512_WORDS, rhs += AVX512_WORDS) {
+    const auto value = _mm512_and_si512(_mm512_loadu_si512(lhs), _mm512_loadu_si512(rhs));
+
+    acc = _mm512_add_epi64(acc, _mm512_popcnt_epi64(value));
+  }
+
+  return size_t(_mm512_reduce_add_epi64(acc)) + popcnt_and_count(lhs, rhs, size);
+}
+
+#endif // IRESEARCH_X86
+
+// ----------------------------------------------------------------------------
+// runtime dispatch
+// ----------------------------------------------------------------------------
+
+struct simd_kernels {
+  simd_kernels() NOEXCEPT {
+#if defined(IRESEARCH_X86)
+    if (iresearch::cpuinfo::support_avx512f()) {
+      and_assign = &avx512_assign<op_and>;
+      or_assign = &avx512_assign<op_or>;
+      andnot_assign = &avx512_assign<op_andnot>;
+      xor_assign = &avx512_assign<op_xor>;
+    } else if (iresearch::cpuinfo::support_avx2()) {
+      and_assign = &avx2_assign<op_and>;
+      or_assign = &avx2_assign<op_or>;
+      andnot_assign = &avx2_assign<op_andnot>;
+      xor_assign = &avx2_assign<op_xor>;
+    }
+
+    if (iresearch::cpuinfo::support_popcnt()) {
+      if (iresearch::cpuinfo::support_avx512vpopcntdq()) {
+        count = &avx512_count;
+        and_count = &avx512_and_count;
+      } else if (iresearch::cpuinfo::support_avx2()) {
+        count = &avx2_count;
+        and_count = &avx2_and_count;
+      } else {
+        count = &popcnt_count;
+        and_count = &popcnt_and_count;
+      }
+    }
+#endif
+  }
+
+  void (*and_assign)(word_t*, const word_t*, size_t) { &scalar_assign<op_and> };
+  void (*or_assign)(word_t*, const word_t*, size_t) { &scalar_assign<op_or> };
+  void (*andnot_assign)(word_t*, const word_t*, size_t) { &scalar_assign<op_andnot> };
+  void (*xor_assign)(word_t*, const word_t*, size_t) { &scalar_assign<op_xor> };
+  size_t (*count)(const word_t*, size_t) { &scalar_count };
+  size_t (*and_count)(const word_t*, const word_t*, size_t) { &scalar_and_count };
+}; // simd_kernels
+
+const simd_kernels& kernels() NOEXCEPT {
+  static const simd_kernels instance; // lazy initialization, relies on 'cpuinfo'
+  return instance;
+}
+
+NS_END // NS_LOCAL
+
+NS_ROOT
+NS_BEGIN(bitwise)
+
+void and_assign(size_t* lhs, const size_t* rhs, size_t size) NOEXCEPT {
+  kernels().and_assign(lhs, rhs, size);
+}
+
+void or_assign(size_t* lhs, const size_t* rhs, size_t size) NOEXCEPT {
+  kernels().or_assign(lhs, rhs, size);
+}
+
+void andnot_assign(size_t* lhs, const size_t* rhs, size_t size) NOEXCEPT {
+  kernels().andnot_assign(lhs, rhs, size);
+}
+
+void xor_assign(size_t* lhs, const size_t* rhs, size_t size) NOEXCEPT {
+  kernels().xor_assign(lhs, rhs, size);
+}
+
+size_t count(const size_t* data, size_t size) NOEXCEPT {
+  return kernels().count(data, size);
+}
+
+size_t and_count(const size_t* lhs, const size_t* rhs, size_t size) NOEXCEPT {
+  return kernels().and_count(lhs, rhs, size);
+}
+
+NS_END // bitwise
+NS_END // root
@@ -24,6 +24,8 @@
 #ifndef IRESEARCH_BITSET_H
 #define IRESEARCH_BITSET_H
 
+#include <algorithm>
+#include <cstring>
 #include <memory>
 
 #include "shared.hpp"
@@ -33,6 +35,30 @@
 #include "memory.hpp"
 
 NS_ROOT
+NS_BEGIN(bitwise)
+
+// word-wise boolean algebra over arrays of 'size' words, the fastest
+// implementation available on the current CPU is chosen at runtime
+
+// lhs[i] &= rhs[i]
+IRESEARCH_API void and_assign(size_t* lhs, const size_t* rhs, size_t size) NOEXCEPT;
+
+// lhs[i] |= rhs[i]
+IRESEARCH_API void or_assign(size_t* lhs, const size_t* rhs, size_t size) NOEXCEPT;
+
+// lhs[i] &= ~rhs[i]
+IRESEARCH_API void andnot_assign(size_t* lhs, const size_t* rhs, size_t size) NOEXCEPT;
+
+// lhs[i] ^= rhs[i]
+IRESEARCH_API void xor_assign(size_t* lhs, const size_t* rhs, size_t size) NOEXCEPT;
+
+// returns number of bits set in 'data'
+IRESEARCH_API size_t count(const size_t* data, size_t size) NOEXCEPT;
+
+// returns number of bits set in both 'lhs' and 'rhs'
+IRESEARCH_API size_t and_count(const size_t* lhs, const size_t* rhs, size_t size) NOEXCEPT;
+
+NS_END // bitwise
 
 class bitset : util::noncopyable {
  public:
@@ -158,11 +184,13 @@ class bitset : util::noncopyable {
 
   // counts bits set
   word_t count() const NOEXCEPT {
-    return std::accumulate(
-      begin(), end(), word_t(0),
-      [] (word_t v, word_t w) {
-        return v + math::math_traits<word_t>::pop(w);
-    });
+    return bitwise::count(begin(), words_);
+  }
+
+  // counts bits set in both 'this' and 'rhs' without materializing
+  // the intersection
+  word_t and_count(const bitset& rhs) const NOEXCEPT {
+    return bitwise::and_count(begin(), rhs.begin(), std::min(words_, rhs.words_));
   }
 
  private:
@@ -81,16 +81,12 @@ class bitvector final {
     auto* data = const_cast<word_t*>(begin());
     auto last_word = bitset::word(other.size() - 1); // -1 for bit offset
 
-    for (size_t i = 0; i < last_word; ++i) {
-      assert(i < set_.words() && i < other.set_.words());
-      *(data + i) &= *(other.data() + i);
-    }
+    assert(last_word < set_.words() && last_word < other.set_.words());
+    bitwise::and_assign(data, other.data(), last_word);
 
     // for the last word consider only those bits included in 'other.size()'
-    auto last_word_bits = other.size() % bits_required<word_t>();
-    const auto mask = (word_t(1) << last_word_bits) - 1; // set all bits that are not part of 'other.size()'
+    const auto mask = last_word_mask(other.size());
 
-    assert(last_word < set_.words() && last_word < other.set_.words());
     *(data + last_word) &= (*(other.data() + last_word) & mask);
     std::memset(data + last_word + 1, 0, (set_.words() - last_word - 1) * sizeof(word_t)); // unset tail words
 
@@ -108,10 +104,8 @@ class bitvector final {
     auto* data = const_cast<word_t*>(begin());
     auto last_word = bitset::word(other.size() - 1); // -1 for bit offset
 
-    for (size_t i = 0; i <= last_word; ++i) {
-      assert(i < set_.words() && i < other.set_.words());
-      *(data + i) |= *(other.data() + i);
-    }
+    assert(last_word < set_.words() && last_word < other.set_.words());
+    bitwise::or_assign(data, other.data(), last_word + 1);
 
     return *this;
   }
@@ -127,21 +121,12 @@ class bitvector final {
     auto* data = const_cast<word_t*>(begin());
     auto last_word = bitset::word(other.size() - 1); // -1 for bit offset
 
-    for (size_t i = 0; i < last_word; ++i) {
-      assert(i < set_.words() && i < other.set_.words());
-      *(data + i) ^= *(other.data() + i);
-    }
+    assert(last_word < set_.words() && last_word < other.set_.words());
+    bitwise::xor_assign(data, other.data(), last_word);
 
     // for the last word consider only those bits included in 'other.size()'
-    auto last_word_bits = other.size() % bits_required<word_t>();
-    auto mask = ~word_t(0);
+    const auto mask = last_word_mask(other.size());
 
-    // clear trailing bits
-    if (last_word_bits) {
-      mask = ~(mask << last_word_bits); // unset all bits that are not part of 'other.size()'
-    }
-
-    assert(last_word < set_.words() && last_word < other.set_.words());
     *(data + last_word) ^= (*(other.data() + last_word) & mask);
 
     return *this;
@@ -157,27 +142,46 @@ class bitvector final {
     auto* data = const_cast<word_t*>(begin());
     auto last_word = bitset::word(other.size() - 1); // -1 for bit offset
 
-    for (size_t i = 0; i < last_word; ++i) {
-      assert(i < set_.words() && i < other.set_.words());
-      *(data + i) &= ~(*(other.data() + i));
-    }
+    assert(last_word < set_.words() && last_word < other.set_.words());
+    bitwise::andnot_assign(data, other.data(), last_word);
 
     // for the last word consider only those bits included in 'other.size()'
-    auto last_word_bits = other.size() % bits_required<word_t>();
-    auto mask = ~word_t(0);
+    const auto mask = last_word_mask(other.size());
 
-    // clear trailing bits
-    if (last_word_bits) {
-      mask = ~(mask << last_word_bits); // unset all bits that are not part of 'other.size()'
-    }
-
-    assert(last_word < set_.words() && last_word < other.set_.words());
     *(data + last_word) &= ~(*(other.data() + last_word) & mask);
 
     return *this;
   }
 
   bool all() const NOEXCEPT { return set_.count() == size(); }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief counts bits set in both 'this' and 'other' without materializing
+  ///        the intersection, i.e. equivalent to 'bitvector(*this) &= other'
+  ///        followed by 'count()'
+  //////////////////////////////////////////////////////////////////////////////
+  word_t and_count(const bitvector& other) const NOEXCEPT {
+    const auto words = std::min(set_.words(), other.set_.words());
+
+    if (!words || !other.size()) {
+      return 0; // nothing to do
+    }
+
+    const auto last_word = bitset::word(other.size() - 1); // -1 for bit offset
+
+    if (last_word >= words) {
+      return bitwise::and_count(begin(), other.begin(), words);
+    }
+
+    // for the last word consider only those bits included in 'other.size()'
+    const auto mask = last_word_mask(other.size());
+
+    return bitwise::and_count(begin(), other.begin(), last_word)
+      + math::math_traits<word_t>::pop(
+          *(begin() + last_word) & *(other.begin() + last_word) & mask
+        );
+  }
+
   bool any() const NOEXCEPT { return set_.any(); }
   const word_t* begin() const NOEXCEPT { return set_.data(); }
   size_t capacity() const NOEXCEPT { return set_.capacity(); }
@@ -300,6 +304,15 @@ class bitvector final {
   void unset(size_t i) { reset(i, false); }
 
  private:
+  // returns mask of bits in the last word that are part of 'size'
+  static word_t last_word_mask(size_t size) NOEXCEPT {
+    const auto last_word_bits = size % bits_required<word_t>();
+
+    return last_word_bits
+      ? ~(~word_t(0) << last_word_bits) // unset all bits that are not part of 'size'
+      : ~word_t(0); // last word is fully covered by 'size'
+  }
+
   bitset set_;
   size_t size_{}; // number of bits requested in a bitset
 };
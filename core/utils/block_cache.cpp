@@ -0,0 +1,188 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2016 by EMC Corporation, All Rights Reserved
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is EMC Corporation
+///
+/// @author Andrey Abramov
+/// @author Vasiliy Nabatchikov
+////////////////////////////////////////////////////////////////////////////////
+
+#include "block_cache.hpp"
+#include "hash_utils.hpp"
+#include "thread_utils.hpp"
+
+#include <iterator>
+
+NS_ROOT
+
+/*static*/ block_cache::ptr block_cache::make(
+    size_t max_size,
+    size_t shards /*= DEFAULT_SHARDS*/) {
+  return std::make_shared<block_cache>(max_size, shards);
+}
+
+/*static*/ uint64_t block_cache::next_owner() NOEXCEPT {
+  static std::atomic<uint64_t> owner{};
+  return ++owner;
+}
+
+size_t block_cache::key_hash::operator()(const key& value) const NOEXCEPT {
+  return hash_combine(std::hash<uint64_t>()(value.owner), value.offset);
+}
+
+block_cache::block_cache(size_t max_size, size_t shards /*= DEFAULT_SHARDS*/)
+  : max_size_(max_size) {
+  shards = std::max(size_t(1), shards);
+  max_shard_size_ = max_size / shards;
+
+  shards_.reserve(shards);
+  for (; shards; --shards) {
+    shards_.emplace_back(memory::make_unique<shard>());
+  }
+}
+
+block_cache::shard& block_cache::get_shard(const key& id) NOEXCEPT {
+  return *shards_[key_hash()(id) % shards_.size()];
+}
+
+block_cache::value_ptr block_cache::find_value(
+    uint64_t owner,
+    uint64_t offset) {
+  const key id{ owner, offset };
+  auto& shard = get_shard(id);
+
+  {
+    SCOPED_LOCK(shard.mutex);
+
+    const auto it = shard.map.find(id);
+
+    if (it != shard.map.end()) {
+      // mark as most recently used
+      shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+      ++hits_;
+
+      return it->second->value;
+    }
+  }
+
+  ++misses_;
+
+  return nullptr;
+}
+
+block_cache::value_ptr block_cache::emplace_value(
+    uint64_t owner,
+    uint64_t offset,
+    value_ptr&& value,
+    size_t size) {
+  const key id{ owner, offset };
+  auto& shard = get_shard(id);
+  lru_t evicted; // destroy evicted blocks outside of the lock
+
+  {
+    SCOPED_LOCK(shard.mutex);
+
+    const auto it = shard.map.find(id);
+
+    if (it != shard.map.end()) {
+      // already cached by another thread
+      shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+
+      return it->second->value;
+    }
+
+    if (size > max_shard_size_) {
+      // block is too large to be cached
+      return std::move(value);
+    }
+
+    // evict least recently used blocks
+    while (shard.size + size > max_shard_size_) {
+      assert(!shard.lru.empty());
+      auto last = std::prev(shard.lru.end());
+
+      shard.size -= last->size;
+      shard.map.erase(last->id);
+      evicted.splice(evicted.end(), shard.lru, last);
+      ++evictions_;
+    }
+
+    shard.lru.emplace_front();
+
+    auto& entry = shard.lru.front();
+    entry.id = id;
+    entry.value = std::move(value);
+    entry.size = size;
+
+    try {
+      shard.map.emplace(id, shard.lru.begin());
+    } catch (...) {
+      shard.lru.pop_front();
+      throw;
+    }
+
+    shard.size += size;
+
+    return entry.value;
+  }
+}
+
+void block_cache::erase(uint64_t owner) {
+  for (auto& shard : shards_) {
+    lru_t erased; // destroy erased blocks outside of the lock
+
+    SCOPED_LOCK(shard->mutex);
+
+    for (auto it = shard->lru.begin(), end = shard->lru.end(); it != end;) {
+      auto entry = it++;
+
+      if (entry->id.owner == owner) {
+        shard->size -= entry->size;
+        shard->map.erase(entry->id);
+        erased.splice(erased.end(), shard->lru, entry);
+      }
+    }
+  }
+}
+
+void block_cache::clear() {
+  for (auto& shard : shards_) {
+    lru_t erased; // destroy erased blocks outside of the lock
+
+    SCOPED_LOCK(shard->mutex);
+    shard->map.clear();
+    shard->size = 0;
+    erased.swap(shard->lru);
+  }
+}
+
+block_cache::stats_t block_cache::stats() const {
+  stats_t stats;
+  stats.hits = hits_;
+  stats.misses = misses_;
+  stats.evictions = evictions_;
+
+  for (auto& shard : shards_) {
+    SCOPED_LOCK(shard->mutex);
+    stats.size += shard->size;
+    stats.count += shard->lru.size();
+  }
+
+  return stats;
+}
+
+NS_END
@@ -0,0 +1,168 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2016 by EMC Corporation, All Rights Reserved
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is EMC Corporation
+///
+/// @author Andrey Abramov
+/// @author Vasiliy Nabatchikov
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef IRESEARCH_BLOCK_CACHE_H
+#define IRESEARCH_BLOCK_CACHE_H
+
+#include "shared.hpp"
+#include "memory.hpp"
+#include "noncopyable.hpp"
+
+#include <atomic>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+NS_ROOT
+
+////////////////////////////////////////////////////////////////////////////////
+/// @class block_cache
+/// @brief a thread-safe cache of decoded data blocks bounded by the total size
+///        of the cached blocks, entries are evicted in LRU order
+///        the cache is split into a number of independently locked shards,
+///        each one is limited by the equal part of the total budget
+/// @note a block is identified by the pair <owner, offset>, where 'owner' is
+///       a unique identifier obtained via 'block_cache::next_owner()'
+/// @note cached blocks are reference counted, so evicted blocks remain
+///       valid while they are referenced by the readers
+////////////////////////////////////////////////////////////////////////////////
+class IRESEARCH_API block_cache : private util::noncopyable {
+ public:
+  DECLARE_SPTR(block_cache);
+  typedef std::shared_ptr<const void> value_ptr;
+
+  static const size_t DEFAULT_SHARDS = 16;
+
+  struct stats_t {
+    uint64_t hits{}; // number of successful lookups
+    uint64_t misses{}; // number of failed lookups
+    uint64_t evictions{}; // number of blocks evicted due to the size limit
+    size_t size{}; // total size of the cached blocks (in bytes)
+    size_t count{}; // total number of the cached blocks
+  }; // stats_t
+
+  static ptr make(size_t max_size, size_t shards = DEFAULT_SHARDS);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @returns new unique owner identifier
+  //////////////////////////////////////////////////////////////////////////////
+  static uint64_t next_owner() NOEXCEPT;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @param max_size maximum total size of the cached blocks (in bytes)
+  /// @param shards number of the independently locked shards
+  //////////////////////////////////////////////////////////////////////////////
+  explicit block_cache(size_t max_size, size_t shards = DEFAULT_SHARDS);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @returns cached block identified by the specified key, nullptr if the
+  ///          block isn't cached
+  //////////////////////////////////////////////////////////////////////////////
+  template<typename T>
+  std::shared_ptr<const T> find(uint64_t owner, uint64_t offset) {
+    return std::static_pointer_cast<const T>(find_value(owner, offset));
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief puts the specified block of 'size' bytes into the cache
+  /// @returns the cached block, which may differ from the specified one in
+  ///          case if the block has been already cached by another thread
+  //////////////////////////////////////////////////////////////////////////////
+  template<typename T>
+  std::shared_ptr<const T> emplace(
+      uint64_t owner,
+      uint64_t offset,
+      std::shared_ptr<const T>&& block,
+      size_t size) {
+    return std::static_pointer_cast<const T>(
+      emplace_value(owner, offset, std::move(block), size)
+    );
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief removes all blocks belonging to the specified owner
+  //////////////////////////////////////////////////////////////////////////////
+  void erase(uint64_t owner);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief removes all cached blocks
+  //////////////////////////////////////////////////////////////////////////////
+  void clear();
+
+  size_t max_size() const NOEXCEPT { return max_size_; }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @returns a snapshot of the cache counters
+  //////////////////////////////////////////////////////////////////////////////
+  stats_t stats() const;
+
+ private:
+  struct key {
+    bool operator==(const key& rhs) const NOEXCEPT {
+      return owner == rhs.owner && offset == rhs.offset;
+    }
+
+    uint64_t owner;
+    uint64_t offset;
+  }; // key
+
+  struct key_hash {
+    size_t operator()(const key& value) const NOEXCEPT;
+  }; // key_hash
+
+  struct entry {
+    key id;
+    value_ptr value;
+    size_t size;
+  }; // entry
+
+  typedef std::list<entry> lru_t; // most recently used are in front
+
+  struct shard {
+    mutable std::mutex mutex;
+    lru_t lru;
+    std::unordered_map<key, lru_t::iterator, key_hash> map;
+    size_t size{}; // total size of the cached blocks
+  }; // shard
+
+  value_ptr find_value(uint64_t owner, uint64_t offset);
+  value_ptr emplace_value(
+    uint64_t owner, uint64_t offset, value_ptr&& value, size_t size
+  );
+  shard& get_shard(const key& id) NOEXCEPT;
+
+  IRESEARCH_API_PRIVATE_VARIABLES_BEGIN
+  std::vector<std::unique_ptr<shard>> shards_;
+  size_t max_size_; // total size limit
+  size_t max_shard_size_; // size limit per shard
+  std::atomic<uint64_t> hits_{};
+  std::atomic<uint64_t> misses_{};
+  std::atomic<uint64_t> evictions_{};
+  IRESEARCH_API_PRIVATE_VARIABLES_END
+}; // block_cache
+
+NS_END
+
+#endif
@@ -22,20 +22,113 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "cpuinfo.hpp"
+#include "bit_utils.hpp"
+
+#include <algorithm>
+
+#if defined(IRESEARCH_X86)
+  #if defined(_MSC_VER)
+    #include <intrin.h>
+    #include <immintrin.h>
+  #else
+    #include <cpuid.h>
+  #endif
+#endif
+
+NS_LOCAL
 
+#if defined(IRESEARCH_X86)
+
+void cpuid(int info[4], int leaf) {
 #if defined(_MSC_VER)
+  __cpuidex(info, leaf, 0);
+#else
+  unsigned int regs[4]{};
+  __cpuid_count(leaf, 0, regs[0], regs[1], regs[2], regs[3]);
+  std::copy(regs, regs + 4, info);
+#endif
+}
 
-#include "bit_utils.hpp"
+uint64_t xgetbv() {
+#if defined(_MSC_VER)
+  return _xgetbv(0);
+#else
+  uint32_t eax, edx;
+  __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+  return (uint64_t(edx) << 32) | eax;
+#endif
+}
 
-NS_ROOT
+#endif
+
+struct features {
+  features() {
+#if defined(IRESEARCH_X86)
+    int info[4]{};
+    cpuid(info, 0);
+    const int max_leaf = info[0];
 
-const cpuinfo cpuinfo::instance_;
+    cpuid(info, 1);
+    popcnt = irs::check_bit<23>(info[2]);
+    sse4_1 = irs::check_bit<19>(info[2]);
+    sse4_2 = irs::check_bit<20>(info[2]);
+
+    // OS must preserve YMM registers across context switches
+    const bool avx = irs::check_bit<28>(info[2]) // AVX
+      && irs::check_bit<27>(info[2]) // OSXSAVE
+      && 6 == (xgetbv() & 6); // XMM | YMM state
+
+    // OS must additionally preserve opmask and ZMM registers for AVX-512
+    const bool avx512 = avx && 0xE6 == (xgetbv() & 0xE6); // XMM | YMM | opmask | ZMM
+
+    if (avx && max_leaf >= 7) {
+      cpuid(info, 7);
+      avx2 = irs::check_bit<5>(info[1]);
+      avx512f = avx512 && irs::check_bit<16>(info[1]);
+      avx512vpopcntdq = avx512f && irs::check_bit<14>(info[2]);
+    }
+#endif
+  }
+
+  bool popcnt{};
+  bool sse4_1{};
+  bool sse4_2{};
+  bool avx2{};
+  bool avx512f{};
+  bool avx512vpopcntdq{};
+}; // features
+
+const features& cpu_features() {
+  static const features instance; // lazy initialization, avoids static init order issues
+  return instance;
+}
+
+NS_END // LOCAL
+
+NS_ROOT
 
 /*static*/ bool cpuinfo::support_popcnt() {
-  // according to https://msdn.microsoft.com/en-us/library/bb385231.aspx
-  return check_bit<23>(instance_.f1_cpuinfo_[2]);
+  return cpu_features().popcnt;
 }
 
-NS_END
+/*static*/ bool cpuinfo::support_sse4_1() {
+  return cpu_features().sse4_1;
+}
 
-#endif
+/*static*/ bool cpuinfo::support_sse4_2() {
+  return cpu_features().sse4_2;
+}
+
+/*static*/ bool cpuinfo::support_avx2() {
+  return cpu_features().avx2;
+}
+
+/*static*/ bool cpuinfo::support_avx512f() {
+  return cpu_features().avx512f;
+}
+
+/*static*/ bool cpuinfo::support_avx512vpopcntdq() {
+  return cpu_features().avx512vpopcntdq;
+}
+
+NS_END
@@ -24,28 +24,26 @@
 #ifndef IRESEARCH_CPUID_ID
 #define IRESEARCH_CPUID_ID
 
-#if defined(_MSC_VER)
-
 #include "shared.hpp"
-#include <intrin.h>
 
 NS_ROOT
 
+////////////////////////////////////////////////////////////////////////////////
+/// @class cpuinfo
+/// @brief provides information about instruction sets supported by the
+///        current CPU, used for runtime dispatching of the vectorized code
+///        paths, all checks return 'false' on non-x86 platforms
+////////////////////////////////////////////////////////////////////////////////
 class IRESEARCH_API cpuinfo {
  public:
   static bool support_popcnt();
- private:
-  static const cpuinfo instance_;
-
-  cpuinfo() {
-    __cpuid( f1_cpuinfo_, 1 );
-  }
-
-  int f1_cpuinfo_[4];
-};
+  static bool support_sse4_1();
+  static bool support_sse4_2();
+  static bool support_avx2();
+  static bool support_avx512f();
+  static bool support_avx512vpopcntdq();
+}; // cpuinfo
 
 NS_END
 
 #endif
-
-#endif
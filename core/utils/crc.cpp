@@ -0,0 +1,145 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2016 by EMC Corporation, All Rights Reserved
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is EMC Corporation
+///
+/// @author Andrey Abramov
+/// @author Vasiliy Nabatchikov
+////////////////////////////////////////////////////////////////////////////////
+
+#include "crc.hpp"
+#include "cpuinfo.hpp"
+
+#include <cstring>
+
+#if defined(IRESEARCH_X86)
+  #include <nmmintrin.h>
+#endif
+
+NS_LOCAL
+
+using irs::byte_type;
+
+const uint32_t CRC32C_POLY = 0x82F63B78; // reversed Castagnoli polynomial
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief tables for the slice-by-8 algorithm
+////////////////////////////////////////////////////////////////////////////////
+struct crc32c_tables {
+  crc32c_tables() NOEXCEPT {
+    for (uint32_t i = 0; i < 256; ++i) {
+      uint32_t crc = i;
+
+      for (size_t j = 0; j < 8; ++j) {
+        crc = (crc >> 1) ^ (CRC32C_POLY & (0 - (crc & 1)));
+      }
+
+      table[0][i] = crc;
+    }
+
+    for (uint32_t i = 0; i < 256; ++i) {
+      for (size_t k = 1; k < 8; ++k) {
+        const auto crc = table[k - 1][i];
+        table[k][i] = (crc >> 8) ^ table[0][crc & 0xFF];
+      }
+    }
+  }
+
+  uint32_t table[8][256];
+}; // crc32c_tables
+
+uint32_t crc32c_sb8(uint32_t crc, const byte_type* data, size_t size) NOEXCEPT {
+  static const crc32c_tables tables; // lazy initialization
+  const auto& t = tables.table;
+
+  for (; size >= 8; data += 8, size -= 8) {
+    crc ^= uint32_t(data[0])
+         | (uint32_t(data[1]) << 8)
+         | (uint32_t(data[2]) << 16)
+         | (uint32_t(data[3]) << 24);
+
+    crc = t[7][crc & 0xFF]
+        ^ t[6][(crc >> 8) & 0xFF]
+        ^ t[5][(crc >> 16) & 0xFF]
+        ^ t[4][crc >> 24]
+        ^ t[3][data[4]]
+        ^ t[2][data[5]]
+        ^ t[1][data[6]]
+        ^ t[0][data[7]];
+  }
+
+  for (; size; ++data, --size) {
+    crc = (crc >> 8) ^ t[0][(crc ^ *data) & 0xFF];
+  }
+
+  return crc;
+}
+
+#if defined(IRESEARCH_X86)
+
+IRESEARCH_TARGET("sse4.2")
+uint32_t crc32c_sse42(uint32_t crc, const byte_type* data, size_t size) NOEXCEPT {
+#if defined(__x86_64__) || defined(_M_X64)
+  uint64_t crc64 = crc;
+
+  for (; size >= sizeof(uint64_t); data += sizeof(uint64_t), size -= sizeof(uint64_t)) {
+    uint64_t value;
+    std::memcpy(&value, data, sizeof value); // unaligned load
+    crc64 = _mm_crc32_u64(crc64, value);
+  }
+
+  crc = static_cast<uint32_t>(crc64);
+#endif
+
+  for (; size >= sizeof(uint32_t); data += sizeof(uint32_t), size -= sizeof(uint32_t)) {
+    uint32_t value;
+    std::memcpy(&value, data, sizeof value); // unaligned load
+    crc = _mm_crc32_u32(crc, value);
+  }
+
+  for (; size; ++data, --size) {
+    crc = _mm_crc32_u8(crc, *data);
+  }
+
+  return crc;
+}
+
+#endif
+
+typedef uint32_t(*crc32c_f)(uint32_t, const byte_type*, size_t);
+
+crc32c_f crc32c_impl() NOEXCEPT {
+#if defined(IRESEARCH_X86)
+  if (irs::cpuinfo::support_sse4_2()) {
+    return &crc32c_sse42;
+  }
+#endif
+
+  return &crc32c_sb8;
+}
+
+NS_END // LOCAL
+
+NS_ROOT
+
+void crc32c::process_bytes(const void* data, size_t size) NOEXCEPT {
+  static const crc32c_f impl = crc32c_impl(); // lazy initialization, relies on 'cpuinfo'
+
+  value_ = impl(value_, static_cast<const byte_type*>(data), size);
+}
+
+NS_END
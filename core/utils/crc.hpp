@@ -0,0 +1,58 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2016 by EMC Corporation, All Rights Reserved
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is EMC Corporation
+///
+/// @author Andrey Abramov
+/// @author Vasiliy Nabatchikov
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef IRESEARCH_CRC_H
+#define IRESEARCH_CRC_H
+
+#include "shared.hpp"
+
+NS_ROOT
+
+////////////////////////////////////////////////////////////////////////////////
+/// @class crc32c
+/// @brief CRC-32C (Castagnoli) checksum, uses SSE4.2 'crc32' instruction
+///        where supported by the CPU and slice-by-8 tables otherwise,
+///        the interface mirrors the one of boost::crc_32_type
+////////////////////////////////////////////////////////////////////////////////
+class IRESEARCH_API crc32c {
+ public:
+  void process_bytes(const void* data, size_t size) NOEXCEPT;
+
+  void process_block(const void* begin, const void* end) NOEXCEPT {
+    process_bytes(
+      begin,
+      static_cast<const byte_type*>(end) - static_cast<const byte_type*>(begin)
+    );
+  }
+
+  uint32_t checksum() const NOEXCEPT { return ~value_; }
+
+  void reset() NOEXCEPT { value_ = 0xFFFFFFFF; }
+
+ private:
+  uint32_t value_{ 0xFFFFFFFF };
+}; // crc32c
+
+NS_END
+
+#endif
@@ -225,6 +225,83 @@ directory_cleaner::removal_acceptor_t remove_except_current_segments(
 
 NS_END
 
+// -----------------------------------------------------------------------------
+// --SECTION--                                                advising_directory
+// -----------------------------------------------------------------------------
+
+advising_directory::advising_directory(directory& impl, IOAdvice advice)
+  : impl_(impl), advice_(advice) {
+}
+
+advising_directory::~advising_directory() {}
+
+directory& advising_directory::operator*() NOEXCEPT {
+  return impl_;
+}
+
+attribute_store& advising_directory::attributes() NOEXCEPT {
+  return impl_.attributes();
+}
+
+void advising_directory::close() NOEXCEPT {
+  impl_.close();
+}
+
+index_output::ptr advising_directory::create(
+  const std::string& name
+) NOEXCEPT {
+  return impl_.create(name);
+}
+
+bool advising_directory::exists(
+  bool& result, const std::string& name
+) const NOEXCEPT {
+  return impl_.exists(result, name);
+}
+
+bool advising_directory::length(
+  uint64_t& result, const std::string& name
+) const NOEXCEPT {
+  return impl_.length(result, name);
+}
+
+bool advising_directory::visit(const directory::visitor_f& visitor) const {
+  return impl_.visit(visitor);
+}
+
+index_lock::ptr advising_directory::make_lock(
+  const std::string& name
+) NOEXCEPT {
+  return impl_.make_lock(name);
+}
+
+bool advising_directory::mtime(
+  std::time_t& result, const std::string& name
+) const NOEXCEPT {
+  return impl_.mtime(result, name);
+}
+
+index_input::ptr advising_directory::open(
+  const std::string& name,
+  IOAdvice advice
+) const NOEXCEPT {
+  return impl_.open(name, advice | advice_);
+}
+
+bool advising_directory::remove(const std::string& name) NOEXCEPT {
+  return impl_.remove(name);
+}
+
+bool advising_directory::rename(
+  const std::string& src, const std::string& dst
+) NOEXCEPT {
+  return impl_.rename(src, dst);
+}
+
+bool advising_directory::sync(const std::string& name) NOEXCEPT {
+  return impl_.sync(name);
+}
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                tracking_directory
 // -----------------------------------------------------------------------------
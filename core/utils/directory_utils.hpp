@@ -79,6 +79,47 @@ IRESEARCH_API directory_cleaner::removal_acceptor_t remove_except_current_segmen
 
 NS_END
 
+//////////////////////////////////////////////////////////////////////////////
+/// @class advising_directory
+/// @brief adds the specified IOAdvice to every input opened via the directory
+//////////////////////////////////////////////////////////////////////////////
+
+struct IRESEARCH_API advising_directory: public directory {
+  advising_directory(directory& impl, IOAdvice advice);
+  virtual ~advising_directory();
+  directory& operator*() NOEXCEPT;
+  using directory::attributes;
+  virtual attribute_store& attributes() NOEXCEPT override;
+  virtual void close() NOEXCEPT override;
+  virtual index_output::ptr create(const std::string& name) NOEXCEPT override;
+  virtual bool exists(
+    bool& result, const std::string& name
+  ) const NOEXCEPT override;
+  virtual bool length(
+    uint64_t& result, const std::string& name
+  ) const NOEXCEPT override;
+  virtual index_lock::ptr make_lock(const std::string& name) NOEXCEPT override;
+  virtual bool mtime(
+    std::time_t& result, const std::string& name
+  ) const NOEXCEPT override;
+  virtual index_input::ptr open(
+    const std::string& name,
+    IOAdvice advice
+  ) const NOEXCEPT override;
+  virtual bool remove(const std::string& name) NOEXCEPT override;
+  virtual bool rename(
+    const std::string& src, const std::string& dst
+  ) NOEXCEPT override;
+  virtual bool sync(const std::string& name) NOEXCEPT override;
+  virtual bool visit(const visitor_f& visitor) const override;
+
+ private:
+  IRESEARCH_API_PRIVATE_VARIABLES_BEGIN
+  directory& impl_;
+  IOAdvice advice_;
+  IRESEARCH_API_PRIVATE_VARIABLES_END
+};
+
 //////////////////////////////////////////////////////////////////////////////
 /// @class tracking_directory
 /// @brief track files created/opened via file names
@@ -24,9 +24,62 @@
 #include "formats/format_utils.hpp"
 #include "index_utils.hpp"
 
-namespace {
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <unordered_set>
+
+NS_LOCAL
+
+struct segment_stat {
+  const irs::segment_meta* meta;
+  size_t bytes; // size of all segment files
+  size_t live_bytes; // estimated size of the live documents
+  double live_ratio; // live_docs_count / docs_count
+};
+
+size_t segment_bytes(const irs::directory& dir, const irs::segment_meta& meta) {
+  size_t size = 0;
+  uint64_t length;
+
+  for (auto& file: meta.files) {
+    if (dir.length(length, file)) {
+      size += length;
+    }
+  }
+
+  return size;
+}
+
+// number of segments allowed in the index of the specified size
+size_t allowed_segments(
+    size_t total_bytes,
+    size_t min_segment_bytes,
+    const irs::index_utils::consolidate_tier_options& options) {
+  const auto segments_per_tier = std::max(size_t(2), options.segments_per_tier);
+  const auto tier_factor = std::max(size_t(2), options.max_segments);
+  double tier_bytes = double(std::max(size_t(1), std::max(min_segment_bytes, options.floor_segment_bytes)));
+  double remaining = double(total_bytes);
+  size_t allowed = 0;
+
+  for (;;) {
+    const auto tier_segments = remaining / tier_bytes;
+
+    if (tier_segments < segments_per_tier) {
+      allowed += size_t(std::ceil(tier_segments));
+      break;
+    }
+
+    allowed += segments_per_tier;
+    remaining -= segments_per_tier * tier_bytes;
+    tier_bytes *= tier_factor;
+  }
+
+  return allowed;
 }
 
+NS_END // LOCAL
+
 NS_ROOT
 NS_BEGIN(index_utils)
 
@@ -146,6 +199,130 @@ index_writer::consolidation_policy_t consolidate_fill(float fill_threshold /*= 0
   };
 }
 
+index_writer::consolidation_policy_t consolidate_tier(
+    const consolidate_tier_options& options /*= consolidate_tier_options()*/) {
+  return [options](
+    const directory& dir, const index_meta& meta
+  )->index_writer::consolidation_acceptor_t {
+    const auto min_segments = std::max(size_t(1), options.min_segments);
+    const auto max_segments = std::max(min_segments, options.max_segments);
+    const auto floor_bytes = std::max(size_t(1), options.floor_segment_bytes);
+    std::vector<segment_stat> segments;
+    size_t total_bytes = 0;
+    size_t min_segment_bytes = std::numeric_limits<size_t>::max();
+
+    segments.reserve(meta.size());
+
+    for (auto& segment: meta) {
+      segment_stat stat;
+      stat.meta = &segment.meta;
+      stat.bytes = segment_bytes(dir, segment.meta);
+      stat.live_ratio = segment.meta.docs_count
+        ? double(segment.meta.live_docs_count) / segment.meta.docs_count
+        : 0.;
+      stat.live_bytes = size_t(stat.bytes * stat.live_ratio);
+
+      // too large segments are merged only if mostly removed
+      if (stat.live_bytes > options.max_segments_bytes / 2 && stat.live_ratio > 0.5) {
+        continue;
+      }
+
+      total_bytes += stat.live_bytes;
+      min_segment_bytes = std::min(min_segment_bytes, stat.live_bytes);
+      segments.emplace_back(stat);
+    }
+
+    const bool has_removals = std::any_of(
+      segments.begin(), segments.end(),
+      [](const segment_stat& stat) { return stat.live_ratio < 0.5; }
+    );
+
+    // a single mostly removed segment is still worth rewriting
+    if (segments.empty() || (segments.size() < min_segments && !has_removals)) {
+      return [](const segment_meta&)->bool { return false; };
+    }
+
+    // the index is within the budget and there's nothing to reclaim
+    if (!has_removals
+        && segments.size() <= allowed_segments(total_bytes, min_segment_bytes, options)) {
+      return [](const segment_meta&)->bool { return false; };
+    }
+
+    // largest first, so the adjacent segments are of the similar size
+    std::sort(
+      segments.begin(), segments.end(),
+      [](const segment_stat& lhs, const segment_stat& rhs) {
+        return lhs.live_bytes > rhs.live_bytes
+          || (lhs.live_bytes == rhs.live_bytes && lhs.meta->name < rhs.meta->name);
+    });
+
+    double best_score = std::numeric_limits<double>::max();
+    size_t best_begin = 0, best_end = 0;
+
+    for (size_t begin = 0, count = segments.size(); begin < count; ++begin) {
+      size_t merged_bytes = 0;
+      size_t bytes = 0;
+      size_t floored_bytes = 0;
+      size_t end = begin;
+
+      // take the similarly sized segments while the merged segment fits
+      for (; end < count && end - begin < max_segments; ++end) {
+        auto& stat = segments[end];
+
+        if (merged_bytes + stat.live_bytes > options.max_segments_bytes) {
+          if (end == begin) {
+            merged_bytes += stat.live_bytes; // a single mostly removed segment
+            bytes += stat.bytes;
+            floored_bytes += std::max(stat.live_bytes, floor_bytes);
+            ++end;
+          }
+
+          break;
+        }
+
+        merged_bytes += stat.live_bytes;
+        bytes += stat.bytes;
+        floored_bytes += std::max(stat.live_bytes, floor_bytes);
+      }
+
+      // a mostly removed segment which can't be merged with the next one
+      // (or is the only one) is rewritten alone to reclaim the removals
+      const bool single = end - begin == 1
+        && segments[begin].live_ratio < 0.5
+        && (end == count
+            ? count == 1
+            : merged_bytes + segments[end].live_bytes > options.max_segments_bytes);
+
+      if (end - begin < min_segments && !single) {
+        continue;
+      }
+
+      // share of the largest segment, tiny segments are treated as of floor size
+      const double skew = double(std::max(segments[begin].live_bytes, floor_bytes)) / floored_bytes;
+      const double live_ratio = bytes ? double(merged_bytes) / bytes : 0.;
+      const double score = skew
+        * std::pow(double(std::max(merged_bytes, floor_bytes)), 0.05)
+        * live_ratio * live_ratio;
+
+      if (score < best_score) {
+        best_score = score;
+        best_begin = begin;
+        best_end = end;
+      }
+    }
+
+    std::unordered_set<std::string> candidates;
+
+    for (auto i = best_begin; i < best_end; ++i) {
+      candidates.emplace(segments[i].meta->name);
+    }
+
+    return [candidates](const segment_meta& meta)->bool {
+      return candidates.find(meta.name) != candidates.end();
+    };
+  };
+}
+
 void read_document_mask(
   iresearch::document_mask& docs_mask,
   const iresearch::directory& dir,
@@ -41,6 +41,36 @@ IRESEARCH_API index_writer::consolidation_policy_t consolidate_count(float docs_
 // merge segment if: {threshold} > #segment_docs{valid} / (#segment_docs{valid} + #segment_docs{removed})
 IRESEARCH_API index_writer::consolidation_policy_t consolidate_fill(float fill_threshold = 0);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief parameters of the tiered consolidation policy
+////////////////////////////////////////////////////////////////////////////////
+struct IRESEARCH_API consolidate_tier_options {
+  size_t min_segments = 2; // minimum number of segments merged at once
+  size_t max_segments = 10; // maximum number of segments merged at once (merge width)
+  size_t segments_per_tier = 10; // number of segments allowed in a tier before merging
+  size_t max_segments_bytes = size_t(5) << 30; // maximum size of the merged segment
+  size_t floor_segment_bytes = size_t(2) << 20; // smaller segments are treated as of this size
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief tiered (log-structured) consolidation policy
+///        segments are grouped into tiers of exponentially growing size
+///        ('floor_segment_bytes' * 'max_segments'^tier), the policy does
+///        nothing while every tier has at most 'segments_per_tier' segments,
+///        otherwise it merges the group of similarly sized segments having
+///        the best score:
+///        skew * merged_bytes^0.05 * live_ratio^2 (lower is better), where
+///        'skew' is the share of the largest segment in the group, so
+///        balanced merges which reclaim removed documents are preferred
+/// @note segment sizes are estimated by the number of live documents,
+///       segments whose live size exceeds half of 'max_segments_bytes' are
+///       merged only if they're dominated by removed documents, such a
+///       segment is selected alone if it can't be merged with any other
+////////////////////////////////////////////////////////////////////////////////
+IRESEARCH_API index_writer::consolidation_policy_t consolidate_tier(
+  const consolidate_tier_options& options = consolidate_tier_options()
+);
+
 void read_document_mask(
   iresearch::document_mask& docs_mask,
   const iresearch::directory& dir,
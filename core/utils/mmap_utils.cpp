@@ -25,8 +25,13 @@
 #include "mmap_utils.hpp"
 #include "utils/log.hpp"
 
+#include <algorithm>
 #include <cassert>
 
+#ifndef _MSC_VER
+  #include <unistd.h>
+#endif
+
 NS_ROOT
 NS_BEGIN(mmap_utils)
 
@@ -59,6 +64,26 @@ int flush(int fd, void* addr, size_t size, int flags) NOEXCEPT {
   return 0;
 }
 
+bool mmap_handle::prefetch(size_t offset, size_t length) NOEXCEPT {
+  #ifdef _MSC_VER
+    static const size_t page_size = 4096;
+  #else
+    static const size_t page_size = size_t(sysconf(_SC_PAGESIZE));
+  #endif
+
+  if (addr_ == MAP_FAILED || offset >= size_ || !length) {
+    return false;
+  }
+
+  // madvise requires page aligned address
+  const auto begin = offset - offset % page_size;
+  const auto end = (std::min)(size_, offset + (std::min)(length, size_ - offset));
+
+  return 0 == ::madvise(
+    static_cast<char*>(addr_) + begin, end - begin, IR_MADVICE_WILLNEED
+  );
+}
+
 void mmap_handle::close() NOEXCEPT {
   if (addr_ != MAP_FAILED) {
     if (dontneed_) {
@@ -126,6 +126,10 @@ class mmap_handle : private util::noncopyable {
     dontneed_ = value;
   }
 
+  // asks the kernel to read ahead the pages of the specified range,
+  // the range is truncated to the mapped region
+  bool prefetch(size_t offset, size_t length) NOEXCEPT;
+
  private:
   void init() NOEXCEPT;
 
@@ -182,6 +182,25 @@ uint64_t decoded64(const byte_type* in) {
   return decode<double_t>(in);
 }
 
+bool exact(const bytes_ref& value) {
+  if (value.empty()) {
+    return false;
+  }
+
+  switch (value[0]) {
+    case encode_traits<uint32_t>::TYPE_MAGIC:
+#ifndef FLOAT_T_IS_DOUBLE_T
+    case encode_traits<float_t>::TYPE_MAGIC:
+#endif
+      return value.size() == 1 + encoded_size<uint32_t>(0);
+    case encode_traits<uint64_t>::TYPE_MAGIC:
+    case encode_traits<double_t>::TYPE_MAGIC:
+      return value.size() == 1 + encoded_size<uint64_t>(0);
+    default:
+      return false;
+  }
+}
+
 const bytes_ref& mini32() {
   static bytes_ref data = encode(static_buf<int32_t, buf_id_t::MIN>(), integer_traits<int32_t>::const_min);
   return data; 
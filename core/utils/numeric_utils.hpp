@@ -98,6 +98,10 @@ IRESEARCH_API const bytes_ref& maxd64();
 IRESEARCH_API const bytes_ref& dinf64();
 IRESEARCH_API const bytes_ref& ndinf64();
 
+// returns true if the specified term is an encoded value of the highest
+// precision, i.e. the one encoded with zero shift
+IRESEARCH_API bool exact(const bytes_ref& value);
+
 template<typename T>
 struct numeric_traits;
 
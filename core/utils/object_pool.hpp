@@ -144,6 +144,10 @@ class bounded_object_pool : atomic_base<typename T::ptr> {
   // do not use std::shared_ptr to avoid unnecessary heap allocatons
   class ptr : util::noncopyable {
    public:
+    ptr() NOEXCEPT
+      : slot_(nullptr) {
+    }
+
     ptr(slot_t& slot) NOEXCEPT
       : slot_(&slot) {
     }
@@ -180,7 +184,7 @@ class bounded_object_pool : atomic_base<typename T::ptr> {
     element_type* operator->() const NOEXCEPT { return get(); }
     element_type* get() const NOEXCEPT { return slot_->ptr.get(); }
     operator bool() const NOEXCEPT {
-      return static_cast<bool>(slot_->ptr);
+      return slot_ && static_cast<bool>(slot_->ptr);
     }
 
    private:
@@ -222,6 +226,20 @@ class bounded_object_pool : atomic_base<typename T::ptr> {
     }
   }
 
+  // acquires exclusive access to the specified pooled object without waiting
+  // @return empty 'ptr' if the object is in use or not managed by the pool
+  ptr try_acquire(const element_type& obj) {
+    for (auto& slot : pool_) {
+      if (atomic_utils::atomic_load(&slot.ptr).get() != &obj) {
+        continue;
+      }
+
+      return lock(slot) ? ptr(slot) : ptr();
+    }
+
+    return ptr();
+  }
+
   size_t size() const NOEXCEPT { return pool_.size(); }
 
   template<typename Visitor>
@@ -37,6 +37,7 @@
 
 #include <boost/locale/conversion.hpp>
 #include <boost/locale/generator.hpp>
+#include <tuple>
 #include "analysis/text_token_stream.hpp"
 #include "analysis/token_attributes.hpp"
 #include "analysis/token_stream.hpp"
@@ -269,6 +270,48 @@ TEST_F(TextAnalyzerParserTestSuite, test_text_analyzer) {
   }
 }
 
+TEST_F(TextAnalyzerParserTestSuite, test_ascii_fast_path) {
+  typedef std::tuple<std::string, uint32_t, uint32_t> token_t;
+  boost::locale::generator localeGenerator;
+  std::unordered_set<std::string> stopwordSet = { "the" };
+  std::locale locale = localeGenerator.generate("en_US.UTF-8");
+  std::string data = "The U.S.A. don't_stop: e.g. 3.14, 1,000;2 __init__ _ a.1 user@example.com Foxes, FOXES; foxes!";
+  std::wstring sDataUCS2 = L" \u00E9t\u00E9"; // non-ASCII suffix, processed by ICU
+  std::string dataUtf8 = data + boost::locale::conv::utf_to_utf<char>(sDataUCS2);
+
+  auto tokenize = [&locale, &stopwordSet](const std::string& data)->std::vector<token_t> {
+    text_token_stream stream(locale, stopwordSet);
+    std::vector<token_t> tokens;
+
+    EXPECT_TRUE(stream.reset(data));
+
+    auto& offset = stream.attributes().get<iresearch::offset>();
+    auto& value = stream.attributes().get<iresearch::term_attribute>();
+
+    while (stream.next()) {
+      tokens.emplace_back(
+        std::string((char*)(value->value().c_str()), value->value().size()),
+        offset->start,
+        offset->end
+      );
+    }
+
+    return tokens;
+  };
+
+  auto ascii = tokenize(data);
+  auto utf8 = tokenize(dataUtf8);
+
+  ASSERT_FALSE(ascii.empty());
+  ASSERT_EQ(ascii.size() + 1, utf8.size());
+  ASSERT_TRUE(std::equal(ascii.begin(), ascii.end(), utf8.begin()));
+  ASSERT_EQ("ete", std::get<0>(utf8.back()));
+
+  // repeated words are served from the memo
+  ASSERT_EQ(std::get<0>(ascii[ascii.size() - 3]), std::get<0>(ascii[ascii.size() - 2]));
+  ASSERT_EQ(std::get<0>(ascii[ascii.size() - 3]), std::get<0>(ascii.back()));
+}
+
 TEST_F(TextAnalyzerParserTestSuite, test_load_stopwords) {
   boost::locale::generator localeGenerator;
   std::unordered_set<std::string> emptySet;
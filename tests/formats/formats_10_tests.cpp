@@ -23,14 +23,22 @@
 
 #include "tests_shared.hpp"
 
+#include "analysis/token_attributes.hpp"
 #include "index/field_meta.hpp"
 #include "store/memory_directory.hpp"
+#include "store/store_utils.hpp"
 #include "store/fs_directory.hpp"
+#include "store/mmap_directory.hpp"
 #include "utils/bit_packing.hpp"
+#include "utils/crc.hpp"
 #include "formats/formats_10.hpp"
+#include "formats/formats_burst_trie.hpp"
+#include "index/file_names.hpp"
 #include "formats_test_case_base.hpp"
 #include "formats/format_utils.hpp"
 
+#include <boost/crc.hpp>
+
 class format_10_test_case : public tests::format_test_case_base {
  protected:
   irs::format::ptr get_codec() {
@@ -543,6 +551,44 @@ class format_10_test_case : public tests::format_test_case_base {
           }
         }
 
+        // next by batches mixed with next
+        for (size_t batch : { size_t(1), size_t(7), size_t(irs::version10::postings_writer::BLOCK_SIZE + 3) }) {
+          auto it = reader.iterator(field.features, read_attrs, field.features);
+          ASSERT_FALSE(irs::type_limits<irs::type_t::doc_id_t>::valid(it->value()));
+
+          postings expected(docs.begin(), docs.end(), field.features);
+          std::vector<irs::doc_id_t> buf(batch);
+          auto doc = docs.begin();
+
+          while (doc != docs.end()) {
+            const auto count = it->next_batch(&buf[0], batch);
+            ASSERT_EQ(std::min(batch, size_t(std::distance(doc, docs.end()))), count);
+            ASSERT_TRUE(std::equal(buf.begin(), buf.begin() + count, doc));
+            doc += count;
+
+            if (count < batch) {
+              ASSERT_TRUE(irs::type_limits<irs::type_t::doc_id_t>::eof(it->value()));
+              break;
+            }
+
+            ASSERT_EQ(*(doc - 1), it->value());
+            ASSERT_EQ(*(doc - 1), expected.seek(*(doc - 1)));
+            assert_positions(expected, *it);
+
+            if (doc != docs.end()) {
+              ASSERT_TRUE(it->next());
+              ASSERT_EQ(*doc, it->value());
+              ASSERT_TRUE(expected.next());
+              assert_positions(expected, *it);
+              ++doc;
+            }
+          }
+
+          ASSERT_FALSE(it->next());
+          ASSERT_TRUE(irs::type_limits<irs::type_t::doc_id_t>::eof(it->value()));
+          ASSERT_EQ(0, it->next_batch(&buf[0], batch));
+        }
+
         // seek for INVALID_DOC
         {
           auto it = reader.iterator(field.features, read_attrs, irs::flags::empty_instance());
@@ -717,6 +763,295 @@ class format_10_test_case : public tests::format_test_case_base {
       postings_seek(docs, { irs::frequency::type(), irs::position::type(), irs::offset::type(), irs::payload::type() });
     }
   }
+
+  void footer_checksum() {
+    const irs::bytes_ref payload(
+      reinterpret_cast<const irs::byte_type*>("footer checksum payload"), 23
+    );
+
+    auto read_file = [this](const std::string& name) {
+      auto in = dir().open(name, irs::IOAdvice::NORMAL);
+      irs::bstring data(in->length(), 0);
+      in->read_bytes(&data[0], data.size());
+      return data;
+    };
+
+    // current format, CRC32C
+    {
+      auto out = dir().create("crc32c");
+      ASSERT_FALSE(!out);
+      irs::format_utils::write_header(*out, "footer_test", 0);
+      out->write_bytes(payload.c_str(), payload.size());
+      irs::format_utils::write_footer(*out);
+    }
+
+    {
+      const auto data = read_file("crc32c");
+      irs::crc32c crc;
+      crc.process_bytes(data.c_str(), data.size() - sizeof(uint64_t));
+
+      auto in = dir().open("crc32c", irs::IOAdvice::NORMAL);
+      ASSERT_FALSE(!in);
+      const auto checksum = irs::format_utils::checksum(*in);
+      ASSERT_EQ(int64_t(crc.checksum()), checksum);
+      ASSERT_EQ(0, irs::format_utils::check_header(*in, "footer_test", 0, 0));
+      in->seek(in->length() - irs::format_utils::FOOTER_LEN);
+      ASSERT_EQ(checksum, irs::format_utils::check_footer(*in, checksum));
+    }
+
+    // legacy format, CRC32
+    {
+      auto out = dir().create("crc32_body");
+      ASSERT_FALSE(!out);
+      irs::format_utils::write_header(*out, "footer_test", 0);
+      out->write_bytes(payload.c_str(), payload.size());
+      out->write_int(irs::format_utils::FOOTER_MAGIC);
+      out->write_int(irs::format_utils::CHECKSUM_CRC32);
+    }
+
+    const auto data = read_file("crc32_body");
+    boost::crc_32_type crc;
+    crc.process_bytes(data.c_str(), data.size());
+
+    {
+      auto out = dir().create("crc32");
+      ASSERT_FALSE(!out);
+      out->write_bytes(data.c_str(), data.size());
+      out->write_long(crc.checksum());
+    }
+
+    {
+      auto in = dir().open("crc32", irs::IOAdvice::NORMAL);
+      ASSERT_FALSE(!in);
+      const auto checksum = irs::format_utils::checksum(*in);
+      ASSERT_EQ(int64_t(crc.checksum()), checksum);
+      ASSERT_EQ(0, irs::format_utils::check_header(*in, "footer_test", 0, 0));
+      in->seek(in->length() - irs::format_utils::FOOTER_LEN);
+      ASSERT_EQ(checksum, irs::format_utils::check_footer(*in, checksum));
+    }
+  }
+
+  void columns_read_write_legacy_norms() {
+    irs::segment_meta meta("_1", nullptr);
+    meta.codec = codec();
+
+    const uint32_t lengths[] = { 2, 3, 24, 100, 1000, 123456 };
+    const irs::string_ref format_name = "iresearch_10_columnstore";
+    irs::field_id column_id;
+
+    // norms of the previous versions are written as 'zvfloat'
+    {
+      auto writer = codec()->get_columnstore_writer();
+      ASSERT_TRUE(writer->prepare(dir(), meta));
+      auto column = writer->push_column();
+      column_id = column.first;
+      irs::doc_id_t doc = irs::type_limits<irs::type_t::doc_id_t>::min();
+
+      for (auto length : lengths) {
+        irs::write_zvfloat(column.second(doc++), float_t(1. / std::sqrt(double_t(length))));
+      }
+
+      ASSERT_TRUE(writer->flush());
+    }
+
+    const auto filename = irs::file_name(meta.name, "cs");
+    const size_t version_offset = sizeof(int32_t) + 1 + format_name.size(); // magic + name
+
+    auto read_norms = [&]()->bool {
+      auto reader = codec()->get_columnstore_reader();
+      EXPECT_TRUE(reader->prepare(dir(), meta));
+      auto* column = reader->column(column_id);
+      EXPECT_NE(nullptr, column);
+      return column->quantized_norms();
+    };
+
+    ASSERT_TRUE(read_norms()); // current version
+
+    // downgrade version of the columnstore
+    {
+      irs::bstring data;
+      {
+        auto in = dir().open(filename, irs::IOAdvice::NORMAL);
+        ASSERT_FALSE(!in);
+        data.resize(in->length());
+        in->read_bytes(&data[0], data.size());
+      }
+
+      ASSERT_EQ(
+        irs::ref_cast<irs::byte_type>(format_name),
+        irs::bytes_ref(&data[sizeof(int32_t) + 1], format_name.size())
+      );
+      ASSERT_EQ(1, data[version_offset + 3]); // FORMAT_QUANTIZED_NORMS
+      std::fill_n(&data[version_offset], sizeof(int32_t), irs::byte_type(0));
+
+      auto out = dir().create(filename);
+      ASSERT_FALSE(!out);
+      out->write_bytes(data.c_str(), data.size());
+    }
+
+    ASSERT_FALSE(read_norms()); // legacy version
+
+    // legacy norms map onto the quantized lengths
+    {
+      auto reader = codec()->get_columnstore_reader();
+      ASSERT_TRUE(reader->prepare(dir(), meta));
+      auto* column = reader->column(column_id);
+      ASSERT_NE(nullptr, column);
+      auto values = column->values();
+      irs::doc_id_t doc = irs::type_limits<irs::type_t::doc_id_t>::min();
+      irs::bytes_ref value;
+
+      for (auto length : lengths) {
+        ASSERT_TRUE(values(doc++, value));
+        irs::bytes_ref_input in(value);
+        ASSERT_EQ(irs::norm::quantize(length), irs::norm::quantize_norm(irs::read_zvfloat(in)));
+      }
+    }
+  }
+
+  void fields_read_write_legacy() {
+    typedef std::set<irs::bytes_ref> sorted_terms_t;
+    sorted_terms_t sorted_terms;
+
+    tests::json_doc_generator gen(
+      resource("fst_prefixes.json"),
+      [&sorted_terms] (tests::document& doc, const std::string& name, const tests::json_doc_generator::json_value& data) {
+        doc.insert(std::make_shared<tests::templates::string_field>(
+          irs::string_ref(name),
+          data.str
+        ));
+
+        auto ref = irs::ref_cast<irs::byte_type>((doc.indexed.end() - 1).as<tests::templates::string_field>().value());
+        sorted_terms.emplace(ref);
+    });
+
+    irs::field_meta field;
+    field.name = "field";
+    field.norm = 5;
+
+    // write terms index with the legacy OpenFST layout
+    {
+      irs::flush_state state;
+      state.dir = &dir();
+      state.doc_count = 100;
+      state.fields_count = 1;
+      state.name = "segment_name";
+      state.ver = IRESEARCH_VERSION;
+      state.features = &field.features;
+
+      terms<sorted_terms_t::iterator> terms(sorted_terms.begin(), sorted_terms.end());
+
+      auto writer = irs::field_writer::make<irs::burst_trie::field_writer>(
+        irs::postings_writer::make<irs::version10::postings_writer>(false),
+        false,
+        irs::burst_trie::field_writer::DEFAULT_MIN_BLOCK_SIZE,
+        irs::burst_trie::field_writer::DEFAULT_MAX_BLOCK_SIZE,
+        irs::burst_trie::field_writer::FORMAT_MIN
+      );
+      writer->prepare(state);
+      writer->write(field.name, field.norm, field.features, terms);
+      writer->end();
+    }
+
+    const auto index_name = irs::file_name(
+      "segment_name", irs::burst_trie::field_writer::TERMS_INDEX_EXT
+    );
+
+    // check written version
+    {
+      auto in = dir().open(index_name, irs::IOAdvice::NORMAL);
+      ASSERT_FALSE(!in);
+      ASSERT_EQ(
+        int32_t(irs::burst_trie::field_writer::FORMAT_MIN),
+        irs::format_utils::check_header(
+          *in,
+          irs::burst_trie::field_writer::FORMAT_TERMS_INDEX,
+          irs::burst_trie::field_writer::FORMAT_MIN,
+          irs::burst_trie::field_writer::FORMAT_MAX
+        )
+      );
+    }
+
+    // legacy FST is converted into the compact layout on read
+    {
+      irs::segment_meta meta;
+      meta.name = "segment_name";
+
+      irs::document_mask docs_mask;
+      auto reader = codec()->get_field_reader();
+      ASSERT_TRUE(reader->prepare(dir(), meta, docs_mask));
+      ASSERT_EQ(1, reader->size());
+
+      auto term_reader = reader->field(field.name);
+      ASSERT_NE(nullptr, term_reader);
+      ASSERT_EQ(sorted_terms.size(), term_reader->size());
+      ASSERT_EQ(*sorted_terms.begin(), (term_reader->min)());
+      ASSERT_EQ(*sorted_terms.rbegin(), (term_reader->max)());
+      ASSERT_EQ(nullptr, term_reader->points());
+
+      // check terms using "next"
+      {
+        auto expected_term = sorted_terms.begin();
+        auto term = term_reader->iterator();
+        for (; term->next(); ++expected_term) {
+          ASSERT_EQ(*expected_term, term->value());
+        }
+        ASSERT_EQ(sorted_terms.end(), expected_term);
+      }
+
+      // check terms using "seek", traverses converted FST
+      {
+        auto term = term_reader->iterator();
+        for (auto& expected_term : sorted_terms) {
+          ASSERT_TRUE(term->seek(expected_term));
+          ASSERT_EQ(expected_term, term->value());
+        }
+      }
+
+      // check missing terms using "seek_ge"
+      {
+        auto term = term_reader->iterator();
+        for (auto& expected_term : sorted_terms) {
+          irs::bstring missing(expected_term.c_str(), expected_term.size());
+          missing.push_back(0);
+          auto next = sorted_terms.upper_bound(expected_term);
+
+          if (next == sorted_terms.end()) {
+            ASSERT_EQ(irs::SeekResult::END, term->seek_ge(missing));
+          } else {
+            ASSERT_EQ(irs::SeekResult::NOT_FOUND, term->seek_ge(missing));
+            ASSERT_EQ(*next, term->value());
+          }
+        }
+      }
+    }
+
+    // corruption anywhere in the terms index is detected
+    {
+      irs::bstring data;
+      {
+        auto in = dir().open(index_name, irs::IOAdvice::NORMAL);
+        ASSERT_FALSE(!in);
+        data.resize(in->length());
+        in->read_bytes(&data[0], data.size());
+      }
+
+      data[data.size() / 2] ^= 0xFF;
+
+      {
+        auto out = dir().create(index_name);
+        ASSERT_FALSE(!out);
+        out->write_bytes(data.c_str(), data.size());
+      }
+
+      irs::segment_meta meta;
+      meta.name = "segment_name";
+
+      irs::document_mask docs_mask;
+      auto reader = codec()->get_field_reader();
+      ASSERT_THROW(reader->prepare(dir(), meta, docs_mask), irs::index_error);
+    }
+  }
 }; // format_10_test_case
 
 // ----------------------------------------------------------------------------
@@ -738,6 +1073,10 @@ TEST_F(memory_format_10_test_case, fields_rw) {
   fields_read_write();
 }
 
+TEST_F(memory_format_10_test_case, fields_rw_legacy) {
+  fields_read_write_legacy();
+}
+
 TEST_F(memory_format_10_test_case, postings_rw) {
   postings_read_write_single_doc();
   postings_read_write();
@@ -758,6 +1097,11 @@ TEST_F(memory_format_10_test_case, columns_rw) {
   columns_big_document_read_write();
   columns_read_write_writer_reuse();
   columns_read_write_typed();
+  columns_read_write_cached();
+}
+
+TEST_F(memory_format_10_test_case, columns_rw_legacy_norms) {
+  columns_read_write_legacy_norms();
 }
 
 TEST_F(memory_format_10_test_case, columns_meta_rw) {
@@ -768,6 +1112,10 @@ TEST_F(memory_format_10_test_case, document_mask_rw) {
   document_mask_read_write();
 }
 
+TEST_F(memory_format_10_test_case, footer_checksum) {
+  footer_checksum();
+}
+
 // ----------------------------------------------------------------------------
 // --SECTION--                               fs_directory + iresearch_format_10
 // ----------------------------------------------------------------------------
@@ -798,6 +1146,10 @@ TEST_F(fs_format_10_test_case, fields_rw) {
   fields_read_write();
 }
 
+TEST_F(fs_format_10_test_case, fields_rw_legacy) {
+  fields_read_write_legacy();
+}
+
 TEST_F(fs_format_10_test_case, postings_seek) {
   postings_seek();
 }
@@ -818,6 +1170,11 @@ TEST_F(fs_format_10_test_case, columns_rw) {
   columns_big_document_read_write();
   columns_read_write_writer_reuse();
   columns_read_write_typed();
+  columns_read_write_cached();
+}
+
+TEST_F(fs_format_10_test_case, columns_rw_legacy_norms) {
+  columns_read_write_legacy_norms();
 }
 
 TEST_F(fs_format_10_test_case, columns_meta_rw) {
@@ -828,6 +1185,38 @@ TEST_F(fs_format_10_test_case, document_mask_rw) {
   document_mask_read_write();
 }
 
+TEST_F(fs_format_10_test_case, footer_checksum) {
+  footer_checksum();
+}
+
+// ----------------------------------------------------------------------------
+// --SECTION--                             mmap_directory + iresearch_format_10
+// ----------------------------------------------------------------------------
+
+class mmap_format_10_test_case : public format_10_test_case {
+protected:
+  virtual irs::directory* get_directory() override {
+    auto dir = test_dir();
+
+    dir /= "index";
+    dir.mkdir();
+
+    return new irs::mmap_directory(dir.utf8());
+  }
+};
+
+TEST_F(mmap_format_10_test_case, fields_rw) {
+  fields_read_write();
+}
+
+TEST_F(mmap_format_10_test_case, fields_rw_legacy) {
+  fields_read_write_legacy();
+}
+
+TEST_F(mmap_format_10_test_case, footer_checksum) {
+  footer_checksum();
+}
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                       END-OF-FILE
 // -----------------------------------------------------------------------------
\ No newline at end of file
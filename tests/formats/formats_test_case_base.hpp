@@ -837,6 +837,49 @@ class format_test_case_base : public index_test_base {
       EXPECT_EQ(true, expected.empty());
       reader->end();
     }
+
+    // dense chunks are stored as bitmaps
+    std::set<irs::doc_id_t> dense_set;
+    for (irs::doc_id_t doc = 1; doc < 2*irs::document_mask::CONTAINER_DOCS; doc += 3) {
+      dense_set.insert(doc);
+    }
+    dense_set.insert(10*irs::document_mask::CONTAINER_DOCS + 5); // sparse chunk
+    meta.version = 43;
+
+    // write document_mask
+    {
+      auto writer = codec()->get_document_mask_writer();
+
+      writer->prepare(dir(), meta);
+      writer->begin(static_cast<uint32_t>(dense_set.size()));
+
+      for (auto& mask : dense_set) {
+        writer->write(mask);
+      }
+
+      writer->end();
+    }
+
+    // read document_mask
+    {
+      auto reader = codec()->get_document_mask_reader();
+
+      EXPECT_EQ(true, reader->prepare(dir(), meta));
+
+      auto count = reader->begin();
+
+      EXPECT_EQ(dense_set.size(), count);
+
+      // documents are read in ascending order
+      for (auto expected : dense_set) {
+        iresearch::doc_id_t mask;
+
+        reader->read(mask);
+        EXPECT_EQ(expected, mask);
+      }
+
+      reader->end();
+    }
   }
 
   void columns_read_write_writer_reuse() {
@@ -2308,6 +2351,104 @@ class format_test_case_base : public index_test_base {
     }
   }
 
+  void columns_read_write_cached() {
+    const irs::doc_id_t MAX_DOCS = 100000;
+
+    irs::segment_meta segment("cached", nullptr);
+    segment.codec = codec();
+
+    irs::field_id id;
+
+    // write sparse column
+    {
+      auto writer = codec()->get_columnstore_writer();
+      writer->prepare(dir(), segment);
+
+      auto column = writer->push_column();
+      id = column.first;
+
+      for (irs::doc_id_t doc = 0; doc < MAX_DOCS; doc += 2) {
+        auto& out = column.second(doc);
+        irs::write_string(out, std::to_string(doc));
+        ++segment.docs_count;
+      }
+
+      ASSERT_TRUE(writer->flush());
+    }
+
+    // read column using a cache which is much smaller than the column
+    auto cache = irs::block_cache::make(128*1024, 1);
+
+    {
+      auto reader = codec()->get_columnstore_reader();
+      ASSERT_TRUE(reader->prepare(dir(), segment, nullptr, cache));
+
+      auto column = reader->column(id);
+      ASSERT_NE(nullptr, column);
+
+      // random access
+      {
+        auto values = column->values();
+        irs::bytes_ref actual_value;
+
+        for (size_t i = 0; i < 2; ++i) { // second pass hits evicted blocks
+          for (irs::doc_id_t doc = 0; doc < MAX_DOCS; ++doc) {
+            if (doc % 2) {
+              ASSERT_FALSE(values(doc, actual_value));
+              continue;
+            }
+
+            ASSERT_TRUE(values(doc, actual_value));
+            const auto str = std::to_string(doc);
+            ASSERT_EQ(irs::string_ref(str), irs::to_string<irs::string_ref>(actual_value.c_str()));
+          }
+        }
+      }
+
+      auto stats = cache->stats();
+      ASSERT_LT(0, stats.hits);
+      ASSERT_LT(0, stats.misses);
+      ASSERT_LT(0, stats.evictions);
+      ASSERT_LE(stats.size, cache->max_size());
+
+      // iterator
+      {
+        auto it = column->iterator();
+        ASSERT_NE(nullptr, it);
+        auto& payload = it->attributes().get<irs::payload_iterator>();
+        ASSERT_FALSE(!payload);
+
+        irs::doc_id_t expected_doc = 0;
+        for (; it->next(); expected_doc += 2) {
+          ASSERT_EQ(expected_doc, it->value());
+          ASSERT_TRUE(payload->next());
+          const auto str = std::to_string(expected_doc);
+          ASSERT_EQ(irs::string_ref(str), irs::to_string<irs::string_ref>(payload->value().c_str()));
+        }
+        ASSERT_EQ(MAX_DOCS, expected_doc);
+      }
+
+      // visit
+      {
+        irs::doc_id_t expected_doc = 0;
+        ASSERT_TRUE(column->visit([&expected_doc](irs::doc_id_t doc, const irs::bytes_ref& value) {
+          if (expected_doc != doc
+              || irs::string_ref(std::to_string(doc)) != irs::to_string<irs::string_ref>(value.c_str())) {
+            return false;
+          }
+
+          expected_doc += 2;
+          return true;
+        }));
+        ASSERT_EQ(MAX_DOCS, expected_doc);
+      }
+    }
+
+    // blocks are removed from the cache with the reader
+    ASSERT_EQ(0, cache->stats().count);
+    ASSERT_EQ(0, cache->stats().size);
+  }
+
   void columns_read_write_typed() {
     struct Value {
       enum class Type {
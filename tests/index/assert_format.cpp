@@ -290,7 +290,7 @@ void document_mask_writer::begin(uint32_t count) {
 }
 
 void document_mask_writer::write(const iresearch::doc_id_t& doc_id) {
-  EXPECT_EQ(true, data_.doc_mask().find(doc_id) != data_.doc_mask().end());
+  EXPECT_EQ(true, data_.doc_mask().contains(doc_id));
 }
 
 void document_mask_writer::end() { }
@@ -729,7 +729,15 @@ void assert_term(
     {
       auto& expected_attrs = expected_docs->attributes();
       auto& actual_attrs = actual_docs->attributes();
-      ASSERT_EQ(expected_attrs.features(), actual_attrs.features());
+
+      // frequency bounds and raw postings are optional and depend on the format
+      auto expected_features = expected_attrs.features();
+      auto actual_features = actual_attrs.features();
+      expected_features.remove<iresearch::frequency_bound>();
+      actual_features.remove<iresearch::frequency_bound>();
+      expected_features.remove<iresearch::raw_postings>();
+      actual_features.remove<iresearch::raw_postings>();
+      ASSERT_EQ(expected_features, actual_features);
 
       auto& expected_freq = expected_attrs.get<iresearch::frequency>();
       auto& actual_freq = actual_attrs.get<iresearch::frequency>();
@@ -0,0 +1,179 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2016 by EMC Corporation, All Rights Reserved
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is EMC Corporation
+///
+/// @author Andrey Abramov
+/// @author Vasiliy Nabatchikov
+////////////////////////////////////////////////////////////////////////////////
+
+
+#include "gtest/gtest.h"
+#include "index/document_mask.hpp"
+#include "utils/misc.hpp"
+
+#include <set>
+
+TEST(document_mask_tests, empty) {
+  irs::document_mask mask;
+  ASSERT_TRUE(mask.empty());
+  ASSERT_EQ(0, mask.size());
+  ASSERT_TRUE(mask.containers().empty());
+  ASSERT_EQ(mask.begin(), mask.end());
+  ASSERT_FALSE(mask.contains(0));
+  ASSERT_FALSE(mask.contains(1));
+}
+
+TEST(document_mask_tests, insert_sparse) {
+  const std::set<irs::doc_id_t> expected = {
+    1, 4, 5, 7, 10, 12, 65535, 65536, 65537, 1000000, 10000000000
+  };
+  irs::document_mask mask;
+
+  // insert in reverse order
+  for (auto it = expected.rbegin(), end = expected.rend(); it != end; ++it) {
+    ASSERT_TRUE(mask.insert(*it));
+    ASSERT_FALSE(mask.insert(*it)); // duplicate
+  }
+
+  ASSERT_FALSE(mask.empty());
+  ASSERT_EQ(expected.size(), mask.size());
+
+  for (auto& container : mask.containers()) {
+    ASSERT_FALSE(container.is_bitmap());
+  }
+
+  for (auto doc : expected) {
+    ASSERT_TRUE(mask.contains(doc));
+  }
+
+  ASSERT_FALSE(mask.contains(2));
+  ASSERT_FALSE(mask.contains(65538));
+
+  // iteration is ordered
+  ASSERT_TRUE(std::equal(expected.begin(), expected.end(), mask.begin()));
+  ASSERT_EQ(expected.size(), std::distance(mask.begin(), mask.end()));
+}
+
+TEST(document_mask_tests, insert_dense) {
+  irs::document_mask mask;
+  std::set<irs::doc_id_t> expected;
+
+  // every other document of the 2 chunks
+  for (irs::doc_id_t doc = 1; doc < 2*irs::document_mask::CONTAINER_DOCS; doc += 2) {
+    ASSERT_TRUE(mask.insert(doc));
+    expected.insert(doc);
+  }
+
+  ASSERT_EQ(expected.size(), mask.size());
+  ASSERT_EQ(2, mask.containers().size());
+
+  for (auto& container : mask.containers()) {
+    ASSERT_TRUE(container.is_bitmap());
+    ASSERT_EQ(irs::document_mask::CONTAINER_DOCS / 2, container.size());
+  }
+
+  for (irs::doc_id_t doc = 0; doc < 2*irs::document_mask::CONTAINER_DOCS; ++doc) {
+    ASSERT_EQ(0 != (doc & 1), mask.contains(doc));
+  }
+
+  ASSERT_FALSE(mask.insert(3)); // duplicate
+  ASSERT_EQ(expected.size(), mask.size());
+  ASSERT_TRUE(std::equal(expected.begin(), expected.end(), mask.begin()));
+  ASSERT_EQ(expected.size(), std::distance(mask.begin(), mask.end()));
+}
+
+TEST(document_mask_tests, array_to_bitmap) {
+  irs::document_mask mask;
+
+  for (irs::doc_id_t doc = 0; doc < irs::document_mask::ARRAY_MAX; ++doc) {
+    ASSERT_TRUE(mask.insert(doc));
+  }
+
+  ASSERT_EQ(1, mask.containers().size());
+  ASSERT_FALSE(mask.containers().front().is_bitmap());
+
+  // array is full, next insertion converts container to bitmap
+  ASSERT_TRUE(mask.insert(irs::document_mask::ARRAY_MAX));
+  ASSERT_TRUE(mask.containers().front().is_bitmap());
+  ASSERT_EQ(irs::document_mask::ARRAY_MAX + 1, mask.size());
+
+  irs::doc_id_t expected = 0;
+  for (auto doc : mask) {
+    ASSERT_EQ(expected++, doc);
+  }
+  ASSERT_EQ(irs::document_mask::ARRAY_MAX + 1, expected);
+}
+
+TEST(document_mask_tests, reserve) {
+  irs::document_mask mask;
+
+  mask.reserve(42);
+  ASSERT_TRUE(mask.empty());
+  ASSERT_EQ(mask.begin(), mask.end()); // empty container is skipped
+  ASSERT_FALSE(mask.contains(42));
+
+  ASSERT_TRUE(mask.insert(42));
+  ASSERT_EQ(1, mask.size());
+  ASSERT_EQ(42, *mask.begin());
+}
+
+TEST(document_mask_tests, push_back) {
+  irs::document_mask mask;
+
+  mask.push_back(irs::document_mask::container(0, std::vector<uint16_t>{ 1, 3 }));
+
+  std::vector<irs::document_mask::word_t> bitmap(irs::document_mask::BITMAP_WORDS);
+  bitmap[0] = 1; // 1 << 16
+  bitmap.back() = irs::document_mask::word_t(1) << 63; // (2 << 16) - 1
+  mask.push_back(irs::document_mask::container(1, std::move(bitmap)));
+
+  const irs::doc_id_t expected[] = { 1, 3, 65536, 131071 };
+
+  ASSERT_EQ(IRESEARCH_COUNTOF(expected), mask.size());
+  ASSERT_TRUE(std::equal(std::begin(expected), std::end(expected), mask.begin()));
+
+  for (auto doc : expected) {
+    ASSERT_TRUE(mask.contains(doc));
+  }
+
+  irs::document_mask other;
+  for (auto doc : expected) {
+    other.insert(doc);
+  }
+  ASSERT_EQ(mask, other);
+
+  other.insert(2);
+  ASSERT_NE(mask, other);
+}
+
+TEST(document_mask_tests, move_copy) {
+  irs::document_mask mask;
+  mask.insert(1);
+  mask.insert(100000);
+
+  irs::document_mask copy(mask);
+  ASSERT_EQ(mask, copy);
+
+  irs::document_mask moved(std::move(mask));
+  ASSERT_EQ(copy, moved);
+  ASSERT_TRUE(mask.empty());
+
+  mask = std::move(moved);
+  ASSERT_EQ(copy, mask);
+  ASSERT_TRUE(moved.empty());
+}
@@ -8244,6 +8244,315 @@ TEST_F(memory_index_test, concurrent_add_remove_mt) {
   }
 }
 
+TEST_F(memory_index_test, concurrent_flush_mt) {
+  tests::json_doc_generator gen(
+    resource("simple_sequential.json"),
+    [] (tests::document& doc, const std::string& name, const tests::json_doc_generator::json_value& data) {
+    if (data.is_string()) {
+      doc.insert(std::make_shared<tests::templates::string_field>(
+        irs::string_ref(name),
+        data.str
+      ));
+    }
+  });
+  std::vector<const tests::document*> docs;
+
+  for (const tests::document* doc; (doc = gen.next()) != nullptr; docs.emplace_back(doc)) {}
+
+  const size_t thread_count = 4;
+  irs::async_utils::thread_pool pool(thread_count, thread_count);
+  auto query_doc1 = iresearch::iql::query_builder().build("name==A", std::locale::classic());
+  auto writer = irs::index_writer::make(dir(), codec(), irs::OM_CREATE, &pool);
+
+  {
+    std::atomic<size_t> active(0);
+    std::vector<std::thread> threads;
+
+    for (size_t t = 0; t < thread_count; ++t) {
+      threads.emplace_back([&writer, &docs, &active, t, thread_count]()->void {
+        size_t i = t;
+
+        writer->insert([&](irs::segment_writer::document& doc)->bool {
+          if (i == t) {
+            // wait for the other threads, so each thread gets its own segment writer
+            ++active;
+            while (active.load() < thread_count) {
+              std::this_thread::yield();
+            }
+          }
+
+          auto& src = *docs[i];
+          doc.insert(irs::action::index, src.indexed.begin(), src.indexed.end());
+          doc.insert(irs::action::store, src.stored.begin(), src.stored.end());
+          i += thread_count;
+
+          return i < docs.size();
+        });
+      });
+    }
+
+    for (auto& thread : threads) {
+      thread.join();
+    }
+  }
+
+  writer->remove(std::move(query_doc1.filter));
+  writer->commit();
+
+  auto reader = iresearch::directory_reader::open(dir(), codec());
+  ASSERT_EQ(thread_count, reader.size()); // segments are flushed concurrently
+  ASSERT_EQ(docs.size(), reader.docs_count());
+  ASSERT_EQ(docs.size() - 1, reader.live_docs_count());
+
+  std::unordered_set<std::string> expected;
+
+  for (auto* doc : docs) {
+    auto* field = doc->stored.get<tests::templates::string_field>("name");
+    ASSERT_NE(nullptr, field);
+
+    if (field->value() != "A") {
+      expected.emplace(field->value());
+    }
+  }
+
+  irs::bytes_ref actual_value;
+
+  for (auto& segment : reader) {
+    const auto* column = segment.column_reader("name");
+    ASSERT_NE(nullptr, column);
+    auto values = column->values();
+
+    for (auto docs_itr = segment.docs_iterator(); docs_itr->next();) {
+      ASSERT_TRUE(values(docs_itr->value(), actual_value));
+      ASSERT_EQ(1, expected.erase(irs::to_string<irs::string_ref>(actual_value.c_str())));
+    }
+  }
+
+  ASSERT_TRUE(expected.empty());
+}
+
+TEST_F(memory_index_test, memory_limit_flush) {
+  tests::json_doc_generator gen(
+    resource("simple_sequential.json"),
+    [] (tests::document& doc, const std::string& name, const tests::json_doc_generator::json_value& data) {
+    if (data.is_string()) {
+      doc.insert(std::make_shared<tests::templates::string_field>(
+        irs::string_ref(name),
+        data.str
+      ));
+    }
+  });
+  std::vector<const tests::document*> docs;
+
+  for (const tests::document* doc; (doc = gen.next()) != nullptr; docs.emplace_back(doc)) {}
+
+  auto query_doc1 = iresearch::iql::query_builder().build("name==A", std::locale::classic());
+  auto query_doc2 = iresearch::iql::query_builder().build("name==B", std::locale::classic());
+  auto writer = open_writer();
+
+  ASSERT_EQ(0, writer->memory_limit());
+  writer->memory_limit(1); // flush after every document
+  ASSERT_EQ(1, writer->memory_limit());
+
+  for (size_t i = 0, count = docs.size() - 1; i < count; ++i) {
+    auto& doc = docs[i];
+    ASSERT_TRUE(insert(*writer,
+      doc->indexed.begin(), doc->indexed.end(),
+      doc->stored.begin(), doc->stored.end()
+    ));
+    ASSERT_EQ(0, writer->buffered_docs()); // flushed into a segment
+  }
+
+  // modifications are applied to the flushed segments during commit
+  auto& last = docs.back();
+  ASSERT_TRUE(update(*writer,
+    std::move(query_doc1.filter),
+    last->indexed.begin(), last->indexed.end(),
+    last->stored.begin(), last->stored.end()
+  ));
+  writer->remove(std::move(query_doc2.filter));
+  writer->commit();
+
+  auto reader = iresearch::directory_reader::open(dir(), codec());
+  ASSERT_EQ(docs.size() - 2, reader.size()); // fully masked segments are removed
+  ASSERT_EQ(docs.size() - 2, reader.live_docs_count());
+
+  std::unordered_set<std::string> expected;
+
+  for (auto* doc : docs) {
+    auto* field = doc->stored.get<tests::templates::string_field>("name");
+    ASSERT_NE(nullptr, field);
+
+    if (field->value() != "A" && field->value() != "B") {
+      expected.emplace(field->value());
+    }
+  }
+
+  irs::bytes_ref actual_value;
+
+  for (auto& segment : reader) {
+    ASSERT_EQ(1, segment.docs_count());
+    const auto* column = segment.column_reader("name");
+    ASSERT_NE(nullptr, column);
+    auto values = column->values();
+
+    for (auto docs_itr = segment.docs_iterator(); docs_itr->next();) {
+      ASSERT_TRUE(values(docs_itr->value(), actual_value));
+      ASSERT_EQ(1, expected.erase(irs::to_string<irs::string_ref>(actual_value.c_str())));
+    }
+  }
+
+  ASSERT_TRUE(expected.empty());
+}
+
+TEST_F(memory_index_test, memory_limit_flush_idle_writer_mt) {
+  tests::json_doc_generator gen(resource("simple_sequential.json"), &tests::generic_json_field_factory);
+  std::vector<const tests::document*> docs;
+
+  for (const tests::document* doc; (doc = gen.next()) != nullptr; docs.emplace_back(doc)) {}
+
+  ASSERT_LT(4, docs.size());
+
+  auto writer = open_writer();
+  std::condition_variable cond;
+  std::mutex mutex;
+  bool acquired = false;
+  bool resume = false;
+  size_t inserted = 0;
+
+  // keeps its writer in use while the other writer is being filled
+  std::thread thread([&]()->void {
+    writer->insert([&](irs::segment_writer::document& doc)->bool {
+      auto* src = docs[inserted];
+
+      if (inserted++) {
+        SCOPED_LOCK_NAMED(mutex, lock);
+        acquired = true;
+        cond.notify_all();
+        cond.wait(lock, [&resume]()->bool { return resume; });
+      }
+
+      doc.insert(irs::action::index, src->indexed.begin(), src->indexed.end());
+      doc.insert(irs::action::store, src->stored.begin(), src->stored.end());
+
+      return 1 == inserted;
+    });
+  });
+  auto release = [&]()->void {
+    {
+      SCOPED_LOCK(mutex);
+      resume = true;
+      cond.notify_all();
+    }
+
+    if (thread.joinable()) {
+      thread.join();
+    }
+  };
+  auto finally = irs::make_finally([&release]()->void { release(); }); // on assertion failure
+
+  {
+    SCOPED_LOCK_NAMED(mutex, lock);
+    cond.wait(lock, [&acquired]()->bool { return acquired; });
+  }
+
+  // fill the largest writer, which becomes idle afterwards
+  for (size_t i = 2, count = docs.size(); i < count; ++i) {
+    auto& doc = docs[i];
+    ASSERT_TRUE(insert(*writer,
+      doc->indexed.begin(), doc->indexed.end(),
+      doc->stored.begin(), doc->stored.end()
+    ));
+  }
+
+  ASSERT_EQ(docs.size(), writer->buffered_docs()); // including the pending document
+  writer->memory_limit(1);
+  release();
+
+  // the largest idle writer is flushed by the thread exceeding the limit
+  ASSERT_EQ(2, writer->buffered_docs());
+
+  writer->commit();
+
+  auto reader = iresearch::directory_reader::open(dir(), codec());
+  ASSERT_EQ(2, reader.size());
+  ASSERT_EQ(docs.size(), reader.docs_count());
+  ASSERT_TRUE(
+    docs.size() - 2 == reader[0].docs_count()
+    || docs.size() - 2 == reader[1].docs_count()
+  );
+}
+
+TEST_F(memory_index_test, concurrent_consolidation_mt) {
+  tests::json_doc_generator gen(resource("simple_sequential.json"), &tests::generic_json_field_factory);
+  const size_t segment_count = 4;
+  auto writer = open_writer();
+
+  for (size_t i = 0; i < segment_count; ++i) {
+    auto* doc = gen.next();
+    ASSERT_NE(nullptr, doc);
+    ASSERT_TRUE(insert(*writer,
+      doc->indexed.begin(), doc->indexed.end(),
+      doc->stored.begin(), doc->stored.end()
+    ));
+    writer->commit();
+  }
+
+  // merges 2 segments starting from the specified position in the index meta
+  auto make_policy = [](size_t first)->irs::index_writer::consolidation_policy_t {
+    return [first](const irs::directory&, const irs::index_meta& meta)->irs::index_writer::consolidation_acceptor_t {
+      std::set<std::string> names;
+      size_t i = 0;
+
+      for (auto& segment : meta) {
+        if (i >= first && i < first + 2) {
+          names.emplace(segment.meta.name);
+        }
+
+        ++i;
+      }
+
+      return [names](const irs::segment_meta& meta)->bool {
+        return names.find(meta.name) != names.end();
+      };
+    };
+  };
+
+  // independent candidates are consolidated concurrently
+  {
+    irs::async_utils::thread_pool pool(2, 2);
+
+    for (size_t first = 0; first < segment_count; first += 2) {
+      auto policy = make_policy(first);
+
+      pool.run([&writer, policy]()->void {
+        writer->consolidate(policy, true);
+      });
+    }
+
+    pool.stop();
+  }
+
+  writer->commit();
+
+  auto reader = iresearch::directory_reader::open(dir(), codec());
+  ASSERT_EQ(segment_count / 2, reader.size());
+  ASSERT_EQ(segment_count, reader.docs_count());
+
+  for (auto& segment : reader) {
+    ASSERT_EQ(2, segment.docs_count());
+  }
+
+  // already consolidated segments are skipped by the pending consolidation
+  writer->consolidate(make_policy(0), true);
+  writer->consolidate(make_policy(0), true);
+  writer->commit();
+
+  reader = iresearch::directory_reader::open(dir(), codec());
+  ASSERT_EQ(1, reader.size());
+  ASSERT_EQ(segment_count, reader.docs_count());
+}
+
 TEST_F(memory_index_test, doc_removal) {
   tests::json_doc_generator gen(
     resource("simple_sequential.json"),
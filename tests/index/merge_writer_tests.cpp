@@ -27,6 +27,7 @@
 #include "store/memory_directory.hpp"
 #include "utils/type_limits.hpp"
 #include "index/merge_writer.hpp"
+#include "search/term_filter.hpp"
 
 namespace tests {
   class merge_writer_tests: public ::testing::Test {
@@ -68,11 +69,13 @@ namespace tests {
         auto& attrs = docs_itr->attributes();
 
         ASSERT_EQ(1, itr->second.erase(docs_itr->value()));
-        ASSERT_EQ(1 + (frequency ? 1 : 0) + (position ? 1 : 0), attrs.size());
+        ASSERT_EQ(2 + (frequency ? 2 : 0) + (position ? 1 : 0), attrs.size()); // frequency comes with its bounds
         ASSERT_TRUE(attrs.contains(iresearch::document::type()));
+        ASSERT_TRUE(attrs.contains(iresearch::raw_postings::type()));
 
         if (frequency) {
           ASSERT_TRUE(attrs.contains(iresearch::frequency::type()));
+          ASSERT_TRUE(attrs.contains(iresearch::frequency_bound::type()));
           ASSERT_EQ(*frequency, attrs.get<iresearch::frequency>()->value);
         }
 
@@ -1110,8 +1113,11 @@ TEST_F(merge_writer_tests, test_merge_writer) {
       };
 
       auto reader = [&expected_values] (iresearch::doc_id_t doc, const irs::bytes_ref& value) {
-        irs::bytes_ref_input in(value);
-        const auto actual_value = iresearch::read_zvfloat(in); // read norm value
+        if (1 != value.size()) {
+          return false; // norms are stored as quantized field lengths
+        }
+
+        const auto actual_value = irs::norm::dequantize(value[0]); // read norm value
 
         auto it = expected_values.find(actual_value);
         if (it == expected_values.end()) {
@@ -1474,8 +1480,11 @@ TEST_F(merge_writer_tests, test_merge_writer) {
       };
 
       auto reader = [&expected_values] (iresearch::doc_id_t doc, const irs::bytes_ref& value) {
-        irs::bytes_ref_input in(value);
-        const auto actual_value = iresearch::read_zvfloat(in); // read norm value
+        if (1 != value.size()) {
+          return false; // norms are stored as quantized field lengths
+        }
+
+        const auto actual_value = irs::norm::dequantize(value[0]); // read norm value
 
         auto it = expected_values.find(actual_value);
         if (it == expected_values.end()) {
@@ -1826,8 +1835,11 @@ TEST_F(merge_writer_tests, test_merge_writer) {
     };
 
     auto reader = [&expected_values] (iresearch::doc_id_t doc, const irs::bytes_ref& value) {
-      irs::bytes_ref_input in(value);
-      const auto actual_value = iresearch::read_zvfloat(in); // read norm value
+      if (1 != value.size()) {
+        return false; // norms are stored as quantized field lengths
+      }
+
+      const auto actual_value = irs::norm::dequantize(value[0]); // read norm value
 
       auto it = expected_values.find(actual_value);
       if (it == expected_values.end()) {
@@ -2173,6 +2185,334 @@ TEST_F(merge_writer_tests, test_merge_writer) {
   ASSERT_TRUE(expected_string.empty());
 }
 
+TEST_F(merge_writer_tests, test_merge_writer_masked_unmasked) {
+  typedef std::vector<std::tuple<irs::doc_id_t, uint64_t, std::vector<std::pair<uint32_t, uint32_t>>>> postings_t;
+  typedef std::map<std::string, std::map<irs::bstring, postings_t>> fields_t;
+  const irs::flags OFFS_FIELD_FEATURES{ irs::offset::type() };
+
+  irs::version10::format codec;
+  irs::format::ptr codec_ptr(&codec, [](irs::format*)->void{});
+  irs::memory_directory dir;
+
+  // postings of the terms found only in segment 0 or 2 (no deletions) are
+  // copied, those with more than a block of documents only from segment 0
+  // (doc_ids unchanged), 'doc_offs' terms span blocks of positions and offsets
+  auto make_doc = [&OFFS_FIELD_FEATURES](const std::string& prefix, size_t i) {
+    tests::document doc;
+    doc.insert(std::make_shared<tests::templates::string_field>(
+      "doc_id", prefix + std::to_string(i)
+    ));
+    doc.insert(std::make_shared<tests::templates::string_field>(
+      "doc_group", prefix + std::to_string(i % 3)
+    ), true, false);
+    doc.insert(std::make_shared<tests::templates::string_field>(
+      "doc_common", prefix + "_common"
+    ), true, false);
+
+    for (size_t j = 0, count = 1 + i % 3; j < count; ++j) {
+      doc.insert(std::make_shared<tests::templates::string_field>(
+        "doc_offs", prefix + "_offs" + std::to_string(i % 2), OFFS_FIELD_FEATURES
+      ), true, false);
+      doc.insert(std::make_shared<tests::templates::string_field>(
+        "doc_common", "common"
+      ), true, false);
+    }
+
+    return doc;
+  };
+
+  // populate directory
+  {
+    irs::by_term query;
+    query.field("doc_id").term("b3");
+
+    auto writer = irs::index_writer::make(dir, codec_ptr, irs::OM_CREATE);
+
+    for (size_t i = 0; i < 300; ++i) {
+      auto doc = make_doc("a", i);
+      ASSERT_TRUE(insert(*writer, doc.indexed.begin(), doc.indexed.end(), doc.stored.begin(), doc.stored.end()));
+    }
+    writer->commit();
+
+    for (size_t i = 0; i < 10; ++i) {
+      auto doc = make_doc("b", i);
+      ASSERT_TRUE(insert(*writer, doc.indexed.begin(), doc.indexed.end(), doc.stored.begin(), doc.stored.end()));
+    }
+    writer->commit();
+
+    for (size_t i = 0; i < 200; ++i) {
+      auto doc = make_doc("c", i);
+      ASSERT_TRUE(insert(*writer, doc.indexed.begin(), doc.indexed.end(), doc.stored.begin(), doc.stored.end()));
+    }
+    writer->commit();
+
+    writer->remove(query);
+    writer->commit();
+    writer->close();
+  }
+
+  // collects postings of the live documents remapping doc_ids with 'doc_map'
+  auto collect = [](
+      fields_t& fields,
+      const irs::sub_reader& segment,
+      const std::map<irs::doc_id_t, irs::doc_id_t>& doc_map) {
+    for (auto field_itr = segment.fields(); field_itr->next();) {
+      auto& field = field_itr->value();
+      auto& terms = fields[field.meta().name];
+
+      for (auto term_itr = field.iterator(); term_itr->next();) {
+        postings_t postings;
+        auto docs_itr = segment.mask(term_itr->postings(field.meta().features));
+        auto& freq = docs_itr->attributes().get<irs::frequency>();
+        auto& pos = docs_itr->attributes().get<irs::position>();
+
+        while (docs_itr->next()) {
+          auto doc_map_itr = doc_map.find(docs_itr->value());
+          ASSERT_NE(doc_map.end(), doc_map_itr);
+          std::vector<std::pair<uint32_t, uint32_t>> positions;
+          auto& offs = pos->attributes().get<irs::offset>();
+
+          while (pos->next()) {
+            positions.emplace_back(pos->value(), offs ? offs->end : 0);
+          }
+
+          postings.emplace_back(doc_map_itr->second, freq->value, std::move(positions));
+        }
+
+        if (!postings.empty()) {
+          auto& term_postings = terms[irs::bstring(term_itr->value())];
+          term_postings.insert(term_postings.end(), postings.begin(), postings.end());
+        }
+      }
+    }
+  };
+
+  auto reader = irs::directory_reader::open(dir, codec_ptr);
+  ASSERT_EQ(3, reader.size());
+  ASSERT_EQ(300, reader[0].live_docs_count());
+  ASSERT_EQ(9, reader[1].live_docs_count());
+  ASSERT_EQ(200, reader[2].live_docs_count());
+
+  fields_t expected_fields;
+  std::vector<std::string> expected_values;
+  irs::merge_writer writer(dir, "merged");
+
+  for (auto& segment : reader) {
+    std::map<irs::doc_id_t, irs::doc_id_t> doc_map;
+
+    for (auto docs_itr = segment.docs_iterator(); docs_itr->next();) {
+      doc_map.emplace(
+        docs_itr->value(),
+        irs::doc_id_t(irs::type_limits<irs::type_t::doc_id_t>::min() + expected_values.size())
+      );
+
+      irs::bytes_ref value;
+      auto* column = segment.column_reader("doc_id");
+      ASSERT_NE(nullptr, column);
+      auto values = column->values();
+      ASSERT_TRUE(values(docs_itr->value(), value));
+      irs::bytes_ref_input in(value);
+      expected_values.emplace_back(irs::read_string<std::string>(in));
+    }
+
+    collect(expected_fields, segment, doc_map);
+    writer.add(segment);
+  }
+
+  ASSERT_EQ(509, expected_values.size());
+  ASSERT_EQ("b4", expected_values[303]);
+
+  std::string filename;
+  irs::segment_meta meta;
+
+  meta.codec = codec_ptr;
+  ASSERT_TRUE(writer.flush(filename, meta));
+
+  auto segment = irs::segment_reader::open(dir, meta);
+  ASSERT_EQ(expected_values.size(), segment.docs_count());
+  ASSERT_EQ(expected_values.size(), segment.live_docs_count());
+
+  // check postings
+  {
+    std::map<irs::doc_id_t, irs::doc_id_t> doc_map;
+
+    for (auto docs_itr = segment.docs_iterator(); docs_itr->next();) {
+      doc_map.emplace(docs_itr->value(), docs_itr->value());
+    }
+
+    fields_t actual_fields;
+    collect(actual_fields, segment, doc_map);
+    ASSERT_EQ(expected_fields.size(), actual_fields.size());
+
+    for (auto& expected_field : expected_fields) {
+      auto& actual_terms = actual_fields[expected_field.first];
+      ASSERT_EQ(expected_field.second.size(), actual_terms.size());
+
+      for (auto& expected_term : expected_field.second) {
+        auto& actual_postings = actual_terms[expected_term.first];
+        SCOPED_TRACE(expected_field.first + ":" + irs::ref_cast<char>(irs::bytes_ref(expected_term.first)).c_str());
+        ASSERT_EQ(expected_term.second, actual_postings);
+      }
+    }
+    ASSERT_EQ(300 + 9 + 200, actual_fields["doc_common"][irs::ref_cast<irs::byte_type>(irs::string_ref("common"))].size());
+
+    // seek over the skip list of the copied postings
+    auto* field = segment.field("doc_common");
+    ASSERT_NE(nullptr, field);
+    auto term_itr = field->iterator();
+    ASSERT_TRUE(term_itr->seek(irs::ref_cast<irs::byte_type>(irs::string_ref("a_common"))));
+    auto docs_itr = term_itr->postings(field->meta().features);
+    ASSERT_EQ(irs::type_limits<irs::type_t::doc_id_t>::min() + 257, docs_itr->seek(irs::type_limits<irs::type_t::doc_id_t>::min() + 257));
+    ASSERT_FALSE(irs::type_limits<irs::type_t::doc_id_t>::eof(docs_itr->seek(irs::type_limits<irs::type_t::doc_id_t>::min() + 299)));
+    ASSERT_FALSE(docs_itr->next());
+  }
+
+  // check stored values
+  {
+    auto* column = segment.column_reader("doc_id");
+    ASSERT_NE(nullptr, column);
+    auto values = column->values();
+    irs::bytes_ref value;
+
+    for (size_t i = 0; i < expected_values.size(); ++i) {
+      ASSERT_TRUE(values(irs::doc_id_t(irs::type_limits<irs::type_t::doc_id_t>::min() + i), value));
+      irs::bytes_ref_input in(value);
+      ASSERT_EQ(expected_values[i], irs::read_string<std::string>(in));
+    }
+  }
+}
+
+TEST_F(merge_writer_tests, test_merge_writer_block_size_postings) {
+  typedef std::vector<std::tuple<irs::doc_id_t, uint64_t, std::vector<uint32_t>>> postings_t;
+  typedef std::map<irs::bstring, postings_t> terms_t;
+
+  const size_t block_size = irs::version10::postings_writer::BLOCK_SIZE;
+  irs::version10::format codec;
+  irs::format::ptr codec_ptr(&codec, [](irs::format*)->void{});
+  irs::memory_directory dir;
+
+  // terms with exactly a block of documents are written as a single packed
+  // block, they are copied from segment 0 (doc_ids unchanged) and re-encoded
+  // from segment 2, terms with a document less are variable length encoded
+  auto make_doc = [](const std::string& prefix, size_t i) {
+    tests::document doc;
+    doc.insert(std::make_shared<tests::templates::string_field>(
+      "doc_id", prefix + std::to_string(i)
+    ));
+
+    for (size_t j = 0, count = 1 + i % 3; j < count; ++j) {
+      doc.insert(std::make_shared<tests::templates::string_field>(
+        "doc_common", prefix + "_block"
+      ), true, false);
+    }
+
+    if (i + 1 < irs::version10::postings_writer::BLOCK_SIZE) {
+      doc.insert(std::make_shared<tests::templates::string_field>(
+        "doc_common", prefix + "_tail"
+      ), true, false);
+    }
+
+    return doc;
+  };
+
+  // populate directory
+  {
+    irs::by_term query;
+    query.field("doc_id").term("b3");
+
+    auto writer = irs::index_writer::make(dir, codec_ptr, irs::OM_CREATE);
+
+    for (auto& prefix: { "a", "b", "c" }) {
+      const size_t count = std::string("b") == prefix
+        ? 10 : block_size;
+
+      for (size_t i = 0; i < count; ++i) {
+        auto doc = make_doc(prefix, i);
+        ASSERT_TRUE(insert(*writer, doc.indexed.begin(), doc.indexed.end(), doc.stored.begin(), doc.stored.end()));
+      }
+
+      writer->commit();
+    }
+
+    writer->remove(query);
+    writer->commit();
+    writer->close();
+  }
+
+  // collects postings of the live documents in 'field' renumbering doc_ids
+  auto collect = [](terms_t& terms, const irs::sub_reader& segment, irs::doc_id_t base) {
+    std::map<irs::doc_id_t, irs::doc_id_t> doc_map;
+
+    for (auto docs_itr = segment.docs_iterator(); docs_itr->next();) {
+      doc_map.emplace(docs_itr->value(), irs::doc_id_t(base + doc_map.size()));
+    }
+
+    auto* field = segment.field("doc_common");
+    ASSERT_NE(nullptr, field);
+
+    for (auto term_itr = field->iterator(); term_itr->next();) {
+      auto docs_itr = segment.mask(term_itr->postings(field->meta().features));
+      auto& freq = docs_itr->attributes().get<irs::frequency>();
+      auto& pos = docs_itr->attributes().get<irs::position>();
+      auto& postings = terms[irs::bstring(term_itr->value())];
+
+      while (docs_itr->next()) {
+        std::vector<uint32_t> positions;
+
+        while (pos->next()) {
+          positions.emplace_back(pos->value());
+        }
+
+        postings.emplace_back(doc_map[docs_itr->value()], freq->value, std::move(positions));
+      }
+    }
+  };
+
+  auto reader = irs::directory_reader::open(dir, codec_ptr);
+  ASSERT_EQ(3, reader.size());
+
+  terms_t expected_terms;
+  irs::doc_id_t base = irs::type_limits<irs::type_t::doc_id_t>::min();
+  irs::merge_writer writer(dir, "merged");
+
+  for (auto& segment : reader) {
+    collect(expected_terms, segment, base);
+    base += irs::doc_id_t(segment.live_docs_count());
+    writer.add(segment);
+  }
+
+  ASSERT_EQ(6, expected_terms.size());
+  ASSERT_EQ(block_size, expected_terms[irs::ref_cast<irs::byte_type>(irs::string_ref("a_block"))].size());
+  ASSERT_EQ(block_size, expected_terms[irs::ref_cast<irs::byte_type>(irs::string_ref("c_block"))].size());
+
+  std::string filename;
+  irs::segment_meta meta;
+
+  meta.codec = codec_ptr;
+  ASSERT_TRUE(writer.flush(filename, meta));
+
+  auto segment = irs::segment_reader::open(dir, meta);
+  ASSERT_EQ(2*block_size + 9, segment.live_docs_count());
+
+  terms_t actual_terms;
+  collect(actual_terms, segment, irs::type_limits<irs::type_t::doc_id_t>::min());
+  ASSERT_EQ(expected_terms, actual_terms);
+
+  // seek within the packed block
+  auto* field = segment.field("doc_common");
+  ASSERT_NE(nullptr, field);
+
+  for (auto& term: { "a_block", "c_block" }) {
+    auto& expected = expected_terms[irs::ref_cast<irs::byte_type>(irs::string_ref(term))];
+    auto term_itr = field->iterator();
+    ASSERT_TRUE(term_itr->seek(irs::ref_cast<irs::byte_type>(irs::string_ref(term))));
+    auto docs_itr = term_itr->postings(field->meta().features);
+    ASSERT_EQ(std::get<0>(expected[100]), docs_itr->seek(std::get<0>(expected[100])));
+    ASSERT_EQ(std::get<0>(expected.back()), docs_itr->seek(std::get<0>(expected.back())));
+    ASSERT_FALSE(docs_itr->next());
+  }
+}
+
 TEST_F(merge_writer_tests, test_merge_writer_field_features) {
   //iresearch::flags STRING_FIELD_FEATURES{ iresearch::frequency::type(), iresearch::position::type() };
   //iresearch::flags TEXT_FIELD_FEATURES{ iresearch::frequency::type(), iresearch::position::type(), iresearch::offset::type(), iresearch::payload::type() };
@@ -180,3 +180,41 @@ TEST(postings_tests, slice_alignment) {
     ASSERT_EQ(tests::detail::to_bytes_ref("string1"), bh.begin()->first);
   }
 }
+
+TEST(postings_tests, sort) {
+  const uint32_t block_size = 32768;
+  block_pool<byte_type, block_size> pool;
+  block_pool<byte_type, block_size>::inserter writer(pool.begin());
+  postings bh(writer);
+
+  // terms sharing long prefixes, terms being prefixes of each other
+  // and bytes above 0x7F to exercise both radix and comparison sort paths
+  std::vector<std::string> data;
+  for (size_t i = 0; i < 1000; ++i) {
+    data.emplace_back(std::to_string(i * 7919 % 1000));
+    data.emplace_back(std::string(i % 50, 'a') + std::to_string(i));
+    data.emplace_back(std::string(1, char(0x80 + i % 64)) + std::to_string(i % 40));
+  }
+  data.emplace_back("");
+
+  std::set<std::string> expected;
+  for (auto& s : data) {
+    bh.emplace(tests::detail::to_bytes_ref(s));
+    expected.emplace(s);
+  }
+  ASSERT_EQ(expected.size(), bh.size());
+
+  std::vector<const postings::value_type*> sorted;
+  bh.sort(sorted);
+  ASSERT_EQ(expected.size(), sorted.size());
+
+  auto it = sorted.begin();
+  for (auto& s : expected) {
+    ASSERT_EQ(tests::detail::to_bytes_ref(s), (*it)->first);
+    ++it;
+  }
+
+  bh.clear();
+  bh.sort(sorted);
+  ASSERT_TRUE(sorted.empty());
+}
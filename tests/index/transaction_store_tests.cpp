@@ -5447,6 +5447,95 @@ TEST_F(transaction_store_tests, segment_flush) {
   }
 }
 
+TEST_F(transaction_store_tests, segment_flush_writer) {
+  auto codec = irs::formats::get("1_0");
+  irs::memory_directory dir;
+  tests::json_doc_generator gen(
+    resource("simple_sequential.json"),
+    [] (tests::document& doc, const std::string& name, const tests::json_doc_generator::json_value& data) {
+      if (data.is_string()) {
+        doc.insert(std::make_shared<tests::templates::string_field>(
+          irs::string_ref(name),
+          data.str
+        ));
+      }
+  });
+
+  irs::bytes_ref actual_value;
+
+  tests::document const* doc1 = gen.next();
+  tests::document const* doc2 = gen.next();
+  tests::document const* doc3 = gen.next();
+  tests::document const* doc4 = gen.next();
+  tests::document const* doc5 = gen.next();
+
+  auto all_features = irs::flags{ irs::document::type(), irs::frequency::type(), irs::position::type(), irs::payload::type(), irs::offset::type() };
+  auto query_doc2 = irs::iql::query_builder().build("name==B", std::locale::classic());
+  auto dir_writer = irs::index_writer::make(dir, codec, irs::OPEN_MODE::OM_CREATE);
+  irs::transaction_store store;
+  irs::store_writer writer(store);
+
+  for (auto* src: { doc1, doc2, doc3, doc4 }) {
+    ASSERT_TRUE(writer.insert([src](irs::store_writer::document& doc)->bool {
+      doc.insert(irs::action::index, src->indexed.begin(), src->indexed.end());
+      doc.insert(irs::action::store, src->stored.begin(), src->stored.end());
+      return false;
+    }));
+  }
+
+  ASSERT_TRUE(writer.commit());
+  writer.remove(std::move(query_doc2.filter));
+  ASSERT_TRUE(writer.commit());
+
+  // export in batches of 2 documents
+  auto flushed = store.flush(*dir_writer, 2);
+  ASSERT_TRUE(flushed);
+  ASSERT_EQ(3, flushed.live_docs_count());
+  ASSERT_EQ(0, store.reader().live_docs_count());
+
+  // documents commited after export remain in store
+  ASSERT_TRUE(writer.insert([doc5](irs::store_writer::document& doc)->bool {
+    doc.insert(irs::action::index, doc5->indexed.begin(), doc5->indexed.end());
+    doc.insert(irs::action::store, doc5->stored.begin(), doc5->stored.end());
+    return false;
+  }));
+  ASSERT_TRUE(writer.commit());
+  ASSERT_EQ(1, store.reader().live_docs_count());
+  ASSERT_EQ(3, flushed.live_docs_count());
+
+  // not visible in index until commit
+  dir_writer->commit();
+
+  // validate structure
+  tests::index_t expected;
+  expected.emplace_back();
+  expected.back().add(doc1->indexed.begin(), doc1->indexed.end());
+  expected.back().add(doc3->indexed.begin(), doc3->indexed.end());
+  expected.back().add(doc4->indexed.begin(), doc4->indexed.end());
+  tests::assert_index(dir, codec, expected, all_features);
+
+  auto reader = irs::directory_reader::open(dir);
+  ASSERT_EQ(1, reader.size());
+  auto& segment = reader[0]; // assume 0 is id of first/only segment
+  ASSERT_EQ(3, segment.docs_count());
+  const auto* column = segment.column_reader("name");
+  ASSERT_NE(nullptr, column);
+  auto values = column->values();
+  auto terms = segment.field("same");
+  ASSERT_NE(nullptr, terms);
+  auto termItr = terms->iterator();
+  ASSERT_TRUE(termItr->next());
+  auto docsItr = termItr->postings(irs::flags());
+
+  for (auto* expected_name: { "A", "C", "D" }) {
+    ASSERT_TRUE(docsItr->next());
+    ASSERT_TRUE(values(docsItr->value(), actual_value));
+    ASSERT_EQ(expected_name, irs::to_string<irs::string_ref>(actual_value.c_str()));
+  }
+
+  ASSERT_FALSE(docsItr->next());
+}
+
 TEST_F(transaction_store_tests, rollback_uncommited) {
   irs::transaction_store store;
   tests::json_doc_generator gen(
@@ -5667,7 +5756,7 @@ TEST_F(transaction_store_tests, read_reopen) {
     ASSERT_EQ(2, reader0.docs_count()); // +1 for invalid doc
     ASSERT_EQ(1, reader0.size());
     ASSERT_NE(reader0.begin(), reader0.end());
-    ASSERT_NE(&*(reader.begin()), &*(reader0.begin()));
+    ASSERT_EQ(&*(reader.begin()), &*(reader0.begin())); // same snapshot since there were no changes in store
     ASSERT_EQ(size_t(0), size_t(&*(reader0.end())));
   }
 
@@ -5706,6 +5795,106 @@ TEST_F(transaction_store_tests, read_reopen) {
   }
 }
 
+TEST_F(transaction_store_tests, read_snapshot) {
+  irs::transaction_store store;
+  tests::templates::string_field field_a("a", "x");
+  tests::templates::string_field field_b0("b", "y");
+  tests::templates::string_field field_b1("b", "z");
+
+  // write 1st generation
+  {
+    irs::store_writer writer(store);
+
+    ASSERT_TRUE(writer.insert([&](irs::store_writer::document& doc)->bool {
+      doc.insert(irs::action::index, field_a);
+      doc.insert(irs::action::index, field_b0);
+      return false;
+    }));
+    ASSERT_TRUE(writer.commit());
+  }
+
+  auto reader0 = store.reader();
+  ASSERT_EQ(1, reader0.live_docs_count());
+  ASSERT_NE(nullptr, reader0.field("a"));
+  ASSERT_NE(nullptr, reader0.field("b"));
+
+  // write 2nd generation (only field 'b' modified)
+  {
+    irs::store_writer writer(store);
+
+    ASSERT_TRUE(writer.insert([&](irs::store_writer::document& doc)->bool {
+      doc.insert(irs::action::index, field_b1);
+      return false;
+    }));
+    ASSERT_TRUE(writer.commit());
+  }
+
+  // unmodified field state is shared with the previous snapshot
+  auto reader1 = store.reader();
+  ASSERT_EQ(2, reader1.live_docs_count());
+  ASSERT_EQ(reader0.field("a"), reader1.field("a"));
+  ASSERT_NE(reader0.field("b"), reader1.field("b"));
+  ASSERT_EQ(1, reader0.field("b")->docs_count());
+  ASSERT_EQ(2, reader1.field("b")->docs_count());
+  ASSERT_EQ(2, reader1.field("b")->size());
+
+  // no changes, same snapshot
+  {
+    auto reader = store.reader();
+    ASSERT_EQ(&*(reader1.begin()), &*(reader.begin()));
+  }
+
+  // write 3rd generation (removal from field 'b' that also removes field 'a')
+  {
+    irs::store_writer writer(store);
+    irs::by_term filter;
+
+    filter.field("b").term("y");
+    writer.remove(filter);
+    ASSERT_TRUE(writer.commit());
+  }
+
+  auto reader2 = store.reader();
+  ASSERT_EQ(1, reader2.live_docs_count());
+  ASSERT_EQ(nullptr, reader2.field("a"));
+  ASSERT_EQ(1, reader2.field("b")->docs_count());
+  ASSERT_EQ(1, reader2.field("b")->size());
+
+  // previous snapshots are not affected
+  ASSERT_EQ(1, reader0.live_docs_count());
+  ASSERT_EQ(2, reader1.live_docs_count());
+  ASSERT_EQ(1, reader1.field("a")->docs_count());
+  ASSERT_EQ(2, reader1.field("b")->docs_count());
+
+  // update evaluated against the snapshot and the writer's own documents
+  {
+    irs::store_writer writer(store);
+    irs::by_term filter;
+
+    filter.field("b").term("z");
+    ASSERT_TRUE(writer.insert([&](irs::store_writer::document& doc)->bool {
+      doc.insert(irs::action::index, field_b1);
+      return false;
+    }));
+    ASSERT_TRUE(writer.update(filter, [&](irs::store_writer::document& doc)->bool {
+      doc.insert(irs::action::index, field_a);
+      return false;
+    }));
+    ASSERT_TRUE(writer.commit());
+  }
+
+  auto reader3 = store.reader();
+  ASSERT_EQ(1, reader3.live_docs_count());
+  ASSERT_EQ(nullptr, reader3.field("b"));
+  ASSERT_NE(nullptr, reader3.field("a"));
+  ASSERT_EQ(1, reader3.field("a")->docs_count());
+
+  // flush invalidates the snapshot
+  auto flushed = store.flush();
+  ASSERT_EQ(1, flushed.live_docs_count());
+  ASSERT_EQ(0, store.reader().live_docs_count());
+}
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                       END-OF-FILE
 // -----------------------------------------------------------------------------
\ No newline at end of file
@@ -42,6 +42,7 @@ namespace tests {
   public:
     test_context(std::string& sData): parser_context(sData) {}
     test_context(std::string& sData, iresearch::iql::functions const& functions): parser_context(sData, functions) {}
+    test_context(std::string& sData, iresearch::iql::functions const& functions, bool bPlaceholders): parser_context(sData, functions, bPlaceholders) {}
     template<typename T>
     typename T::contextual_function_t const& function(T const& fn) const { return iresearch::iql::parser_context::function(fn); }
     query_node const& node(size_t const& id) const { return find_node(id); }
@@ -1399,6 +1400,79 @@ TEST_F(IqlParserTestSuite, test_term) {
   }
 }
 
+TEST_F(IqlParserTestSuite, test_placeholder) {
+  {
+    std::string sData = "$2==a";
+    test_context ctx(sData, functions::DEFAULT(), true);
+    parser parser(ctx);
+
+    ASSERT_EQ(0, parser.parse());
+
+    auto state = ctx.state();
+
+    ASSERT_NE(nullptr, state.pnFilter);
+    ASSERT_EQ(2, state.nPlaceholders);
+
+    auto* pQuery = &ctx.node(*(state.pnFilter));
+
+    ASSERT_EQ(pQuery->EQUAL, pQuery->type);
+    ASSERT_EQ(2, pQuery->children.size());
+
+    auto* pNode = &ctx.node(pQuery->children[0]); // value
+
+    ASSERT_EQ(pNode->PLACEHOLDER, pNode->type);
+    ASSERT_EQ("$2", pNode->sValue);
+    ASSERT_EQ(1, pNode->nPlaceholder);
+  }
+
+  // placeholders are not recognized by default
+  {
+    std::string sData = "$2==a";
+    test_context ctx(sData);
+    parser parser(ctx);
+
+    ASSERT_EQ(0, parser.parse());
+
+    auto state = ctx.state();
+
+    ASSERT_NE(nullptr, state.pnFilter);
+    ASSERT_EQ(0, state.nPlaceholders);
+
+    auto* pQuery = &ctx.node(*(state.pnFilter));
+    auto* pNode = &ctx.node(pQuery->children[0]); // value
+
+    ASSERT_EQ(pNode->SEQUENCE, pNode->type);
+    ASSERT_EQ("$2", pNode->sValue);
+  }
+
+  {
+    std::string sData = "$1b==a";
+    test_context ctx(sData, functions::DEFAULT(), true);
+    parser parser(ctx);
+
+    ASSERT_EQ(0, parser.parse());
+
+    auto state = ctx.state();
+
+    ASSERT_NE(nullptr, state.pnFilter);
+    ASSERT_EQ(0, state.nPlaceholders);
+
+    auto* pQuery = &ctx.node(*(state.pnFilter));
+    auto* pNode = &ctx.node(pQuery->children[0]); // value
+
+    ASSERT_EQ(pNode->SEQUENCE, pNode->type);
+    ASSERT_EQ("$1b", pNode->sValue);
+  }
+
+  {
+    std::string sData = "$0==a";
+    test_context ctx(sData, functions::DEFAULT(), true);
+    parser parser(ctx);
+
+    ASSERT_NE(0, parser.parse());
+  }
+}
+
 TEST_F(IqlParserTestSuite, test_range) {
   {
     std::string sData = "a==[123,456]";
@@ -1313,6 +1313,222 @@ TEST_F(IqlQueryBuilderTestSuite, test_query_builder_order) {
   }
 }
 
+TEST_F(IqlQueryBuilderTestSuite, test_query_template) {
+  iresearch::memory_directory dir;
+  auto reader = load_json(dir, "simple_sequential.json");
+  ASSERT_EQ(1, reader.size());
+  auto& segment = reader[0]; // assume 0 is id of first/only segment
+  auto column = segment.column_reader("name");
+  ASSERT_NE(nullptr, column);
+  auto values = column->values();
+
+  auto names = [&segment, &values](const iresearch::filter& filter)->std::set<std::string> {
+    std::set<std::string> result;
+    irs::bytes_ref actual_value;
+    auto pQuery = filter.prepare(segment, iresearch::order::prepared::unordered());
+
+    if (!pQuery) {
+      return result;
+    }
+
+    for (auto docsItr = pQuery->execute(segment); docsItr->next();) {
+      EXPECT_TRUE(values(docsItr->value(), actual_value));
+      result.emplace(irs::to_string<irs::string_ref>(actual_value.c_str()));
+    }
+
+    return result;
+  };
+
+  // placeholders in terms
+  {
+    auto query_tpl = query_builder().compile("name==$1 || name==$2");
+    ASSERT_NE(nullptr, query_tpl);
+    ASSERT_EQ(nullptr, query_tpl->error());
+    ASSERT_EQ(2, query_tpl->placeholders());
+
+    auto query = query_tpl->build({ "A", "C" }, std::locale::classic());
+    ASSERT_NE(nullptr, query.filter.get());
+    ASSERT_EQ(nullptr, query.error);
+    ASSERT_EQ((std::set<std::string>{ "A", "C" }), names(*query.filter));
+
+    // same template with different values
+    auto query2 = query_tpl->build({ "B", "D" }, std::locale::classic());
+    ASSERT_NE(nullptr, query2.filter.get());
+    ASSERT_EQ(nullptr, query2.error);
+    ASSERT_EQ((std::set<std::string>{ "B", "D" }), names(*query2.filter));
+
+    // equivalent to a literal query
+    auto expected = query_builder().build("name==B || name==D", std::locale::classic());
+    ASSERT_EQ(nullptr, expected.error);
+    ASSERT_EQ(names(*expected.filter), names(*query2.filter));
+  }
+
+  // placeholders in a range, reused and out of order
+  {
+    auto query_tpl = query_builder().compile("name==[$2, $1] || name==$2");
+    ASSERT_EQ(nullptr, query_tpl->error());
+    ASSERT_EQ(2, query_tpl->placeholders());
+
+    auto query = query_tpl->build({ "D", "B" }, std::locale::classic());
+    ASSERT_EQ(nullptr, query.error);
+    ASSERT_EQ((std::set<std::string>{ "B", "C", "D" }), names(*query.filter));
+  }
+
+  // placeholder as a field name
+  {
+    auto query_tpl = query_builder().compile("$1==A");
+    ASSERT_EQ(nullptr, query_tpl->error());
+
+    auto query = query_tpl->build({ "name" }, std::locale::classic());
+    ASSERT_EQ(nullptr, query.error);
+    ASSERT_EQ((std::set<std::string>{ "A" }), names(*query.filter));
+  }
+
+  // not a placeholder
+  {
+    auto query_tpl = query_builder().compile("name==$1a");
+    ASSERT_EQ(nullptr, query_tpl->error());
+    ASSERT_EQ(0, query_tpl->placeholders());
+
+    auto query = query_tpl->build({}, std::locale::classic());
+    ASSERT_EQ(nullptr, query.error);
+    ASSERT_TRUE(names(*query.filter).empty());
+  }
+
+  // missing value
+  {
+    auto query_tpl = query_builder().compile("name==$1 || name==$3");
+    ASSERT_EQ(nullptr, query_tpl->error());
+    ASSERT_EQ(3, query_tpl->placeholders());
+
+    auto query = query_tpl->build({ "A", "B" }, std::locale::classic());
+    ASSERT_NE(nullptr, query.filter.get());
+    ASSERT_NE(nullptr, query.error);
+    ASSERT_EQ(nullptr, query.filter->prepare(segment));
+    ASSERT_EQ("bind error, expected 3 value(s), got 2", *query.error);
+
+    auto query2 = query_tpl->build({ "A", "B", "C" }, std::locale::classic());
+    ASSERT_EQ(nullptr, query2.error);
+    ASSERT_EQ((std::set<std::string>{ "A", "C" }), names(*query2.filter));
+  }
+
+  // invalid placeholder
+  {
+    auto query_tpl = query_builder().compile("name==$0");
+    ASSERT_NE(nullptr, query_tpl->error());
+
+    auto query = query_tpl->build({ "A" }, std::locale::classic());
+    ASSERT_NE(nullptr, query.error);
+    ASSERT_EQ(*query_tpl->error(), *query.error);
+  }
+
+  // link under root
+  {
+    auto query_tpl = query_builder().compile("name==$1");
+    proxy_filter root;
+    auto query = query_tpl->build({ "A" }, std::locale::classic(), nullptr, &root);
+    ASSERT_EQ(nullptr, query.error);
+    ASSERT_EQ((std::set<std::string>{ "A" }), names(root));
+    ASSERT_EQ((std::set<std::string>{ "A" }), names(*query.filter));
+  }
+}
+
+TEST_F(IqlQueryBuilderTestSuite, test_query_builder_placeholder_literal) {
+  iresearch::memory_directory dir;
+
+  // index a document with a value looking like a placeholder
+  {
+    auto writer = irs::index_writer::make(dir, irs::formats::get("1_0"), irs::OPEN_MODE::OM_CREATE);
+    templates::string_field field("name", "$1");
+
+    ASSERT_TRUE(writer->insert([&field](irs::segment_writer::document& doc)->bool {
+      doc.insert(irs::action::index, field);
+      return false; // break the loop
+    }));
+    writer->commit();
+  }
+
+  auto reader = irs::directory_reader::open(dir);
+  ASSERT_EQ(1, reader.size());
+  auto& segment = reader[0]; // assume 0 is id of first/only segment
+
+  // '$N' is a plain sequence outside of query_builder::compile(...)
+  {
+    auto query = query_builder().build("name==$1", std::locale::classic());
+    ASSERT_EQ(nullptr, query.error);
+
+    auto pQuery = query.filter->prepare(segment, iresearch::order::prepared::unordered());
+    ASSERT_NE(nullptr, pQuery);
+    auto docsItr = pQuery->execute(segment);
+    ASSERT_TRUE(docsItr->next());
+    ASSERT_FALSE(docsItr->next());
+  }
+
+  // '$0' is a plain sequence too, i.e. not a parse error
+  {
+    auto query = query_builder().build("name==$0", std::locale::classic());
+    ASSERT_EQ(nullptr, query.error);
+
+    auto pQuery = query.filter->prepare(segment, iresearch::order::prepared::unordered());
+    ASSERT_NE(nullptr, pQuery);
+    ASSERT_FALSE(pQuery->execute(segment)->next());
+  }
+
+  // same query compiled as a template binds '$1' instead
+  {
+    auto query_tpl = query_builder().compile("name==$1");
+    ASSERT_EQ(nullptr, query_tpl->error());
+    ASSERT_EQ(1, query_tpl->placeholders());
+
+    auto query = query_tpl->build({ "$1" }, std::locale::classic());
+    ASSERT_EQ(nullptr, query.error);
+
+    auto pQuery = query.filter->prepare(segment, iresearch::order::prepared::unordered());
+    ASSERT_NE(nullptr, pQuery);
+    ASSERT_TRUE(pQuery->execute(segment)->next());
+
+    auto query2 = query_tpl->build({ "A" }, std::locale::classic());
+    ASSERT_EQ(nullptr, query2.error);
+
+    auto pQuery2 = query2.filter->prepare(segment, iresearch::order::prepared::unordered());
+    ASSERT_NE(nullptr, pQuery2);
+    ASSERT_FALSE(pQuery2->execute(segment)->next());
+  }
+}
+
+TEST_F(IqlQueryBuilderTestSuite, test_query_cache) {
+  query_builder builder;
+  query_cache cache(builder, 2);
+  ASSERT_EQ(2, cache.max_size());
+  ASSERT_EQ(0, cache.size());
+
+  auto tpl1 = cache.get("name==$1");
+  ASSERT_NE(nullptr, tpl1);
+  ASSERT_EQ(tpl1, cache.get("name==$1"));
+  ASSERT_EQ(1, cache.size());
+
+  auto tpl2 = cache.get("name==$1 || name==$2");
+  ASSERT_NE(tpl1, tpl2);
+  ASSERT_EQ(2, cache.size());
+
+  // 'name==$1' is most recently used, 'name==$1 || name==$2' gets evicted
+  ASSERT_EQ(tpl1, cache.get("name==$1"));
+  auto tpl3 = cache.get("name==$2");
+  ASSERT_EQ(2, cache.size());
+  ASSERT_EQ(tpl1, cache.get("name==$1"));
+  ASSERT_EQ(tpl3, cache.get("name==$2"));
+  ASSERT_NE(tpl2, cache.get("name==$1 || name==$2"));
+
+  // parse errors are cached too
+  auto tpl4 = cache.get("name==");
+  ASSERT_NE(nullptr, tpl4->error());
+  ASSERT_EQ(tpl4, cache.get("name=="));
+
+  cache.clear();
+  ASSERT_EQ(0, cache.size());
+  ASSERT_NE(tpl4, cache.get("name=="));
+}
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                       END-OF-FILE
 // -----------------------------------------------------------------------------
\ No newline at end of file
@@ -850,6 +850,63 @@ TEST(bitset_iterator_test, seek_next) {
   }
 }
 
+TEST(bitset_iterator_test, next_batch) {
+  auto& reader = empty_sub_reader::instance();
+  auto& filter_attrs = irs::attribute_store::empty_instance();
+
+  // sparse bitset spanning several words
+  const size_t size = 3*irs::bits_required<irs::bitset::word_t>() + 13;
+  irs::bitset bs(size);
+  std::vector<irs::doc_id_t> expected;
+
+  for (size_t i = 1; i < size; i += 3) {
+    bs.set(i);
+    expected.push_back(irs::doc_id_t(i));
+  }
+  bs.set(size - 1);
+  expected.push_back(irs::doc_id_t(size - 1));
+
+  for (size_t batch : { 1, 2, 7, 64, 1024 }) {
+    irs::bitset_doc_iterator it(reader, filter_attrs, bs, irs::order::prepared::unordered());
+    ASSERT_FALSE(irs::type_limits<irs::type_t::doc_id_t>::valid(it.value()));
+
+    std::vector<irs::doc_id_t> docs(batch);
+    std::vector<irs::doc_id_t> actual;
+
+    for (;;) {
+      const auto count = it.next_batch(&docs[0], batch);
+      actual.insert(actual.end(), docs.begin(), docs.begin() + count);
+
+      if (count < batch) {
+        ASSERT_TRUE(irs::type_limits<irs::type_t::doc_id_t>::eof(it.value()));
+        break;
+      }
+
+      ASSERT_EQ(docs[batch - 1], it.value()); // positioned at the last doc
+    }
+
+    ASSERT_EQ(expected, actual);
+    ASSERT_FALSE(it.next());
+    ASSERT_EQ(0, it.next_batch(&docs[0], batch));
+  }
+
+  // mixed with 'next' and 'seek'
+  {
+    irs::bitset_doc_iterator it(reader, filter_attrs, bs, irs::order::prepared::unordered());
+    irs::doc_id_t docs[4];
+
+    ASSERT_EQ(expected[5], it.seek(14));
+    ASSERT_EQ(4, it.next_batch(docs, 4));
+    ASSERT_EQ(expected[6], docs[0]);
+    ASSERT_EQ(expected[9], docs[3]);
+    ASSERT_TRUE(it.next());
+    ASSERT_EQ(expected[10], it.value());
+    ASSERT_EQ(4, it.next_batch(docs, 4));
+    ASSERT_EQ(expected[11], docs[0]);
+    ASSERT_EQ(expected[14], it.value());
+  }
+}
+
 #endif
 
 // -----------------------------------------------------------------------------
@@ -0,0 +1,310 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2016 by EMC Corporation, All Rights Reserved
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is EMC Corporation
+///
+/// @author Andrey Abramov
+/// @author Vasiliy Nabatchikov
+////////////////////////////////////////////////////////////////////////////////
+
+#include "tests_shared.hpp"
+#include "index/index_tests.hpp"
+#include "formats/formats_10.hpp"
+#include "store/memory_directory.hpp"
+#include "search/boolean_filter.hpp"
+#include "search/scorers.hpp"
+#include "search/score.hpp"
+#include "search/term_filter.hpp"
+#include "search/top_docs_collector.hpp"
+#include "utils/async_utils.hpp"
+
+#include <map>
+
+NS_BEGIN(tests)
+
+class block_max_disjunction_test: public index_test_base {
+ protected:
+  static const size_t TERMS = 6;
+
+  virtual irs::directory* get_directory() {
+    return new irs::memory_directory();
+  }
+
+  virtual irs::format::ptr get_codec() {
+    return irs::formats::get("1_0");
+  }
+
+  // frequency of the term 'i' in the document 'doc'
+  static size_t frequency(size_t i, size_t doc) {
+    static const size_t STEP[TERMS] = { 1, 2, 5, 17, 101, 997 };
+    static const size_t MAX_FREQ[TERMS] = { 2, 3, 8, 4, 16, 5 };
+
+    if (doc % STEP[i]) {
+      return 0;
+    }
+
+    return 1 + (doc * 2654435761U + i) % MAX_FREQ[i];
+  }
+
+  static std::string term(size_t i) {
+    return "t" + std::to_string(i);
+  }
+
+  void add_segment(size_t docs, size_t offset) {
+    static const irs::flags FEATURES{ irs::frequency::type(), irs::norm::type() };
+    auto writer = open_writer(offset ? irs::OPEN_MODE::OM_APPEND : irs::OPEN_MODE::OM_CREATE);
+
+    for (size_t doc = offset; doc < offset + docs; ++doc) {
+      tests::document fields;
+
+      // repeated fields make up the term frequency
+      for (size_t i = 0; i < TERMS; ++i) {
+        for (size_t freq = frequency(i, doc); freq; --freq) {
+          fields.indexed.push_back(std::make_shared<templates::string_field>(
+            "body", term(i), FEATURES
+          ));
+        }
+      }
+
+      ASSERT_TRUE(writer->insert([&fields](irs::segment_writer::document& doc)->bool {
+        doc.insert(irs::action::index, fields.indexed.begin(), fields.indexed.end());
+        return false;
+      }));
+    }
+
+    writer->commit();
+  }
+
+  // collects all matched documents without pruning
+  static irs::top_docs_collector::entries_t all(
+      const irs::index_reader& reader,
+      const irs::filter::prepared& filter,
+      const irs::order::prepared& ord) {
+    irs::top_docs_collector::entries_t all;
+
+    for (auto& segment : reader) {
+      auto docs = filter.execute(segment, ord);
+      auto& score = irs::score::extract(docs->attributes());
+
+      while (docs->next()) {
+        score.evaluate();
+        all.emplace_back();
+        all.back().segment = &segment;
+        all.back().doc = docs->value();
+        all.back().score = score.value();
+      }
+    }
+
+    return all;
+  }
+
+  static float_t value(const irs::bstring& score) {
+    return *reinterpret_cast<const float_t*>(score.c_str());
+  }
+
+  // scores are summed up in a different order, so compare with tolerance
+  static void assert_near(float_t expected, float_t actual) {
+    ASSERT_NEAR(expected, actual, 1e-5f * std::fabs(expected));
+  }
+
+  static void assert_top(
+      const irs::top_docs_collector::entries_t& matched,
+      const irs::top_docs_collector::entries_t& actual,
+      const irs::order::prepared& ord,
+      size_t limit) {
+    std::map<std::pair<const irs::sub_reader*, irs::doc_id_t>, float_t> scores;
+
+    for (auto& entry : matched) {
+      scores[std::make_pair(entry.segment, entry.doc)] = value(entry.score);
+    }
+
+    auto expected = matched;
+
+    std::stable_sort(
+      expected.begin(), expected.end(),
+      [&ord](const irs::top_docs_collector::entry& lhs, const irs::top_docs_collector::entry& rhs) {
+        return ord.less(lhs.score.c_str(), rhs.score.c_str());
+    });
+    expected.resize(std::min(limit, expected.size()));
+
+    ASSERT_EQ(expected.size(), actual.size());
+
+    for (size_t i = 0, count = expected.size(); i < count; ++i) {
+      // the same scores in the same order
+      assert_near(value(expected[i].score), value(actual[i].score));
+
+      // returned document has the proper score
+      auto it = scores.find(std::make_pair(actual[i].segment, actual[i].doc));
+      ASSERT_NE(scores.end(), it);
+      assert_near(it->second, value(actual[i].score));
+    }
+  }
+}; // block_max_disjunction_test
+
+NS_END
+
+using namespace tests;
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                        test suite
+// -----------------------------------------------------------------------------
+
+TEST_F(block_max_disjunction_test, frequency_bound) {
+  const size_t count = 1000; // 7 full blocks and a tail
+  add_segment(count, 0);
+
+  auto reader = irs::directory_reader::open(dir(), codec());
+  ASSERT_EQ(1, reader.size());
+  auto& segment = *reader.begin();
+  auto* field = segment.field("body");
+  ASSERT_NE(nullptr, field);
+
+  auto terms = field->iterator();
+  ASSERT_TRUE(terms->seek(irs::ref_cast<irs::byte_type>(irs::string_ref("t0"))));
+
+  auto docs = terms->postings(irs::flags{ irs::frequency::type() });
+  auto& freq = docs->attributes().get<irs::frequency>();
+  ASSERT_TRUE(bool(freq));
+  auto& bound = docs->attributes().get<irs::frequency_bound>();
+  ASSERT_TRUE(bool(bound));
+
+  const size_t block_size = irs::version10::postings_writer::BLOCK_SIZE;
+  const size_t full_blocks = count / block_size;
+  uint64_t total_freq = 0;
+
+  for (size_t i = 0; i < count; ++i) {
+    total_freq += frequency(0, i);
+  }
+
+  ASSERT_EQ(total_freq, bound->max());
+
+  for (size_t i = 0; docs->next(); ++i) {
+    const auto doc = docs->value();
+    const auto end = bound->shallow_seek(doc);
+    ASSERT_LE(freq->value, bound->block_max());
+
+    const size_t block = i / block_size;
+
+    if (block < full_blocks) {
+      uint64_t block_max = 0;
+
+      for (size_t j = block*block_size; j < (block + 1)*block_size; ++j) {
+        block_max = std::max(block_max, uint64_t(frequency(0, j)));
+      }
+
+      ASSERT_EQ((irs::type_limits<irs::type_t::doc_id_t>::min)() + (block + 1)*block_size - 1, end);
+      ASSERT_EQ(block_max, bound->block_max());
+    } else {
+      // the tail isn't indexed by skip list
+      ASSERT_TRUE(irs::type_limits<irs::type_t::doc_id_t>::eof(end));
+      ASSERT_EQ(bound->max(), bound->block_max());
+    }
+  }
+}
+
+TEST_F(block_max_disjunction_test, top_docs) {
+  add_segment(3000, 0);
+  add_segment(2000, 3000);
+
+  auto reader = irs::directory_reader::open(dir(), codec());
+  ASSERT_EQ(2, reader.size());
+
+  irs::Or filter;
+
+  for (size_t i = 0; i < TERMS; ++i) {
+    filter.add<irs::by_term>().field("body").term(term(i));
+  }
+
+  irs::async_utils::thread_pool pool(2, 2);
+
+  for (auto* name : { "bm25", "tfidf" }) {
+    irs::order order;
+    order.add(true, irs::scorers::get(name, irs::text_format::json, irs::string_ref::NIL));
+
+    auto prepared_order = order.prepare();
+    auto prepared_filter = filter.prepare(reader, prepared_order);
+    auto matched = all(reader, *prepared_filter, prepared_order);
+    ASSERT_EQ(5000, matched.size());
+
+    for (size_t limit : { 1, 10, 100 }) {
+      irs::top_docs_collector collector(prepared_order, limit);
+      collector.collect(reader, *prepared_filter);
+      assert_top(matched, collector.top(), prepared_order, limit);
+
+      // non-competitive documents are skipped
+      ASSERT_LT(collector.total_hits(), matched.size());
+
+      // each task has its own threshold
+      irs::top_docs_collector parallel(prepared_order, limit);
+      parallel.collect(reader, *prepared_filter, pool, 0);
+      assert_top(matched, parallel.top(), prepared_order, limit);
+      ASSERT_LT(parallel.total_hits(), matched.size());
+    }
+  }
+}
+
+TEST_F(block_max_disjunction_test, nested) {
+  add_segment(3000, 0);
+
+  auto reader = irs::directory_reader::open(dir(), codec());
+
+  // only the root query may skip documents
+  irs::And filter;
+  filter.add<irs::by_term>().field("body").term(term(1));
+  auto& any = filter.add<irs::Or>();
+
+  for (size_t i = 2; i < TERMS; ++i) {
+    any.add<irs::by_term>().field("body").term(term(i));
+  }
+
+  irs::order order;
+  order.add(true, irs::scorers::get("bm25", irs::text_format::json, irs::string_ref::NIL));
+
+  auto prepared_order = order.prepare();
+  auto prepared_filter = filter.prepare(reader, prepared_order);
+  auto matched = all(reader, *prepared_filter, prepared_order);
+
+  irs::top_docs_collector collector(prepared_order, 10);
+  collector.collect(reader, *prepared_filter);
+  assert_top(matched, collector.top(), prepared_order, 10);
+  ASSERT_EQ(matched.size(), collector.total_hits());
+}
+
+TEST_F(block_max_disjunction_test, unbounded) {
+  add_segment(3000, 0);
+
+  auto reader = irs::directory_reader::open(dir(), codec());
+
+  irs::Or filter;
+
+  for (size_t i = 0; i < TERMS; ++i) {
+    filter.add<irs::by_term>().field("body").term(term(i));
+  }
+
+  // ascending order can't be pruned
+  irs::order order;
+  order.add(false, irs::scorers::get("bm25", irs::text_format::json, irs::string_ref::NIL));
+
+  auto prepared_order = order.prepare();
+  auto prepared_filter = filter.prepare(reader, prepared_order);
+  auto matched = all(reader, *prepared_filter, prepared_order);
+
+  irs::top_docs_collector collector(prepared_order, 10);
+  collector.collect(reader, *prepared_filter);
+  assert_top(matched, collector.top(), prepared_order, 10);
+  ASSERT_EQ(matched.size(), collector.total_hits());
+}
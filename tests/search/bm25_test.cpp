@@ -725,6 +725,39 @@ TEST_F(bm25_test, test_query_norms) {
   }
 }
 
+TEST_F(bm25_test, test_norm_quantization) {
+  // short lengths are exact
+  for (uint32_t length = 0; length < 24; ++length) {
+    ASSERT_EQ(length, irs::norm::quantize(length));
+    ASSERT_EQ(float_t(1. / std::sqrt(double_t(length))), irs::norm::dequantize(irs::byte_type(length)));
+  }
+
+  ASSERT_EQ(irs::norm::DEFAULT(), irs::norm::dequantize(irs::norm::quantize(1)));
+
+  // longer lengths keep 4 significant bits, i.e. are rounded down by less
+  // than 1/8, the longest ones saturate
+  irs::byte_type prev = 0;
+  for (uint64_t length = 24; length <= irs::integer_traits<uint32_t>::const_max; length += 1 + length / 5) {
+    const auto value = irs::norm::quantize(uint32_t(length));
+    ASSERT_LE(prev, value);
+    prev = value;
+
+    const double_t quantized = 1. / std::pow(double_t(irs::norm::dequantize(value)), 2);
+    ASSERT_LE(quantized, double_t(length) * (1 + 1e-5));
+
+    if (value < irs::norm::QUANTIZED_VALUES() - 1) {
+      ASSERT_GT(quantized, double_t(length) * 7 / 8 * (1 - 1e-5));
+    }
+  }
+
+  ASSERT_EQ(irs::norm::QUANTIZED_VALUES() - 1, irs::norm::quantize(irs::integer_traits<uint32_t>::const_max));
+
+  // norms don't grow with the length
+  for (size_t i = 1; i < irs::norm::QUANTIZED_VALUES(); ++i) {
+    ASSERT_LT(irs::norm::dequantize(irs::byte_type(i)), irs::norm::dequantize(irs::byte_type(i - 1)));
+  }
+}
+
 #ifndef IRESEARCH_DLL
 
 TEST_F(bm25_test, test_make) {
@@ -166,6 +166,30 @@ struct seek_doc {
   iresearch::doc_id_t expected;
 };
 
+// drains the specified iterator by batches of the specified size
+template<typename DocIterator>
+std::vector<irs::doc_id_t> next_batch_all(DocIterator& it, size_t batch) {
+  std::vector<irs::doc_id_t> docs(batch);
+  std::vector<irs::doc_id_t> result;
+
+  for (;;) {
+    const auto count = it.next_batch(&docs[0], batch);
+    result.insert(result.end(), docs.begin(), docs.begin() + count);
+
+    if (count < batch) {
+      EXPECT_TRUE(irs::type_limits<irs::type_t::doc_id_t>::eof(it.value()));
+      break;
+    }
+
+    EXPECT_EQ(docs[batch - 1], it.value()); // positioned at the last doc
+  }
+
+  EXPECT_FALSE(it.next());
+  EXPECT_EQ(0, it.next_batch(&docs[0], batch));
+
+  return result;
+}
+
 NS_END // detail
 
 // ----------------------------------------------------------------------------
@@ -1830,6 +1854,92 @@ TEST(disjunction_test, next) {
   }
 }
 
+TEST(disjunction_test, next_batch) {
+  using disjunction = irs::disjunction;
+
+  const std::vector<std::vector<irs::doc_id_t>> docs{
+    { 1, 2, 5, 7, 9, 11, 45 },
+    { 1, 5, 6, 12, 29 },
+    { 1, 5, 6 },
+    { 256 },
+    { 11, 79, 101, 141, 1025, 1101 }
+  };
+  const auto expected = detail::union_all(docs);
+
+  for (size_t batch : { 1, 2, 3, 5, 16, 128 }) {
+    disjunction it(detail::execute_all<irs::score_iterator_adapter>(docs));
+    ASSERT_EQ(expected, detail::next_batch_all(it, batch));
+  }
+
+  for (size_t batch : { 1, 2, 3, 5, 16, 128 }) {
+    irs::basic_disjunction it(
+      irs::doc_iterator::make<detail::basic_doc_iterator>(docs[0].begin(), docs[0].end()),
+      irs::doc_iterator::make<detail::basic_doc_iterator>(docs[4].begin(), docs[4].end())
+    );
+    ASSERT_EQ(
+      (std::vector<irs::doc_id_t>{ 1, 2, 5, 7, 9, 11, 45, 79, 101, 141, 1025, 1101 }),
+      detail::next_batch_all(it, batch)
+    );
+  }
+
+  // documents spread over several windows
+  {
+    const std::vector<std::vector<irs::doc_id_t>> sparse{
+      { 1, 63, 64, 65, 4095, 4096, 4097, 100000 },
+      { 2, 64, 4096, 8192, 8193, 65536 },
+      { 4097, 100000, 100001 }
+    };
+    const auto expected = detail::union_all(sparse);
+
+    for (size_t batch : { 1, 2, 7, 64, 4096, 5000, 10000 }) {
+      disjunction it(detail::execute_all<irs::score_iterator_adapter>(sparse));
+      ASSERT_EQ(expected, detail::next_batch_all(it, batch));
+    }
+
+    // continue with 'next' after the windowed batch
+    disjunction it(detail::execute_all<irs::score_iterator_adapter>(sparse));
+    irs::doc_id_t batch[4];
+    ASSERT_EQ(4, it.next_batch(batch, 4));
+    ASSERT_EQ(64, batch[3]);
+    ASSERT_TRUE(it.next());
+    ASSERT_EQ(65, it.value());
+    ASSERT_TRUE(it.next());
+    ASSERT_EQ(4095, it.value());
+    ASSERT_EQ(8192, it.seek(4098));
+    ASSERT_EQ(4, it.next_batch(batch, 4));
+    ASSERT_EQ(8193, batch[0]);
+    ASSERT_EQ(65536, batch[1]);
+    ASSERT_EQ(100000, batch[2]);
+    ASSERT_EQ(100001, batch[3]);
+    ASSERT_FALSE(it.next());
+  }
+
+  // mixed with 'seek' and 'next'
+  {
+    disjunction it(detail::execute_all<irs::score_iterator_adapter>(docs));
+    irs::doc_id_t batch[3];
+    ASSERT_EQ(9, it.seek(8));
+    ASSERT_EQ(3, it.next_batch(batch, 3));
+    ASSERT_EQ(11, batch[0]);
+    ASSERT_EQ(12, batch[1]);
+    ASSERT_EQ(29, batch[2]);
+    ASSERT_EQ(29, it.value());
+    ASSERT_TRUE(it.next());
+    ASSERT_EQ(45, it.value());
+    ASSERT_EQ(1025, it.seek(1000));
+    ASSERT_EQ(1, it.next_batch(batch, 3));
+    ASSERT_EQ(1101, batch[0]);
+    ASSERT_TRUE(irs::type_limits<irs::type_t::doc_id_t>::eof(it.value()));
+  }
+
+  // empty
+  {
+    const std::vector<std::vector<irs::doc_id_t>> empty{ {}, {} };
+    disjunction it(detail::execute_all<irs::score_iterator_adapter>(empty));
+    ASSERT_TRUE(detail::next_batch_all(it, 4).empty());
+  }
+}
+
 TEST(disjunction_test, seek) {
   using disjunction = iresearch::disjunction;
 
@@ -3177,6 +3287,47 @@ TEST(conjunction_test, next) {
   }
 }
 
+TEST(conjunction_test, next_batch) {
+  using conjunction = irs::conjunction;
+
+  const std::vector<std::vector<irs::doc_id_t>> docs{
+    { 1, 2, 5, 7, 9, 11, 12, 29, 45, 46, 47, 101, 102, 103, 256 },
+    { 1, 5, 6, 12, 29, 46, 101, 103, 256 },
+    { 1, 5, 9, 12, 29, 46, 47, 101, 103, 256, 1024 }
+  };
+  const std::vector<irs::doc_id_t> expected{ 1, 5, 12, 29, 46, 101, 103, 256 };
+
+  for (size_t batch : { 1, 2, 3, 5, 8, 16, 128 }) {
+    conjunction it(detail::execute_all<irs::score_iterator_adapter>(docs));
+    ASSERT_EQ(expected, detail::next_batch_all(it, batch));
+  }
+
+  // mixed with 'seek' and 'next'
+  {
+    conjunction it(detail::execute_all<irs::score_iterator_adapter>(docs));
+    irs::doc_id_t batch[2];
+    ASSERT_EQ(12, it.seek(6));
+    ASSERT_EQ(2, it.next_batch(batch, 2));
+    ASSERT_EQ(29, batch[0]);
+    ASSERT_EQ(46, batch[1]);
+    ASSERT_EQ(46, it.value());
+    ASSERT_TRUE(it.next());
+    ASSERT_EQ(101, it.value());
+    ASSERT_EQ(2, it.next_batch(batch, 2));
+    ASSERT_EQ(103, batch[0]);
+    ASSERT_EQ(256, batch[1]);
+    ASSERT_EQ(0, it.next_batch(batch, 2));
+    ASSERT_TRUE(irs::type_limits<irs::type_t::doc_id_t>::eof(it.value()));
+  }
+
+  // no intersection
+  {
+    const std::vector<std::vector<irs::doc_id_t>> disjoint{ { 1, 3, 5 }, { 2, 4, 6 } };
+    conjunction it(detail::execute_all<irs::score_iterator_adapter>(disjoint));
+    ASSERT_TRUE(detail::next_batch_all(it, 4).empty());
+  }
+}
+
 TEST(conjunction_test, seek) {
   using conjunction = irs::conjunction;
 
@@ -3434,6 +3585,38 @@ TEST(exclusion_test, next) {
   }
 }
 
+TEST(exclusion_test, next_batch) {
+  const std::vector<irs::doc_id_t> incl{ 1, 2, 5, 7, 9, 11, 12, 29, 45, 46, 47, 101, 256 };
+  const std::vector<irs::doc_id_t> excl{ 2, 3, 9, 12, 13, 47, 256, 1024 };
+  const std::vector<irs::doc_id_t> expected{ 1, 5, 7, 11, 29, 45, 46, 101 };
+
+  for (size_t batch : { 1, 2, 3, 5, 8, 16, 128 }) {
+    irs::exclusion it(
+      irs::doc_iterator::make<detail::basic_doc_iterator>(incl.begin(), incl.end()),
+      irs::doc_iterator::make<detail::basic_doc_iterator>(excl.begin(), excl.end())
+    );
+    ASSERT_EQ(expected, detail::next_batch_all(it, batch));
+  }
+
+  // mixed with 'seek' and 'next'
+  {
+    irs::exclusion it(
+      irs::doc_iterator::make<detail::basic_doc_iterator>(incl.begin(), incl.end()),
+      irs::doc_iterator::make<detail::basic_doc_iterator>(excl.begin(), excl.end())
+    );
+    irs::doc_id_t batch[3];
+    ASSERT_EQ(11, it.seek(9));
+    ASSERT_EQ(3, it.next_batch(batch, 3));
+    ASSERT_EQ(29, batch[0]);
+    ASSERT_EQ(45, batch[1]);
+    ASSERT_EQ(46, batch[2]);
+    ASSERT_TRUE(it.next());
+    ASSERT_EQ(101, it.value());
+    ASSERT_EQ(0, it.next_batch(batch, 3));
+    ASSERT_TRUE(irs::type_limits<irs::type_t::doc_id_t>::eof(it.value()));
+  }
+}
+
 TEST(exclusion_test, seek) {
   // simple case
   {
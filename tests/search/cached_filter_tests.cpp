@@ -0,0 +1,299 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Andrey Abramov
+/// @author Vasiliy Nabatchikov
+////////////////////////////////////////////////////////////////////////////////
+
+#include "tests_shared.hpp"
+#include "filter_test_case_base.hpp"
+#include "search/cached_filter.hpp"
+#include "search/term_filter.hpp"
+#include "search/range_filter.hpp"
+#include "store/memory_directory.hpp"
+#include "formats/formats.hpp"
+
+NS_LOCAL
+
+irs::filter::ptr make_term_filter(const irs::string_ref& field, const irs::string_ref& term) {
+  auto filter = irs::memory::make_unique<irs::by_term>();
+  filter->field(field).term(term);
+  return std::move(filter);
+}
+
+irs::filter::ptr make_range_filter(const irs::string_ref& field, const irs::string_ref& min, const irs::string_ref& max) {
+  auto filter = irs::memory::make_unique<irs::by_range>();
+  filter->field(field)
+    .include<irs::Bound::MIN>(true).term<irs::Bound::MIN>(min)
+    .include<irs::Bound::MAX>(true).term<irs::Bound::MAX>(max);
+  return std::move(filter);
+}
+
+NS_END
+
+NS_BEGIN(tests)
+
+class cached_filter_test_case : public filter_test_case_base {
+ protected:
+  void cached_sequential() {
+    // add segment
+    {
+      tests::json_doc_generator gen(
+        resource("simple_sequential.json"),
+        &tests::generic_json_field_factory
+      );
+      add_segment(gen);
+    }
+
+    auto rdr = open_reader();
+    ASSERT_EQ(1, rdr.size());
+    ASSERT_NE(0, rdr[0].id());
+
+    auto cache = irs::filter_cache::make(1 << 20, 2);
+
+    irs::cached filter;
+    filter.cache(cache);
+    filter.filter(make_range_filter("name", "A", "D"));
+
+    const docs_t docs{ 1, 2, 3, 4 };
+
+    // 1st request, not admitted
+    check_query(filter, docs, rdr);
+    {
+      auto stats = cache->stats();
+      ASSERT_EQ(0, stats.hits);
+      ASSERT_EQ(1, stats.misses);
+      ASSERT_EQ(0, stats.count);
+    }
+
+    // 2nd request, admitted
+    check_query(filter, docs, rdr);
+    {
+      auto stats = cache->stats();
+      ASSERT_EQ(0, stats.hits);
+      ASSERT_EQ(2, stats.misses);
+      ASSERT_EQ(1, stats.count);
+      ASSERT_LT(0, stats.size);
+    }
+
+    // served from the cache, equal filter
+    {
+      irs::cached other;
+      other.cache(cache);
+      other.filter(make_range_filter("name", "A", "D"));
+
+      check_query(other, docs, rdr);
+      auto stats = cache->stats();
+      ASSERT_EQ(1, stats.hits);
+      ASSERT_EQ(1, stats.count);
+    }
+
+    // ordered queries aren't cached
+    {
+      irs::order order;
+      order.add<sort::frequency_sort>(false);
+      check_query(filter, order, docs, rdr);
+      auto stats = cache->stats();
+      ASSERT_EQ(1, stats.hits);
+      ASSERT_EQ(2, stats.misses);
+    }
+
+    // document mask changes, cached entries aren't matched anymore
+    {
+      irs::by_term remove;
+      remove.field("name").term("B");
+
+      auto writer = open_writer(irs::OPEN_MODE::OM_APPEND);
+      writer->remove(remove);
+      writer->commit();
+    }
+
+    auto new_rdr = rdr.reopen();
+    ASSERT_EQ(1, new_rdr.size());
+    ASSERT_NE(rdr[0].id(), new_rdr[0].id());
+
+    check_query(filter, docs, new_rdr);
+    check_query(filter, docs, new_rdr);
+
+    // removed documents are masked by the reader
+    {
+      auto prepared = filter.prepare(new_rdr);
+      auto it = new_rdr[0].mask(prepared->execute(new_rdr[0]));
+      docs_t result;
+
+      while (it->next()) {
+        result.push_back(it->value());
+      }
+
+      ASSERT_EQ(docs_t({ 1, 3, 4 }), result);
+    }
+    {
+      auto stats = cache->stats();
+      ASSERT_EQ(2, stats.hits);
+      ASSERT_EQ(4, stats.misses);
+      ASSERT_EQ(2, stats.count);
+    }
+
+    // old reader is still served from its own entry
+    check_query(filter, docs, rdr);
+    ASSERT_EQ(3, cache->stats().hits);
+
+    // drop the segment
+    cache->erase(rdr[0].id());
+    ASSERT_EQ(1, cache->stats().count);
+  }
+}; // cached_filter_test_case
+
+NS_END // tests
+
+TEST(cached_filter_test, ctor) {
+  irs::cached q;
+  ASSERT_EQ(irs::cached::type(), q.type());
+  ASSERT_TRUE(q.empty());
+  ASSERT_EQ(nullptr, q.filter());
+  ASSERT_EQ(nullptr, q.cache());
+  ASSERT_EQ(irs::boost::no_boost(), q.boost());
+}
+
+TEST(cached_filter_test, equal) {
+  irs::cached lhs;
+  lhs.filter(make_term_filter("field", "term"));
+  ASSERT_FALSE(lhs.empty());
+  ASSERT_NE(nullptr, lhs.filter<irs::by_term>());
+  ASSERT_EQ(irs::string_ref("term"), irs::ref_cast<char>(lhs.filter<irs::by_term>()->term()));
+
+  irs::cached rhs;
+  rhs.cache(irs::filter_cache::make(1024));
+  rhs.filter(make_term_filter("field", "term"));
+
+  ASSERT_EQ(lhs, rhs);
+  ASSERT_EQ(lhs.hash(), rhs.hash());
+
+  rhs.filter(make_term_filter("field", "term1"));
+  ASSERT_NE(lhs, rhs);
+  ASSERT_NE(lhs, irs::cached());
+}
+
+TEST(cached_filter_test, no_cache) {
+  irs::cached q;
+  q.filter(make_term_filter("field", "term"));
+
+  // nothing to cache into, the wrapped query is used as is
+  auto prepared = q.prepare(tests::empty_index_reader::instance());
+  ASSERT_NE(nullptr, prepared);
+}
+
+TEST(filter_cache_tests, admit) {
+  irs::filter_cache cache(1024, 3);
+  ASSERT_EQ(1024, cache.max_size());
+  ASSERT_EQ(3, cache.min_frequency());
+
+  irs::by_term q;
+  q.field("field").term("term");
+
+  ASSERT_FALSE(cache.admit(1, q));
+  ASSERT_FALSE(cache.admit(1, q));
+  ASSERT_TRUE(cache.admit(1, q));
+  ASSERT_TRUE(cache.admit(1, q));
+}
+
+TEST(filter_cache_tests, find_emplace) {
+  irs::filter_cache cache(1024);
+  std::shared_ptr<const irs::filter> q0 = irs::by_term::make();
+  std::shared_ptr<irs::filter> q1 = irs::by_term::make();
+  static_cast<irs::by_term&>(*q1).field("field").term("term");
+
+  ASSERT_EQ(nullptr, cache.find(1, *q0));
+
+  auto docs = cache.emplace(1, q0, std::make_shared<const irs::bitset>(64));
+  ASSERT_NE(nullptr, docs);
+
+  // already cached
+  auto dup = cache.emplace(1, q0, std::make_shared<const irs::bitset>(64));
+  ASSERT_EQ(docs, dup);
+
+  ASSERT_EQ(docs, cache.find(1, irs::by_term())); // equal filter
+  ASSERT_EQ(nullptr, cache.find(2, *q0)); // different segment
+  ASSERT_EQ(nullptr, cache.find(1, *q1)); // different filter
+
+  auto stats = cache.stats();
+  ASSERT_EQ(1, stats.hits);
+  ASSERT_EQ(3, stats.misses);
+  ASSERT_EQ(0, stats.evictions);
+  ASSERT_EQ(sizeof(irs::bitset::word_t), stats.size);
+  ASSERT_EQ(1, stats.count);
+
+  cache.clear();
+  ASSERT_EQ(nullptr, cache.find(1, *q0));
+  ASSERT_EQ(0, cache.stats().size);
+  ASSERT_EQ(0, cache.stats().count);
+}
+
+TEST(filter_cache_tests, evict_lru) {
+  const size_t word_size = sizeof(irs::bitset::word_t);
+  irs::filter_cache cache(2*word_size);
+  std::shared_ptr<const irs::filter> q = irs::by_term::make();
+
+  cache.emplace(1, q, std::make_shared<const irs::bitset>(64));
+  cache.emplace(2, q, std::make_shared<const irs::bitset>(64));
+
+  // mark segment 1 as recently used
+  ASSERT_NE(nullptr, cache.find(1, *q));
+
+  // evicts segment 2
+  cache.emplace(3, q, std::make_shared<const irs::bitset>(64));
+  ASSERT_EQ(nullptr, cache.find(2, *q));
+  ASSERT_NE(nullptr, cache.find(1, *q));
+  ASSERT_NE(nullptr, cache.find(3, *q));
+  ASSERT_EQ(1, cache.stats().evictions);
+
+  // too large to be cached
+  auto docs = cache.emplace(4, q, std::make_shared<const irs::bitset>(3*64));
+  ASSERT_NE(nullptr, docs);
+  ASSERT_EQ(nullptr, cache.find(4, *q));
+  ASSERT_EQ(2, cache.stats().count);
+
+  cache.erase(1);
+  ASSERT_EQ(nullptr, cache.find(1, *q));
+  ASSERT_NE(nullptr, cache.find(3, *q));
+  ASSERT_EQ(word_size, cache.stats().size);
+}
+
+// ----------------------------------------------------------------------------
+// --SECTION--                           memory_directory + iresearch_format_10
+// ----------------------------------------------------------------------------
+
+class memory_cached_filter_test_case : public tests::cached_filter_test_case {
+ protected:
+  virtual irs::directory* get_directory() override {
+    return new irs::memory_directory();
+  }
+
+  virtual irs::format::ptr get_codec() override {
+    return irs::formats::get("1_0");
+  }
+}; // memory_cached_filter_test_case
+
+TEST_F(memory_cached_filter_test_case, cached) {
+  cached_sequential();
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                       END-OF-FILE
+// -----------------------------------------------------------------------------
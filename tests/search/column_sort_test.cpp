@@ -0,0 +1,292 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Andrey Abramov
+/// @author Vasiliy Nabatchikov
+////////////////////////////////////////////////////////////////////////////////
+
+#include "tests_shared.hpp"
+#include "index/index_tests.hpp"
+#include "store/memory_directory.hpp"
+#include "search/all_filter.hpp"
+#include "search/column_sort.hpp"
+#include "search/score.hpp"
+#include "search/scorers.hpp"
+
+NS_BEGIN(tests)
+
+class column_sort_test: public index_test_base {
+ protected:
+  virtual irs::directory* get_directory() override {
+    return new irs::memory_directory();
+  }
+
+  virtual irs::format::ptr get_codec() override {
+    return irs::formats::get("1_0");
+  }
+
+  struct stored_field {
+    irs::string_ref name_;
+    irs::bstring value_;
+
+    const irs::string_ref& name() const { return name_; }
+
+    bool write(irs::data_output& out) const {
+      out.write_bytes(value_.c_str(), value_.size());
+      return true;
+    }
+  }; // stored_field
+
+  // big-endian encoding preserves the order of values
+  static irs::bstring encode(uint64_t value) {
+    irs::bstring buf(sizeof(value), 0);
+
+    for (auto i = buf.size(); i; --i) {
+      buf[i - 1] = irs::byte_type(value & 0xFF);
+      value >>= 8;
+    }
+
+    return buf;
+  }
+
+  static uint64_t key(size_t i) {
+    return (i * 7919) % DOCS_COUNT;
+  }
+
+  static const size_t DOCS_COUNT = 1000;
+
+  // fills columns of every kind handled by the columnstore
+  void add_documents() {
+    auto writer = open_writer();
+
+    for (size_t i = 0; i < DOCS_COUNT; ++i) {
+      std::vector<stored_field> fields;
+
+      fields.push_back({ "dense_fixed", encode(key(i)) });
+      fields.push_back({ "dense", irs::bstring(1 + i % 5, irs::byte_type(i)) });
+      fields.push_back({ "dense_mask", irs::bstring() });
+
+      if (0 == i % 3) {
+        fields.push_back({ "sparse_fixed", encode(key(i)) });
+        fields.push_back({ "sparse_mask", irs::bstring() });
+      }
+
+      if (0 == i % 7) {
+        fields.push_back({ "sparse", irs::bstring(1 + i % 3, irs::byte_type(i)) });
+      }
+
+      ASSERT_TRUE(writer->insert([&fields](irs::segment_writer::document& doc)->bool {
+        doc.insert(irs::action::store, fields.begin(), fields.end());
+        return false;
+      }));
+    }
+
+    writer->commit();
+  }
+}; // column_sort_test
+
+NS_END
+
+using namespace tests;
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                        test suite
+// -----------------------------------------------------------------------------
+
+TEST_F(column_sort_test, values_cursor) {
+  add_documents();
+
+  auto reader = open_reader();
+  ASSERT_EQ(1, reader.size());
+  auto& segment = reader[0];
+
+  const irs::string_ref columns[] {
+    "dense_fixed", "dense", "dense_mask", "sparse_fixed", "sparse_mask", "sparse"
+  };
+
+  for (auto& name : columns) {
+    SCOPED_TRACE(name);
+    const auto* column = segment.column_reader(name);
+    ASSERT_NE(nullptr, column);
+
+    auto values = column->values();
+    irs::bytes_ref expected;
+    irs::bytes_ref actual;
+
+    // ascending order, including documents beyond the column
+    {
+      auto cursor = column->cursor();
+      ASSERT_NE(nullptr, cursor);
+
+      for (irs::doc_id_t doc = 0; doc <= DOCS_COUNT + 1; ++doc) {
+        expected = irs::bytes_ref::NIL;
+        const bool found = values(doc, expected);
+        ASSERT_EQ(found, cursor->read(doc, actual));
+
+        if (found) {
+          ASSERT_EQ(expected, actual);
+        }
+      }
+    }
+
+    // arbitrary order
+    {
+      auto cursor = column->cursor();
+      ASSERT_NE(nullptr, cursor);
+
+      for (size_t i = 0; i < DOCS_COUNT; ++i) {
+        const irs::doc_id_t doc = irs::doc_id_t((i * 631) % (DOCS_COUNT + 2));
+        expected = irs::bytes_ref::NIL;
+        const bool found = values(doc, expected);
+        ASSERT_EQ(found, cursor->read(doc, actual));
+
+        if (found) {
+          ASSERT_EQ(expected, actual);
+        }
+      }
+    }
+  }
+}
+
+TEST_F(column_sort_test, order_by_column) {
+  add_documents();
+
+  auto reader = open_reader();
+  auto& segment = reader[0];
+
+  auto execute = [&segment, &reader](
+      const irs::order& ord
+  )->std::vector<irs::doc_id_t> {
+    auto prepared_order = ord.prepare();
+    auto comparer = [&prepared_order](const irs::bstring& lhs, const irs::bstring& rhs)->bool {
+      return prepared_order.less(lhs.c_str(), rhs.c_str());
+    };
+    std::multimap<irs::bstring, irs::doc_id_t, decltype(comparer)> sorted(comparer);
+
+    auto prepared_filter = irs::all().prepare(reader, prepared_order);
+    auto docs = prepared_filter->execute(segment, prepared_order);
+    auto& score = docs->attributes().get<irs::score>();
+    EXPECT_TRUE(bool(score));
+
+    while (docs->next()) {
+      score->evaluate();
+      sorted.emplace(score->value(), docs->value());
+    }
+
+    std::vector<irs::doc_id_t> result;
+
+    for (auto& entry : sorted) {
+      result.push_back(entry.second);
+    }
+
+    return result;
+  };
+
+  // dense column, ascending
+  {
+    std::vector<irs::doc_id_t> expected(DOCS_COUNT);
+
+    for (size_t i = 0; i < DOCS_COUNT; ++i) {
+      expected[key(i)] = irs::doc_id_t(irs::type_limits<irs::type_t::doc_id_t>::min() + i);
+    }
+
+    irs::order ord;
+    ord.add<irs::column_sort>(false).column("dense_fixed");
+    ASSERT_EQ(expected, execute(ord));
+
+    // descending
+    irs::order reversed;
+    reversed.add<irs::column_sort>(true).column("dense_fixed");
+    ASSERT_EQ(std::vector<irs::doc_id_t>(expected.rbegin(), expected.rend()), execute(reversed));
+  }
+
+  // sparse column, documents without a value come first
+  {
+    std::vector<irs::doc_id_t> expected;
+    std::map<uint64_t, irs::doc_id_t> with_value;
+
+    for (size_t i = 0; i < DOCS_COUNT; ++i) {
+      const auto doc = irs::doc_id_t(irs::type_limits<irs::type_t::doc_id_t>::min() + i);
+
+      if (0 == i % 3) {
+        with_value.emplace(key(i), doc);
+      } else {
+        expected.push_back(doc);
+      }
+    }
+
+    for (auto& entry : with_value) {
+      expected.push_back(entry.second);
+    }
+
+    irs::order ord;
+    ord.add<irs::column_sort>(false).column("sparse_fixed");
+    ASSERT_EQ(expected, execute(ord));
+  }
+
+  // prefix of the value
+  {
+    irs::order ord;
+    auto& sort = ord.add<irs::column_sort>(false);
+    sort.column("dense_fixed").length(7);
+    auto prepared_order = ord.prepare();
+    ASSERT_EQ(8, prepared_order.size()); // +1 for 'present' flag
+  }
+
+  // no such column, original order
+  {
+    std::vector<irs::doc_id_t> expected;
+
+    for (size_t i = 0; i < DOCS_COUNT; ++i) {
+      expected.push_back(irs::doc_id_t(irs::type_limits<irs::type_t::doc_id_t>::min() + i));
+    }
+
+    irs::order ord;
+    ord.add<irs::column_sort>(false).column("missing");
+    ASSERT_EQ(expected, execute(ord));
+  }
+}
+
+TEST_F(column_sort_test, make_json) {
+  {
+    auto scorer = irs::scorers::get("column", irs::text_format::json, "\"timestamp\"");
+    ASSERT_NE(nullptr, scorer);
+    auto& sort = dynamic_cast<irs::column_sort&>(*scorer);
+    ASSERT_EQ("timestamp", sort.column());
+    ASSERT_EQ(irs::column_sort::LENGTH(), sort.length());
+  }
+
+  {
+    auto scorer = irs::scorers::get("column", irs::text_format::json, "{ \"column\": \"timestamp\", \"length\": 4 }");
+    ASSERT_NE(nullptr, scorer);
+    auto& sort = dynamic_cast<irs::column_sort&>(*scorer);
+    ASSERT_EQ("timestamp", sort.column());
+    ASSERT_EQ(4, sort.length());
+  }
+
+  // invalid arguments
+  ASSERT_EQ(nullptr, irs::scorers::get("column", irs::text_format::json, "{ \"length\": 4 }"));
+  ASSERT_EQ(nullptr, irs::scorers::get("column", irs::text_format::json, "{ \"column\": \"timestamp\", \"length\": 0 }"));
+  ASSERT_EQ(nullptr, irs::scorers::get("column", irs::text_format::json, "1"));
+  ASSERT_EQ(nullptr, irs::scorers::get("column", irs::text_format::json, "[]"));
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                       END-OF-FILE
+// -----------------------------------------------------------------------------
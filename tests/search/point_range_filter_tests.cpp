@@ -0,0 +1,347 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Andrey Abramov
+/// @author Vasiliy Nabatchikov
+////////////////////////////////////////////////////////////////////////////////
+
+#include "tests_shared.hpp"
+#include "filter_test_case_base.hpp"
+#include "formats/formats_10.hpp"
+#include "search/granular_range_filter.hpp"
+#include "search/point_range_filter.hpp"
+#include "store/memory_directory.hpp"
+
+NS_BEGIN(tests)
+
+class point_long_field: public long_field {
+ public:
+  const irs::flags& features() const {
+    static const irs::flags features{
+      irs::granularity_prefix::type(), irs::point_index::type()
+    };
+    return features;
+  }
+};
+
+class granular_long_field: public long_field {
+ public:
+  const irs::flags& features() const {
+    static const irs::flags features{ irs::granularity_prefix::type() };
+    return features;
+  }
+};
+
+class point_range_filter_test_case: public filter_test_case_base {
+ protected:
+  typedef std::vector<int64_t> values_t;
+
+  // indexes every value both as points ('value') and as terms only ('plain')
+  void add_segment(irs::index_writer& writer, const values_t& values) {
+    for (auto value : values) {
+      auto point = std::make_shared<point_long_field>();
+      point->name(irs::string_ref("value"));
+      point->value(value);
+
+      auto plain = std::make_shared<granular_long_field>();
+      plain->name(irs::string_ref("plain"));
+      plain->value(value);
+
+      tests::document doc;
+      doc.insert(point, true, false);
+      doc.insert(plain, true, false);
+
+      ASSERT_TRUE(writer.insert([&doc](irs::segment_writer::document& dst)->bool {
+        dst.insert(irs::action::index, doc.indexed.begin(), doc.indexed.end());
+        return false;
+      }));
+    }
+
+    writer.commit();
+  }
+
+  static docs_t expected(
+      const values_t& values,
+      const irs::by_point_range& q,
+      int64_t min, int64_t max) {
+    docs_t docs;
+
+    for (size_t i = 0; i < values.size(); ++i) {
+      const auto value = values[i];
+
+      if ((!q.include<irs::Bound::MIN>() && q.term<irs::Bound::MIN>().empty())
+          || (q.include<irs::Bound::MIN>() ? value >= min : value > min)) {
+        if ((!q.include<irs::Bound::MAX>() && q.term<irs::Bound::MAX>().empty())
+            || (q.include<irs::Bound::MAX>() ? value <= max : value < max)) {
+          docs.push_back(irs::doc_id_t(irs::type_limits<irs::type_t::doc_id_t>::min() + i));
+        }
+      }
+    }
+
+    return docs;
+  }
+
+  static docs_t execute(const irs::filter& q, const irs::sub_reader& segment) {
+    docs_t docs;
+    auto prepared = q.prepare(segment);
+
+    for (auto it = prepared->execute(segment); it->next();) {
+      docs.push_back(it->value());
+    }
+
+    return docs;
+  }
+
+  static irs::by_point_range make_query(
+      const irs::string_ref& field,
+      int64_t min, bool min_inclusive,
+      int64_t max, bool max_inclusive) {
+    irs::bstring min_buf, max_buf;
+    irs::by_point_range q;
+    q.field(field)
+     .term<irs::Bound::MIN>(irs::numeric_token_stream::value(min_buf, min))
+     .include<irs::Bound::MIN>(min_inclusive)
+     .term<irs::Bound::MAX>(irs::numeric_token_stream::value(max_buf, max))
+     .include<irs::Bound::MAX>(max_inclusive);
+    return q;
+  }
+
+  void check_ranges(const irs::sub_reader& segment, const values_t& values) {
+    const std::vector<std::pair<int64_t, int64_t>> ranges {
+      { -700, 799 }, { -10, 10 }, { 0, 0 }, { 42, 43 }, { 100, 1300 },
+      { -2000, -701 }, { 800, 5000 }, { 5, 4 }
+    };
+
+    for (auto& range : ranges) {
+      for (auto flags = 0; flags < 4; ++flags) {
+        const bool min_inclusive = 0 != (flags & 1);
+        const bool max_inclusive = 0 != (flags & 2);
+
+        auto q = make_query("value", range.first, min_inclusive, range.second, max_inclusive);
+        const auto docs = expected(values, q, range.first, range.second);
+        ASSERT_EQ(docs, execute(q, segment));
+
+        // evaluated over terms
+        q.field("plain");
+        ASSERT_EQ(docs, execute(q, segment));
+      }
+    }
+
+    // open ranges
+    {
+      irs::bstring buf;
+      irs::by_point_range q;
+      q.field("value")
+       .term<irs::Bound::MIN>(irs::numeric_token_stream::value(buf, INT64_C(500)));
+      ASSERT_EQ(expected(values, q, 500, 0), execute(q, segment));
+      q.field("plain");
+      ASSERT_EQ(expected(values, q, 500, 0), execute(q, segment));
+    }
+
+    {
+      irs::bstring buf;
+      irs::by_point_range q;
+      q.field("value")
+       .term<irs::Bound::MAX>(irs::numeric_token_stream::value(buf, INT64_C(-500)))
+       .include<irs::Bound::MAX>(true);
+      ASSERT_EQ(expected(values, q, 0, -500), execute(q, segment));
+      q.field("plain");
+      ASSERT_EQ(expected(values, q, 0, -500), execute(q, segment));
+    }
+
+    {
+      irs::by_point_range q;
+      q.field("value");
+      ASSERT_EQ(expected(values, q, 0, 0), execute(q, segment));
+      ASSERT_EQ(values.size(), execute(q, segment).size());
+    }
+
+    // no such field
+    {
+      auto q = make_query("missing", -700, true, 800, true);
+      ASSERT_EQ(docs_t{}, execute(q, segment));
+    }
+
+    // same result as granular range
+    {
+      irs::numeric_token_stream min_stream;
+      min_stream.reset(INT64_C(-123));
+      irs::numeric_token_stream max_stream;
+      max_stream.reset(INT64_C(456));
+
+      irs::by_granular_range granular;
+      granular.field("plain")
+        .include<irs::Bound::MIN>(true).insert<irs::Bound::MIN>(min_stream)
+        .include<irs::Bound::MAX>(false).insert<irs::Bound::MAX>(max_stream);
+
+      auto q = make_query("value", -123, true, 456, false);
+      ASSERT_EQ(execute(granular, segment), execute(q, segment));
+    }
+  }
+
+  void by_point_range_sequential() {
+    values_t segment0;
+    values_t segment1;
+
+    for (int64_t i = 0; i < 3000; ++i) {
+      segment0.push_back((i * 7919) % 1500 - 700);
+    }
+
+    for (int64_t i = 0; i < 1000; ++i) {
+      segment1.push_back(i * 3 - 1000);
+    }
+
+    {
+      auto writer = open_writer();
+      add_segment(*writer, segment0);
+      add_segment(*writer, segment1);
+    }
+
+    auto rdr = open_reader();
+    ASSERT_EQ(2, rdr.size());
+
+    // points are written at flush
+    {
+      auto& segment = rdr[0];
+      auto* field = segment.field("value");
+      ASSERT_NE(nullptr, field);
+
+      auto* points = field->points();
+      ASSERT_NE(nullptr, points);
+      ASSERT_EQ(segment0.size(), points->size());
+
+      irs::bstring buf;
+      ASSERT_EQ(irs::numeric_token_stream::value(buf, INT64_C(-700)), points->min());
+      ASSERT_EQ(irs::numeric_token_stream::value(buf, INT64_C(799)), points->max());
+
+      // fields without 'point_index' have no points
+      ASSERT_EQ(nullptr, segment.field("plain")->points());
+    }
+
+    check_ranges(rdr[0], segment0);
+    check_ranges(rdr[1], segment1);
+
+    // points are written at merge
+    {
+      auto writer = open_writer(irs::OPEN_MODE::OM_APPEND);
+      const irs::index_writer::consolidation_policy_t policy = [](
+          const irs::directory&, const irs::index_meta&
+      )->irs::index_writer::consolidation_acceptor_t {
+        return [](const irs::segment_meta&)->bool { return true; }; // merge every segment
+      };
+
+      writer->consolidate(policy, false);
+      writer->commit();
+    }
+
+    rdr = open_reader();
+    ASSERT_EQ(1, rdr.size());
+
+    auto& segment = rdr[0];
+    auto* points = segment.field("value")->points();
+    ASSERT_NE(nullptr, points);
+    ASSERT_EQ(segment0.size() + segment1.size(), points->size());
+
+    values_t merged(segment0);
+    merged.insert(merged.end(), segment1.begin(), segment1.end());
+    check_ranges(segment, merged);
+  }
+}; // point_range_filter_test_case
+
+NS_END // tests
+
+TEST(by_point_range_test, ctor) {
+  irs::by_point_range q;
+  ASSERT_EQ(irs::by_point_range::type(), q.type());
+  ASSERT_TRUE(q.field().empty());
+  ASSERT_TRUE(q.term<irs::Bound::MIN>().empty());
+  ASSERT_FALSE(q.include<irs::Bound::MIN>());
+  ASSERT_TRUE(q.term<irs::Bound::MAX>().empty());
+  ASSERT_FALSE(q.include<irs::Bound::MAX>());
+  ASSERT_EQ(irs::boost::no_boost(), q.boost());
+}
+
+TEST(by_point_range_test, equal) {
+  irs::by_point_range q0;
+  q0.field("field")
+    .term<irs::Bound::MIN>("min").include<irs::Bound::MIN>(true)
+    .term<irs::Bound::MAX>("max").include<irs::Bound::MAX>(false);
+
+  irs::by_point_range q1;
+  q1.field("field")
+    .term<irs::Bound::MIN>("min").include<irs::Bound::MIN>(true)
+    .term<irs::Bound::MAX>("max").include<irs::Bound::MAX>(false);
+
+  ASSERT_EQ(q0, q1);
+  ASSERT_EQ(q0.hash(), q1.hash());
+
+  q1.include<irs::Bound::MAX>(true);
+  ASSERT_NE(q0, q1);
+
+  irs::by_range q2;
+  q2.field("field")
+    .term<irs::Bound::MIN>("min").include<irs::Bound::MIN>(true)
+    .term<irs::Bound::MAX>("max").include<irs::Bound::MAX>(false);
+  ASSERT_NE(q0, q2);
+}
+
+TEST(by_point_range_test, boost) {
+  // no boost
+  {
+    irs::by_point_range q;
+    q.field("field").term<irs::Bound::MIN>("a").term<irs::Bound::MAX>("z");
+
+    auto prepared = q.prepare(tests::empty_index_reader::instance());
+    ASSERT_EQ(irs::boost::no_boost(), irs::boost::extract(prepared->attributes()));
+  }
+
+  // with boost
+  {
+    irs::boost::boost_t boost = 1.5f;
+    irs::by_point_range q;
+    q.field("field").term<irs::Bound::MIN>("a").term<irs::Bound::MAX>("z");
+    q.boost(boost);
+
+    auto prepared = q.prepare(tests::empty_index_reader::instance());
+    ASSERT_EQ(boost, irs::boost::extract(prepared->attributes()));
+  }
+}
+
+// ----------------------------------------------------------------------------
+// --SECTION--                           memory_directory + iresearch_format_10
+// ----------------------------------------------------------------------------
+
+class memory_point_range_filter_test_case : public tests::point_range_filter_test_case {
+ protected:
+  virtual irs::directory* get_directory() override {
+    return new irs::memory_directory();
+  }
+
+  virtual irs::format::ptr get_codec() override {
+    return irs::formats::get("1_0");
+  }
+}; // memory_point_range_filter_test_case
+
+TEST_F(memory_point_range_filter_test_case, by_point_range) {
+  by_point_range_sequential();
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                       END-OF-FILE
+// -----------------------------------------------------------------------------
@@ -0,0 +1,259 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2016 by EMC Corporation, All Rights Reserved
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is EMC Corporation
+///
+/// @author Andrey Abramov
+/// @author Vasiliy Nabatchikov
+////////////////////////////////////////////////////////////////////////////////
+
+
+#include "tests_shared.hpp"
+#include "index/index_tests.hpp"
+#include "store/memory_directory.hpp"
+#include "search/range_filter.hpp"
+#include "search/scorers.hpp"
+#include "search/score.hpp"
+#include "search/sort.hpp"
+#include "search/term_filter.hpp"
+#include "search/top_docs_collector.hpp"
+#include "utils/async_utils.hpp"
+
+NS_BEGIN(tests)
+
+class top_docs_collector_test: public index_test_base {
+ protected:
+  virtual irs::directory* get_directory() {
+    return new irs::memory_directory();
+  }
+
+  virtual irs::format::ptr get_codec() {
+    return irs::formats::get("1_0");
+  }
+
+  void add_segments(size_t count) {
+    tests::json_doc_generator gen(
+      resource("simple_sequential_order.json"),
+      [](tests::document& doc, const std::string& name, const tests::json_doc_generator::json_value& data) {
+        if (data.is_string()) { // field
+          doc.insert(std::make_shared<templates::string_field>(name, data.str), true, false);
+        }
+    });
+
+    for (size_t i = 0; i < count; ++i) {
+      gen.reset();
+      add_segment(gen, i ? irs::OPEN_MODE::OM_APPEND : irs::OPEN_MODE::OM_CREATE);
+    }
+  }
+
+  // collects all matched documents and sorts them via 'order::prepared::less'
+  static irs::top_docs_collector::entries_t expected(
+      const irs::index_reader& reader,
+      const irs::filter::prepared& filter,
+      const irs::order::prepared& ord,
+      size_t limit) {
+    irs::top_docs_collector::entries_t all;
+
+    for (auto& segment : reader) {
+      auto docs = filter.execute(segment, ord);
+      auto& score = irs::score::extract(docs->attributes());
+
+      while (docs->next()) {
+        score.evaluate();
+        all.emplace_back();
+        all.back().segment = &segment;
+        all.back().doc = docs->value();
+        all.back().score = score.value();
+      }
+    }
+
+    std::stable_sort(
+      all.begin(), all.end(),
+      [&ord](const irs::top_docs_collector::entry& lhs, const irs::top_docs_collector::entry& rhs) {
+        return ord.less(lhs.score.c_str(), rhs.score.c_str());
+    });
+
+    all.resize(std::min(limit, all.size()));
+
+    return all;
+  }
+
+  static void assert_equal(
+      const irs::top_docs_collector::entries_t& expected,
+      const irs::top_docs_collector::entries_t& actual) {
+    ASSERT_EQ(expected.size(), actual.size());
+
+    for (size_t i = 0, count = expected.size(); i < count; ++i) {
+      ASSERT_EQ(expected[i].segment, actual[i].segment);
+      ASSERT_EQ(expected[i].doc, actual[i].doc);
+      ASSERT_EQ(expected[i].score, actual[i].score);
+    }
+  }
+}; // top_docs_collector_test
+
+NS_END
+
+using namespace tests;
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                        test suite
+// -----------------------------------------------------------------------------
+
+TEST_F(top_docs_collector_test, float_score) {
+  add_segments(3);
+
+  irs::by_range filter;
+  filter.field("field")
+    .include<irs::Bound::MIN>(true).term<irs::Bound::MIN>("2")
+    .include<irs::Bound::MAX>(true).term<irs::Bound::MAX>("7");
+
+  auto reader = irs::directory_reader::open(dir(), codec());
+  ASSERT_EQ(3, reader.size());
+
+  for (auto* name : { "bm25", "tfidf" }) {
+    for (auto reverse : { true, false }) {
+      irs::order order;
+      order.add(reverse, irs::scorers::get(name, irs::text_format::json, irs::string_ref::NIL));
+
+      auto prepared_order = order.prepare();
+      ASSERT_EQ(1, std::distance(prepared_order.begin(), prepared_order.end()));
+      ASSERT_TRUE(prepared_order[0].bucket->float_score());
+
+      auto prepared_filter = filter.prepare(reader, prepared_order);
+
+      for (size_t limit : { 0, 1, 5, 10, 100 }) {
+        auto expected_top = expected(reader, *prepared_filter, prepared_order, limit);
+
+        irs::top_docs_collector collector(prepared_order, limit);
+        collector.collect(reader, *prepared_filter);
+        ASSERT_EQ(limit, collector.limit());
+        ASSERT_EQ(3*8, collector.total_hits());
+        assert_equal(expected_top, collector.top());
+
+        if (limit && limit <= 3*8) {
+          ASSERT_NE(nullptr, collector.threshold());
+          ASSERT_EQ(expected_top.back().score, irs::bytes_ref(collector.threshold(), prepared_order.size()));
+        } else {
+          ASSERT_EQ(nullptr, collector.threshold());
+        }
+
+        collector.clear();
+        ASSERT_TRUE(collector.empty());
+        ASSERT_EQ(0, collector.total_hits());
+      }
+    }
+  }
+}
+
+TEST_F(top_docs_collector_test, generic_score) {
+  add_segments(2);
+
+  irs::by_range filter;
+  filter.field("field")
+    .include<irs::Bound::MIN>(true).term<irs::Bound::MIN>("0")
+    .include<irs::Bound::MAX>(true).term<irs::Bound::MAX>("4");
+
+  auto reader = irs::directory_reader::open(dir(), codec());
+
+  // multiple buckets are compared via 'order::prepared::less(...)'
+  irs::order order;
+  order.add(true, irs::scorers::get("bm25", irs::text_format::json, irs::string_ref::NIL));
+  order.add(false, irs::scorers::get("tfidf", irs::text_format::json, irs::string_ref::NIL));
+
+  auto prepared_order = order.prepare();
+  auto prepared_filter = filter.prepare(reader, prepared_order);
+  auto expected_top = expected(reader, *prepared_filter, prepared_order, 7);
+
+  irs::top_docs_collector collector(prepared_order, 7);
+  collector.collect(reader, *prepared_filter);
+  assert_equal(expected_top, collector.top());
+}
+
+TEST_F(top_docs_collector_test, unordered) {
+  add_segments(2);
+
+  irs::by_term filter;
+  filter.field("field").term("2");
+
+  auto reader = irs::directory_reader::open(dir(), codec());
+  auto& ord = irs::order::prepared::unordered();
+  auto prepared_filter = filter.prepare(reader, ord);
+
+  // collection stops after 'limit' documents
+  {
+    irs::top_docs_collector collector(ord, 3);
+    collector.collect(reader, *prepared_filter);
+
+    auto top = collector.top();
+    ASSERT_EQ(3, top.size());
+    ASSERT_EQ(5, collector.total_hits()); // 1 extra document visited per segment
+
+    auto& segment = *reader.begin();
+    for (auto& entry : top) {
+      ASSERT_EQ(&segment, entry.segment);
+      ASSERT_TRUE(entry.score.empty());
+    }
+    ASSERT_TRUE(top[0].doc < top[1].doc);
+    ASSERT_TRUE(top[1].doc < top[2].doc);
+  }
+
+  // all documents
+  {
+    irs::top_docs_collector collector(ord, 100);
+    collector.collect(reader, *prepared_filter);
+    ASSERT_EQ(2*6, collector.size());
+    ASSERT_EQ(2*6, collector.total_hits());
+  }
+}
+
+TEST_F(top_docs_collector_test, parallel) {
+  add_segments(5);
+
+  irs::by_range filter;
+  filter.field("field")
+    .include<irs::Bound::MIN>(true).term<irs::Bound::MIN>("1")
+    .include<irs::Bound::MAX>(true).term<irs::Bound::MAX>("8");
+
+  auto reader = irs::directory_reader::open(dir(), codec());
+  ASSERT_EQ(5, reader.size());
+
+  irs::order order;
+  order.add(true, irs::scorers::get("bm25", irs::text_format::json, irs::string_ref::NIL));
+
+  auto prepared_order = order.prepare();
+  auto prepared_filter = filter.prepare(reader, prepared_order);
+  irs::async_utils::thread_pool pool(4, 4);
+
+  // 0 - task per segment, 8 - a few segments per task, max - single task
+  for (irs::cost::cost_t min_task_cost : { irs::cost::cost_t(0), irs::cost::cost_t(8), irs::cost::MAX }) {
+    for (size_t limit : { 0, 1, 10, 1000 }) {
+      irs::top_docs_collector sequential(prepared_order, limit);
+      sequential.collect(reader, *prepared_filter);
+
+      irs::top_docs_collector parallel(prepared_order, limit);
+      parallel.collect(reader, *prepared_filter, pool, min_task_cost);
+
+      ASSERT_EQ(sequential.total_hits(), parallel.total_hits());
+      assert_equal(sequential.top(), parallel.top());
+      assert_equal(expected(reader, *prepared_filter, prepared_order, limit), parallel.top());
+
+      // subsequent collection continues the segment ordinals
+      parallel.collect(reader, *prepared_filter, pool, min_task_cost);
+      ASSERT_EQ(2*sequential.total_hits(), parallel.total_hits());
+    }
+  }
+}
@@ -27,13 +27,14 @@
 #include "store/data_output.hpp"
 #include "store/data_input.hpp"
 #include "utils/async_utils.hpp"
+#include "utils/crc.hpp"
 #include "utils/utf8_path.hpp"
 
-#include <boost/crc.hpp>
 #include <cstdio>
 #include <vector>
 #include <string>
 #include <algorithm>
+#include <limits>
 
 void directory_test_case::lock_obtain_release() {
   {
@@ -879,7 +880,7 @@ void directory_test_case::smoke_store() {
   auto it = names.end();
   for (const auto& name : names) {
     --it;
-    boost::crc_32_type crc;
+    irs::crc32c crc;
 
     auto file = dir_->create(name);
     ASSERT_FALSE(!file);
@@ -911,7 +912,7 @@ void directory_test_case::smoke_store() {
 
   for (const auto& name : names) {
     --it;
-    boost::crc_32_type crc;
+    irs::crc32c crc;
     bool exists;
 
     ASSERT_TRUE(dir_->exists(exists, name) && exists);
@@ -1062,6 +1063,104 @@ void directory_test_case::directory_size() {
   }
 }
 
+void directory_test_case::prefetch() {
+  const std::string name = "prefetch";
+  std::vector<irs::byte_type> data(3*4096 + 17);
+
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = irs::byte_type(i % 251);
+  }
+
+  {
+    auto out = dir_->create(name);
+    ASSERT_FALSE(!out);
+    out->write_bytes(data.data(), data.size());
+  }
+
+  const irs::IOAdvice advices[] = {
+    irs::IOAdvice::NORMAL,
+    irs::IOAdvice::WILLNEED,
+    irs::IOAdvice::RANDOM | irs::IOAdvice::WILLNEED,
+    irs::IOAdvice::SEQUENTIAL | irs::IOAdvice::WILLNEED,
+    irs::IOAdvice::READONCE_RANDOM | irs::IOAdvice::WILLNEED
+  };
+
+  for (auto advice : advices) {
+    auto in = dir_->open(name, advice);
+    ASSERT_FALSE(!in);
+    ASSERT_EQ(data.size(), in->length());
+    in->seek(10);
+
+    // hints don't change the input state, out of range hints are ignored
+    in->prefetch(0, data.size());
+    in->prefetch(4097, 10);
+    in->prefetch(data.size() - 1, 4096);
+    in->prefetch(data.size(), 1);
+    in->prefetch(0, 0);
+    in->prefetch(data.size() / 2, std::numeric_limits<size_t>::max());
+    ASSERT_EQ(10, in->file_pointer());
+
+    std::vector<irs::byte_type> read(data.size() - 10);
+    ASSERT_EQ(read.size(), in->read_bytes(read.data(), read.size()));
+    ASSERT_TRUE(std::equal(read.begin(), read.end(), data.begin() + 10));
+    ASSERT_TRUE(in->eof());
+
+    // duplicates are prefetched independently
+    auto dup = in->dup();
+    ASSERT_FALSE(!dup);
+    dup->prefetch(0, data.size());
+    ASSERT_EQ(data.size(), dup->file_pointer());
+  }
+}
+
+void directory_test_case::read_buffer(bool mapped) {
+  const std::string name = "read_buffer";
+  std::vector<irs::byte_type> data(2*4096 + 17);
+
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = irs::byte_type(i % 251);
+  }
+
+  {
+    auto out = dir_->create(name);
+    ASSERT_FALSE(!out);
+    out->write_bytes(data.data(), data.size());
+  }
+
+  auto in = dir_->open(name, irs::IOAdvice::RANDOM);
+  ASSERT_FALSE(!in);
+  in->seek(10);
+
+  const irs::byte_type* buf = in->read_buffer(4096);
+
+  if (!mapped) {
+    // not supported, input is not changed
+    ASSERT_EQ(nullptr, buf);
+    ASSERT_EQ(10, in->file_pointer());
+    return;
+  }
+
+  ASSERT_NE(nullptr, buf);
+  ASSERT_EQ(10 + 4096, in->file_pointer());
+  ASSERT_TRUE(std::equal(buf, buf + 4096, data.begin() + 10));
+
+  // out of range, input is not changed
+  ASSERT_EQ(nullptr, in->read_buffer(data.size()));
+  ASSERT_EQ(10 + 4096, in->file_pointer());
+
+  // till the end of the input
+  const irs::byte_type* tail = in->read_buffer(data.size() - 10 - 4096);
+  ASSERT_NE(nullptr, tail);
+  ASSERT_TRUE(in->eof());
+  ASSERT_EQ(buf + 4096, tail);
+
+  // data stays valid while a duplicate is open
+  auto dup = in->dup();
+  ASSERT_FALSE(!dup);
+  in.reset();
+  ASSERT_TRUE(std::equal(buf, buf + 4096, data.begin() + 10));
+}
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                       END-OF-FILE
 // -----------------------------------------------------------------------------
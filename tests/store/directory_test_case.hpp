@@ -37,6 +37,8 @@ class directory_test_case {
   void read_multiple_streams();
   void lock_obtain_release();
   void directory_size();
+  void prefetch();
+  void read_buffer(bool mapped);
 
  protected:
   iresearch::directory::ptr dir_;
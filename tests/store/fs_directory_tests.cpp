@@ -26,10 +26,13 @@
 #include "directory_test_case.hpp"
 
 #include "store/fs_directory.hpp"
+#include "store/directory_attributes.hpp"
 #include "utils/process_utils.hpp"
 #include "utils/network_utils.hpp"
 
+#include <atomic>
 #include <fstream>
+#include <thread>
 
 #ifndef _WIN32
 #include <sys/file.h>
@@ -117,6 +120,14 @@ TEST_F(fs_directory_test, lock_obtain_release) {
   lock_obtain_release();
 }
 
+TEST_F(fs_directory_test, prefetch) {
+  prefetch();
+}
+
+TEST_F(fs_directory_test, read_buffer) {
+  read_buffer(false);
+}
+
 TEST_F(fs_directory_test, orphaned_lock) {
   // orhpaned lock file with orphaned pid, same hostname
   {
@@ -294,6 +305,82 @@ TEST_F(fs_directory_test, directory_size) {
   directory_size();
 }
 
+TEST_F(fs_directory_test, positional_read) {
+  const size_t length = 300000; // spans several O_DIRECT buffers
+  auto value = [](size_t i) { return irs::byte_type(i * 31 + i / 256); };
+
+  {
+    auto out = dir_->create("data");
+    ASSERT_FALSE(!out);
+
+    for (size_t i = 0; i < length; ++i) {
+      out->write_byte(value(i));
+    }
+  }
+
+  dir_->attributes().emplace<irs::read_buffer_size>()->size = 4096;
+
+  for (auto advice : { irs::IOAdvice::NORMAL, irs::IOAdvice::SEQUENTIAL | irs::IOAdvice::READONCE | irs::IOAdvice::DIRECT }) {
+    auto in = dir_->open("data", advice);
+    ASSERT_FALSE(!in);
+    ASSERT_EQ(length, in->length());
+
+    // sequential read
+    for (size_t i = 0; i < length; ++i) {
+      ASSERT_EQ(value(i), in->read_byte());
+    }
+    ASSERT_TRUE(in->eof());
+
+    // unaligned bulk reads bypassing the stream buffer
+    const size_t offsets[] = { 1, 4095, 4097, 262143, length - 10000 };
+    std::vector<irs::byte_type> buf(10000);
+
+    for (auto offset : offsets) {
+      in->seek(offset);
+      ASSERT_EQ(buf.size(), in->read_bytes(&buf[0], buf.size()));
+
+      for (size_t i = 0; i < buf.size(); ++i) {
+        ASSERT_EQ(value(offset + i), buf[i]);
+      }
+    }
+
+    // checksum does not affect the stream position
+    in->seek(4097);
+    const auto checksum = in->checksum(length);
+    ASSERT_EQ(4097, in->file_pointer());
+    ASSERT_EQ(value(4097), in->read_byte());
+
+    // concurrent readers over a shared handle
+    std::vector<std::thread> threads;
+    std::atomic<bool> success(true);
+
+    for (size_t t = 0; t < 4; ++t) {
+      threads.emplace_back([&in, &success, &value, checksum, length, t]() {
+        auto input = in->reopen();
+
+        if (!input) {
+          success = false;
+          return;
+        }
+
+        input->seek(4097);
+        success = success && checksum == input->checksum(length);
+
+        for (size_t i = t; i < length; i += 997) {
+          input->seek(i);
+          success = success && value(i) == input->read_byte();
+        }
+      });
+    }
+
+    for (auto& thread : threads) {
+      thread.join();
+    }
+
+    ASSERT_TRUE(success);
+  }
+}
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                       END-OF-FILE
 // -----------------------------------------------------------------------------
\ No newline at end of file
@@ -67,6 +67,14 @@ TEST_F(memory_directory_test, lock_obtain_release) {
   lock_obtain_release();
 }
 
+TEST_F(memory_directory_test, prefetch) {
+  prefetch();
+}
+
+TEST_F(memory_directory_test, read_buffer) {
+  read_buffer(false);
+}
+
 TEST_F(memory_directory_test, directory_size) {
   directory_size();
 }
@@ -108,6 +108,14 @@ TEST_F(mmap_directory_test, lock_obtain_release) {
   lock_obtain_release();
 }
 
+TEST_F(mmap_directory_test, prefetch) {
+  prefetch();
+}
+
+TEST_F(mmap_directory_test, read_buffer) {
+  read_buffer(true);
+}
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                       END-OF-FILE
 // -----------------------------------------------------------------------------
\ No newline at end of file
@@ -174,6 +174,35 @@ void read_write_block(const std::vector<uint32_t>& source, std::vector<uint32_t>
   ASSERT_EQ(source, read);
 }
 
+template<typename T>
+void read_write_block_simd(const std::vector<T>& source) {
+  std::vector<T> enc_dec_buf(source.size(), std::numeric_limits<T>::max());
+
+  // write block
+  iresearch::bytes_output out;
+  irs::encode::bitpack::write_block_simd(out, &source[0], uint32_t(source.size()), &enc_dec_buf[0]);
+
+  // read block
+  {
+    iresearch::bytes_input in(out);
+    std::vector<T> read(source.size());
+    irs::encode::bitpack::read_block_simd(in, uint32_t(source.size()), &enc_dec_buf[0], read.data());
+    ASSERT_EQ(source, read);
+    ASSERT_EQ(in.length(), in.file_pointer());
+  }
+
+  // skip block
+  {
+    iresearch::bytes_ref_input in(out);
+    if (sizeof(T) == sizeof(uint32_t)) {
+      irs::encode::bitpack::skip_block32(in, uint32_t(source.size()));
+    } else {
+      irs::encode::bitpack::skip_block64(in, uint32_t(source.size()));
+    }
+    ASSERT_EQ(in.length(), in.file_pointer());
+  }
+}
+
 void read_write_block(const std::vector<uint32_t>& source) {
   // intermediate buffer for encoding/decoding
   std::vector<uint32_t> enc_dec_buf(source.size());
@@ -604,6 +633,56 @@ TEST(store_utils_tests, read_write_block) {
   }
 }
 
+TEST(store_utils_tests, read_write_block_simd) {
+  const size_t block_size = 2*irs::packed::SIMD_BLOCK_SIZE_32;
+
+  // distinct values
+  {
+    std::vector<uint32_t> data32(block_size);
+    std::vector<uint64_t> data64(block_size);
+    for (size_t i = 0; i < block_size; ++i) {
+      data32[i] = uint32_t(i * 2654435761U) >> 3;
+      data64[i] = data32[i];
+    }
+
+    tests::detail::read_write_block_simd(data32);
+    tests::detail::read_write_block_simd(data64); // fits 32 bits
+
+    data64[7] = 144115188109676544ULL;
+    tests::detail::read_write_block_simd(data64); // requires 64 bits
+  }
+
+  // all equals
+  tests::detail::read_write_block_simd(std::vector<uint32_t>(block_size, 5));
+  tests::detail::read_write_block_simd(std::vector<uint64_t>(block_size, 5));
+
+  // deltas
+  for (auto max : { uint64_t(1000), uint64_t(1) << 40 }) {
+    std::vector<uint64_t> deltas(block_size);
+    for (size_t i = 0; i < block_size; ++i) {
+      deltas[i] = (i * 2654435761U) % max;
+    }
+
+    std::vector<uint64_t> enc_dec_buf(block_size);
+    irs::bytes_output out;
+    irs::encode::bitpack::write_block_simd(out, &deltas[0], uint32_t(block_size), &enc_dec_buf[0]);
+
+    const uint64_t base = 42;
+    std::vector<uint64_t> read(block_size);
+    irs::bytes_input in(out);
+    const auto last = irs::encode::bitpack::read_block_delta_simd(
+      in, uint32_t(block_size), &enc_dec_buf[0], read.data(), base
+    );
+
+    uint64_t expected = base;
+    for (size_t i = 0; i < block_size; ++i) {
+      expected += deltas[i];
+      ASSERT_EQ(expected, read[i]);
+    }
+    ASSERT_EQ(expected, last);
+  }
+}
+
 TEST(store_utils_tests, shift_pack_unpack_32) {
   tests::detail::shift_pack_unpack_core_32(2343242, true);
   tests::detail::shift_pack_unpack_core_32(2343242, false);
@@ -646,6 +646,77 @@ TEST_F(async_utils_tests, test_thread_pool_stop_mt) {
   }
 }
 
+TEST_F(async_utils_tests, test_parallel_for_mt) {
+  // every task is run exactly once
+  {
+    irs::async_utils::thread_pool pool(4, 4);
+    std::vector<std::atomic<size_t>> counts(100);
+
+    for (auto& count: counts) {
+      count = 0;
+    }
+
+    irs::async_utils::parallel_for(&pool, counts.size(), [&counts](size_t i)->void {
+      ++counts[i];
+    });
+
+    for (auto& count: counts) {
+      ASSERT_EQ(1, count);
+    }
+  }
+
+  // no pool
+  {
+    size_t count = 0;
+
+    irs::async_utils::parallel_for(nullptr, 10, [&count](size_t)->void { ++count; });
+    ASSERT_EQ(10, count);
+  }
+
+  // first failure is rethrown after all tasks finish
+  {
+    irs::async_utils::thread_pool pool(2, 2);
+    std::atomic<size_t> count(0);
+
+    ASSERT_THROW(
+      irs::async_utils::parallel_for(&pool, 10, [&count](size_t i)->void {
+        ++count;
+
+        if (i == 5) {
+          throw std::runtime_error("failure");
+        }
+      }),
+      std::runtime_error
+    );
+    ASSERT_EQ(10, count);
+  }
+
+  // nested calls from a saturated pool do not deadlock
+  {
+    irs::async_utils::thread_pool pool(2, 2);
+    std::atomic<size_t> count(0);
+    std::mutex mutex;
+    std::condition_variable cond;
+    size_t finished = 0;
+    auto task = [&]()->void {
+      irs::async_utils::parallel_for(&pool, 10, [&count](size_t)->void { ++count; });
+      std::lock_guard<std::mutex> lock(mutex);
+      ++finished;
+      cond.notify_all();
+    };
+
+    std::unique_lock<std::mutex> lock(mutex);
+    pool.run(task);
+    pool.run(task);
+
+    while (finished < 2) {
+      ASSERT_EQ(std::cv_status::no_timeout, cond.wait_for(lock, std::chrono::milliseconds(10000)));
+    }
+
+    ASSERT_EQ(20, count);
+  }
+}
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                       END-OF-FILE
 // -----------------------------------------------------------------------------
\ No newline at end of file
@@ -261,6 +261,62 @@ TEST(bit_packing_tests, pack_unpack_64) {
   }
 }
 
+TEST(bit_packing_tests, pack_unpack_simd) {
+  const size_t size = 2*packed::SIMD_BLOCK_SIZE_32;
+
+  std::vector<uint32_t> src(size);
+  for (size_t i = 0; i < size; ++i) {
+    src[i] = uint32_t(i * 2654435761U); // distinct values in all bits
+  }
+
+  for (uint32_t bits = 1; bits <= 32; ++bits) {
+    const uint32_t mask = packed::max_value<uint32_t>(bits);
+
+    std::vector<uint32_t> packed(packed::blocks_required_32(size, bits));
+    packed::pack_simd(&src[0], &src[0] + size, &packed[0], bits);
+
+    // check vertical layout: value 'i' is stored in the lane 'i % 4'
+    for (size_t i = 0; i < packed::SIMD_BLOCK_SIZE_32; ++i) {
+      const size_t row = i / 4, lane = i % 4;
+      const size_t word = (row * bits) / 32, shift = (row * bits) % 32;
+
+      uint64_t value = packed[4*word + lane] >> shift;
+      if (shift + bits > 32) {
+        value |= uint64_t(packed[4*(word + 1) + lane]) << (32 - shift);
+      }
+
+      ASSERT_EQ(src[i] & mask, uint32_t(value) & mask);
+    }
+
+    // 32-bit
+    std::vector<uint32_t> unpacked(size);
+    packed::unpack_simd(&unpacked[0], &unpacked[0] + size, &packed[0], bits);
+
+    for (size_t i = 0; i < size; ++i) {
+      ASSERT_EQ(src[i] & mask, unpacked[i]);
+    }
+
+    // 64-bit
+    std::vector<uint64_t> unpacked64(size);
+    packed::unpack_simd(&unpacked64[0], &unpacked64[0] + size, &packed[0], bits);
+
+    for (size_t i = 0; i < size; ++i) {
+      ASSERT_EQ(src[i] & mask, unpacked64[i]);
+    }
+
+    // deltas
+    const uint64_t base = uint64_t(integer_traits<uint32_t>::const_max) - 1;
+    std::vector<uint64_t> decoded(size);
+    packed::unpack_delta_simd(&decoded[0], &decoded[0] + size, &packed[0], bits, base);
+
+    uint64_t expected = base;
+    for (size_t i = 0; i < size; ++i) {
+      expected += src[i] & mask;
+      ASSERT_EQ(expected, decoded[i]);
+    }
+  }
+}
+
 TEST(bit_packing_tests, iterator32) {
   std::vector<uint32_t> src{
     14410, 21766, 15994, 29493, 20819,
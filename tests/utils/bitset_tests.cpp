@@ -396,6 +396,93 @@ TEST(bitset_tests, memset) {
   }
 }
 
+TEST(bitset_tests, and_count) {
+  const bitset::index_t size = 1000;
+  bitset lhs(size);
+  bitset rhs(size);
+
+  for (bitset::index_t i = 0; i < size; i += 3) {
+    lhs.set(i);
+  }
+
+  for (bitset::index_t i = 0; i < size; i += 5) {
+    rhs.set(i);
+  }
+
+  ASSERT_EQ(334, lhs.count());
+  ASSERT_EQ(200, rhs.count());
+  ASSERT_EQ(67, lhs.and_count(rhs)); // multiples of 15
+  ASSERT_EQ(67, rhs.and_count(lhs));
+  ASSERT_EQ(334, lhs.and_count(lhs));
+
+  // intersection with a shorter bitset
+  bitset short_set(100);
+  for (bitset::index_t i = 0; i < short_set.size(); ++i) {
+    short_set.set(i);
+  }
+  ASSERT_EQ(34, lhs.and_count(short_set));
+  ASSERT_EQ(34, short_set.and_count(lhs));
+
+  // intersection with an empty bitset
+  bitset empty;
+  ASSERT_EQ(0, lhs.and_count(empty));
+  ASSERT_EQ(0, empty.and_count(lhs));
+}
+
+TEST(bitset_tests, bitwise) {
+  // ensure runtime dispatched kernels match the scalar implementation
+  // for all lengths around vector boundaries
+  const size_t max_words = 67;
+  std::vector<bitset::word_t> lhs(max_words), rhs(max_words), expected, actual;
+
+  uint64_t seed = 0x2545F4914F6CDD1D;
+  auto next = [&seed]() {
+    seed ^= seed << 13; seed ^= seed >> 7; seed ^= seed << 17; // xorshift64
+    return bitset::word_t(seed);
+  };
+
+  for (size_t size = 0; size <= max_words; ++size) {
+    std::generate(lhs.begin(), lhs.end(), next);
+    std::generate(rhs.begin(), rhs.end(), next);
+
+    size_t expected_count = 0;
+    size_t expected_and_count = 0;
+    for (size_t i = 0; i < size; ++i) {
+      expected_count += math::math_traits<bitset::word_t>::pop(lhs[i]);
+      expected_and_count += math::math_traits<bitset::word_t>::pop(lhs[i] & rhs[i]);
+    }
+    ASSERT_EQ(expected_count, bitwise::count(lhs.data(), size));
+    ASSERT_EQ(expected_and_count, bitwise::and_count(lhs.data(), rhs.data(), size));
+
+    // AND
+    expected = actual = lhs;
+    std::transform(expected.begin(), expected.begin() + size, rhs.begin(), expected.begin(), std::bit_and<bitset::word_t>());
+    bitwise::and_assign(actual.data(), rhs.data(), size);
+    ASSERT_EQ(expected, actual);
+
+    // OR
+    expected = actual = lhs;
+    std::transform(expected.begin(), expected.begin() + size, rhs.begin(), expected.begin(), std::bit_or<bitset::word_t>());
+    bitwise::or_assign(actual.data(), rhs.data(), size);
+    ASSERT_EQ(expected, actual);
+
+    // AND NOT
+    expected = actual = lhs;
+    std::transform(
+      expected.begin(), expected.begin() + size, rhs.begin(), expected.begin(),
+      [] (bitset::word_t l, bitset::word_t r) { return l & ~r; }
+    );
+    bitwise::andnot_assign(actual.data(), rhs.data(), size);
+    ASSERT_EQ(expected, actual);
+
+    // XOR
+    expected = actual = lhs;
+    std::transform(expected.begin(), expected.begin() + size, rhs.begin(), expected.begin(), std::bit_xor<bitset::word_t>());
+    bitwise::xor_assign(actual.data(), rhs.data(), size);
+    ASSERT_EQ(expected, actual);
+  }
+}
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                       END-OF-FILE
 // -----------------------------------------------------------------------------
\ No newline at end of file
@@ -2700,6 +2700,75 @@ TEST(bitvector_tests, shrink_to_fit) {
   }
 }
 
+TEST(bitvector_tests, bit_and_full_last_word) {
+  // 'other.size()' ends exactly on a word boundary, last word must be kept
+  irs::bitvector bv0;
+  bv0.set(3);
+  bv0.set(irs::bits_required<irs::bitset::word_t>() - 1);
+  bv0.set(irs::bits_required<irs::bitset::word_t>() + 1);
+
+  irs::bitvector bv1(2 * irs::bits_required<irs::bitset::word_t>());
+  bv1.set(irs::bits_required<irs::bitset::word_t>() - 1);
+  bv1.set(irs::bits_required<irs::bitset::word_t>() + 1);
+  ASSERT_EQ(2 * irs::bits_required<irs::bitset::word_t>(), bv1.size());
+
+  ASSERT_EQ(2, bv0.and_count(bv1));
+
+  bv0 &= bv1;
+  ASSERT_EQ(2 * irs::bits_required<irs::bitset::word_t>(), bv0.size());
+  ASSERT_EQ(2, bv0.count());
+  ASSERT_FALSE(bv0.test(3));
+  ASSERT_TRUE(bv0.test(irs::bits_required<irs::bitset::word_t>() - 1));
+  ASSERT_TRUE(bv0.test(irs::bits_required<irs::bitset::word_t>() + 1));
+}
+
+TEST(bitvector_tests, and_count) {
+  // empty operands
+  {
+    irs::bitvector bv0;
+    irs::bitvector bv1;
+    ASSERT_EQ(0, bv0.and_count(bv1));
+
+    bv1.set(3);
+    ASSERT_EQ(0, bv0.and_count(bv1));
+    ASSERT_EQ(0, bv1.and_count(bv0));
+  }
+
+  // must match 'count()' of a materialized intersection
+  {
+    const size_t size = 5000;
+    irs::bitvector bv0;
+    irs::bitvector bv1;
+
+    for (size_t i = 0; i < size; i += 3) {
+      bv0.set(i);
+    }
+
+    for (size_t i = 0; i < size; i += 7) {
+      bv1.set(i);
+    }
+
+    for (size_t bits : { size_t(1), size_t(63), size_t(64), size_t(65), size_t(1000), size_t(2048), size }) {
+      irs::bitvector bv2;
+      for (size_t i = 0; i < bits; i += 2) {
+        bv2.set(i);
+      }
+
+      for (auto* lhs : { &bv0, &bv1, &bv2 }) {
+        for (auto* rhs : { &bv0, &bv1, &bv2 }) {
+          irs::bitvector expected(*lhs);
+          expected &= *rhs;
+          ASSERT_EQ(expected.count(), lhs->and_count(*rhs));
+        }
+      }
+    }
+
+    const auto prev_count = bv0.count();
+    ASSERT_EQ(239, bv0.and_count(bv1)); // multiples of 21 below 5000
+    ASSERT_EQ(prev_count, bv0.count()); // operands are unchanged
+  }
+}
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                       END-OF-FILE
 // -----------------------------------------------------------------------------
\ No newline at end of file
@@ -0,0 +1,164 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2016 by EMC Corporation, All Rights Reserved
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is EMC Corporation
+///
+/// @author Andrey Abramov
+/// @author Vasiliy Nabatchikov
+////////////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+#include "utils/block_cache.hpp"
+
+#include <thread>
+
+TEST(block_cache_tests, next_owner) {
+  const auto owner0 = irs::block_cache::next_owner();
+  const auto owner1 = irs::block_cache::next_owner();
+  ASSERT_NE(owner0, owner1);
+}
+
+TEST(block_cache_tests, find_emplace) {
+  irs::block_cache cache(100, 1);
+  ASSERT_EQ(100, cache.max_size());
+
+  const auto owner = irs::block_cache::next_owner();
+  ASSERT_EQ(nullptr, cache.find<int>(owner, 0));
+
+  auto block = cache.emplace<int>(owner, 0, std::make_shared<const int>(42), 10);
+  ASSERT_NE(nullptr, block);
+  ASSERT_EQ(42, *block);
+
+  // already cached
+  auto dup = cache.emplace<int>(owner, 0, std::make_shared<const int>(24), 10);
+  ASSERT_EQ(block, dup);
+
+  // different owner
+  ASSERT_EQ(nullptr, cache.find<int>(irs::block_cache::next_owner(), 0));
+
+  ASSERT_EQ(block, cache.find<int>(owner, 0));
+
+  auto stats = cache.stats();
+  ASSERT_EQ(1, stats.hits);
+  ASSERT_EQ(2, stats.misses);
+  ASSERT_EQ(0, stats.evictions);
+  ASSERT_EQ(10, stats.size);
+  ASSERT_EQ(1, stats.count);
+}
+
+TEST(block_cache_tests, evict_lru) {
+  irs::block_cache cache(30, 1);
+  const auto owner = irs::block_cache::next_owner();
+
+  cache.emplace<int>(owner, 0, std::make_shared<const int>(0), 10);
+  cache.emplace<int>(owner, 1, std::make_shared<const int>(1), 10);
+  auto block2 = cache.emplace<int>(owner, 2, std::make_shared<const int>(2), 10);
+
+  // mark block 0 as recently used
+  ASSERT_NE(nullptr, cache.find<int>(owner, 0));
+
+  // evicts block 1
+  cache.emplace<int>(owner, 3, std::make_shared<const int>(3), 10);
+  ASSERT_EQ(nullptr, cache.find<int>(owner, 1));
+  ASSERT_NE(nullptr, cache.find<int>(owner, 0));
+  ASSERT_NE(nullptr, cache.find<int>(owner, 3));
+
+  // evicts blocks 2 and 0
+  cache.emplace<int>(owner, 4, std::make_shared<const int>(4), 20);
+  ASSERT_EQ(nullptr, cache.find<int>(owner, 2));
+  ASSERT_EQ(nullptr, cache.find<int>(owner, 0));
+
+  // evicted block is still valid
+  ASSERT_EQ(2, *block2);
+
+  // block exceeding the limit isn't cached
+  auto huge = cache.emplace<int>(owner, 5, std::make_shared<const int>(5), 31);
+  ASSERT_NE(nullptr, huge);
+  ASSERT_EQ(5, *huge);
+  ASSERT_EQ(nullptr, cache.find<int>(owner, 5));
+
+  auto stats = cache.stats();
+  ASSERT_EQ(3, stats.evictions);
+  ASSERT_EQ(30, stats.size);
+  ASSERT_EQ(2, stats.count);
+}
+
+TEST(block_cache_tests, erase_clear) {
+  irs::block_cache cache(1000);
+  const auto owner0 = irs::block_cache::next_owner();
+  const auto owner1 = irs::block_cache::next_owner();
+
+  for (uint64_t i = 0; i < 10; ++i) {
+    cache.emplace<uint64_t>(owner0, i, std::make_shared<const uint64_t>(i), 1);
+    cache.emplace<uint64_t>(owner1, i, std::make_shared<const uint64_t>(i), 1);
+  }
+  ASSERT_EQ(20, cache.stats().count);
+
+  cache.erase(owner0);
+  ASSERT_EQ(10, cache.stats().count);
+  ASSERT_EQ(10, cache.stats().size);
+
+  for (uint64_t i = 0; i < 10; ++i) {
+    ASSERT_EQ(nullptr, cache.find<uint64_t>(owner0, i));
+    ASSERT_EQ(i, *cache.find<uint64_t>(owner1, i));
+  }
+
+  cache.clear();
+  ASSERT_EQ(0, cache.stats().count);
+  ASSERT_EQ(0, cache.stats().size);
+  ASSERT_EQ(nullptr, cache.find<uint64_t>(owner1, 0));
+}
+
+TEST(block_cache_tests, concurrent_access) {
+  const size_t THREADS = 8;
+  const uint64_t BLOCKS = 1000;
+  auto cache = irs::block_cache::make(BLOCKS * sizeof(uint64_t) / 4);
+  const auto owner = irs::block_cache::next_owner();
+
+  std::vector<std::thread> threads;
+  std::atomic<bool> failed{ false };
+
+  for (size_t i = 0; i < THREADS; ++i) {
+    threads.emplace_back([cache, owner, &failed, BLOCKS]() {
+      for (uint64_t offset = 0; offset < 10*BLOCKS; ++offset) {
+        const auto key = offset % BLOCKS;
+        auto block = cache->find<uint64_t>(owner, key);
+
+        if (!block) {
+          block = cache->emplace<uint64_t>(
+            owner, key, std::make_shared<const uint64_t>(key), sizeof(uint64_t)
+          );
+        }
+
+        if (!block || key != *block) {
+          failed = true;
+        }
+      }
+    });
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  ASSERT_FALSE(failed);
+
+  const auto stats = cache->stats();
+  ASSERT_EQ(THREADS*10*BLOCKS, stats.hits + stats.misses);
+  ASSERT_LE(stats.size, cache->max_size());
+  ASSERT_LT(0, stats.evictions);
+}
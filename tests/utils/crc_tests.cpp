@@ -0,0 +1,114 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2016 by EMC Corporation, All Rights Reserved
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is EMC Corporation
+///
+/// @author Andrey Abramov
+/// @author Vasiliy Nabatchikov
+////////////////////////////////////////////////////////////////////////////////
+
+#include "tests_shared.hpp"
+
+#include "utils/crc.hpp"
+
+#include <string>
+#include <vector>
+
+using namespace iresearch;
+
+namespace tests {
+
+// bit-at-a-time reference implementation
+uint32_t crc32c_ref(const byte_type* data, size_t size) {
+  uint32_t crc = 0xFFFFFFFF;
+
+  for (size_t i = 0; i < size; ++i) {
+    crc ^= data[i];
+
+    for (size_t j = 0; j < 8; ++j) {
+      crc = (crc >> 1) ^ (0x82F63B78 & (0 - (crc & 1)));
+    }
+  }
+
+  return ~crc;
+}
+
+} // tests
+
+TEST(crc_tests, crc32c_check_values) {
+  {
+    crc32c crc;
+    ASSERT_EQ(0, crc.checksum());
+  }
+
+  {
+    const std::string data = "123456789";
+    crc32c crc;
+    crc.process_bytes(data.c_str(), data.size());
+    ASSERT_EQ(0xE3069283, crc.checksum());
+  }
+
+  // RFC 3720, B.4
+  {
+    const std::vector<byte_type> data(32, 0);
+    crc32c crc;
+    crc.process_block(&data[0], &data[0] + data.size());
+    ASSERT_EQ(0x8A9136AA, crc.checksum());
+  }
+
+  {
+    const std::vector<byte_type> data(32, 0xFF);
+    crc32c crc;
+    crc.process_bytes(&data[0], data.size());
+    ASSERT_EQ(0x62A8AB43, crc.checksum());
+  }
+}
+
+TEST(crc_tests, crc32c_incremental) {
+  std::vector<byte_type> data(4099);
+
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = byte_type(i * 131 + (i >> 8));
+  }
+
+  // unaligned starts, tails of every length, chunked processing
+  for (size_t offset = 0; offset < 9; ++offset) {
+    for (size_t size = 0; size < 40; ++size) {
+      crc32c crc;
+      crc.process_bytes(&data[offset], size);
+      ASSERT_EQ(tests::crc32c_ref(&data[offset], size), crc.checksum());
+    }
+
+    const auto size = data.size() - offset;
+    const auto expected = tests::crc32c_ref(&data[offset], size);
+
+    for (size_t chunk : { 1, 3, 8, 13, 64, 1000 }) {
+      crc32c crc;
+
+      for (size_t pos = 0; pos < size; pos += chunk) {
+        crc.process_bytes(&data[offset + pos], (std::min)(chunk, size - pos));
+      }
+
+      ASSERT_EQ(expected, crc.checksum());
+    }
+  }
+
+  crc32c crc;
+  crc.process_bytes(&data[0], data.size());
+  crc.reset();
+  ASSERT_EQ(0, crc.checksum());
+}
@@ -0,0 +1,206 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2016 by EMC Corporation, All Rights Reserved
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is EMC Corporation
+///
+/// @author Andrey Abramov
+/// @author Vasiliy Nabatchikov
+////////////////////////////////////////////////////////////////////////////////
+
+#include "tests_shared.hpp"
+#include "store/memory_directory.hpp"
+#include "utils/index_utils.hpp"
+
+#include <set>
+
+namespace tests {
+  class index_utils_tests: public ::testing::Test {
+   protected:
+    // adds a segment consisting of a single file of the specified size
+    void add_segment(
+        size_t bytes,
+        uint64_t docs_count = 100,
+        uint64_t live_docs_count = 100) {
+      std::string name = "segment" + std::to_string(meta_.size());
+      auto out = dir_.create(name);
+      ASSERT_FALSE(!out);
+      std::vector<irs::byte_type> data(bytes);
+      out->write_bytes(data.data(), data.size());
+      out->flush();
+
+      irs::segment_meta::file_set files;
+      files.emplace(name);
+
+      std::vector<irs::index_meta::index_segment_t> segments;
+      segments.emplace_back(irs::segment_meta(
+        std::move(name), nullptr, docs_count, live_docs_count, false, std::move(files)
+      ));
+      meta_.add(segments.begin(), segments.end());
+    }
+
+    // names of the segments accepted by the policy
+    std::set<std::string> accepted(const irs::index_writer::consolidation_policy_t& policy) {
+      std::set<std::string> names;
+      auto acceptor = policy(dir_, meta_);
+
+      for (auto& segment : meta_) {
+        if (acceptor(segment.meta)) {
+          names.emplace(segment.meta.name);
+        }
+      }
+
+      return names;
+    }
+
+    irs::memory_directory dir_;
+    irs::index_meta meta_;
+  };
+}
+
+using namespace tests;
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                        test suite
+// -----------------------------------------------------------------------------
+
+TEST_F(index_utils_tests, consolidate_tier_within_budget) {
+  irs::index_utils::consolidate_tier_options options;
+  options.floor_segment_bytes = 1000;
+  options.segments_per_tier = 4;
+
+  // an empty index
+  ASSERT_TRUE(accepted(irs::index_utils::consolidate_tier(options)).empty());
+
+  // a single tier
+  for (size_t i = 0; i < 4; ++i) {
+    add_segment(1000);
+  }
+
+  ASSERT_TRUE(accepted(irs::index_utils::consolidate_tier(options)).empty());
+
+  // one segment per tier
+  add_segment(10000);
+  add_segment(100000);
+
+  ASSERT_TRUE(accepted(irs::index_utils::consolidate_tier(options)).empty());
+}
+
+TEST_F(index_utils_tests, consolidate_tier_over_budget) {
+  irs::index_utils::consolidate_tier_options options;
+  options.floor_segment_bytes = 1000;
+  options.segments_per_tier = 4;
+  options.max_segments = 10;
+
+  for (size_t i = 0; i < 12; ++i) {
+    add_segment(1000);
+  }
+
+  // merge width is limited
+  ASSERT_EQ(10, accepted(irs::index_utils::consolidate_tier(options)).size());
+}
+
+TEST_F(index_utils_tests, consolidate_tier_skew) {
+  irs::index_utils::consolidate_tier_options options;
+  options.floor_segment_bytes = 1000;
+  options.segments_per_tier = 2;
+  options.max_segments = 4;
+
+  add_segment(100000); // segment0
+
+  for (size_t i = 0; i < 8; ++i) {
+    add_segment(1000 + i);
+  }
+
+  // similarly sized segments are merged, the large one is left intact
+  auto names = accepted(irs::index_utils::consolidate_tier(options));
+  ASSERT_EQ(4, names.size());
+  ASSERT_EQ(names.end(), names.find("segment0"));
+}
+
+TEST_F(index_utils_tests, consolidate_tier_max_bytes) {
+  irs::index_utils::consolidate_tier_options options;
+  options.floor_segment_bytes = 100;
+  options.segments_per_tier = 2;
+  options.max_segments = 10;
+  options.max_segments_bytes = 3500;
+
+  for (size_t i = 0; i < 10; ++i) {
+    add_segment(1000);
+  }
+
+  // the merged segment doesn't exceed the limit
+  ASSERT_EQ(3, accepted(irs::index_utils::consolidate_tier(options)).size());
+
+  // too large segments are skipped
+  options.max_segments_bytes = 1500;
+  ASSERT_TRUE(accepted(irs::index_utils::consolidate_tier(options)).empty());
+}
+
+TEST_F(index_utils_tests, consolidate_tier_removals) {
+  irs::index_utils::consolidate_tier_options options;
+  options.floor_segment_bytes = 1000;
+  options.segments_per_tier = 10;
+  options.max_segments = 2;
+
+  add_segment(1000);
+  add_segment(1000);
+  add_segment(1000, 100, 10); // segment2, mostly removed
+  add_segment(1000);
+
+  // within budget, but removed documents should be reclaimed
+  auto names = accepted(irs::index_utils::consolidate_tier(options));
+  ASSERT_EQ(2, names.size());
+  ASSERT_NE(names.end(), names.find("segment2"));
+}
+
+TEST_F(index_utils_tests, consolidate_tier_single_removals) {
+  irs::index_utils::consolidate_tier_options options;
+  options.floor_segment_bytes = 1000;
+  options.segments_per_tier = 10;
+  options.max_segments_bytes = 20500;
+
+  // too large to be merged with any other segment, but mostly removed
+  add_segment(100000, 100, 20); // segment0
+
+  // the only segment of the index
+  {
+    auto names = accepted(irs::index_utils::consolidate_tier(options));
+    ASSERT_EQ(1, names.size());
+    ASSERT_NE(names.end(), names.find("segment0"));
+  }
+
+  add_segment(1000);
+  add_segment(1000);
+  add_segment(1000);
+
+  // reclaiming the removals is preferred to merging the small segments
+  {
+    auto names = accepted(irs::index_utils::consolidate_tier(options));
+    ASSERT_EQ(1, names.size());
+    ASSERT_NE(names.end(), names.find("segment0"));
+  }
+
+  // not selected alone unless dominated by removed documents
+  meta_ = irs::index_meta();
+  add_segment(100000, 100, 60); // segment0
+  options.max_segments_bytes = 100000;
+  ASSERT_TRUE(accepted(irs::index_utils::consolidate_tier(options)).empty());
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                       END-OF-FILE
+// -----------------------------------------------------------------------------
@@ -156,6 +156,26 @@ TEST_F(object_pool_tests, bounded_sobject_pool) {
     ASSERT_EQ(obj_ptr, obj.get());
   }
 
+  // test acquisition of a specific object
+  {
+    iresearch::bounded_object_pool<test_sobject> pool(2);
+    auto obj = pool.emplace(1);
+    auto& value = *obj;
+    test_sobject other(2);
+
+    ASSERT_FALSE(pool.try_acquire(value)); // in use
+    ASSERT_FALSE(pool.try_acquire(other)); // not managed by the pool
+    obj.reset();
+
+    auto acquired = pool.try_acquire(value);
+    ASSERT_TRUE(acquired);
+    ASSERT_EQ(&value, acquired.get());
+    ASSERT_FALSE(pool.try_acquire(value)); // in use
+    acquired.reset();
+    obj = pool.emplace(3);
+    ASSERT_EQ(&value, obj.get()); // released object is reused
+  }
+
   // test shared visitation
   {
     iresearch::bounded_object_pool<test_sobject> pool(1);